@@ -37,6 +37,7 @@
 #include "core/io/file_access_compressed.h"
 #include "core/io/file_access_encrypted.h"
 #include "core/io/marshalls.h"
+#include "core/math/batch_math.h"
 #include "core/math/geometry_2d.h"
 #include "core/math/geometry_3d.h"
 #include "core/os/keyboard.h"
@@ -1073,6 +1074,40 @@ Vector<int32_t> Geometry3D::tetrahedralize_delaunay(const Vector<Vector3> &p_poi
 	return ::Geometry3D::tetrahedralize_delaunay(p_points);
 }
 
+Vector<float> Geometry3D::transform_transforms(const Transform3D &p_transform, const Vector<float> &p_transforms, int p_stride) {
+	ERR_FAIL_COND_V_MSG(p_stride < 12, Vector<float>(), "The stride must be at least 12 floats.");
+	ERR_FAIL_COND_V_MSG(p_transforms.size() % p_stride != 0, Vector<float>(), "The array size must be a multiple of the stride.");
+
+	Vector<float> ret = p_transforms;
+	float *w = ret.ptrw();
+	BatchMath::xform_transforms_3x4(p_transform, w, w, ret.size() / p_stride, p_stride);
+	return ret;
+}
+
+Vector<float> Geometry3D::transform_aabbs(const Transform3D &p_transform, const Vector<float> &p_aabbs) {
+	ERR_FAIL_COND_V_MSG(p_aabbs.size() % 6 != 0, Vector<float>(), "The array size must be a multiple of 6.");
+
+	Vector<float> ret = p_aabbs;
+	float *w = ret.ptrw();
+#ifdef REAL_T_IS_DOUBLE
+	LocalVector<AABB> aabbs;
+	aabbs.resize(ret.size() / 6);
+	for (uint32_t i = 0; i < aabbs.size(); i++) {
+		aabbs[i] = AABB(Vector3(w[i * 6 + 0], w[i * 6 + 1], w[i * 6 + 2]), Vector3(w[i * 6 + 3], w[i * 6 + 4], w[i * 6 + 5]));
+	}
+	BatchMath::xform_aabbs(p_transform, aabbs.ptr(), aabbs.ptr(), aabbs.size());
+	for (uint32_t i = 0; i < aabbs.size(); i++) {
+		for (int j = 0; j < 3; j++) {
+			w[i * 6 + j] = aabbs[i].position[j];
+			w[i * 6 + 3 + j] = aabbs[i].size[j];
+		}
+	}
+#else
+	BatchMath::xform_aabbs(p_transform, (const AABB *)w, (AABB *)w, ret.size() / 6);
+#endif
+	return ret;
+}
+
 void Geometry3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("compute_convex_mesh_points", "planes"), &Geometry3D::compute_convex_mesh_points);
 	ClassDB::bind_method(D_METHOD("build_box_planes", "extents"), &Geometry3D::build_box_planes);
@@ -1095,6 +1130,9 @@ void Geometry3D::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("clip_polygon", "points", "plane"), &Geometry3D::clip_polygon);
 	ClassDB::bind_method(D_METHOD("tetrahedralize_delaunay", "points"), &Geometry3D::tetrahedralize_delaunay);
+
+	ClassDB::bind_method(D_METHOD("transform_transforms", "transform", "transforms", "stride"), &Geometry3D::transform_transforms, DEFVAL(12));
+	ClassDB::bind_method(D_METHOD("transform_aabbs", "transform", "aabbs"), &Geometry3D::transform_aabbs);
 }
 
 ////// Marshalls //////
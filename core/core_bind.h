@@ -346,6 +346,9 @@ public:
 	Vector<Vector3> clip_polygon(const Vector<Vector3> &p_points, const Plane &p_plane);
 	Vector<int32_t> tetrahedralize_delaunay(const Vector<Vector3> &p_points);
 
+	Vector<float> transform_transforms(const Transform3D &p_transform, const Vector<float> &p_transforms, int p_stride = 12);
+	Vector<float> transform_aabbs(const Transform3D &p_transform, const Vector<float> &p_aabbs);
+
 	Geometry3D() { singleton = this; }
 };
 
@@ -0,0 +1,190 @@
+/**************************************************************************/
+/*  trace_profiler.cpp                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "trace_profiler.h"
+
+#include "core/io/file_access.h"
+
+std::atomic<bool> TraceProfiler::recording(false);
+uint32_t TraceProfiler::events_per_thread = 1 << 16;
+uint64_t TraceProfiler::start_usec = 0;
+
+BinaryMutex TraceProfiler::buffers_mutex;
+LocalVector<TraceProfiler::ThreadBuffer *> TraceProfiler::buffers;
+std::atomic<uint32_t> TraceProfiler::generation(0);
+std::atomic<uint32_t> TraceProfiler::writers(0);
+thread_local TraceProfiler::ThreadBuffer *TraceProfiler::thread_buffer = nullptr;
+thread_local uint32_t TraceProfiler::thread_generation = 0;
+thread_local const char *TraceProfiler::thread_name = nullptr;
+
+TraceProfiler::ThreadBuffer *TraceProfiler::_create_thread_buffer(uint32_t &r_generation) {
+	ThreadBuffer *buffer = memnew(ThreadBuffer);
+	buffer->thread_id = Thread::get_caller_id();
+	buffer->thread_name = thread_name;
+	buffer->events = memnew_arr(Event, events_per_thread);
+	buffer->mask = events_per_thread - 1;
+	buffer->written.store(0, std::memory_order_relaxed);
+
+	// Read under the lock, so the buffer belongs to the list of that generation.
+	MutexLock lock(buffers_mutex);
+	r_generation = generation.load(std::memory_order_relaxed);
+	buffers.push_back(buffer);
+	return buffer;
+}
+
+void TraceProfiler::record(const char *p_name, uint64_t p_begin_usec, uint64_t p_end_usec) {
+	// Counted before reading the generation, so finish() either sees this
+	// thread as writing or has already bumped the generation it reads.
+	writers.fetch_add(1, std::memory_order_seq_cst);
+	ThreadBuffer *buffer = thread_buffer;
+	if (unlikely(!buffer || thread_generation != generation.load(std::memory_order_seq_cst))) {
+		buffer = _create_thread_buffer(thread_generation);
+		thread_buffer = buffer;
+	}
+
+	// Only this thread writes, readers use the count to know what's valid.
+	const uint64_t index = buffer->written.load(std::memory_order_relaxed);
+	Event &event = buffer->events[index & buffer->mask];
+	event.name = p_name;
+	event.begin_usec = p_begin_usec;
+	event.end_usec = p_end_usec;
+	buffer->written.store(index + 1, std::memory_order_release);
+	writers.fetch_sub(1, std::memory_order_release);
+}
+
+void TraceProfiler::set_thread_name(const char *p_name) {
+	thread_name = p_name;
+	writers.fetch_add(1, std::memory_order_seq_cst);
+	if (thread_buffer && thread_generation == generation.load(std::memory_order_seq_cst)) {
+		thread_buffer->thread_name = p_name;
+	}
+	writers.fetch_sub(1, std::memory_order_release);
+}
+
+void TraceProfiler::start(uint32_t p_events_per_thread) {
+	ERR_FAIL_COND_MSG(p_events_per_thread == 0, "The trace buffer needs room for at least one event.");
+	{
+		MutexLock lock(buffers_mutex);
+		if (buffers.is_empty()) {
+			events_per_thread = next_power_of_2(p_events_per_thread);
+		}
+	}
+	if (start_usec == 0) {
+		start_usec = OS::get_singleton()->get_ticks_usec();
+	}
+	recording.store(true, std::memory_order_relaxed);
+}
+
+void TraceProfiler::stop() {
+	recording.store(false, std::memory_order_relaxed);
+}
+
+void TraceProfiler::clear() {
+	ERR_FAIL_COND_MSG(is_recording(), "Can't clear the trace while recording.");
+	MutexLock lock(buffers_mutex);
+	for (ThreadBuffer *buffer : buffers) {
+		buffer->written.store(0, std::memory_order_relaxed);
+	}
+	start_usec = 0;
+}
+
+void TraceProfiler::get_events(HashMap<Thread::ID, LocalVector<Event>> &r_events) {
+	MutexLock lock(buffers_mutex);
+	for (ThreadBuffer *buffer : buffers) {
+		const uint64_t written = buffer->written.load(std::memory_order_acquire);
+		const uint64_t kept = MIN(written, (uint64_t)buffer->mask + 1);
+		LocalVector<Event> &events = r_events[buffer->thread_id];
+		for (uint64_t i = written - kept; i < written; i++) {
+			events.push_back(buffer->events[i & buffer->mask]);
+		}
+	}
+}
+
+Error TraceProfiler::save_chrome_trace(const String &p_path) {
+	Error err = OK;
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(err != OK, err, "Can't open trace file for writing: " + p_path);
+
+	HashMap<Thread::ID, LocalVector<Event>> events;
+	get_events(events);
+
+	f->store_string("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+	bool first = true;
+	{
+		MutexLock lock(buffers_mutex);
+		for (const ThreadBuffer *buffer : buffers) {
+			String name = buffer->thread_name ? String(buffer->thread_name) : (buffer->thread_id == Thread::MAIN_ID ? String("Main Thread") : vformat("Thread %d", buffer->thread_id));
+			f->store_string(vformat("%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}", first ? "" : ",\n", buffer->thread_id, name.json_escape()));
+			first = false;
+		}
+	}
+
+	for (const KeyValue<Thread::ID, LocalVector<Event>> &E : events) {
+		const String tid = itos(E.key);
+		for (const Event &event : E.value) {
+			// Zones that were open across a clear() began before the recording did.
+			if (event.begin_usec < start_usec) {
+				continue;
+			}
+			f->store_string(vformat(",\n{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%d,\"dur\":%d,\"pid\":1,\"tid\":%s}", String(event.name).json_escape(), event.begin_usec - start_usec, event.end_usec - event.begin_usec, tid));
+		}
+	}
+	f->store_string("\n]}\n");
+
+	f->flush();
+	if (f->get_error() != OK && f->get_error() != ERR_FILE_EOF) {
+		ERR_FAIL_V_MSG(ERR_CANT_CREATE, "Can't write trace file: " + p_path);
+	}
+
+	return OK;
+}
+
+void TraceProfiler::finish() {
+	stop();
+	LocalVector<ThreadBuffer *> retired;
+	{
+		MutexLock lock(buffers_mutex);
+		retired = buffers;
+		buffers.clear();
+		start_usec = 0;
+		generation.fetch_add(1, std::memory_order_seq_cst);
+	}
+
+	// Zones ending on other threads may still be writing to the old buffers.
+	// Not waited for under the lock, as they may be creating a new buffer.
+	while (writers.load(std::memory_order_seq_cst) != 0) {
+		OS::get_singleton()->yield();
+	}
+
+	for (ThreadBuffer *buffer : retired) {
+		memdelete_arr(buffer->events);
+		memdelete(buffer);
+	}
+}
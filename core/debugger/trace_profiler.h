@@ -0,0 +1,132 @@
+/**************************************************************************/
+/*  trace_profiler.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TRACE_PROFILER_H
+#define TRACE_PROFILER_H
+
+#include "core/os/mutex.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+
+#include <atomic>
+
+// Records scoped zones into a ring buffer per thread, to be saved as a Chrome
+// trace (also readable by Perfetto). Meant for profiling whole frames across
+// threads, including in headless builds, see the --profile-trace command line
+// option.
+//
+// Zones are always compiled in. They only cost a relaxed atomic load while not
+// recording, so place them around coarse units of work (a frame, a physics
+// step, a task) rather than in tight loops. Zone names must be string literals,
+// or at least outlive the recording.
+class TraceProfiler {
+public:
+	struct Event {
+		const char *name = nullptr;
+		uint64_t begin_usec = 0;
+		uint64_t end_usec = 0;
+	};
+
+private:
+	struct ThreadBuffer {
+		Thread::ID thread_id = Thread::UNASSIGNED_ID;
+		const char *thread_name = nullptr;
+		Event *events = nullptr;
+		uint32_t mask = 0;
+		// Total events written; the last mask + 1 of them are kept.
+		std::atomic<uint64_t> written;
+	};
+
+	static std::atomic<bool> recording;
+	static uint32_t events_per_thread;
+	static uint64_t start_usec;
+
+	static BinaryMutex buffers_mutex;
+	static LocalVector<ThreadBuffer *> buffers;
+	// Bumped by finish(), so threads drop their pointer to freed buffers.
+	static std::atomic<uint32_t> generation;
+	// Threads inside record(), which finish() waits for before freeing.
+	static std::atomic<uint32_t> writers;
+	static thread_local ThreadBuffer *thread_buffer;
+	static thread_local uint32_t thread_generation;
+	static thread_local const char *thread_name;
+
+	static ThreadBuffer *_create_thread_buffer(uint32_t &r_generation);
+
+public:
+	class Zone {
+		const char *name = nullptr;
+		uint64_t begin_usec = 0;
+
+	public:
+		_FORCE_INLINE_ Zone(const char *p_name) {
+			if (unlikely(is_recording())) {
+				name = p_name;
+				begin_usec = OS::get_singleton()->get_ticks_usec();
+			}
+		}
+		_FORCE_INLINE_ ~Zone() {
+			if (unlikely(name)) {
+				record(name, begin_usec, OS::get_singleton()->get_ticks_usec());
+			}
+		}
+	};
+
+	_FORCE_INLINE_ static bool is_recording() { return recording.load(std::memory_order_relaxed); }
+
+	static void record(const char *p_name, uint64_t p_begin_usec, uint64_t p_end_usec);
+	// Names the calling thread in traces.
+	static void set_thread_name(const char *p_name);
+
+	// The buffer size only applies to threads that haven't recorded anything yet.
+	static void start(uint32_t p_events_per_thread = 1 << 16);
+	static void stop();
+	// Forgets all recorded events. Not while recording.
+	static void clear();
+
+	// Gets the events kept for each thread, oldest first.
+	static void get_events(HashMap<Thread::ID, LocalVector<Event>> &r_events);
+	// Writes the kept events in the Chrome trace event format. Best done after
+	// stop(), as the oldest events may be overwritten while saving otherwise.
+	static Error save_chrome_trace(const String &p_path);
+
+	// Frees all buffers, once threads still writing to them are done. Zones
+	// ending afterwards go to new buffers.
+	static void finish();
+};
+
+#define _TRACE_ZONE_CONCAT_IMPL(m_a, m_b) m_a##m_b
+#define _TRACE_ZONE_CONCAT(m_a, m_b) _TRACE_ZONE_CONCAT_IMPL(m_a, m_b)
+// Records the rest of the enclosing scope as a zone named m_name.
+#define TRACE_ZONE(m_name) TraceProfiler::Zone _TRACE_ZONE_CONCAT(_trace_zone_, __LINE__)(m_name)
+
+#endif // TRACE_PROFILER_H
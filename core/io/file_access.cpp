@@ -728,6 +728,14 @@ void FileAccess::store_buffer(const Vector<uint8_t> &p_buffer) {
 	store_buffer(&r[0], len);
 }
 
+void FileAccess::store_buffer(const VectorSlice<uint8_t> &p_buffer) {
+	if (p_buffer.is_empty()) {
+		return;
+	}
+
+	store_buffer(p_buffer.ptr(), p_buffer.size());
+}
+
 void FileAccess::store_var(const Variant &p_var, bool p_full_objects) {
 	int len;
 	Error err = encode_variant(p_var, nullptr, len, p_full_objects);
@@ -36,6 +36,7 @@
 #include "core/object/ref_counted.h"
 #include "core/os/memory.h"
 #include "core/string/ustring.h"
+#include "core/templates/vector_slice.h"
 #include "core/typedefs.h"
 
 /**
@@ -186,6 +187,7 @@ public:
 
 	virtual void store_buffer(const uint8_t *p_src, uint64_t p_length); ///< store an array of bytes
 	void store_buffer(const Vector<uint8_t> &p_buffer);
+	void store_buffer(const VectorSlice<uint8_t> &p_buffer);
 
 	void store_var(const Variant &p_var, bool p_full_objects = false);
 
@@ -3488,14 +3488,14 @@ void Image::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("adjust_bcs", "brightness", "contrast", "saturation"), &Image::adjust_bcs);
 
-	ClassDB::bind_method(D_METHOD("load_png_from_buffer", "buffer"), &Image::load_png_from_buffer);
-	ClassDB::bind_method(D_METHOD("load_jpg_from_buffer", "buffer"), &Image::load_jpg_from_buffer);
-	ClassDB::bind_method(D_METHOD("load_webp_from_buffer", "buffer"), &Image::load_webp_from_buffer);
-	ClassDB::bind_method(D_METHOD("load_tga_from_buffer", "buffer"), &Image::load_tga_from_buffer);
-	ClassDB::bind_method(D_METHOD("load_bmp_from_buffer", "buffer"), &Image::load_bmp_from_buffer);
-	ClassDB::bind_method(D_METHOD("load_ktx_from_buffer", "buffer"), &Image::load_ktx_from_buffer);
-
-	ClassDB::bind_method(D_METHOD("load_svg_from_buffer", "buffer", "scale"), &Image::load_svg_from_buffer, DEFVAL(1.0));
+	ClassDB::bind_method(D_METHOD("load_png_from_buffer", "buffer"), (Error(Image::*)(const Vector<uint8_t> &)) & Image::load_png_from_buffer);
+	ClassDB::bind_method(D_METHOD("load_jpg_from_buffer", "buffer"), (Error(Image::*)(const Vector<uint8_t> &)) & Image::load_jpg_from_buffer);
+	ClassDB::bind_method(D_METHOD("load_webp_from_buffer", "buffer"), (Error(Image::*)(const Vector<uint8_t> &)) & Image::load_webp_from_buffer);
+	ClassDB::bind_method(D_METHOD("load_tga_from_buffer", "buffer"), (Error(Image::*)(const Vector<uint8_t> &)) & Image::load_tga_from_buffer);
+	ClassDB::bind_method(D_METHOD("load_bmp_from_buffer", "buffer"), (Error(Image::*)(const Vector<uint8_t> &)) & Image::load_bmp_from_buffer);
+	ClassDB::bind_method(D_METHOD("load_ktx_from_buffer", "buffer"), (Error(Image::*)(const Vector<uint8_t> &)) & Image::load_ktx_from_buffer);
+
+	ClassDB::bind_method(D_METHOD("load_svg_from_buffer", "buffer", "scale"), (Error(Image::*)(const Vector<uint8_t> &, float)) & Image::load_svg_from_buffer, DEFVAL(1.0));
 	ClassDB::bind_method(D_METHOD("load_svg_from_string", "svg_str", "scale"), &Image::load_svg_from_string, DEFVAL(1.0));
 
 	ADD_PROPERTY(PropertyInfo(Variant::DICTIONARY, "data", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_STORAGE), "_set_data", "_get_data");
@@ -3821,18 +3821,34 @@ String Image::get_format_name(Format p_format) {
 }
 
 Error Image::load_png_from_buffer(const Vector<uint8_t> &p_array) {
+	return load_png_from_buffer(VectorSlice<uint8_t>(p_array));
+}
+
+Error Image::load_png_from_buffer(const VectorSlice<uint8_t> &p_array) {
 	return _load_from_buffer(p_array, _png_mem_loader_func);
 }
 
 Error Image::load_jpg_from_buffer(const Vector<uint8_t> &p_array) {
+	return load_jpg_from_buffer(VectorSlice<uint8_t>(p_array));
+}
+
+Error Image::load_jpg_from_buffer(const VectorSlice<uint8_t> &p_array) {
 	return _load_from_buffer(p_array, _jpg_mem_loader_func);
 }
 
 Error Image::load_webp_from_buffer(const Vector<uint8_t> &p_array) {
+	return load_webp_from_buffer(VectorSlice<uint8_t>(p_array));
+}
+
+Error Image::load_webp_from_buffer(const VectorSlice<uint8_t> &p_array) {
 	return _load_from_buffer(p_array, _webp_mem_loader_func);
 }
 
 Error Image::load_tga_from_buffer(const Vector<uint8_t> &p_array) {
+	return load_tga_from_buffer(VectorSlice<uint8_t>(p_array));
+}
+
+Error Image::load_tga_from_buffer(const VectorSlice<uint8_t> &p_array) {
 	ERR_FAIL_NULL_V_MSG(
 			_tga_mem_loader_func,
 			ERR_UNAVAILABLE,
@@ -3841,6 +3857,10 @@ Error Image::load_tga_from_buffer(const Vector<uint8_t> &p_array) {
 }
 
 Error Image::load_bmp_from_buffer(const Vector<uint8_t> &p_array) {
+	return load_bmp_from_buffer(VectorSlice<uint8_t>(p_array));
+}
+
+Error Image::load_bmp_from_buffer(const VectorSlice<uint8_t> &p_array) {
 	ERR_FAIL_NULL_V_MSG(
 			_bmp_mem_loader_func,
 			ERR_UNAVAILABLE,
@@ -3849,6 +3869,10 @@ Error Image::load_bmp_from_buffer(const Vector<uint8_t> &p_array) {
 }
 
 Error Image::load_svg_from_buffer(const Vector<uint8_t> &p_array, float scale) {
+	return load_svg_from_buffer(VectorSlice<uint8_t>(p_array), scale);
+}
+
+Error Image::load_svg_from_buffer(const VectorSlice<uint8_t> &p_array, float scale) {
 	ERR_FAIL_NULL_V_MSG(
 			_svg_scalable_mem_loader_func,
 			ERR_UNAVAILABLE,
@@ -3871,6 +3895,10 @@ Error Image::load_svg_from_string(const String &p_svg_str, float scale) {
 }
 
 Error Image::load_ktx_from_buffer(const Vector<uint8_t> &p_array) {
+	return load_ktx_from_buffer(VectorSlice<uint8_t>(p_array));
+}
+
+Error Image::load_ktx_from_buffer(const VectorSlice<uint8_t> &p_array) {
 	ERR_FAIL_NULL_V_MSG(
 			_ktx_mem_loader_func,
 			ERR_UNAVAILABLE,
@@ -3917,7 +3945,7 @@ void Image::convert_rgba8_to_bgra8() {
 	}
 }
 
-Error Image::_load_from_buffer(const Vector<uint8_t> &p_array, ImageMemLoadFunc p_loader) {
+Error Image::_load_from_buffer(const VectorSlice<uint8_t> &p_array, ImageMemLoadFunc p_loader) {
 	int buffer_size = p_array.size();
 
 	ERR_FAIL_COND_V(buffer_size == 0, ERR_INVALID_PARAMETER);
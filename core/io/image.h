@@ -34,6 +34,7 @@
 #include "core/io/resource.h"
 #include "core/math/color.h"
 #include "core/math/rect2.h"
+#include "core/templates/vector_slice.h"
 
 /**
  * Image storage class. This is used to store an image in user memory, as well as
@@ -210,7 +211,7 @@ private:
 	void _set_data(const Dictionary &p_data);
 	Dictionary _get_data() const;
 
-	Error _load_from_buffer(const Vector<uint8_t> &p_array, ImageMemLoadFunc p_loader);
+	Error _load_from_buffer(const VectorSlice<uint8_t> &p_array, ImageMemLoadFunc p_loader);
 
 	static void average_4_uint8(uint8_t &p_out, const uint8_t &p_a, const uint8_t &p_b, const uint8_t &p_c, const uint8_t &p_d);
 	static void average_4_float(float &p_out, const float &p_a, const float &p_b, const float &p_c, const float &p_d);
@@ -403,13 +404,20 @@ public:
 	static String get_format_name(Format p_format);
 
 	Error load_png_from_buffer(const Vector<uint8_t> &p_array);
+	Error load_png_from_buffer(const VectorSlice<uint8_t> &p_array);
 	Error load_jpg_from_buffer(const Vector<uint8_t> &p_array);
+	Error load_jpg_from_buffer(const VectorSlice<uint8_t> &p_array);
 	Error load_webp_from_buffer(const Vector<uint8_t> &p_array);
+	Error load_webp_from_buffer(const VectorSlice<uint8_t> &p_array);
 	Error load_tga_from_buffer(const Vector<uint8_t> &p_array);
+	Error load_tga_from_buffer(const VectorSlice<uint8_t> &p_array);
 	Error load_bmp_from_buffer(const Vector<uint8_t> &p_array);
+	Error load_bmp_from_buffer(const VectorSlice<uint8_t> &p_array);
 	Error load_ktx_from_buffer(const Vector<uint8_t> &p_array);
+	Error load_ktx_from_buffer(const VectorSlice<uint8_t> &p_array);
 
 	Error load_svg_from_buffer(const Vector<uint8_t> &p_array, float scale = 1.0);
+	Error load_svg_from_buffer(const VectorSlice<uint8_t> &p_array, float scale = 1.0);
 	Error load_svg_from_string(const String &p_svg_str, float scale = 1.0);
 
 	void convert_rg_to_ra_rgba8();
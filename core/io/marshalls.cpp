@@ -1253,6 +1253,11 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 	return OK;
 }
 
+Error decode_variant(Variant &r_variant, const VectorSlice<uint8_t> &p_buffer, int *r_len, bool p_allow_objects, int p_depth) {
+	ERR_FAIL_COND_V(p_buffer.size() > INT_MAX, ERR_INVALID_DATA);
+	return decode_variant(r_variant, p_buffer.ptr(), p_buffer.size(), r_len, p_allow_objects, p_depth);
+}
+
 static void _encode_string(const String &p_string, uint8_t *&buf, int &r_len) {
 	CharString utf8 = p_string.utf8();
 
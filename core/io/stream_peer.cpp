@@ -41,6 +41,14 @@ Error StreamPeer::_put_data(const Vector<uint8_t> &p_data) {
 	return put_data(&r[0], len);
 }
 
+Error StreamPeer::put_data(const VectorSlice<uint8_t> &p_data) {
+	if (p_data.is_empty()) {
+		return OK;
+	}
+	ERR_FAIL_COND_V(p_data.size() > INT_MAX, ERR_INVALID_PARAMETER);
+	return put_data(p_data.ptr(), p_data.size());
+}
+
 Array StreamPeer::_put_partial_data(const Vector<uint8_t> &p_data) {
 	Array ret;
 
@@ -32,6 +32,7 @@
 #define STREAM_PEER_H
 
 #include "core/object/ref_counted.h"
+#include "core/templates/vector_slice.h"
 
 #include "core/extension/ext_wrappers.gen.inc"
 #include "core/object/gdvirtual.gen.inc"
@@ -54,6 +55,7 @@ protected:
 
 public:
 	virtual Error put_data(const uint8_t *p_data, int p_bytes) = 0; ///< put a whole chunk of data, blocking until it sent
+	Error put_data(const VectorSlice<uint8_t> &p_data);
 	virtual Error put_partial_data(const uint8_t *p_data, int p_bytes, int &r_sent) = 0; ///< put as much data as possible, without blocking.
 
 	virtual Error get_data(uint8_t *p_buffer, int p_bytes) = 0; ///< read p_bytes of data, if p_bytes > available, it will block
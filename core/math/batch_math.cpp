@@ -0,0 +1,970 @@
+/**************************************************************************/
+/*  batch_math.cpp                                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "batch_math.h"
+
+#include "core/error/error_macros.h"
+
+#ifndef REAL_T_IS_DOUBLE
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BATCH_MATH_SSE2
+#include <emmintrin.h>
+#if !defined(__EMSCRIPTEN__) && (defined(_MSC_VER) || defined(__GNUC__))
+// AVX2 kernels are compiled for the target with function attributes and only
+// used when the CPU supports them, so no global compiler flags are needed.
+#define BATCH_MATH_AVX2
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define BATCH_MATH_AVX2_FUNC
+#else
+#define BATCH_MATH_AVX2_FUNC __attribute__((target("avx2")))
+#endif
+#endif
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define BATCH_MATH_NEON
+#include <arm_neon.h>
+#endif
+#endif // REAL_T_IS_DOUBLE
+
+static_assert(sizeof(Vector3) == sizeof(real_t) * 3, "Batch kernels expect tightly packed Vector3.");
+static_assert(sizeof(Transform3D) == sizeof(real_t) * 12, "Batch kernels expect tightly packed Transform3D.");
+static_assert(sizeof(AABB) == sizeof(real_t) * 6, "Batch kernels expect tightly packed AABB.");
+
+struct BatchMathKernels {
+	BatchMath::SIMDLevel level;
+	void (*xform_points)(const Transform3D &p_xform, const Vector3 *p_src, Vector3 *r_dst, uint32_t p_count);
+	void (*xform_transforms)(const Transform3D &p_xform, const Transform3D *p_src, Transform3D *r_dst, uint32_t p_count);
+	void (*compose_transforms)(const Transform3D *p_a, const Transform3D *p_b, Transform3D *r_dst, uint32_t p_count);
+	void (*xform_transforms_3x4)(const Transform3D &p_xform, const float *p_src, float *r_dst, uint32_t p_count, uint32_t p_stride);
+	void (*xform_aabbs)(const Transform3D &p_xform, const AABB *p_src, AABB *r_dst, uint32_t p_count);
+	void (*add)(const float *p_a, const float *p_b, float *r_dst, uint32_t p_count);
+	void (*multiply)(const float *p_a, const float *p_b, float *r_dst, uint32_t p_count);
+	void (*scale_offset)(const float *p_src, float p_scale, float p_offset, float *r_dst, uint32_t p_count);
+	void (*lerp)(const float *p_a, const float *p_b, float p_weight, float *r_dst, uint32_t p_count);
+	void (*clamp)(const float *p_src, float p_min, float p_max, float *r_dst, uint32_t p_count);
+	void (*fill_range)(float p_from, float p_step, float *r_dst, uint32_t p_count);
+	double (*sum)(const float *p_src, uint32_t p_count);
+	double (*dot)(const float *p_a, const float *p_b, uint32_t p_count);
+	float (*min)(const float *p_src, uint32_t p_count);
+	float (*max)(const float *p_src, uint32_t p_count);
+};
+
+/* Scalar kernels, also used for the elements left over by the SIMD ones. */
+
+static void _xform_points_scalar(const Transform3D &p_xform, const Vector3 *p_src, Vector3 *r_dst, uint32_t p_count) {
+	for (uint32_t i = 0; i < p_count; i++) {
+		r_dst[i] = p_xform.xform(p_src[i]);
+	}
+}
+
+static void _xform_transforms_scalar(const Transform3D &p_xform, const Transform3D *p_src, Transform3D *r_dst, uint32_t p_count) {
+	for (uint32_t i = 0; i < p_count; i++) {
+		r_dst[i] = p_xform * p_src[i];
+	}
+}
+
+static void _compose_transforms_scalar(const Transform3D *p_a, const Transform3D *p_b, Transform3D *r_dst, uint32_t p_count) {
+	for (uint32_t i = 0; i < p_count; i++) {
+		r_dst[i] = p_a[i] * p_b[i];
+	}
+}
+
+static void _xform_transforms_3x4_scalar(const Transform3D &p_xform, const float *p_src, float *r_dst, uint32_t p_count, uint32_t p_stride) {
+	for (uint32_t i = 0; i < p_count; i++) {
+		const float *s = p_src + i * p_stride;
+		const Transform3D t = p_xform * Transform3D(s[0], s[1], s[2], s[4], s[5], s[6], s[8], s[9], s[10], s[3], s[7], s[11]);
+
+		float *d = r_dst + i * p_stride;
+		for (int j = 0; j < 3; j++) {
+			d[j * 4 + 0] = t.basis.rows[j][0];
+			d[j * 4 + 1] = t.basis.rows[j][1];
+			d[j * 4 + 2] = t.basis.rows[j][2];
+			d[j * 4 + 3] = t.origin[j];
+		}
+	}
+}
+
+static void _xform_aabbs_scalar(const Transform3D &p_xform, const AABB *p_src, AABB *r_dst, uint32_t p_count) {
+	for (uint32_t i = 0; i < p_count; i++) {
+		r_dst[i] = p_xform.xform(p_src[i]);
+	}
+}
+
+// Element-wise kernels are templates, as double arrays use them too.
+
+template <typename T>
+static void _add_scalar(const T *p_a, const T *p_b, T *r_dst, uint32_t p_count) {
+	for (uint32_t i = 0; i < p_count; i++) {
+		r_dst[i] = p_a[i] + p_b[i];
+	}
+}
+
+template <typename T>
+static void _multiply_scalar(const T *p_a, const T *p_b, T *r_dst, uint32_t p_count) {
+	for (uint32_t i = 0; i < p_count; i++) {
+		r_dst[i] = p_a[i] * p_b[i];
+	}
+}
+
+template <typename T>
+static void _scale_offset_scalar(const T *p_src, T p_scale, T p_offset, T *r_dst, uint32_t p_count) {
+	for (uint32_t i = 0; i < p_count; i++) {
+		r_dst[i] = p_src[i] * p_scale + p_offset;
+	}
+}
+
+template <typename T>
+static void _lerp_scalar(const T *p_a, const T *p_b, T p_weight, T *r_dst, uint32_t p_count) {
+	for (uint32_t i = 0; i < p_count; i++) {
+		r_dst[i] = p_a[i] + (p_b[i] - p_a[i]) * p_weight;
+	}
+}
+
+template <typename T>
+static void _clamp_scalar(const T *p_src, T p_min, T p_max, T *r_dst, uint32_t p_count) {
+	for (uint32_t i = 0; i < p_count; i++) {
+		r_dst[i] = CLAMP(p_src[i], p_min, p_max);
+	}
+}
+
+// Fills [p_begin, p_end), so the SIMD kernels can leave the end to it.
+template <typename T>
+static void _fill_range_scalar(T p_from, T p_step, T *r_dst, uint32_t p_begin, uint32_t p_end) {
+	for (uint32_t i = p_begin; i < p_end; i++) {
+		r_dst[i] = p_from + (T)i * p_step;
+	}
+}
+
+static void _fill_range_scalar_float(float p_from, float p_step, float *r_dst, uint32_t p_count) {
+	_fill_range_scalar(p_from, p_step, r_dst, 0, p_count);
+}
+
+// Floats are summed in double, as a float sum stops growing once the elements
+// fall below its precision.
+template <typename T>
+static double _sum_scalar(const T *p_src, uint32_t p_count) {
+	double sum = 0;
+	for (uint32_t i = 0; i < p_count; i++) {
+		sum += (double)p_src[i];
+	}
+	return sum;
+}
+
+template <typename T>
+static double _dot_scalar(const T *p_a, const T *p_b, uint32_t p_count) {
+	double sum = 0;
+	for (uint32_t i = 0; i < p_count; i++) {
+		sum += (double)p_a[i] * (double)p_b[i];
+	}
+	return sum;
+}
+
+template <typename T>
+static T _min_scalar(const T *p_src, uint32_t p_count) {
+	if (p_count == 0) {
+		return 0;
+	}
+	T result = p_src[0];
+	for (uint32_t i = 1; i < p_count; i++) {
+		result = MIN(result, p_src[i]);
+	}
+	return result;
+}
+
+template <typename T>
+static T _max_scalar(const T *p_src, uint32_t p_count) {
+	if (p_count == 0) {
+		return 0;
+	}
+	T result = p_src[0];
+	for (uint32_t i = 1; i < p_count; i++) {
+		result = MAX(result, p_src[i]);
+	}
+	return result;
+}
+
+static const BatchMathKernels kernels_scalar = {
+	BatchMath::SIMD_NONE,
+	_xform_points_scalar,
+	_xform_transforms_scalar,
+	_compose_transforms_scalar,
+	_xform_transforms_3x4_scalar,
+	_xform_aabbs_scalar,
+	_add_scalar<float>,
+	_multiply_scalar<float>,
+	_scale_offset_scalar<float>,
+	_lerp_scalar<float>,
+	_clamp_scalar<float>,
+	_fill_range_scalar_float,
+	_sum_scalar<float>,
+	_dot_scalar<float>,
+	_min_scalar<float>,
+	_max_scalar<float>,
+};
+
+#if defined(BATCH_MATH_SSE2) || defined(BATCH_MATH_NEON)
+
+/* SIMD kernels, written once against a 4-wide set of operations (SIMDOps). */
+
+// Where each element of a transform is, among its 12 floats.
+template <bool IS_3X4>
+struct TransformLayout {
+	static constexpr int basis(int p_row, int p_column) { return IS_3X4 ? p_row * 4 + p_column : p_row * 3 + p_column; }
+	static constexpr int origin(int p_row) { return IS_3X4 ? p_row * 4 + 3 : 9 + p_row; }
+};
+
+#ifdef BATCH_MATH_SSE2
+
+#define BATCH_SHUFFLE(m_a, m_b, m_0, m_1, m_2, m_3) _mm_shuffle_ps(m_a, m_b, _MM_SHUFFLE(m_3, m_2, m_1, m_0))
+
+struct SIMDOps {
+	typedef __m128 V;
+
+	static _FORCE_INLINE_ V set1(float p_value) { return _mm_set1_ps(p_value); }
+	static _FORCE_INLINE_ V load(const float *p_src) { return _mm_loadu_ps(p_src); }
+	static _FORCE_INLINE_ void store(float *r_dst, V p_value) { _mm_storeu_ps(r_dst, p_value); }
+	static _FORCE_INLINE_ V add(V p_a, V p_b) { return _mm_add_ps(p_a, p_b); }
+	static _FORCE_INLINE_ V sub(V p_a, V p_b) { return _mm_sub_ps(p_a, p_b); }
+	static _FORCE_INLINE_ V mul(V p_a, V p_b) { return _mm_mul_ps(p_a, p_b); }
+	static _FORCE_INLINE_ V vmin(V p_a, V p_b) { return _mm_min_ps(p_a, p_b); }
+	static _FORCE_INLINE_ V vmax(V p_a, V p_b) { return _mm_max_ps(p_a, p_b); }
+
+	static _FORCE_INLINE_ void load4x4(const float *p_src, uint32_t p_stride, V &r_0, V &r_1, V &r_2, V &r_3) {
+		r_0 = _mm_loadu_ps(p_src);
+		r_1 = _mm_loadu_ps(p_src + p_stride);
+		r_2 = _mm_loadu_ps(p_src + p_stride * 2);
+		r_3 = _mm_loadu_ps(p_src + p_stride * 3);
+		_MM_TRANSPOSE4_PS(r_0, r_1, r_2, r_3);
+	}
+
+	static _FORCE_INLINE_ void store4x4(float *r_dst, uint32_t p_stride, V p_0, V p_1, V p_2, V p_3) {
+		_MM_TRANSPOSE4_PS(p_0, p_1, p_2, p_3);
+		_mm_storeu_ps(r_dst, p_0);
+		_mm_storeu_ps(r_dst + p_stride, p_1);
+		_mm_storeu_ps(r_dst + p_stride * 2, p_2);
+		_mm_storeu_ps(r_dst + p_stride * 3, p_3);
+	}
+
+	// Loads 4 packed Vector3 (12 floats) as one register per axis.
+	static _FORCE_INLINE_ void load3(const float *p_src, V &r_x, V &r_y, V &r_z) {
+		const V a = _mm_loadu_ps(p_src); // x0 y0 z0 x1
+		const V b = _mm_loadu_ps(p_src + 4); // y1 z1 x2 y2
+		const V c = _mm_loadu_ps(p_src + 8); // z2 x3 y3 z3
+		const V ab = BATCH_SHUFFLE(a, b, 1, 2, 0, 1); // y0 z0 y1 z1
+		r_x = BATCH_SHUFFLE(a, BATCH_SHUFFLE(b, c, 2, 3, 1, 0), 0, 3, 0, 2);
+		r_y = BATCH_SHUFFLE(ab, BATCH_SHUFFLE(b, c, 3, 3, 2, 2), 0, 2, 0, 2);
+		r_z = BATCH_SHUFFLE(ab, c, 1, 3, 0, 3);
+	}
+
+	static _FORCE_INLINE_ void store3(float *r_dst, V p_x, V p_y, V p_z) {
+		_mm_storeu_ps(r_dst, BATCH_SHUFFLE(BATCH_SHUFFLE(p_x, p_y, 0, 0, 0, 0), BATCH_SHUFFLE(p_z, p_x, 0, 0, 1, 1), 0, 2, 0, 2));
+		_mm_storeu_ps(r_dst + 4, BATCH_SHUFFLE(BATCH_SHUFFLE(p_y, p_z, 1, 1, 1, 1), BATCH_SHUFFLE(p_x, p_y, 2, 2, 2, 2), 0, 2, 0, 2));
+		_mm_storeu_ps(r_dst + 8, BATCH_SHUFFLE(BATCH_SHUFFLE(p_z, p_x, 2, 2, 3, 3), BATCH_SHUFFLE(p_y, p_z, 3, 3, 3, 3), 0, 2, 0, 2));
+	}
+
+	// Splits alternating lanes of two registers.
+	static _FORCE_INLINE_ void unzip(V p_a, V p_b, V &r_even, V &r_odd) {
+		r_even = BATCH_SHUFFLE(p_a, p_b, 0, 2, 0, 2);
+		r_odd = BATCH_SHUFFLE(p_a, p_b, 1, 3, 1, 3);
+	}
+
+	static _FORCE_INLINE_ void zip(V p_even, V p_odd, V &r_a, V &r_b) {
+		r_a = _mm_unpacklo_ps(p_even, p_odd);
+		r_b = _mm_unpackhi_ps(p_even, p_odd);
+	}
+
+	// Two doubles, to accumulate reductions of floats in.
+	typedef __m128d D;
+
+	static _FORCE_INLINE_ D dzero() { return _mm_setzero_pd(); }
+	static _FORCE_INLINE_ D dadd(D p_a, D p_b) { return _mm_add_pd(p_a, p_b); }
+	static _FORCE_INLINE_ D dmul(D p_a, D p_b) { return _mm_mul_pd(p_a, p_b); }
+
+	static _FORCE_INLINE_ void widen(V p_value, D &r_lo, D &r_hi) {
+		r_lo = _mm_cvtps_pd(p_value);
+		r_hi = _mm_cvtps_pd(_mm_movehl_ps(p_value, p_value));
+	}
+
+	static _FORCE_INLINE_ double dsum(D p_value) {
+		double lanes[2];
+		_mm_storeu_pd(lanes, p_value);
+		return lanes[0] + lanes[1];
+	}
+};
+
+#else // BATCH_MATH_NEON
+
+struct SIMDOps {
+	typedef float32x4_t V;
+
+	static _FORCE_INLINE_ V set1(float p_value) { return vdupq_n_f32(p_value); }
+	static _FORCE_INLINE_ V load(const float *p_src) { return vld1q_f32(p_src); }
+	static _FORCE_INLINE_ void store(float *r_dst, V p_value) { vst1q_f32(r_dst, p_value); }
+	static _FORCE_INLINE_ V add(V p_a, V p_b) { return vaddq_f32(p_a, p_b); }
+	static _FORCE_INLINE_ V sub(V p_a, V p_b) { return vsubq_f32(p_a, p_b); }
+	static _FORCE_INLINE_ V mul(V p_a, V p_b) { return vmulq_f32(p_a, p_b); }
+	static _FORCE_INLINE_ V vmin(V p_a, V p_b) { return vminq_f32(p_a, p_b); }
+	static _FORCE_INLINE_ V vmax(V p_a, V p_b) { return vmaxq_f32(p_a, p_b); }
+
+	static _FORCE_INLINE_ void transpose(V &r_0, V &r_1, V &r_2, V &r_3) {
+		const float32x4x2_t t01 = vtrnq_f32(r_0, r_1);
+		const float32x4x2_t t23 = vtrnq_f32(r_2, r_3);
+		r_0 = vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0]));
+		r_1 = vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1]));
+		r_2 = vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0]));
+		r_3 = vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1]));
+	}
+
+	static _FORCE_INLINE_ void load4x4(const float *p_src, uint32_t p_stride, V &r_0, V &r_1, V &r_2, V &r_3) {
+		r_0 = vld1q_f32(p_src);
+		r_1 = vld1q_f32(p_src + p_stride);
+		r_2 = vld1q_f32(p_src + p_stride * 2);
+		r_3 = vld1q_f32(p_src + p_stride * 3);
+		transpose(r_0, r_1, r_2, r_3);
+	}
+
+	static _FORCE_INLINE_ void store4x4(float *r_dst, uint32_t p_stride, V p_0, V p_1, V p_2, V p_3) {
+		transpose(p_0, p_1, p_2, p_3);
+		vst1q_f32(r_dst, p_0);
+		vst1q_f32(r_dst + p_stride, p_1);
+		vst1q_f32(r_dst + p_stride * 2, p_2);
+		vst1q_f32(r_dst + p_stride * 3, p_3);
+	}
+
+	static _FORCE_INLINE_ void load3(const float *p_src, V &r_x, V &r_y, V &r_z) {
+		const float32x4x3_t v = vld3q_f32(p_src);
+		r_x = v.val[0];
+		r_y = v.val[1];
+		r_z = v.val[2];
+	}
+
+	static _FORCE_INLINE_ void store3(float *r_dst, V p_x, V p_y, V p_z) {
+		float32x4x3_t v;
+		v.val[0] = p_x;
+		v.val[1] = p_y;
+		v.val[2] = p_z;
+		vst3q_f32(r_dst, v);
+	}
+
+	static _FORCE_INLINE_ void unzip(V p_a, V p_b, V &r_even, V &r_odd) {
+		const float32x4x2_t v = vuzpq_f32(p_a, p_b);
+		r_even = v.val[0];
+		r_odd = v.val[1];
+	}
+
+	static _FORCE_INLINE_ void zip(V p_even, V p_odd, V &r_a, V &r_b) {
+		const float32x4x2_t v = vzipq_f32(p_even, p_odd);
+		r_a = v.val[0];
+		r_b = v.val[1];
+	}
+
+	// Two doubles, to accumulate reductions of floats in.
+#if defined(__aarch64__) || defined(_M_ARM64)
+	typedef float64x2_t D;
+
+	static _FORCE_INLINE_ D dzero() { return vdupq_n_f64(0); }
+	static _FORCE_INLINE_ D dadd(D p_a, D p_b) { return vaddq_f64(p_a, p_b); }
+	static _FORCE_INLINE_ D dmul(D p_a, D p_b) { return vmulq_f64(p_a, p_b); }
+
+	static _FORCE_INLINE_ void widen(V p_value, D &r_lo, D &r_hi) {
+		r_lo = vcvt_f64_f32(vget_low_f32(p_value));
+		r_hi = vcvt_high_f64_f32(p_value);
+	}
+
+	static _FORCE_INLINE_ double dsum(D p_value) { return vgetq_lane_f64(p_value, 0) + vgetq_lane_f64(p_value, 1); }
+#else
+	// 32-bit ARM has no double vectors.
+	struct D {
+		double lo;
+		double hi;
+	};
+
+	static _FORCE_INLINE_ D dzero() { return D{ 0, 0 }; }
+	static _FORCE_INLINE_ D dadd(D p_a, D p_b) { return D{ p_a.lo + p_b.lo, p_a.hi + p_b.hi }; }
+	static _FORCE_INLINE_ D dmul(D p_a, D p_b) { return D{ p_a.lo * p_b.lo, p_a.hi * p_b.hi }; }
+
+	static _FORCE_INLINE_ void widen(V p_value, D &r_lo, D &r_hi) {
+		r_lo = D{ vgetq_lane_f32(p_value, 0), vgetq_lane_f32(p_value, 1) };
+		r_hi = D{ vgetq_lane_f32(p_value, 2), vgetq_lane_f32(p_value, 3) };
+	}
+
+	static _FORCE_INLINE_ double dsum(D p_value) { return p_value.lo + p_value.hi; }
+#endif
+};
+
+#endif // BATCH_MATH_SSE2
+
+typedef SIMDOps::V SIMDVec;
+
+static _FORCE_INLINE_ void _broadcast_transform(const Transform3D &p_xform, SIMDVec *r_soa) {
+	for (int i = 0; i < 3; i++) {
+		for (int j = 0; j < 3; j++) {
+			r_soa[TransformLayout<false>::basis(i, j)] = SIMDOps::set1(p_xform.basis.rows[i][j]);
+		}
+		r_soa[TransformLayout<false>::origin(i)] = SIMDOps::set1(p_xform.origin[i]);
+	}
+}
+
+// Loads 4 transforms of 12 floats each as one register per element.
+static _FORCE_INLINE_ void _load_transforms(const float *p_src, uint32_t p_stride, SIMDVec *r_soa) {
+	for (int i = 0; i < 3; i++) {
+		SIMDOps::load4x4(p_src + i * 4, p_stride, r_soa[i * 4 + 0], r_soa[i * 4 + 1], r_soa[i * 4 + 2], r_soa[i * 4 + 3]);
+	}
+}
+
+static _FORCE_INLINE_ void _store_transforms(float *r_dst, uint32_t p_stride, const SIMDVec *p_soa) {
+	for (int i = 0; i < 3; i++) {
+		SIMDOps::store4x4(r_dst + i * 4, p_stride, p_soa[i * 4 + 0], p_soa[i * 4 + 1], p_soa[i * 4 + 2], p_soa[i * 4 + 3]);
+	}
+}
+
+// Same operation order as Transform3D::operator*, so results match the scalar path.
+template <bool IS_3X4>
+static _FORCE_INLINE_ void _compose(const SIMDVec *p_a, const SIMDVec *p_b, SIMDVec *r_soa) {
+	typedef TransformLayout<false> A;
+	typedef TransformLayout<IS_3X4> B;
+
+	for (int i = 0; i < 3; i++) {
+		const SIMDVec a0 = p_a[A::basis(i, 0)];
+		const SIMDVec a1 = p_a[A::basis(i, 1)];
+		const SIMDVec a2 = p_a[A::basis(i, 2)];
+		for (int j = 0; j < 3; j++) {
+			r_soa[B::basis(i, j)] = SIMDOps::add(SIMDOps::add(SIMDOps::mul(p_b[B::basis(0, j)], a0), SIMDOps::mul(p_b[B::basis(1, j)], a1)), SIMDOps::mul(p_b[B::basis(2, j)], a2));
+		}
+		r_soa[B::origin(i)] = SIMDOps::add(SIMDOps::add(SIMDOps::add(SIMDOps::mul(a0, p_b[B::origin(0)]), SIMDOps::mul(a1, p_b[B::origin(1)])), SIMDOps::mul(a2, p_b[B::origin(2)])), p_a[A::origin(i)]);
+	}
+}
+
+static void _xform_points_simd(const Transform3D &p_xform, const Vector3 *p_src, Vector3 *r_dst, uint32_t p_count) {
+	SIMDVec m[12];
+	_broadcast_transform(p_xform, m);
+
+	const float *src = (const float *)p_src;
+	float *dst = (float *)r_dst;
+	uint32_t i = 0;
+	for (; i + 4 <= p_count; i += 4, src += 12, dst += 12) {
+		SIMDVec x, y, z;
+		SIMDOps::load3(src, x, y, z);
+		SIMDVec r[3];
+		for (int j = 0; j < 3; j++) {
+			r[j] = SIMDOps::add(SIMDOps::add(SIMDOps::add(SIMDOps::mul(m[j * 3 + 0], x), SIMDOps::mul(m[j * 3 + 1], y)), SIMDOps::mul(m[j * 3 + 2], z)), m[9 + j]);
+		}
+		SIMDOps::store3(dst, r[0], r[1], r[2]);
+	}
+	_xform_points_scalar(p_xform, p_src + i, r_dst + i, p_count - i);
+}
+
+static void _xform_transforms_simd(const Transform3D &p_xform, const Transform3D *p_src, Transform3D *r_dst, uint32_t p_count) {
+	SIMDVec a[12];
+	_broadcast_transform(p_xform, a);
+
+	uint32_t i = 0;
+	for (; i + 4 <= p_count; i += 4) {
+		SIMDVec b[12];
+		SIMDVec r[12];
+		_load_transforms((const float *)(p_src + i), 12, b);
+		_compose<false>(a, b, r);
+		_store_transforms((float *)(r_dst + i), 12, r);
+	}
+	_xform_transforms_scalar(p_xform, p_src + i, r_dst + i, p_count - i);
+}
+
+static void _compose_transforms_simd(const Transform3D *p_a, const Transform3D *p_b, Transform3D *r_dst, uint32_t p_count) {
+	uint32_t i = 0;
+	for (; i + 4 <= p_count; i += 4) {
+		SIMDVec a[12];
+		SIMDVec b[12];
+		SIMDVec r[12];
+		_load_transforms((const float *)(p_a + i), 12, a);
+		_load_transforms((const float *)(p_b + i), 12, b);
+		_compose<false>(a, b, r);
+		_store_transforms((float *)(r_dst + i), 12, r);
+	}
+	_compose_transforms_scalar(p_a + i, p_b + i, r_dst + i, p_count - i);
+}
+
+static void _xform_transforms_3x4_simd(const Transform3D &p_xform, const float *p_src, float *r_dst, uint32_t p_count, uint32_t p_stride) {
+	SIMDVec a[12];
+	_broadcast_transform(p_xform, a);
+
+	uint32_t i = 0;
+	for (; i + 4 <= p_count; i += 4) {
+		SIMDVec b[12];
+		SIMDVec r[12];
+		_load_transforms(p_src + i * p_stride, p_stride, b);
+		_compose<true>(a, b, r);
+		_store_transforms(r_dst + i * p_stride, p_stride, r);
+	}
+	_xform_transforms_3x4_scalar(p_xform, p_src + i * p_stride, r_dst + i * p_stride, p_count - i, p_stride);
+}
+
+static void _xform_aabbs_simd(const Transform3D &p_xform, const AABB *p_src, AABB *r_dst, uint32_t p_count) {
+	SIMDVec m[12];
+	_broadcast_transform(p_xform, m);
+
+	const float *src = (const float *)p_src;
+	float *dst = (float *)r_dst;
+	uint32_t i = 0;
+	for (; i + 4 <= p_count; i += 4, src += 24, dst += 24) {
+		// Each AABB is two Vector3, so this is 8 vectors alternating between
+		// positions and sizes.
+		SIMDVec v0[3];
+		SIMDVec v1[3];
+		SIMDOps::load3(src, v0[0], v0[1], v0[2]);
+		SIMDOps::load3(src + 12, v1[0], v1[1], v1[2]);
+
+		SIMDVec lo[3];
+		SIMDVec hi[3];
+		for (int j = 0; j < 3; j++) {
+			SIMDVec size;
+			SIMDOps::unzip(v0[j], v1[j], lo[j], size);
+			hi[j] = SIMDOps::add(lo[j], size);
+		}
+
+		for (int j = 0; j < 3; j++) {
+			SIMDVec tmin = m[9 + j];
+			SIMDVec tmax = m[9 + j];
+			for (int k = 0; k < 3; k++) {
+				const SIMDVec e = SIMDOps::mul(m[j * 3 + k], lo[k]);
+				const SIMDVec f = SIMDOps::mul(m[j * 3 + k], hi[k]);
+				tmin = SIMDOps::add(tmin, SIMDOps::vmin(e, f));
+				tmax = SIMDOps::add(tmax, SIMDOps::vmax(e, f));
+			}
+			SIMDOps::zip(tmin, SIMDOps::sub(tmax, tmin), v0[j], v1[j]);
+		}
+
+		SIMDOps::store3(dst, v0[0], v0[1], v0[2]);
+		SIMDOps::store3(dst + 12, v1[0], v1[1], v1[2]);
+	}
+	_xform_aabbs_scalar(p_xform, p_src + i, r_dst + i, p_count - i);
+}
+
+static void _add_simd(const float *p_a, const float *p_b, float *r_dst, uint32_t p_count) {
+	uint32_t i = 0;
+	for (; i + 4 <= p_count; i += 4) {
+		SIMDOps::store(r_dst + i, SIMDOps::add(SIMDOps::load(p_a + i), SIMDOps::load(p_b + i)));
+	}
+	_add_scalar(p_a + i, p_b + i, r_dst + i, p_count - i);
+}
+
+static void _multiply_simd(const float *p_a, const float *p_b, float *r_dst, uint32_t p_count) {
+	uint32_t i = 0;
+	for (; i + 4 <= p_count; i += 4) {
+		SIMDOps::store(r_dst + i, SIMDOps::mul(SIMDOps::load(p_a + i), SIMDOps::load(p_b + i)));
+	}
+	_multiply_scalar(p_a + i, p_b + i, r_dst + i, p_count - i);
+}
+
+static void _scale_offset_simd(const float *p_src, float p_scale, float p_offset, float *r_dst, uint32_t p_count) {
+	const SIMDVec scale = SIMDOps::set1(p_scale);
+	const SIMDVec offset = SIMDOps::set1(p_offset);
+	uint32_t i = 0;
+	for (; i + 4 <= p_count; i += 4) {
+		SIMDOps::store(r_dst + i, SIMDOps::add(SIMDOps::mul(SIMDOps::load(p_src + i), scale), offset));
+	}
+	_scale_offset_scalar(p_src + i, p_scale, p_offset, r_dst + i, p_count - i);
+}
+
+static void _lerp_simd(const float *p_a, const float *p_b, float p_weight, float *r_dst, uint32_t p_count) {
+	const SIMDVec weight = SIMDOps::set1(p_weight);
+	uint32_t i = 0;
+	for (; i + 4 <= p_count; i += 4) {
+		const SIMDVec a = SIMDOps::load(p_a + i);
+		SIMDOps::store(r_dst + i, SIMDOps::add(a, SIMDOps::mul(SIMDOps::sub(SIMDOps::load(p_b + i), a), weight)));
+	}
+	_lerp_scalar(p_a + i, p_b + i, p_weight, r_dst + i, p_count - i);
+}
+
+static void _clamp_simd(const float *p_src, float p_min, float p_max, float *r_dst, uint32_t p_count) {
+	const SIMDVec lower = SIMDOps::set1(p_min);
+	const SIMDVec upper = SIMDOps::set1(p_max);
+	uint32_t i = 0;
+	for (; i + 4 <= p_count; i += 4) {
+		SIMDOps::store(r_dst + i, SIMDOps::vmin(SIMDOps::vmax(SIMDOps::load(p_src + i), lower), upper));
+	}
+	_clamp_scalar(p_src + i, p_min, p_max, r_dst + i, p_count - i);
+}
+
+static void _fill_range_simd(float p_from, float p_step, float *r_dst, uint32_t p_count) {
+	static const float lanes[4] = { 0, 1, 2, 3 };
+	const SIMDVec from = SIMDOps::set1(p_from);
+	const SIMDVec step = SIMDOps::set1(p_step);
+	const SIMDVec lane_index = SIMDOps::load(lanes);
+	uint32_t i = 0;
+	for (; i + 4 <= p_count; i += 4) {
+		const SIMDVec index = SIMDOps::add(SIMDOps::set1((float)i), lane_index);
+		SIMDOps::store(r_dst + i, SIMDOps::add(from, SIMDOps::mul(index, step)));
+	}
+	_fill_range_scalar(p_from, p_step, r_dst, i, p_count);
+}
+
+// Summed in double like the scalar kernels, with the low and high halves of each
+// vector in their own accumulator, so consecutive additions don't wait on each other.
+static double _sum_simd(const float *p_src, uint32_t p_count) {
+	SIMDOps::D sum_lo = SIMDOps::dzero();
+	SIMDOps::D sum_hi = SIMDOps::dzero();
+	uint32_t i = 0;
+	for (; i + 4 <= p_count; i += 4) {
+		SIMDOps::D lo;
+		SIMDOps::D hi;
+		SIMDOps::widen(SIMDOps::load(p_src + i), lo, hi);
+		sum_lo = SIMDOps::dadd(sum_lo, lo);
+		sum_hi = SIMDOps::dadd(sum_hi, hi);
+	}
+	return SIMDOps::dsum(SIMDOps::dadd(sum_lo, sum_hi)) + _sum_scalar(p_src + i, p_count - i);
+}
+
+static double _dot_simd(const float *p_a, const float *p_b, uint32_t p_count) {
+	SIMDOps::D sum_lo = SIMDOps::dzero();
+	SIMDOps::D sum_hi = SIMDOps::dzero();
+	uint32_t i = 0;
+	for (; i + 4 <= p_count; i += 4) {
+		SIMDOps::D a_lo;
+		SIMDOps::D a_hi;
+		SIMDOps::D b_lo;
+		SIMDOps::D b_hi;
+		SIMDOps::widen(SIMDOps::load(p_a + i), a_lo, a_hi);
+		SIMDOps::widen(SIMDOps::load(p_b + i), b_lo, b_hi);
+		sum_lo = SIMDOps::dadd(sum_lo, SIMDOps::dmul(a_lo, b_lo));
+		sum_hi = SIMDOps::dadd(sum_hi, SIMDOps::dmul(a_hi, b_hi));
+	}
+	return SIMDOps::dsum(SIMDOps::dadd(sum_lo, sum_hi)) + _dot_scalar(p_a + i, p_b + i, p_count - i);
+}
+
+static float _min_simd(const float *p_src, uint32_t p_count) {
+	if (p_count < 4) {
+		return _min_scalar(p_src, p_count);
+	}
+	SIMDVec result = SIMDOps::load(p_src);
+	uint32_t i = 4;
+	for (; i + 4 <= p_count; i += 4) {
+		result = SIMDOps::vmin(result, SIMDOps::load(p_src + i));
+	}
+	float lanes[4];
+	SIMDOps::store(lanes, result);
+	float m = MIN(MIN(lanes[0], lanes[1]), MIN(lanes[2], lanes[3]));
+	for (; i < p_count; i++) {
+		m = MIN(m, p_src[i]);
+	}
+	return m;
+}
+
+static float _max_simd(const float *p_src, uint32_t p_count) {
+	if (p_count < 4) {
+		return _max_scalar(p_src, p_count);
+	}
+	SIMDVec result = SIMDOps::load(p_src);
+	uint32_t i = 4;
+	for (; i + 4 <= p_count; i += 4) {
+		result = SIMDOps::vmax(result, SIMDOps::load(p_src + i));
+	}
+	float lanes[4];
+	SIMDOps::store(lanes, result);
+	float m = MAX(MAX(lanes[0], lanes[1]), MAX(lanes[2], lanes[3]));
+	for (; i < p_count; i++) {
+		m = MAX(m, p_src[i]);
+	}
+	return m;
+}
+
+static const BatchMathKernels kernels_simd = {
+#ifdef BATCH_MATH_SSE2
+	BatchMath::SIMD_SSE2,
+#else
+	BatchMath::SIMD_NEON,
+#endif
+	_xform_points_simd,
+	_xform_transforms_simd,
+	_compose_transforms_simd,
+	_xform_transforms_3x4_simd,
+	_xform_aabbs_simd,
+	_add_simd,
+	_multiply_simd,
+	_scale_offset_simd,
+	_lerp_simd,
+	_clamp_simd,
+	_fill_range_simd,
+	_sum_simd,
+	_dot_simd,
+	_min_simd,
+	_max_simd,
+};
+
+#endif // BATCH_MATH_SSE2 || BATCH_MATH_NEON
+
+#ifdef BATCH_MATH_AVX2
+
+/* AVX2 kernels. Point transforms are the most common batch and benefit from
+ * 8-wide registers; everything else uses the SSE2 kernels, element-wise ones
+ * being limited by memory bandwidth anyway. FMA is deliberately not used, as
+ * results must round the same as Transform3D::xform() on every CPU. */
+
+#define BATCH_SHUFFLE8(m_a, m_b, m_0, m_1, m_2, m_3) _mm256_shuffle_ps(m_a, m_b, _MM_SHUFFLE(m_3, m_2, m_1, m_0))
+
+static _FORCE_INLINE_ BATCH_MATH_AVX2_FUNC __m256 _load_2x4(const float *p_lo, const float *p_hi) {
+	return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p_lo)), _mm_loadu_ps(p_hi), 1);
+}
+
+static _FORCE_INLINE_ BATCH_MATH_AVX2_FUNC void _store_2x4(float *r_lo, float *r_hi, __m256 p_value) {
+	_mm_storeu_ps(r_lo, _mm256_castps256_ps128(p_value));
+	_mm_storeu_ps(r_hi, _mm256_extractf128_ps(p_value, 1));
+}
+
+static BATCH_MATH_AVX2_FUNC void _xform_points_avx2(const Transform3D &p_xform, const Vector3 *p_src, Vector3 *r_dst, uint32_t p_count) {
+	__m256 m[12];
+	for (int i = 0; i < 3; i++) {
+		for (int j = 0; j < 3; j++) {
+			m[i * 3 + j] = _mm256_set1_ps(p_xform.basis.rows[i][j]);
+		}
+		m[9 + i] = _mm256_set1_ps(p_xform.origin[i]);
+	}
+
+	const float *src = (const float *)p_src;
+	float *dst = (float *)r_dst;
+	uint32_t i = 0;
+	for (; i + 8 <= p_count; i += 8, src += 24, dst += 24) {
+		// Points 0-3 go to the low lanes and 4-7 to the high ones, so the
+		// in-lane shuffles are the same as in the SSE2 version.
+		const __m256 a = _load_2x4(src, src + 12);
+		const __m256 b = _load_2x4(src + 4, src + 16);
+		const __m256 c = _load_2x4(src + 8, src + 20);
+		const __m256 ab = BATCH_SHUFFLE8(a, b, 1, 2, 0, 1);
+		const __m256 x = BATCH_SHUFFLE8(a, BATCH_SHUFFLE8(b, c, 2, 3, 1, 0), 0, 3, 0, 2);
+		const __m256 y = BATCH_SHUFFLE8(ab, BATCH_SHUFFLE8(b, c, 3, 3, 2, 2), 0, 2, 0, 2);
+		const __m256 z = BATCH_SHUFFLE8(ab, c, 1, 3, 0, 3);
+
+		__m256 r[3];
+		for (int j = 0; j < 3; j++) {
+			r[j] = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m[j * 3 + 0], x), _mm256_mul_ps(m[j * 3 + 1], y)), _mm256_mul_ps(m[j * 3 + 2], z)), m[9 + j]);
+		}
+
+		_store_2x4(dst, dst + 12, BATCH_SHUFFLE8(BATCH_SHUFFLE8(r[0], r[1], 0, 0, 0, 0), BATCH_SHUFFLE8(r[2], r[0], 0, 0, 1, 1), 0, 2, 0, 2));
+		_store_2x4(dst + 4, dst + 16, BATCH_SHUFFLE8(BATCH_SHUFFLE8(r[1], r[2], 1, 1, 1, 1), BATCH_SHUFFLE8(r[0], r[1], 2, 2, 2, 2), 0, 2, 0, 2));
+		_store_2x4(dst + 8, dst + 20, BATCH_SHUFFLE8(BATCH_SHUFFLE8(r[2], r[0], 2, 2, 3, 3), BATCH_SHUFFLE8(r[1], r[2], 3, 3, 3, 3), 0, 2, 0, 2));
+	}
+	_xform_points_simd(p_xform, p_src + i, r_dst + i, p_count - i);
+}
+
+static const BatchMathKernels kernels_avx2 = {
+	BatchMath::SIMD_AVX2,
+	_xform_points_avx2,
+	_xform_transforms_simd,
+	_compose_transforms_simd,
+	_xform_transforms_3x4_simd,
+	_xform_aabbs_simd,
+	_add_simd,
+	_multiply_simd,
+	_scale_offset_simd,
+	_lerp_simd,
+	_clamp_simd,
+	_fill_range_simd,
+	_sum_simd,
+	_dot_simd,
+	_min_simd,
+	_max_simd,
+};
+
+static bool _cpu_has_avx2() {
+#ifdef _MSC_VER
+	int info[4];
+	__cpuid(info, 0);
+	if (info[0] < 7) {
+		return false;
+	}
+	__cpuid(info, 1);
+	const bool osxsave = info[2] & (1 << 27);
+	const bool avx = info[2] & (1 << 28);
+	if (!osxsave || !avx || (_xgetbv(0) & 6) != 6) {
+		return false;
+	}
+	__cpuidex(info, 7, 0);
+	return info[1] & (1 << 5);
+#else
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif // BATCH_MATH_AVX2
+
+static const BatchMathKernels *_get_kernels_for_level(BatchMath::SIMDLevel p_level) {
+	switch (p_level) {
+#ifdef BATCH_MATH_AVX2
+		case BatchMath::SIMD_AVX2:
+			return &kernels_avx2;
+#endif
+#if defined(BATCH_MATH_SSE2) || defined(BATCH_MATH_NEON)
+		case BatchMath::SIMD_SSE2:
+		case BatchMath::SIMD_NEON:
+			return &kernels_simd;
+#endif
+		default:
+			return &kernels_scalar;
+	}
+}
+
+static const BatchMathKernels *forced_kernels = nullptr;
+
+static _FORCE_INLINE_ const BatchMathKernels *_get_kernels() {
+	if (unlikely(forced_kernels)) {
+		return forced_kernels;
+	}
+	static const BatchMathKernels *detected = _get_kernels_for_level(BatchMath::get_supported_simd_level());
+	return detected;
+}
+
+void BatchMath::xform_points(const Transform3D &p_xform, const Vector3 *p_src, Vector3 *r_dst, uint32_t p_count) {
+	_get_kernels()->xform_points(p_xform, p_src, r_dst, p_count);
+}
+
+void BatchMath::xform_transforms(const Transform3D &p_xform, const Transform3D *p_src, Transform3D *r_dst, uint32_t p_count) {
+	_get_kernels()->xform_transforms(p_xform, p_src, r_dst, p_count);
+}
+
+void BatchMath::compose_transforms(const Transform3D *p_a, const Transform3D *p_b, Transform3D *r_dst, uint32_t p_count) {
+	_get_kernels()->compose_transforms(p_a, p_b, r_dst, p_count);
+}
+
+void BatchMath::xform_transforms_3x4(const Transform3D &p_xform, const float *p_src, float *r_dst, uint32_t p_count, uint32_t p_stride) {
+	ERR_FAIL_COND_MSG(p_stride < 12, "Transform stride must be at least 12 floats.");
+	_get_kernels()->xform_transforms_3x4(p_xform, p_src, r_dst, p_count, p_stride);
+}
+
+void BatchMath::xform_aabbs(const Transform3D &p_xform, const AABB *p_src, AABB *r_dst, uint32_t p_count) {
+	_get_kernels()->xform_aabbs(p_xform, p_src, r_dst, p_count);
+}
+
+void BatchMath::add(const float *p_a, const float *p_b, float *r_dst, uint32_t p_count) {
+	_get_kernels()->add(p_a, p_b, r_dst, p_count);
+}
+
+void BatchMath::add(const double *p_a, const double *p_b, double *r_dst, uint32_t p_count) {
+	_add_scalar(p_a, p_b, r_dst, p_count);
+}
+
+void BatchMath::multiply(const float *p_a, const float *p_b, float *r_dst, uint32_t p_count) {
+	_get_kernels()->multiply(p_a, p_b, r_dst, p_count);
+}
+
+void BatchMath::multiply(const double *p_a, const double *p_b, double *r_dst, uint32_t p_count) {
+	_multiply_scalar(p_a, p_b, r_dst, p_count);
+}
+
+void BatchMath::scale_offset(const float *p_src, float p_scale, float p_offset, float *r_dst, uint32_t p_count) {
+	_get_kernels()->scale_offset(p_src, p_scale, p_offset, r_dst, p_count);
+}
+
+void BatchMath::scale_offset(const double *p_src, double p_scale, double p_offset, double *r_dst, uint32_t p_count) {
+	_scale_offset_scalar(p_src, p_scale, p_offset, r_dst, p_count);
+}
+
+void BatchMath::lerp(const float *p_a, const float *p_b, float p_weight, float *r_dst, uint32_t p_count) {
+	_get_kernels()->lerp(p_a, p_b, p_weight, r_dst, p_count);
+}
+
+void BatchMath::lerp(const double *p_a, const double *p_b, double p_weight, double *r_dst, uint32_t p_count) {
+	_lerp_scalar(p_a, p_b, p_weight, r_dst, p_count);
+}
+
+void BatchMath::clamp(const float *p_src, float p_min, float p_max, float *r_dst, uint32_t p_count) {
+	_get_kernels()->clamp(p_src, p_min, p_max, r_dst, p_count);
+}
+
+void BatchMath::clamp(const double *p_src, double p_min, double p_max, double *r_dst, uint32_t p_count) {
+	_clamp_scalar(p_src, p_min, p_max, r_dst, p_count);
+}
+
+void BatchMath::fill_range(float p_from, float p_step, float *r_dst, uint32_t p_count) {
+	_get_kernels()->fill_range(p_from, p_step, r_dst, p_count);
+}
+
+void BatchMath::fill_range(double p_from, double p_step, double *r_dst, uint32_t p_count) {
+	_fill_range_scalar(p_from, p_step, r_dst, 0, p_count);
+}
+
+double BatchMath::sum(const float *p_src, uint32_t p_count) {
+	return _get_kernels()->sum(p_src, p_count);
+}
+
+double BatchMath::sum(const double *p_src, uint32_t p_count) {
+	return _sum_scalar(p_src, p_count);
+}
+
+double BatchMath::dot(const float *p_a, const float *p_b, uint32_t p_count) {
+	return _get_kernels()->dot(p_a, p_b, p_count);
+}
+
+double BatchMath::dot(const double *p_a, const double *p_b, uint32_t p_count) {
+	return _dot_scalar(p_a, p_b, p_count);
+}
+
+float BatchMath::min(const float *p_src, uint32_t p_count) {
+	return _get_kernels()->min(p_src, p_count);
+}
+
+double BatchMath::min(const double *p_src, uint32_t p_count) {
+	return _min_scalar(p_src, p_count);
+}
+
+float BatchMath::max(const float *p_src, uint32_t p_count) {
+	return _get_kernels()->max(p_src, p_count);
+}
+
+double BatchMath::max(const double *p_src, uint32_t p_count) {
+	return _max_scalar(p_src, p_count);
+}
+
+BatchMath::SIMDLevel BatchMath::get_supported_simd_level() {
+#if defined(BATCH_MATH_AVX2)
+	static const SIMDLevel level = _cpu_has_avx2() ? SIMD_AVX2 : SIMD_SSE2;
+	return level;
+#elif defined(BATCH_MATH_SSE2)
+	return SIMD_SSE2;
+#elif defined(BATCH_MATH_NEON)
+	return SIMD_NEON;
+#else
+	return SIMD_NONE;
+#endif
+}
+
+bool BatchMath::is_simd_level_supported(SIMDLevel p_level) {
+	const SIMDLevel supported = get_supported_simd_level();
+	return p_level == SIMD_NONE || p_level == supported || (p_level == SIMD_SSE2 && supported == SIMD_AVX2);
+}
+
+BatchMath::SIMDLevel BatchMath::get_simd_level() {
+	return _get_kernels()->level;
+}
+
+void BatchMath::set_simd_level(SIMDLevel p_level) {
+	ERR_FAIL_COND_MSG(!is_simd_level_supported(p_level), "This SIMD level is not supported by the CPU or the build.");
+	forced_kernels = _get_kernels_for_level(p_level);
+}
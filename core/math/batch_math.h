@@ -0,0 +1,108 @@
+/**************************************************************************/
+/*  batch_math.h                                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef BATCH_MATH_H
+#define BATCH_MATH_H
+
+#include "core/math/aabb.h"
+#include "core/math/transform_3d.h"
+
+// Transforms whole arrays of points, transforms and bounding boxes at once, and
+// runs element-wise math on whole arrays of numbers.
+// Elements are processed in groups, in structure-of-arrays form, with the
+// widest SIMD instruction set supported by the CPU (detected at runtime).
+// Double precision builds always use the scalar kernels.
+//
+// The source and destination arrays may be the same, but must not otherwise
+// overlap.
+class BatchMath {
+public:
+	enum SIMDLevel {
+		SIMD_NONE,
+		SIMD_SSE2,
+		SIMD_AVX2,
+		SIMD_NEON,
+	};
+
+	// r_dst[i] = p_xform.xform(p_src[i])
+	static void xform_points(const Transform3D &p_xform, const Vector3 *p_src, Vector3 *r_dst, uint32_t p_count);
+	// r_dst[i] = p_xform * p_src[i]
+	static void xform_transforms(const Transform3D &p_xform, const Transform3D *p_src, Transform3D *r_dst, uint32_t p_count);
+	// r_dst[i] = p_a[i] * p_b[i]
+	static void compose_transforms(const Transform3D *p_a, const Transform3D *p_b, Transform3D *r_dst, uint32_t p_count);
+	// Same as xform_transforms(), for transforms stored as 12 floats in the
+	// row-major 3x4 layout of MultiMesh buffers. p_stride is the distance in
+	// floats between two transforms; the floats past the first 12 are left alone.
+	static void xform_transforms_3x4(const Transform3D &p_xform, const float *p_src, float *r_dst, uint32_t p_count, uint32_t p_stride = 12);
+	// r_dst[i] = p_xform.xform(p_src[i])
+	static void xform_aabbs(const Transform3D &p_xform, const AABB *p_src, AABB *r_dst, uint32_t p_count);
+
+	// Element-wise operations on arrays of numbers. Double arrays always use
+	// plain loops.
+	// r_dst[i] = p_a[i] + p_b[i]
+	static void add(const float *p_a, const float *p_b, float *r_dst, uint32_t p_count);
+	static void add(const double *p_a, const double *p_b, double *r_dst, uint32_t p_count);
+	// r_dst[i] = p_a[i] * p_b[i]
+	static void multiply(const float *p_a, const float *p_b, float *r_dst, uint32_t p_count);
+	static void multiply(const double *p_a, const double *p_b, double *r_dst, uint32_t p_count);
+	// r_dst[i] = p_src[i] * p_scale + p_offset
+	static void scale_offset(const float *p_src, float p_scale, float p_offset, float *r_dst, uint32_t p_count);
+	static void scale_offset(const double *p_src, double p_scale, double p_offset, double *r_dst, uint32_t p_count);
+	// r_dst[i] = Math::lerp(p_a[i], p_b[i], p_weight)
+	static void lerp(const float *p_a, const float *p_b, float p_weight, float *r_dst, uint32_t p_count);
+	static void lerp(const double *p_a, const double *p_b, double p_weight, double *r_dst, uint32_t p_count);
+	// r_dst[i] = CLAMP(p_src[i], p_min, p_max)
+	static void clamp(const float *p_src, float p_min, float p_max, float *r_dst, uint32_t p_count);
+	static void clamp(const double *p_src, double p_min, double p_max, double *r_dst, uint32_t p_count);
+	// r_dst[i] = p_from + i * p_step
+	static void fill_range(float p_from, float p_step, float *r_dst, uint32_t p_count);
+	static void fill_range(double p_from, double p_step, double *r_dst, uint32_t p_count);
+
+	// Reductions. Sums of floats are accumulated in double. The SIMD kernels keep
+	// several partial results, so sums may differ slightly between SIMD levels.
+	// Minimums and maximums of empty arrays are 0.
+	static double sum(const float *p_src, uint32_t p_count);
+	static double sum(const double *p_src, uint32_t p_count);
+	static double dot(const float *p_a, const float *p_b, uint32_t p_count);
+	static double dot(const double *p_a, const double *p_b, uint32_t p_count);
+	static float min(const float *p_src, uint32_t p_count);
+	static double min(const double *p_src, uint32_t p_count);
+	static float max(const float *p_src, uint32_t p_count);
+	static double max(const double *p_src, uint32_t p_count);
+
+	static SIMDLevel get_supported_simd_level();
+	static bool is_simd_level_supported(SIMDLevel p_level);
+	static SIMDLevel get_simd_level();
+	// Forces a given (supported) instruction set, meant for tests and benchmarks.
+	// Not thread-safe.
+	static void set_simd_level(SIMDLevel p_level);
+};
+
+#endif // BATCH_MATH_H
@@ -52,6 +52,7 @@
 // and pairable_mask is either 0 if static, or set to all if non static
 
 #include "bvh_tree.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/mutex.h"
 
 #define BVHTREE_CLASS BVH_Tree<T, NUM_TREES, 2, MAX_ITEMS, USER_PAIR_TEST_FUNCTION, USER_CULL_TEST_FUNCTION, USE_PAIRS, BOUNDS, POINT>
@@ -88,6 +89,13 @@ public:
 		tree.params_set_pairing_expansion(p_value);
 	}
 
+	// when enabled, update() culls the tree for the moved items on the WorkerThreadPool,
+	// then pairs them and sends the callbacks on the calling thread, in the same order as before.
+	void params_set_parallel_pairing(bool p_enable) {
+		BVH_LOCKED_FUNCTION
+		_parallel_pairing = p_enable;
+	}
+
 	void set_pair_callback(PairCallback p_callback, void *p_userdata) {
 		BVH_LOCKED_FUNCTION
 		pair_callback = p_callback;
@@ -300,7 +308,11 @@ public:
 	void update() {
 		BVH_LOCKED_FUNCTION
 		tree.update();
-		_check_for_collisions();
+		if (_parallel_pairing && changed_items.size() >= PARALLEL_PAIRING_MIN_ITEMS) {
+			_check_for_collisions_parallel();
+		} else {
+			_check_for_collisions();
+		}
 #ifdef BVH_INTEGRITY_CHECKS
 		tree._integrity_check_all();
 #endif
@@ -480,6 +492,72 @@ private:
 		_reset();
 	}
 
+	// finds the items overlapping the expanded aabb of a changed item, without changing anything.
+	// Called from several threads at once.
+	void _find_pairing_hits(uint32_t p_index, void *p_userdata) {
+		const BVHHandle h = changed_items[p_index];
+		LocalVector<uint32_t, uint32_t, true> &hits = _pairing_hits[p_index];
+
+		BVHABB_CLASS abb;
+		abb.from(tree._pairs[h.id()].expanded_aabb);
+
+		typename BVHTREE_CLASS::CullParams params;
+		params.result_count_overall = 0;
+		params.result_max = INT_MAX;
+		params.result_array = nullptr;
+		params.subindex_array = nullptr;
+		tree.item_fill_cullparams(h, params);
+		params.abb = abb;
+		tree.cull_aabb_hits(params, hits);
+
+		// discard the hits _collide() always rejects, which don't depend on the pairs
+		const typename BVHTREE_CLASS::ItemExtra &ex = _get_extra(h);
+		uint32_t num_hits = 0;
+		for (uint32_t n = 0; n < hits.size(); n++) {
+			uint32_t ref_id = hits[n];
+			if (ref_id == h.id()) {
+				continue;
+			}
+
+			BVHHandle h_collidee;
+			h_collidee.set_id(ref_id);
+			const typename BVHTREE_CLASS::ItemExtra &ex_collidee = _get_extra(h_collidee);
+			if ((ex.userdata == ex_collidee.userdata) && ex.userdata) {
+				continue;
+			}
+			hits[num_hits++] = ref_id;
+		}
+		hits.resize(num_hits);
+	}
+
+	// same as _check_for_collisions(), with the tree culls done on the WorkerThreadPool.
+	// The pairs are still only changed on the calling thread, in changed item order, as
+	// each item can pair or unpair items that come later.
+	void _check_for_collisions_parallel() {
+		// the hit buffers are kept between updates, so only grow them
+		if (_pairing_hits.size() < changed_items.size()) {
+			_pairing_hits.resize(changed_items.size());
+		}
+
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &BVH_Manager::_find_pairing_hits, nullptr, changed_items.size(), -1, true, SNAME("BVHPairing"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+		for (uint32_t i = 0; i < changed_items.size(); i++) {
+			const BVHHandle h = changed_items[i];
+			BVHABB_CLASS abb;
+			abb.from(tree._pairs[h.id()].expanded_aabb);
+
+			_find_leavers(h, abb, false);
+
+			for (const uint32_t ref_id : _pairing_hits[i]) {
+				BVHHandle h_collidee;
+				h_collidee.set_id(ref_id);
+				_collide(h, h_collidee);
+			}
+		}
+		_reset();
+	}
+
 public:
 	void item_get_AABB(BVHHandle p_handle, BOUNDS &r_aabb) {
 		DEV_ASSERT(!p_handle.is_invalid());
@@ -773,6 +851,14 @@ private:
 	LocalVector<BVHHandle, uint32_t, true> changed_items;
 	uint32_t _tick = 1; // Start from 1 so items with 0 indicate never updated.
 
+	// parallel pairing, for the same changed items
+	enum {
+		PARALLEL_PAIRING_MIN_ITEMS = 64
+	};
+
+	LocalVector<LocalVector<uint32_t, uint32_t, true>> _pairing_hits;
+	bool _parallel_pairing = false;
+
 	class BVHLockedFunction {
 	public:
 		BVHLockedFunction(Mutex *p_mutex, bool p_thread_safe) {
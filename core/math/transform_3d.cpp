@@ -30,6 +30,7 @@
 
 #include "transform_3d.h"
 
+#include "core/math/batch_math.h"
 #include "core/math/math_funcs.h"
 #include "core/string/ustring.h"
 
@@ -111,6 +112,13 @@ Transform3D Transform3D::interpolate_with(const Transform3D &p_transform, real_t
 	return interp;
 }
 
+Vector<Vector3> Transform3D::xform(const Vector<Vector3> &p_array) const {
+	Vector<Vector3> array;
+	array.resize(p_array.size());
+	BatchMath::xform_points(*this, p_array.ptr(), array.ptrw(), p_array.size());
+	return array;
+}
+
 void Transform3D::scale(const Vector3 &p_scale) {
 	basis.scale(p_scale);
 	origin *= p_scale;
@@ -718,7 +718,7 @@ bool ClassDB::is_virtual(const StringName &p_class) {
 	return (!ti->disabled && ti->creation_func != nullptr && !(ti->gdextension && !ti->gdextension->create_instance) && ti->is_virtual);
 }
 
-void ClassDB::_add_class2(const StringName &p_class, const StringName &p_inherits) {
+void ClassDB::_add_class2(const StringName &p_class, const StringName &p_inherits, bool p_overrides_callp) {
 	OBJTYPE_WLOCK;
 
 	const StringName &name = p_class;
@@ -730,6 +730,7 @@ void ClassDB::_add_class2(const StringName &p_class, const StringName &p_inherit
 	ti.name = name;
 	ti.inherits = p_inherits;
 	ti.api = current_api;
+	ti.overrides_callp = p_overrides_callp;
 
 	if (ti.inherits) {
 		ERR_FAIL_COND(!classes.has(ti.inherits)); //it MUST be registered.
@@ -792,9 +793,9 @@ void ClassDB::get_method_list(const StringName &p_class, List<MethodInfo> *p_met
 			p_methods->push_back(minfo);
 		}
 #else
-		for (KeyValue<StringName, MethodBind *> &E : type->method_map) {
-			MethodBind *m = E.value;
-			MethodInfo minfo = info_from_bind(m);
+		for (const StringName &E : type->method_order) {
+			MethodBind *method = type->method_map.get(E);
+			MethodInfo minfo = info_from_bind(method);
 			p_methods->push_back(minfo);
 		}
 #endif
@@ -840,8 +841,8 @@ void ClassDB::get_method_list_with_compatibility(const StringName &p_class, List
 			p_methods->push_back(pair);
 		}
 #else
-		for (KeyValue<StringName, MethodBind *> &E : type->method_map) {
-			MethodBind *method = E.value;
+		for (const StringName &E : type->method_order) {
+			MethodBind *method = type->method_map.get(E);
 			MethodInfo minfo = info_from_bind(method);
 
 			Pair<MethodInfo, uint32_t> pair(minfo, method->get_hash());
@@ -1761,10 +1762,7 @@ void ClassDB::_bind_method_custom(const StringName &p_class, MethodBind *p_metho
 		ERR_FAIL_MSG("Method already bound '" + p_class + "::" + p_method->get_name() + "'.");
 	}
 
-#ifdef DEBUG_METHODS_ENABLED
 	type->method_order.push_back(p_method->get_name());
-#endif
-
 	type->method_map[p_method->get_name()] = p_method;
 }
 
@@ -1792,11 +1790,9 @@ MethodBind *ClassDB::_bind_vararg_method(MethodBind *p_bind, const StringName &p
 		ERR_FAIL_V_MSG(nullptr, "Method already bound: " + instance_type + "::" + p_name + ".");
 	}
 	type->method_map[p_name] = bind;
-#ifdef DEBUG_METHODS_ENABLED
 	// FIXME: <reduz> set_return_type is no longer in MethodBind, so I guess it should be moved to vararg method bind
 	//bind->set_return_type("Variant");
 	type->method_order.push_back(p_name);
-#endif
 
 	return bind;
 }
@@ -1840,15 +1836,12 @@ MethodBind *ClassDB::bind_methodfi(uint32_t p_flags, MethodBind *p_bind, bool p_
 	}
 
 	p_bind->set_argument_names(method_name.args);
-
-	if (!p_compatibility) {
-		type->method_order.push_back(mdname);
-	}
 #endif
 
 	if (p_compatibility) {
 		_bind_compatibility(type, p_bind);
 	} else {
+		type->method_order.push_back(mdname);
 		type->method_map[mdname] = p_bind;
 	}
 
@@ -1987,6 +1980,14 @@ bool ClassDB::is_class_runtime(const StringName &p_class) {
 	return ti->is_runtime;
 }
 
+bool ClassDB::class_overrides_callp(const StringName &p_class) {
+	OBJTYPE_RLOCK;
+
+	ClassInfo *ti = classes.getptr(p_class);
+	ERR_FAIL_NULL_V_MSG(ti, false, "Cannot get class '" + String(p_class) + "'.");
+	return ti->overrides_callp;
+}
+
 void ClassDB::add_resource_base_extension(const StringName &p_extension, const StringName &p_class) {
 	if (resource_base_extensions.has(p_extension)) {
 		return;
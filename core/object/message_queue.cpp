@@ -31,33 +31,45 @@
 #include "message_queue.h"
 
 #include "core/config/project_settings.h"
+#include "core/debugger/trace_profiler.h"
 #include "core/object/class_db.h"
 #include "core/object/script_language.h"
+#include "core/os/os.h"
 
 #include <stdio.h>
 
 #ifdef DEV_ENABLED
 // Includes safety checks to ensure that a queue set as a thread singleton override
 // is only ever called from the thread it was set for.
-#define LOCK_MUTEX                                \
-	if (this != MessageQueue::thread_singleton) { \
-		DEV_ASSERT(!is_current_thread_override);  \
-		mutex.lock();                             \
-	} else {                                      \
-		DEV_ASSERT(is_current_thread_override);   \
+#define LOCK_MUTEX                                                         \
+	if (this != MessageQueue::thread_singleton && !is_thread_submission) { \
+		DEV_ASSERT(!is_current_thread_override);                           \
+		mutex.lock();                                                      \
+	} else {                                                               \
+		DEV_ASSERT(is_current_thread_override || is_thread_submission);    \
 	}
 #else
-#define LOCK_MUTEX                                \
-	if (this != MessageQueue::thread_singleton) { \
-		mutex.lock();                             \
+#define LOCK_MUTEX                                                         \
+	if (this != MessageQueue::thread_singleton && !is_thread_submission) { \
+		mutex.lock();                                                      \
 	}
 #endif
 
-#define UNLOCK_MUTEX                              \
-	if (this != MessageQueue::thread_singleton) { \
-		mutex.unlock();                           \
+#define UNLOCK_MUTEX                                                       \
+	if (this != MessageQueue::thread_singleton && !is_thread_submission) { \
+		mutex.unlock();                                                    \
 	}
 
+#ifdef THREADS_ENABLED
+#define PUSH_FROM_THREAD(m_push)                                                                                                      \
+	if (unlikely(this == MessageQueue::main_singleton && !Thread::is_main_thread() && !MessageQueue::thread_submissions_destroyed)) { \
+		MessageQueue::ThreadSubmissionScope scope((MessageQueue *)this);                                                              \
+		return scope.queue->m_push;                                                                                                   \
+	}
+#else
+#define PUSH_FROM_THREAD(m_push)
+#endif
+
 void CallQueue::_add_page() {
 	if (pages_used == page_bytes.size()) {
 		pages.push_back(allocator->alloc());
@@ -67,6 +79,48 @@ void CallQueue::_add_page() {
 	pages_used++;
 }
 
+Error CallQueue::_splice_pages_from(CallQueue *p_source) {
+	DEV_ASSERT(p_source->allocator == allocator);
+
+	pushed_messages += p_source->pushed_messages;
+	pushed_bytes += p_source->pushed_bytes;
+	p_source->pushed_messages = 0;
+	p_source->pushed_bytes = 0;
+
+	if (!p_source->has_messages()) {
+		return OK;
+	}
+
+	_ensure_first_page();
+	if (pages_used == 1 && page_bytes[0] == 0) {
+		pages_used = 0; // Empty, take the first page over.
+	}
+
+	if (pages_used + p_source->pages_used > max_pages) {
+		fprintf(stderr, "Failed to merge %d pages of messages. Message queue out of memory. %s\n", p_source->pages_used, error_text.utf8().get_data());
+		pages_used = MAX(pages_used, 1u);
+		p_source->clear();
+		return ERR_OUT_OF_MEMORY;
+	}
+
+	// Pages are swapped rather than copied; the source gets spare or new pages back.
+	for (uint32_t i = 0; i < p_source->pages_used; i++) {
+		if (pages_used == pages.size()) {
+			pages.push_back(p_source->pages[i]);
+			page_bytes.push_back(p_source->page_bytes[i]);
+			p_source->pages[i] = allocator->alloc();
+		} else {
+			SWAP(pages[pages_used], p_source->pages[i]);
+			page_bytes[pages_used] = p_source->page_bytes[i];
+		}
+		p_source->page_bytes[i] = 0;
+		pages_used++;
+	}
+	p_source->pages_used = 1;
+
+	return OK;
+}
+
 Error CallQueue::push_callp(ObjectID p_id, const StringName &p_method, const Variant **p_args, int p_argcount, bool p_show_error) {
 	return push_callablep(Callable(p_id, p_method), p_args, p_argcount, p_show_error);
 }
@@ -88,6 +142,8 @@ Error CallQueue::push_callablep(const Callable &p_callable, const Variant **p_ar
 
 	ERR_FAIL_COND_V_MSG(room_needed > uint32_t(PAGE_SIZE_BYTES), ERR_INVALID_PARAMETER, "Message is too large to fit on a page (" + itos(PAGE_SIZE_BYTES) + " bytes), consider passing less arguments.");
 
+	PUSH_FROM_THREAD(push_callablep(p_callable, p_args, p_argcount, p_show_error));
+
 	LOCK_MUTEX;
 
 	_ensure_first_page();
@@ -127,6 +183,8 @@ Error CallQueue::push_callablep(const Callable &p_callable, const Variant **p_ar
 	}
 
 	page_bytes[pages_used - 1] += room_needed;
+	pushed_messages++;
+	pushed_bytes += room_needed;
 
 	UNLOCK_MUTEX;
 
@@ -134,6 +192,8 @@ Error CallQueue::push_callablep(const Callable &p_callable, const Variant **p_ar
 }
 
 Error CallQueue::push_set(ObjectID p_id, const StringName &p_prop, const Variant &p_value) {
+	PUSH_FROM_THREAD(push_set(p_id, p_prop, p_value));
+
 	LOCK_MUTEX;
 	uint32_t room_needed = sizeof(Message) + sizeof(Variant);
 
@@ -168,6 +228,8 @@ Error CallQueue::push_set(ObjectID p_id, const StringName &p_prop, const Variant
 	*v = p_value;
 
 	page_bytes[pages_used - 1] += room_needed;
+	pushed_messages++;
+	pushed_bytes += room_needed;
 	UNLOCK_MUTEX;
 
 	return OK;
@@ -175,6 +237,8 @@ Error CallQueue::push_set(ObjectID p_id, const StringName &p_prop, const Variant
 
 Error CallQueue::push_notification(ObjectID p_id, int p_notification) {
 	ERR_FAIL_COND_V(p_notification < 0, ERR_INVALID_PARAMETER);
+	PUSH_FROM_THREAD(push_notification(p_id, p_notification));
+
 	LOCK_MUTEX;
 	uint32_t room_needed = sizeof(Message);
 
@@ -201,6 +265,8 @@ Error CallQueue::push_notification(ObjectID p_id, int p_notification) {
 	msg->notification = p_notification;
 
 	page_bytes[pages_used - 1] += room_needed;
+	pushed_messages++;
+	pushed_bytes += room_needed;
 	UNLOCK_MUTEX;
 
 	return OK;
@@ -224,6 +290,26 @@ void CallQueue::_call_function(const Callable &p_callable, const Variant *p_args
 }
 
 Error CallQueue::flush() {
+	TRACE_ZONE("CallQueue::flush");
+	if (this != MessageQueue::main_singleton) {
+		return _flush();
+	}
+
+	// Timed as a whole, so every way out is accounted for, merging included.
+	MessageQueue *mq = static_cast<MessageQueue *>(this);
+	const uint64_t flush_begin = OS::get_singleton()->get_ticks_usec();
+	Error err = OK;
+	do {
+		mq->_merge_thread_submissions();
+		err = _flush();
+	} while (err == OK && mq->_has_thread_submissions());
+	mutex.lock();
+	mq->flush_usec += OS::get_singleton()->get_ticks_usec() - flush_begin;
+	mutex.unlock();
+	return err;
+}
+
+Error CallQueue::_flush() {
 	LOCK_MUTEX;
 
 	if (pages.size() == 0) {
@@ -346,6 +432,85 @@ void CallQueue::clear() {
 	UNLOCK_MUTEX;
 }
 
+Error CallQueue::transfer_to(CallQueue *p_target) {
+	ERR_FAIL_COND_V(p_target == this, ERR_INVALID_PARAMETER);
+	LOCK_MUTEX;
+
+	if (pages.size() == 0) {
+		UNLOCK_MUTEX;
+		return OK; // Nothing to transfer.
+	}
+
+	if (flushing) {
+		UNLOCK_MUTEX;
+		return ERR_BUSY;
+	}
+
+	// Messages are repacked in the same order and page size, so they never need
+	// more new pages in the target than they use here. Leave them here if those
+	// can't be had, so the caller can still run them.
+	p_target->mutex.lock();
+	const bool fits = p_target->pages_used + pages_used <= p_target->max_pages;
+	p_target->mutex.unlock();
+	if (!fits) {
+		UNLOCK_MUTEX;
+		return ERR_OUT_OF_MEMORY;
+	}
+
+	Error err = OK;
+	for (uint32_t i = 0; i < pages_used; i++) {
+		uint32_t offset = 0;
+		while (offset < page_bytes[i]) {
+			Page *page = pages[i];
+			Message *message = (Message *)&page->data[offset];
+
+			uint32_t advance = sizeof(Message);
+			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
+				advance += sizeof(Variant) * message->args;
+			}
+			offset += advance;
+
+			Error push_err = OK;
+			Variant *args = (Variant *)(message + 1);
+			switch (message->type & FLAG_MASK) {
+				case TYPE_CALL: {
+					const Variant **argptrs = nullptr;
+					if (message->args) {
+						argptrs = (const Variant **)alloca(sizeof(Variant *) * message->args);
+						for (int k = 0; k < message->args; k++) {
+							argptrs[k] = &args[k];
+						}
+					}
+					push_err = p_target->push_callablep(message->callable, argptrs, message->args, message->type & FLAG_SHOW_ERROR);
+				} break;
+				case TYPE_NOTIFICATION: {
+					push_err = p_target->push_notification(message->callable.get_object_id(), message->notification);
+				} break;
+				case TYPE_SET: {
+					push_err = p_target->push_set(message->callable.get_object_id(), message->callable.get_method(), *args);
+				} break;
+			}
+			if (push_err != OK) {
+				err = push_err;
+			}
+
+			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
+				for (int k = 0; k < message->args; k++) {
+					args[k].~Variant();
+				}
+			}
+
+			message->~Message();
+		}
+	}
+
+	pages_used = 1;
+	page_bytes[0] = 0;
+
+	UNLOCK_MUTEX;
+	return err;
+}
+
 void CallQueue::statistics() {
 	LOCK_MUTEX;
 	HashMap<StringName, int> set_count;
@@ -446,6 +611,9 @@ bool CallQueue::is_flushing() const {
 }
 
 bool CallQueue::has_messages() const {
+	if (this == MessageQueue::main_singleton && static_cast<const MessageQueue *>(this)->_has_thread_submissions()) {
+		return true;
+	}
 	if (pages_used == 0) {
 		return false;
 	}
@@ -488,6 +656,116 @@ CallQueue::~CallQueue() {
 
 CallQueue *MessageQueue::main_singleton = nullptr;
 thread_local CallQueue *MessageQueue::thread_singleton = nullptr;
+uint32_t MessageQueue::generation = 0;
+thread_local MessageQueue::ThreadSubmissionsRef MessageQueue::current_thread_submissions;
+thread_local bool MessageQueue::thread_submissions_destroyed = false;
+
+MessageQueue::ThreadSubmissionsRef::~ThreadSubmissionsRef() {
+	// Destructors of other thread locals may still push after this one.
+	MessageQueue::thread_submissions_destroyed = true;
+	if (submissions && generation == MessageQueue::generation) {
+		submissions->thread_exited.store(true, std::memory_order_release);
+	}
+}
+
+MessageQueue::ThreadSubmissionScope::ThreadSubmissionScope(MessageQueue *p_message_queue) {
+	submissions = p_message_queue->_get_thread_submissions();
+	// Sequentially consistent, pairs with the index swap in _merge_thread_submissions().
+	submissions->writing.store(true, std::memory_order_seq_cst);
+	queue = submissions->queues[submissions->write_index.load(std::memory_order_seq_cst)];
+}
+
+MessageQueue::ThreadSubmissionScope::~ThreadSubmissionScope() {
+	submissions->pending.store(true, std::memory_order_relaxed);
+	submissions->writing.store(false, std::memory_order_release);
+}
+
+MessageQueue::ThreadSubmissions *MessageQueue::_get_thread_submissions() {
+	ThreadSubmissionsRef &ref = current_thread_submissions;
+	if (likely(ref.submissions && ref.generation == generation)) {
+		return ref.submissions;
+	}
+
+	ThreadSubmissions *submissions = memnew(ThreadSubmissions);
+	submissions->thread_id = Thread::get_caller_id();
+	for (int i = 0; i < 2; i++) {
+		submissions->queues[i] = memnew(CallQueue(allocator, max_pages, error_text));
+		submissions->queues[i]->is_thread_submission = true;
+	}
+	submissions->write_index.store(0, std::memory_order_relaxed);
+	submissions->writing.store(false, std::memory_order_relaxed);
+	submissions->pending.store(false, std::memory_order_relaxed);
+	submissions->thread_exited.store(false, std::memory_order_relaxed);
+
+	{
+		MutexLock lock(submissions_mutex);
+		uint32_t pos = 0;
+		while (pos < thread_submissions.size() && thread_submissions[pos]->thread_id < submissions->thread_id) {
+			pos++;
+		}
+		thread_submissions.insert(pos, submissions);
+	}
+
+	ref.submissions = submissions;
+	ref.generation = generation;
+	return submissions;
+}
+
+bool MessageQueue::_has_thread_submissions() const {
+	MutexLock lock(submissions_mutex);
+	for (const ThreadSubmissions *submissions : thread_submissions) {
+		if (submissions->pending.load(std::memory_order_acquire)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void MessageQueue::_merge_thread_submissions() {
+	MutexLock lock(submissions_mutex);
+
+	for (uint32_t i = 0; i < thread_submissions.size(); i++) {
+		ThreadSubmissions *submissions = thread_submissions[i];
+		// Cleared first, so pushes to the queue written to next set it again.
+		submissions->pending.store(false, std::memory_order_seq_cst);
+		// The thread may still be reading the old index, so wait until it's done
+		// pushing before taking that queue. Pushing is short and never blocks on
+		// this thread.
+		const uint32_t read_index = submissions->write_index.load(std::memory_order_relaxed);
+		submissions->write_index.store(read_index ^ 1, std::memory_order_seq_cst);
+		while (submissions->writing.load(std::memory_order_seq_cst)) {
+			OS::get_singleton()->yield();
+		}
+
+		mutex.lock();
+		_splice_pages_from(submissions->queues[read_index]);
+		mutex.unlock();
+
+		if (submissions->thread_exited.load(std::memory_order_acquire)) {
+			// Pushed to right before exiting. Nothing writes to it anymore.
+			mutex.lock();
+			_splice_pages_from(submissions->queues[read_index ^ 1]);
+			mutex.unlock();
+			memdelete(submissions->queues[0]);
+			memdelete(submissions->queues[1]);
+			memdelete(submissions);
+			thread_submissions.remove_at(i);
+			i--;
+		}
+	}
+}
+
+void MessageQueue::take_statistics(uint64_t &r_messages, uint64_t &r_bytes, uint64_t &r_flush_usec) {
+	MessageQueue *mq = static_cast<MessageQueue *>(main_singleton);
+	ERR_FAIL_NULL(mq);
+	MutexLock lock(mq->mutex);
+	r_messages = mq->pushed_messages;
+	r_bytes = mq->pushed_bytes;
+	r_flush_usec = mq->flush_usec;
+	mq->pushed_messages = 0;
+	mq->pushed_bytes = 0;
+	mq->flush_usec = 0;
+}
 
 void MessageQueue::set_thread_singleton_override(CallQueue *p_thread_singleton) {
 #ifdef DEV_ENABLED
@@ -509,8 +787,15 @@ MessageQueue::MessageQueue() :
 				"Message queue out of memory. Try increasing 'memory/limits/message_queue/max_size_mb' in project settings.") {
 	ERR_FAIL_COND_MSG(main_singleton != nullptr, "A MessageQueue singleton already exists.");
 	main_singleton = this;
+	generation++;
 }
 
 MessageQueue::~MessageQueue() {
+	for (ThreadSubmissions *submissions : thread_submissions) {
+		memdelete(submissions->queues[0]);
+		memdelete(submissions->queues[1]);
+		memdelete(submissions);
+	}
+	generation++;
 	main_singleton = nullptr;
 }
@@ -32,6 +32,7 @@
 #define MESSAGE_QUEUE_H
 
 #include "core/object/object_id.h"
+#include "core/os/thread.h"
 #include "core/os/thread_safe.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/paged_allocator.h"
@@ -76,6 +77,11 @@ private:
 	uint32_t max_pages = 0;
 	uint32_t pages_used = 0;
 	bool flushing = false;
+	// Only ever pushed to by its thread, see MessageQueue.
+	bool is_thread_submission = false;
+
+	uint64_t pushed_messages = 0;
+	uint64_t pushed_bytes = 0;
 
 #ifdef DEV_ENABLED
 	bool is_current_thread_override = false;
@@ -99,6 +105,9 @@ private:
 	}
 
 	void _add_page();
+	// Moves all messages of another queue, which must share the allocator, to the end of this one.
+	Error _splice_pages_from(CallQueue *p_source);
+	Error _flush();
 
 	void _call_function(const Callable &p_callable, const Variant *p_args, int p_argcount, bool p_show_error);
 
@@ -146,6 +155,9 @@ public:
 
 	Error flush();
 	void clear();
+	// Moves all messages, in order, to the end of another queue, without running them.
+	// On ERR_BUSY or ERR_OUT_OF_MEMORY, nothing is moved and the messages stay here.
+	Error transfer_to(CallQueue *p_target);
 	void statistics();
 
 	bool has_messages() const;
@@ -157,17 +169,77 @@ public:
 	virtual ~CallQueue();
 };
 
+// Threads other than the main one don't push to the main queue directly, which
+// would make them contend for its mutex. Each gets a pair of private queues
+// instead, pushed to without locking: one is written to while the other is
+// merged into the main queue when it's flushed. Threads are merged in the order
+// of their IDs, each keeping the order its messages were pushed in.
+//
+// Merged messages run after those already in the main queue, so a thread's
+// message runs after messages the main thread pushed later, up to the start of
+// the flush. Flushing keeps merging until no thread has anything left, so
+// messages pushed while flushing still run in the same flush.
 class MessageQueue : public CallQueue {
 	static CallQueue *main_singleton;
 	static thread_local CallQueue *thread_singleton;
 	friend class CallQueue;
 
+	struct ThreadSubmissions {
+		Thread::ID thread_id = Thread::UNASSIGNED_ID;
+		CallQueue *queues[2] = {};
+		std::atomic<uint32_t> write_index;
+		// Set while the thread is pushing, so merging can wait for it.
+		std::atomic<bool> writing;
+		// Set after pushing, cleared before merging. May stay set once the
+		// messages are merged, but is never clear while some are left.
+		std::atomic<bool> pending;
+		std::atomic<bool> thread_exited;
+	};
+
+	// Notifies the queue when a thread that pushed messages exits.
+	struct ThreadSubmissionsRef {
+		ThreadSubmissions *submissions = nullptr;
+		uint32_t generation = 0;
+		~ThreadSubmissionsRef();
+	};
+
+	// Marks the calling thread as pushing for as long as it exists.
+	class ThreadSubmissionScope {
+		ThreadSubmissions *submissions = nullptr;
+
+	public:
+		CallQueue *queue = nullptr;
+
+		ThreadSubmissionScope(MessageQueue *p_message_queue);
+		~ThreadSubmissionScope();
+	};
+
+	static uint32_t generation;
+	static thread_local ThreadSubmissionsRef current_thread_submissions;
+	// Set once the thread's submissions are gone, while it exits. Its messages
+	// are then pushed to the main queue directly, under its mutex. Trivially
+	// destructible, so it can still be read from then on.
+	static thread_local bool thread_submissions_destroyed;
+
+	BinaryMutex submissions_mutex;
+	LocalVector<ThreadSubmissions *> thread_submissions; // Sorted by thread ID.
+
+	uint64_t flush_usec = 0;
+
+	ThreadSubmissions *_get_thread_submissions();
+	bool _has_thread_submissions() const;
+	void _merge_thread_submissions();
+
 public:
 	_FORCE_INLINE_ static CallQueue *get_singleton() { return thread_singleton ? thread_singleton : main_singleton; }
 	_FORCE_INLINE_ static CallQueue *get_main_singleton() { return main_singleton; }
 
 	static void set_thread_singleton_override(CallQueue *p_thread_singleton);
 
+	// Messages pushed to the main queue, their size, and the time spent flushing
+	// it, since the last call.
+	static void take_statistics(uint64_t &r_messages, uint64_t &r_bytes, uint64_t &r_flush_usec);
+
 	MessageQueue();
 	~MessageQueue();
 };
@@ -44,18 +44,6 @@
 
 #ifdef DEBUG_ENABLED
 
-struct _ObjectDebugLock {
-	Object *obj;
-
-	_ObjectDebugLock(Object *p_obj) {
-		obj = p_obj;
-		obj->_lock_index.ref();
-	}
-	~_ObjectDebugLock() {
-		obj->_lock_index.unref();
-	}
-};
-
 #define OBJ_DEBUG_LOCK _ObjectDebugLock _debug_lock(this);
 
 #else
@@ -1059,7 +1047,13 @@ void Object::get_meta_list(List<StringName> *p_list) const {
 void Object::add_user_signal(const MethodInfo &p_signal) {
 	ERR_FAIL_COND_MSG(p_signal.name.is_empty(), "Signal name cannot be empty.");
 	ERR_FAIL_COND_MSG(ClassDB::has_signal(get_class_name(), p_signal.name), "User signal's name conflicts with a built-in signal of '" + get_class_name() + "'.");
-	ERR_FAIL_COND_MSG(signal_map.has(p_signal.name), "Trying to add already existing signal '" + p_signal.name + "'.");
+	SignalData *existing = signal_map.getptr(p_signal.name);
+	if (existing && existing->has_id && existing->user.name.is_empty() && existing->slot_map.is_empty() && !ClassDB::has_signal(get_class_name(), p_signal.name)) {
+		// Left by a removed user signal, reuse it so its SignalID stays valid.
+		existing->user = p_signal;
+		return;
+	}
+	ERR_FAIL_COND_MSG(existing, "Trying to add already existing signal '" + p_signal.name + "'.");
 	SignalData s;
 	s.user = p_signal;
 	signal_map[p_signal.name] = s;
@@ -1083,6 +1077,13 @@ void Object::_remove_user_signal(const StringName &p_name) {
 		}
 	}
 
+	if (s->has_id) {
+		// Keep the data a SignalID points to, emitting it just does nothing.
+		*s = SignalData();
+		s->has_id = true;
+		return;
+	}
+
 	signal_map.erase(p_name);
 }
 
@@ -1130,35 +1131,114 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 		return ERR_UNAVAILABLE;
 	}
 
-	// If this is a ref-counted object, prevent it from being destroyed during signal emission,
-	// which is needed in certain edge cases; e.g., https://github.com/godotengine/godot/issues/73889.
-	Ref<RefCounted> rc = Ref<RefCounted>(Object::cast_to<RefCounted>(this));
+	return _emit_signal_data(p_name, s, p_args, p_argcount);
+}
+
+Error Object::emit_signalp(const SignalID &p_signal, const Variant **p_args, int p_argcount) {
+	ERR_FAIL_COND_V_MSG(!p_signal.is_valid() || p_signal.object != get_instance_id(), ERR_INVALID_PARAMETER, "Can't emit signal \"" + p_signal.name + "\" with an ID that wasn't obtained from this object.");
+
+	if (_block_signals) {
+		return ERR_CANT_ACQUIRE_RESOURCE; //no emit, signals blocked
+	}
+
+	return _emit_signal_data(p_signal.name, p_signal.data, p_args, p_argcount);
+}
+
+Object::SignalID Object::get_signal_id(const StringName &p_name) {
+	SignalID id;
+
+	SignalData *s = signal_map.getptr(p_name);
+	if (!s) {
+		bool signal_is_valid = ClassDB::has_signal(get_class_name(), p_name) || (!script.is_null() && Ref<Script>(script)->has_script_signal(p_name));
+		ERR_FAIL_COND_V_MSG(!signal_is_valid, id, "Can't get the ID of non-existing signal \"" + p_name + "\".");
+		s = &signal_map[p_name];
+	}
+
+	// HashMap elements don't move, so the pointer stays valid as long as the data isn't erased.
+	s->has_id = true;
+
+	id.object = get_instance_id();
+	id.data = s;
+	id.name = p_name;
+	return id;
+}
+
+void Object::_init_emit_slot(SignalData::EmitSlot &r_slot, const Callable &p_callable, uint32_t p_flags) {
+	r_slot.callable = p_callable;
+	r_slot.flags = p_flags;
+	r_slot.target = ObjectID();
+	r_slot.target_class = StringName();
+	r_slot.method = nullptr;
+	r_slot.validated = false;
+
+	if (!p_callable.is_standard() || (p_flags & CONNECT_DEFERRED)) {
+		return;
+	}
+
+	// Resolve native methods now, if the target has no script that could override them.
+	Object *target = p_callable.get_object();
+	if (!target || target->get_script_instance() || p_callable.get_method() == CoreStringName(free_)) {
+		return;
+	}
+	MethodBind *method = ClassDB::get_method(target->get_class_name(), p_callable.get_method());
+	// Classes overriding callp() (e.g. scripts calling their static functions) may not call the bound method.
+	if (!method || ClassDB::class_overrides_callp(target->get_class_name())) {
+		return;
+	}
+
+	r_slot.target = target->get_instance_id();
+	r_slot.target_class = target->get_class_name();
+	r_slot.method = method;
+
+	// validated_call() writes the return value without converting it, and can't handle freed objects.
+	r_slot.validated = !method->is_vararg() && !method->has_return();
+	for (int i = 0; r_slot.validated && i < method->get_argument_count(); i++) {
+		r_slot.validated = method->get_argument_type(i) != Variant::OBJECT;
+	}
+}
+
+void Object::_update_emit_slots(SignalData *p_data) {
+	p_data->emit_slots.clear();
+	p_data->emit_slots.resize(p_data->slot_map.size());
+	SignalData::EmitSlot *slots = p_data->emit_slots.ptrw();
 
-	// Ensure that disconnecting the signal or even deleting the object
-	// will not affect the signal calling.
-	Callable *slot_callables = (Callable *)alloca(sizeof(Callable) * s->slot_map.size());
-	uint32_t *slot_flags = (uint32_t *)alloca(sizeof(uint32_t) * s->slot_map.size());
 	uint32_t slot_count = 0;
+	for (const KeyValue<Callable, SignalData::Slot> &slot_kv : p_data->slot_map) {
+		_init_emit_slot(slots[slot_count++], slot_kv.value.conn.callable, slot_kv.value.conn.flags);
+	}
+	p_data->emit_slots_dirty = false;
+}
 
-	for (const KeyValue<Callable, SignalData::Slot> &slot_kv : s->slot_map) {
-		memnew_placement(&slot_callables[slot_count], Callable(slot_kv.value.conn.callable));
-		slot_flags[slot_count] = slot_kv.value.conn.flags;
-		++slot_count;
+Error Object::_emit_signal_data(const StringName &p_name, SignalData *p_data, const Variant **p_args, int p_argcount) {
+	if (p_data->emit_slots_dirty) {
+		_update_emit_slots(p_data);
+	}
+	if (p_data->emit_slots.is_empty()) {
+		return OK;
 	}
 
-	DEV_ASSERT(slot_count == s->slot_map.size());
+	// If this is a ref-counted object, prevent it from being destroyed during signal emission,
+	// which is needed in certain edge cases; e.g., https://github.com/godotengine/godot/issues/73889.
+	Ref<RefCounted> rc = Ref<RefCounted>(Object::cast_to<RefCounted>(this));
+
+	// Ensure that disconnecting the signal or even deleting the object
+	// will not affect the signal calling. Connecting or disconnecting
+	// while emitting copies the array instead of changing this one.
+	const Vector<SignalData::EmitSlot> emit_slots = p_data->emit_slots;
+	const SignalData::EmitSlot *slots = emit_slots.ptr();
+	const uint32_t slot_count = emit_slots.size();
 
 	// Disconnect all one-shot connections before emitting to prevent recursion.
 	for (uint32_t i = 0; i < slot_count; ++i) {
-		bool disconnect = slot_flags[i] & CONNECT_ONE_SHOT;
+		bool disconnect = slots[i].flags & CONNECT_ONE_SHOT;
 #ifdef TOOLS_ENABLED
-		if (disconnect && (slot_flags[i] & CONNECT_PERSIST) && Engine::get_singleton()->is_editor_hint()) {
+		if (disconnect && (slots[i].flags & CONNECT_PERSIST) && Engine::get_singleton()->is_editor_hint()) {
 			// This signal was connected from the editor, and is being edited. Just don't disconnect for now.
 			disconnect = false;
 		}
 #endif
 		if (disconnect) {
-			_disconnect(p_name, slot_callables[i]);
+			_disconnect(p_name, slots[i].callable);
 		}
 	}
 
@@ -1167,47 +1247,79 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 	Error err = OK;
 
 	for (uint32_t i = 0; i < slot_count; ++i) {
-		const Callable &callable = slot_callables[i];
-		const uint32_t &flags = slot_flags[i];
-
-		if (!callable.is_valid()) {
-			// Target might have been deleted during signal callback, this is expected and OK.
-			continue;
-		}
+		const SignalData::EmitSlot &slot = slots[i];
+		const Callable &callable = slot.callable;
+		const uint32_t &flags = slot.flags;
 
 		const Variant **args = p_args;
 		int argc = p_argcount;
 
-		if (flags & CONNECT_DEFERRED) {
-			MessageQueue::get_singleton()->push_callablep(callable, args, argc, true);
+		Callable::CallError ce;
+
+		if (slot.method) {
+			Object *target = ObjectDB::get_instance(slot.target);
+			if (!target) {
+				// Target might have been deleted during signal callback, this is expected and OK.
+				continue;
+			}
+
+			if (likely(!target->get_script_instance() && target->get_class_name() == slot.target_class)) {
+				bool validated = slot.validated && argc == slot.method->get_argument_count();
+				for (int j = 0; validated && j < argc; j++) {
+					const Variant::Type type = slot.method->get_argument_type(j);
+					validated = type == Variant::NIL || type == args[j]->get_type();
+				}
+
+				_emitting = true;
+#ifdef DEBUG_ENABLED
+				_ObjectDebugLock target_lock(target);
+#endif
+				if (validated) {
+					slot.method->validated_call(target, args, nullptr);
+				} else {
+					slot.method->call(target, args, argc, ce);
+				}
+				_emitting = false;
+			} else {
+				// A script was attached since connecting, it may override the method.
+				_emitting = true;
+				Variant ret;
+				callable.callp(args, argc, ret, ce);
+				_emitting = false;
+			}
 		} else {
-			Callable::CallError ce;
+			if (!callable.is_valid()) {
+				// Target might have been deleted during signal callback, this is expected and OK.
+				continue;
+			}
+
+			if (flags & CONNECT_DEFERRED) {
+				MessageQueue::get_singleton()->push_callablep(callable, args, argc, true);
+				continue;
+			}
+
 			_emitting = true;
 			Variant ret;
 			callable.callp(args, argc, ret, ce);
 			_emitting = false;
+		}
 
-			if (ce.error != Callable::CallError::CALL_OK) {
+		if (ce.error != Callable::CallError::CALL_OK) {
 #ifdef DEBUG_ENABLED
-				if (flags & CONNECT_PERSIST && Engine::get_singleton()->is_editor_hint() && (script.is_null() || !Ref<Script>(script)->is_tool())) {
-					continue;
-				}
+			if (flags & CONNECT_PERSIST && Engine::get_singleton()->is_editor_hint() && (script.is_null() || !Ref<Script>(script)->is_tool())) {
+				continue;
+			}
 #endif
-				Object *target = callable.get_object();
-				if (ce.error == Callable::CallError::CALL_ERROR_INVALID_METHOD && target && !ClassDB::class_exists(target->get_class_name())) {
-					//most likely object is not initialized yet, do not throw error.
-				} else {
-					ERR_PRINT("Error calling from signal '" + String(p_name) + "' to callable: " + Variant::get_callable_error_text(callable, args, argc, ce) + ".");
-					err = ERR_METHOD_NOT_FOUND;
-				}
+			Object *target = callable.get_object();
+			if (ce.error == Callable::CallError::CALL_ERROR_INVALID_METHOD && target && !ClassDB::class_exists(target->get_class_name())) {
+				//most likely object is not initialized yet, do not throw error.
+			} else {
+				ERR_PRINT("Error calling from signal '" + String(p_name) + "' to callable: " + Variant::get_callable_error_text(callable, args, argc, ce) + ".");
+				err = ERR_METHOD_NOT_FOUND;
 			}
 		}
 	}
 
-	for (uint32_t i = 0; i < slot_count; ++i) {
-		slot_callables[i].~Callable();
-	}
-
 	return err;
 }
 
@@ -1370,7 +1482,8 @@ Error Object::connect(const StringName &p_signal, const Callable &p_callable, ui
 	}
 
 	SignalData *s = signal_map.getptr(p_signal);
-	if (!s) {
+	if (!s || (s->has_id && s->user.name.is_empty() && s->slot_map.is_empty())) {
+		// Data kept for a SignalID may belong to a user signal that has been removed since.
 		bool signal_is_valid = ClassDB::has_signal(get_class_name(), p_signal);
 		//check in script
 		if (!signal_is_valid && !script.is_null()) {
@@ -1389,8 +1502,10 @@ Error Object::connect(const StringName &p_signal, const Callable &p_callable, ui
 
 		ERR_FAIL_COND_V_MSG(!signal_is_valid, ERR_INVALID_PARAMETER, "In Object of type '" + String(get_class()) + "': Attempt to connect nonexistent signal '" + p_signal + "' to callable '" + p_callable + "'.");
 
-		signal_map[p_signal] = SignalData();
-		s = &signal_map[p_signal];
+		if (!s) {
+			signal_map[p_signal] = SignalData();
+			s = &signal_map[p_signal];
+		}
 	}
 
 	//compare with the base callable, so binds can be ignored
@@ -1422,6 +1537,12 @@ Error Object::connect(const StringName &p_signal, const Callable &p_callable, ui
 	//use callable version as key, so binds can be ignored
 	s->slot_map[*p_callable.get_base_comparator()] = slot;
 
+	if (!s->emit_slots_dirty) {
+		SignalData::EmitSlot emit_slot;
+		_init_emit_slot(emit_slot, p_callable, p_flags);
+		s->emit_slots.push_back(emit_slot);
+	}
+
 	return OK;
 }
 
@@ -1478,8 +1599,9 @@ bool Object::_disconnect(const StringName &p_signal, const Callable &p_callable,
 	}
 
 	s->slot_map.erase(*p_callable.get_base_comparator());
+	s->emit_slots_dirty = true;
 
-	if (s->slot_map.is_empty() && ClassDB::has_signal(get_class_name(), p_signal)) {
+	if (s->slot_map.is_empty() && !s->has_id && ClassDB::has_signal(get_class_name(), p_signal)) {
 		//not user signal, delete
 		signal_map.erase(p_signal);
 	}
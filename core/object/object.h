@@ -618,9 +618,25 @@ private:
 			List<Connection>::Element *cE = nullptr;
 		};
 
+		// A connection as called by emission. Native methods of targets without a script are
+		// resolved when connecting, so emitting calls their MethodBind directly.
+		struct EmitSlot {
+			Callable callable;
+			uint32_t flags = 0;
+			ObjectID target;
+			StringName target_class;
+			MethodBind *method = nullptr;
+			bool validated = false; // Arguments of the exact types can use validated_call().
+		};
+
 		MethodInfo user;
 		HashMap<Callable, Slot, HashableHasher<Callable>> slot_map;
+		// The connections in order. Emission iterates its own reference to the array, so it's
+		// only copied if connections change while emitting.
+		Vector<EmitSlot> emit_slots;
+		bool emit_slots_dirty = false;
 		bool removable = false;
+		bool has_id = false; // A SignalID points to this data, so it must not be erased.
 	};
 
 	HashMap<StringName, SignalData> signal_map;
@@ -646,6 +662,10 @@ private:
 	HashMap<StringName, Variant *> metadata_properties;
 	mutable const StringName *_class_name_ptr = nullptr;
 
+	static void _init_emit_slot(SignalData::EmitSlot &r_slot, const Callable &p_callable, uint32_t p_flags);
+	void _update_emit_slots(SignalData *p_data);
+	Error _emit_signal_data(const StringName &p_name, SignalData *p_data, const Variant **p_args, int p_argcount);
+
 	void _add_user_signal(const String &p_name, const Array &p_args = Array());
 	bool _has_user_signal(const StringName &p_name) const;
 	void _remove_user_signal(const StringName &p_name);
@@ -936,7 +956,34 @@ public:
 		return emit_signalp(p_name, sizeof...(p_args) == 0 ? nullptr : (const Variant **)argptrs, sizeof...(p_args));
 	}
 
+	// Handle to a signal of an object, resolved once with get_signal_id() so emitting it
+	// doesn't look the signal up by name. Valid for as long as the object exists.
+	class SignalID {
+		friend class Object;
+
+		ObjectID object;
+		SignalData *data = nullptr;
+		StringName name;
+
+	public:
+		_FORCE_INLINE_ bool is_valid() const { return data != nullptr; }
+		_FORCE_INLINE_ const StringName &get_name() const { return name; }
+	};
+
+	SignalID get_signal_id(const StringName &p_name);
+
+	template <typename... VarArgs>
+	Error emit_signal(const SignalID &p_signal, VarArgs... p_args) {
+		Variant args[sizeof...(p_args) + 1] = { p_args..., Variant() }; // +1 makes sure zero sized arrays are also supported.
+		const Variant *argptrs[sizeof...(p_args) + 1];
+		for (uint32_t i = 0; i < sizeof...(p_args); i++) {
+			argptrs[i] = &args[i];
+		}
+		return emit_signalp(p_signal, sizeof...(p_args) == 0 ? nullptr : (const Variant **)argptrs, sizeof...(p_args));
+	}
+
 	MTVIRTUAL Error emit_signalp(const StringName &p_name, const Variant **p_args, int p_argcount);
+	MTVIRTUAL Error emit_signalp(const SignalID &p_signal, const Variant **p_args, int p_argcount);
 	MTVIRTUAL bool has_signal(const StringName &p_name) const;
 	MTVIRTUAL void get_signal_list(List<MethodInfo> *p_signals) const;
 	MTVIRTUAL void get_signal_connection_list(const StringName &p_signal, List<Connection> *p_connections) const;
@@ -1006,6 +1053,23 @@ public:
 bool predelete_handler(Object *p_object);
 void postinitialize_handler(Object *p_object);
 
+#ifdef DEBUG_ENABLED
+
+// Keeps the object from being freed while one of its methods runs.
+struct _ObjectDebugLock {
+	Object *obj;
+
+	_ObjectDebugLock(Object *p_obj) {
+		obj = p_obj;
+		obj->_lock_index.ref();
+	}
+	~_ObjectDebugLock() {
+		obj->_lock_index.unref();
+	}
+};
+
+#endif
+
 class ObjectDB {
 // This needs to add up to 63, 1 bit is for reference.
 #define OBJECTDB_VALIDATOR_BITS 39
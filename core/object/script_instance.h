@@ -88,6 +88,10 @@ public:
 
 	virtual bool is_placeholder() const { return false; }
 
+	// Puts members back in the state a new instance starts in, to recycle the object (see ObjectPool).
+	// Returns false if the language can't do it, the object is then not reused.
+	virtual bool reset_members() { return false; }
+
 	virtual void property_set_fallback(const StringName &p_name, const Variant &p_value, bool *r_valid);
 	virtual Variant property_get_fallback(const StringName &p_name, bool *r_valid);
 
@@ -406,6 +406,8 @@ public:
 		uint64_t total_time;
 		uint64_t self_time;
 		uint64_t internal_time;
+		uint64_t inline_cache_hits = 0;
+		uint64_t inline_cache_misses = 0;
 	};
 
 	virtual void profiling_start() = 0;
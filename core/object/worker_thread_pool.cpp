@@ -30,6 +30,7 @@
 
 #include "worker_thread_pool.h"
 
+#include "core/debugger/trace_profiler.h"
 #include "core/object/script_language.h"
 #include "core/os/os.h"
 #include "core/os/thread_safe.h"
@@ -50,6 +51,9 @@ thread_local uintptr_t WorkerThreadPool::unlockable_mutexes[MAX_UNLOCKABLE_MUTEX
 #endif
 
 void WorkerThreadPool::_process_task(Task *p_task) {
+	TRACE_ZONE(p_task->group ? "WorkerThreadPool::group_task" : "WorkerThreadPool::task");
+	LocalVector<Task *> released; // Dependents ready to run once this task is done.
+
 #ifdef THREADS_ENABLED
 	int pool_thread_index = thread_ids[Thread::get_caller_id()];
 	ThreadData &curr_thread = threads[pool_thread_index];
@@ -89,7 +93,7 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 
 	if (p_task->group) {
 		// Handling a group
-		bool do_post = false;
+		bool do_post = p_task->group->max == 0; // Only there to wait for dependencies.
 
 		while (true) {
 			uint32_t work_index = p_task->group->index.postincrement();
@@ -118,8 +122,11 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 		}
 
 		if (do_post) {
-			p_task->group->done_semaphore.post();
+			task_mutex.lock();
 			p_task->group->completed.set_to(true);
+			_release_dependents(p_task->group->dependents, released);
+			task_mutex.unlock();
+			p_task->group->done_semaphore.post();
 		}
 		uint32_t max_users = p_task->group->tasks_used + 1; // Add 1 because the thread waiting for it is also user. Read before to avoid another thread freeing task after increment.
 		uint32_t finished_users = p_task->group->finished.increment();
@@ -158,6 +165,7 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 				threads[i].signaled = true;
 			}
 		}
+		_release_dependents(p_task->dependents, released);
 	}
 
 #ifdef THREADS_ENABLED
@@ -179,13 +187,23 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 	set_current_thread_safe_for_nodes(safe_for_nodes_backup);
 	MessageQueue::set_thread_singleton_override(call_queue_backup);
 #endif
+
+	if (!released.is_empty()) {
+		_post_dependents(released);
+	}
 }
 
 void WorkerThreadPool::_thread_function(void *p_user) {
 	ThreadData *thread_data = (ThreadData *)p_user;
+	TraceProfiler::set_thread_name("WorkerThreadPool");
 	while (true) {
-		Task *task_to_process = nullptr;
-		{
+		// Lock-free path: tasks this thread posted, then tasks other threads posted.
+		Task *task_to_process = singleton->_pop_local_task(thread_data);
+		if (!task_to_process) {
+			task_to_process = singleton->_steal_task(thread_data);
+		}
+
+		if (!task_to_process) {
 			MutexLock lock(singleton->task_mutex);
 			if (singleton->exit_threads) {
 				return;
@@ -196,8 +214,13 @@ void WorkerThreadPool::_thread_function(void *p_user) {
 				task_to_process = singleton->task_queue.first()->self();
 				singleton->task_queue.remove(singleton->task_queue.first());
 			} else {
-				thread_data->cond_var.wait(lock);
-				DEV_ASSERT(singleton->exit_threads || thread_data->signaled);
+				// Tasks are only ever posted with the mutex held, so none can
+				// show up between this last look and starting to wait.
+				task_to_process = singleton->_steal_task(thread_data);
+				if (!task_to_process) {
+					thread_data->cond_var.wait(lock);
+					DEV_ASSERT(singleton->exit_threads || thread_data->signaled);
+				}
 			}
 		}
 
@@ -228,7 +251,11 @@ void WorkerThreadPool::_post_tasks_and_unlock(Task **p_tasks, uint32_t p_count,
 	for (uint32_t i = 0; i < p_count; i++) {
 		p_tasks[i]->low_priority = !p_high_priority;
 		if (p_high_priority || low_priority_threads_used < max_low_priority_threads) {
-			task_queue.add_last(&p_tasks[i]->task_elem);
+			// Tasks posted from a pool thread go to its own queue, so that thread
+			// picks them up first and others can steal them without locking.
+			if (!caller_pool_thread || !caller_pool_thread->work_queue.push(p_tasks[i])) {
+				task_queue.add_last(&p_tasks[i]->task_elem);
+			}
 			if (!p_high_priority) {
 				low_priority_threads_used++;
 			}
@@ -309,6 +336,81 @@ void WorkerThreadPool::_notify_threads(const ThreadData *p_current_thread_data,
 	}
 }
 
+WorkerThreadPool::Task *WorkerThreadPool::_pop_local_task(ThreadData *p_thread) {
+	Task *task = nullptr;
+	return p_thread->work_queue.pop(task) ? task : nullptr;
+}
+
+WorkerThreadPool::Task *WorkerThreadPool::_steal_task(ThreadData *p_thief) {
+	const uint32_t thread_count = threads.size();
+	for (uint32_t i = 1; i < thread_count; i++) {
+		ThreadData &victim = threads[(p_thief->index + i) % thread_count];
+		// A failed steal may just mean another thread won the race for that
+		// element, so keep trying while there's anything left.
+		while (!victim.work_queue.is_empty()) {
+			Task *task = nullptr;
+			if (victim.work_queue.steal(task)) {
+				return task;
+			}
+		}
+	}
+	return nullptr;
+}
+
+uint32_t WorkerThreadPool::_add_dependencies(Task *p_dependent, const TaskID *p_dependencies, uint32_t p_dependency_count) {
+	// Task and group IDs come from the same counter, so either can be a dependency.
+	uint32_t pending = 0;
+	for (uint32_t i = 0; i < p_dependency_count; i++) {
+		const TaskID id = p_dependencies[i];
+		Task **taskp = tasks.getptr(id);
+		if (taskp) {
+			if (!(*taskp)->completed) {
+				(*taskp)->dependents.push_back(p_dependent);
+				pending++;
+			}
+			continue;
+		}
+		Group **groupp = groups.getptr(id);
+		if (groupp) {
+			if (!(*groupp)->completed.is_set()) {
+				(*groupp)->dependents.push_back(p_dependent);
+				pending++;
+			}
+			continue;
+		}
+		// Otherwise it has already been waited on, so it's complete.
+		ERR_CONTINUE_MSG(id <= 0 || id >= (TaskID)last_task, vformat("Invalid task or group ID as dependency: %d.", id));
+	}
+	p_dependent->dependencies_pending = pending;
+	return pending;
+}
+
+void WorkerThreadPool::_release_dependents(LocalVector<Task *> &p_dependents, LocalVector<Task *> &r_released) {
+	for (Task *dependent : p_dependents) {
+		DEV_ASSERT(dependent->dependencies_pending > 0);
+		dependent->dependencies_pending--;
+		if (dependent->dependencies_pending == 0) {
+			r_released.push_back(dependent);
+		}
+	}
+	p_dependents.clear();
+}
+
+void WorkerThreadPool::_post_dependents(const LocalVector<Task *> &p_dependents) {
+	for (Task *task : p_dependents) {
+		task_mutex.lock();
+		const bool high_priority = !task->low_priority; // As requested when it was added.
+		if (task->group) {
+			// A group is represented by its first task in dependency lists.
+			LocalVector<Task *> group_tasks = task->group->parked_tasks;
+			task->group->parked_tasks.clear();
+			_post_tasks_and_unlock(group_tasks.ptr(), group_tasks.size(), high_priority);
+		} else {
+			_post_tasks_and_unlock(&task, 1, high_priority);
+		}
+	}
+}
+
 bool WorkerThreadPool::_try_promote_low_priority_task() {
 	if (low_priority_task_queue.first()) {
 		Task *low_prio_task = low_priority_task_queue.first()->self();
@@ -325,7 +427,11 @@ WorkerThreadPool::TaskID WorkerThreadPool::add_native_task(void (*p_func)(void *
 	return _add_task(Callable(), p_func, p_userdata, nullptr, p_high_priority, p_description);
 }
 
-WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description) {
+WorkerThreadPool::TaskID WorkerThreadPool::add_native_task_after(const Vector<TaskID> &p_dependencies, void (*p_func)(void *), void *p_userdata, bool p_high_priority, const String &p_description) {
+	return _add_task(Callable(), p_func, p_userdata, nullptr, p_high_priority, p_description, p_dependencies.ptr(), p_dependencies.size());
+}
+
+WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description, const TaskID *p_dependencies, uint32_t p_dependency_count) {
 	task_mutex.lock();
 	// Get a free task
 	Task *task = task_allocator.alloc();
@@ -338,6 +444,13 @@ WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable,
 	task->template_userdata = p_template_userdata;
 	tasks.insert(id, task);
 
+	if (p_dependency_count && _add_dependencies(task, p_dependencies, p_dependency_count)) {
+		// Posted by whichever dependency completes last.
+		task->low_priority = !p_high_priority;
+		task_mutex.unlock();
+		return id;
+	}
+
 	_post_tasks_and_unlock(&task, 1, p_high_priority);
 
 	return id;
@@ -491,10 +604,15 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 					}
 				}
 
-				if (singleton->task_queue.first()) {
+				// Own queue first, as it likely holds what's being waited for.
+				task_to_process = _pop_local_task(p_caller_pool_thread);
+				if (!task_to_process && task_queue.first()) {
 					task_to_process = task_queue.first()->self();
 					task_queue.remove(task_queue.first());
 				}
+				if (!task_to_process) {
+					task_to_process = _steal_task(p_caller_pool_thread);
+				}
 
 				if (!task_to_process) {
 					p_caller_pool_thread->awaited_task = p_task;
@@ -550,7 +668,7 @@ void WorkerThreadPool::notify_yield_over(TaskID p_task_id) {
 	task_mutex.unlock();
 }
 
-WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description) {
+WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description, const TaskID *p_dependencies, uint32_t p_dependency_count) {
 	ERR_FAIL_COND_V(p_elements < 0, INVALID_TASK_ID);
 	if (p_tasks < 0) {
 		p_tasks = MAX(1u, threads.size());
@@ -562,13 +680,18 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 	group->max = p_elements;
 	group->self = id;
 
-	Task **tasks_posted = nullptr;
 	if (p_elements == 0) {
 		// Should really not call it with zero Elements, but at least it should work.
+		// With dependencies, a single task without elements still has to wait
+		// for them before completing the group.
+		p_tasks = p_dependency_count ? 1 : 0;
+	}
+
+	Task **tasks_posted = nullptr;
+	if (p_tasks == 0) {
 		group->completed.set_to(true);
 		group->done_semaphore.post();
 		group->tasks_used = 0;
-		p_tasks = 0;
 		if (p_template_userdata) {
 			memdelete(p_template_userdata);
 		}
@@ -591,6 +714,16 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 
 	groups[id] = group;
 
+	if (p_tasks > 0 && p_dependency_count && _add_dependencies(tasks_posted[0], p_dependencies, p_dependency_count)) {
+		// The first task stands for the whole group in dependency lists.
+		tasks_posted[0]->low_priority = !p_high_priority;
+		for (int i = 0; i < p_tasks; i++) {
+			group->parked_tasks.push_back(tasks_posted[i]);
+		}
+		task_mutex.unlock();
+		return id;
+	}
+
 	_post_tasks_and_unlock(tasks_posted, p_tasks, p_high_priority);
 
 	return id;
@@ -600,6 +733,10 @@ WorkerThreadPool::GroupID WorkerThreadPool::add_native_group_task(void (*p_func)
 	return _add_group_task(Callable(), p_func, p_userdata, nullptr, p_elements, p_tasks, p_high_priority, p_description);
 }
 
+WorkerThreadPool::GroupID WorkerThreadPool::add_native_group_task_after(const Vector<TaskID> &p_dependencies, void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description) {
+	return _add_group_task(Callable(), p_func, p_userdata, nullptr, p_elements, p_tasks, p_high_priority, p_description, p_dependencies.ptr(), p_dependencies.size());
+}
+
 WorkerThreadPool::GroupID WorkerThreadPool::add_group_task(const Callable &p_action, int p_elements, int p_tasks, bool p_high_priority, const String &p_description) {
 	return _add_group_task(p_action, nullptr, nullptr, nullptr, p_elements, p_tasks, p_high_priority, p_description);
 }
@@ -643,6 +780,12 @@ void WorkerThreadPool::wait_for_group_task_completion(GroupID p_group) {
 		group->done_semaphore.wait();
 		_lock_unlockable_mutexes();
 
+		// Unregister before the group can be freed, so that adding a task depending
+		// on it never finds a dangling pointer.
+		task_mutex.lock(); // This mutex is needed when Physics 2D and/or 3D is selected to run on a separate thread.
+		groups.erase(p_group);
+		task_mutex.unlock();
+
 		uint32_t max_users = group->tasks_used + 1; // Add 1 because the thread waiting for it is also user. Read before to avoid another thread freeing task after increment.
 		uint32_t finished_users = group->finished.increment(); // fetch happens before inc, so increment later.
 
@@ -653,10 +796,6 @@ void WorkerThreadPool::wait_for_group_task_completion(GroupID p_group) {
 			task_mutex.unlock();
 		}
 	}
-
-	task_mutex.lock(); // This mutex is needed when Physics 2D and/or 3D is selected to run on a separate thread.
-	groups.erase(p_group);
-	task_mutex.unlock();
 #endif
 }
 
@@ -747,9 +886,12 @@ void WorkerThreadPool::finish() {
 		for (KeyValue<TaskID, Task *> &E : tasks) {
 			task_allocator.free(E.value);
 		}
+		tasks.clear();
 	}
 
 	threads.clear();
+	thread_ids.clear();
+	exit_threads = false; // Allows calling init() again.
 }
 
 void WorkerThreadPool::_bind_methods() {
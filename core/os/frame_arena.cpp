@@ -0,0 +1,185 @@
+/**************************************************************************/
+/*  frame_arena.cpp                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "frame_arena.h"
+
+#include "core/error/error_macros.h"
+
+#include <string.h>
+
+SafeNumeric<uint64_t> FrameArena::frame;
+thread_local FrameArena::ThreadArena FrameArena::thread_arena;
+
+void FrameArena::ThreadArena::rewind() {
+	if (current == nullptr) {
+		return;
+	}
+
+	if (current->prev) {
+		// The last frame overflowed the first chunk; merge everything into a
+		// single chunk (allocated lazily) big enough to hold it all next time.
+		size_t total = 0;
+		while (current) {
+			Chunk *prev = current->prev;
+			total += current->size;
+			Memory::free_static(current);
+			current = prev;
+		}
+		reserve_size = total;
+	} else {
+		current->used = 0;
+	}
+
+	last_alloc = nullptr;
+}
+
+void FrameArena::ThreadArena::release() {
+	while (current) {
+		Chunk *prev = current->prev;
+		Memory::free_static(current);
+		current = prev;
+	}
+	last_alloc = nullptr;
+	reserve_size = 0;
+}
+
+FrameArena::ThreadArena::~ThreadArena() {
+	release();
+}
+
+FrameArena::ThreadArena &FrameArena::_get_thread_arena() {
+	ThreadArena &arena = thread_arena;
+	const uint64_t current_frame = frame.get();
+	if (unlikely(arena.frame != current_frame)) {
+		arena.rewind();
+		arena.frame = current_frame;
+	}
+	return arena;
+}
+
+void *FrameArena::_alloc_chunk(ThreadArena &p_arena, size_t p_bytes) {
+	size_t size = MAX(MAX(MIN_CHUNK_SIZE, p_arena.reserve_size), p_bytes);
+	if (p_arena.current) {
+		size = MAX(size, p_arena.current->size * 2);
+	}
+
+	Chunk *chunk = (Chunk *)Memory::alloc_static(CHUNK_HEADER_SIZE + size);
+	ERR_FAIL_NULL_V(chunk, nullptr);
+	chunk->prev = p_arena.current;
+	chunk->size = size;
+	chunk->used = p_bytes;
+
+	p_arena.current = chunk;
+	p_arena.reserve_size = 0;
+	p_arena.last_alloc = _chunk_data(chunk);
+	return p_arena.last_alloc;
+}
+
+void *FrameArena::alloc(size_t p_bytes) {
+	ThreadArena &arena = _get_thread_arena();
+	const size_t bytes = _align(MAX(p_bytes, (size_t)1));
+
+	Chunk *chunk = arena.current;
+	if (unlikely(chunk == nullptr || chunk->size - chunk->used < bytes)) {
+		return _alloc_chunk(arena, bytes);
+	}
+
+	uint8_t *mem = _chunk_data(chunk) + chunk->used;
+	chunk->used += bytes;
+	arena.last_alloc = mem;
+	return mem;
+}
+
+void *FrameArena::realloc(void *p_memory, size_t p_bytes) {
+	if (p_memory == nullptr) {
+		return alloc(p_bytes);
+	}
+	if (p_bytes == 0) {
+		return nullptr;
+	}
+
+	ThreadArena &arena = thread_arena;
+	ERR_FAIL_COND_V_MSG(arena.frame != frame.get(), nullptr, "Reallocating frame arena memory from a previous frame.");
+
+	uint8_t *mem = (uint8_t *)p_memory;
+	const size_t bytes = _align(p_bytes);
+
+	// Locate the chunk holding the allocation. Allocations don't store their
+	// size, but none can extend past the used part of its chunk, which bounds
+	// how much needs to be copied.
+	Chunk *chunk = arena.current;
+	while (chunk && (mem < _chunk_data(chunk) || mem >= _chunk_data(chunk) + chunk->used)) {
+		chunk = chunk->prev;
+	}
+	ERR_FAIL_NULL_V_MSG(chunk, nullptr, "Reallocating memory that doesn't belong to this thread's frame arena.");
+
+	const size_t offset = mem - _chunk_data(chunk);
+	if (mem == arena.last_alloc && chunk == arena.current && offset + bytes <= chunk->size) {
+		// Most recent allocation, grow or shrink in place.
+		chunk->used = offset + bytes;
+		return mem;
+	}
+
+	const size_t available = chunk->used - offset;
+	uint8_t *new_mem = (uint8_t *)alloc(p_bytes);
+	ERR_FAIL_NULL_V(new_mem, nullptr);
+	memcpy(new_mem, mem, MIN(available, p_bytes));
+	return new_mem;
+}
+
+void FrameArena::advance_frame() {
+	frame.increment();
+}
+
+uint64_t FrameArena::get_frame() {
+	return frame.get();
+}
+
+size_t FrameArena::get_thread_used_bytes() {
+	ThreadArena &arena = _get_thread_arena();
+	size_t used = 0;
+	for (Chunk *chunk = arena.current; chunk; chunk = chunk->prev) {
+		used += chunk->used;
+	}
+	return used;
+}
+
+size_t FrameArena::get_thread_capacity_bytes() {
+	ThreadArena &arena = _get_thread_arena();
+	size_t capacity = 0;
+	for (Chunk *chunk = arena.current; chunk; chunk = chunk->prev) {
+		capacity += chunk->size;
+	}
+	return capacity;
+}
+
+void FrameArena::release_thread() {
+	thread_arena.release();
+}
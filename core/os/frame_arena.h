@@ -0,0 +1,113 @@
+/**************************************************************************/
+/*  frame_arena.h                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef FRAME_ARENA_H
+#define FRAME_ARENA_H
+
+#include "core/os/memory.h"
+#include "core/templates/safe_refcount.h"
+
+// Thread-local bump allocator for scratch data that lives at most one frame.
+//
+// Each thread owns its own arena, so allocating never takes a lock nor touches
+// the global heap once the arena is warm. Memory is never freed individually;
+// instead, the arena of every thread is rewound the first time it is used after
+// `advance_frame()` (called once per frame by `Main::iteration()`). If a frame
+// needed more than one chunk, the chunks are coalesced into a single larger one
+// on rewind, so steady-state frames perform no system allocations at all.
+//
+// Rules of use:
+// - Memory obtained from the arena is only valid until the end of the current frame.
+//   Tasks that may span several frames must not use it.
+// - `realloc()` must happen on the thread that did the original allocation.
+//
+// `FrameArena` satisfies the static allocator interface used by `List`, `RBMap`,
+// `RBSet`, `LocalVector` and `PagedAllocator`, and `FrameTypedAllocator` the one
+// used by `HashMap`, so those containers can be backed by it directly, e.g.
+// `LocalVector<Instance *, uint32_t, false, false, FrameArena>`.
+class FrameArena {
+public:
+	static constexpr size_t ALIGNMENT = alignof(max_align_t);
+	static constexpr size_t MIN_CHUNK_SIZE = 64 * 1024;
+
+private:
+	struct Chunk {
+		Chunk *prev = nullptr;
+		size_t size = 0; // Usable bytes, not counting the header.
+		size_t used = 0;
+	};
+
+	static constexpr size_t CHUNK_HEADER_SIZE = (sizeof(Chunk) + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+
+	struct ThreadArena {
+		Chunk *current = nullptr;
+		uint8_t *last_alloc = nullptr;
+		size_t reserve_size = 0;
+		uint64_t frame = 0;
+
+		void rewind();
+		void release();
+		~ThreadArena();
+	};
+
+	static SafeNumeric<uint64_t> frame;
+	static thread_local ThreadArena thread_arena;
+
+	_FORCE_INLINE_ static size_t _align(size_t p_bytes) { return (p_bytes + ALIGNMENT - 1) & ~(ALIGNMENT - 1); }
+	_FORCE_INLINE_ static uint8_t *_chunk_data(Chunk *p_chunk) { return (uint8_t *)p_chunk + CHUNK_HEADER_SIZE; }
+
+	static ThreadArena &_get_thread_arena();
+	static void *_alloc_chunk(ThreadArena &p_arena, size_t p_bytes);
+
+public:
+	static void *alloc(size_t p_bytes);
+	static void *realloc(void *p_memory, size_t p_bytes);
+	_FORCE_INLINE_ static void free(void *p_memory) {} // Reclaimed as a whole when the frame advances.
+
+	static void advance_frame();
+	static uint64_t get_frame();
+
+	// Statistics for the calling thread.
+	static size_t get_thread_used_bytes();
+	static size_t get_thread_capacity_bytes();
+
+	// Returns all the memory held by the calling thread's arena to the system heap.
+	static void release_thread();
+};
+
+template <typename T>
+class FrameTypedAllocator {
+public:
+	template <typename... Args>
+	_FORCE_INLINE_ T *new_allocation(const Args &&...p_args) { return memnew_allocator(T(p_args...), FrameArena); }
+	_FORCE_INLINE_ void delete_allocation(T *p_allocation) { memdelete_allocator<T, FrameArena>(p_allocation); }
+};
+
+#endif // FRAME_ARENA_H
@@ -48,7 +48,11 @@ class StringName {
 	enum {
 		STRING_TABLE_BITS = 16,
 		STRING_TABLE_LEN = 1 << STRING_TABLE_BITS,
-		STRING_TABLE_MASK = STRING_TABLE_LEN - 1
+		STRING_TABLE_MASK = STRING_TABLE_LEN - 1,
+		// Buckets are interleaved across shards, each with its own lock for insertion and removal.
+		STRING_SHARD_BITS = 6,
+		STRING_SHARD_LEN = 1 << STRING_SHARD_BITS,
+		STRING_SHARD_MASK = STRING_SHARD_LEN - 1
 	};
 
 	struct _Data {
@@ -57,32 +61,40 @@ class StringName {
 		const char *cname = nullptr;
 		String name;
 #ifdef DEBUG_ENABLED
-		uint32_t debug_references = 0;
+		SafeNumeric<uint32_t> debug_references;
 #endif
 		String get_name() const { return cname ? String(cname) : name; }
 		int idx = 0;
 		uint32_t hash = 0;
-		_Data *prev = nullptr;
-		_Data *next = nullptr;
+		_Data *prev = nullptr; // Only accessed with the shard locked.
+		std::atomic<_Data *> next = nullptr; // Also followed by lockless lookups.
 		_Data() {}
 	};
 
-	static _Data *_table[STRING_TABLE_LEN];
+	struct Shard;
+
+	static std::atomic<_Data *> _table[STRING_TABLE_LEN];
+	static Shard shards[STRING_SHARD_LEN];
 
 	_Data *_data = nullptr;
 
+	template <typename T>
+	static _Data *_find_and_ref(uint32_t p_hash, const T &p_name);
+	template <typename T>
+	static _Data *_intern(uint32_t p_hash, const T &p_name, const char *p_cname, bool p_static);
+	static void _free_retired(Shard &p_shard);
+
 	void unref();
 	friend void register_core_types();
 	friend void unregister_core_types();
 	friend class Main;
-	static Mutex mutex;
 	static void setup();
 	static void cleanup();
 	static bool configured;
 #ifdef DEBUG_ENABLED
 	struct DebugSortReferences {
 		bool operator()(const _Data *p_left, const _Data *p_right) const {
-			return p_left->debug_references > p_right->debug_references;
+			return p_left->debug_references.get() > p_right->debug_references.get();
 		}
 	};
 
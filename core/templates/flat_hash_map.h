@@ -0,0 +1,589 @@
+/**************************************************************************/
+/*  flat_hash_map.h                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef FLAT_HASH_MAP_H
+#define FLAT_HASH_MAP_H
+
+#include "core/os/memory.h"
+#include "core/templates/hashfuncs.h"
+#include "core/templates/pair.h"
+
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FLAT_HASH_MAP_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define FLAT_HASH_MAP_NEON
+#include <arm_neon.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+/**
+ * A HashMap implementation storing keys and values inline in a single flat
+ * array, in the spirit of Swiss tables.
+ *
+ * Alongside the slots, a control byte per slot stores either the 7 low bits of
+ * the key's hash or an empty/deleted marker. Lookups probe groups of control
+ * bytes at once (16 with SSE2, 8 with NEON or the portable fallback), and only
+ * compare keys whose hash bits match, so most probes never touch the slots.
+ * Erasing leaves a tombstone, so iterators and pointers to other entries stay
+ * valid; they are invalidated by insertions that make the table grow.
+ *
+ * Unlike HashMap, iteration order is unspecified. Use this when insertion
+ * order doesn't matter and the map is hot on lookups, or when saving an
+ * allocation per insertion matters.
+ */
+
+struct FlatHashMapGroup {
+	static constexpr int8_t CTRL_EMPTY = -128; // 0b10000000
+	static constexpr int8_t CTRL_DELETED = -2; // 0b11111110
+
+#if defined(FLAT_HASH_MAP_SSE2)
+	// One bit per slot.
+	static constexpr uint32_t WIDTH = 16;
+	static constexpr uint32_t SHIFT = 0;
+
+	__m128i ctrl;
+
+	_FORCE_INLINE_ explicit FlatHashMapGroup(const int8_t *p_ctrl) {
+		ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p_ctrl));
+	}
+	_FORCE_INLINE_ uint64_t match(int8_t p_h2) const {
+		return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(p_h2), ctrl));
+	}
+	_FORCE_INLINE_ uint64_t match_empty() const {
+		return match(CTRL_EMPTY);
+	}
+	_FORCE_INLINE_ uint64_t match_empty_or_deleted() const {
+		// Only the markers have the sign bit set.
+		return (uint32_t)_mm_movemask_epi8(ctrl);
+	}
+#elif defined(FLAT_HASH_MAP_NEON)
+	// Top bit of one byte per slot.
+	static constexpr uint32_t WIDTH = 8;
+	static constexpr uint32_t SHIFT = 3;
+	static constexpr uint64_t MSBS = 0x8080808080808080ull;
+
+	int8x8_t ctrl;
+
+	_FORCE_INLINE_ explicit FlatHashMapGroup(const int8_t *p_ctrl) {
+		ctrl = vld1_s8(p_ctrl);
+	}
+	_FORCE_INLINE_ uint64_t match(int8_t p_h2) const {
+		return vget_lane_u64(vreinterpret_u64_u8(vceq_s8(ctrl, vdup_n_s8(p_h2))), 0) & MSBS;
+	}
+	_FORCE_INLINE_ uint64_t match_empty() const {
+		return match(CTRL_EMPTY);
+	}
+	_FORCE_INLINE_ uint64_t match_empty_or_deleted() const {
+		return vget_lane_u64(vreinterpret_u64_s8(ctrl), 0) & MSBS;
+	}
+#else
+	// Portable SWAR fallback, top bit of one byte per slot.
+	static constexpr uint32_t WIDTH = 8;
+	static constexpr uint32_t SHIFT = 3;
+	static constexpr uint64_t LSBS = 0x0101010101010101ull;
+	static constexpr uint64_t MSBS = 0x8080808080808080ull;
+
+	uint64_t ctrl = 0;
+
+	_FORCE_INLINE_ explicit FlatHashMapGroup(const int8_t *p_ctrl) {
+		// Assembled byte by byte so slot order doesn't depend on endianness.
+		for (uint32_t i = 0; i < WIDTH; i++) {
+			ctrl |= uint64_t((uint8_t)p_ctrl[i]) << (i * 8);
+		}
+	}
+	_FORCE_INLINE_ uint64_t match(int8_t p_h2) const {
+		// May report false positives, which are filtered out when comparing keys.
+		const uint64_t x = ctrl ^ (LSBS * (uint8_t)p_h2);
+		return (x - LSBS) & ~x & MSBS;
+	}
+	_FORCE_INLINE_ uint64_t match_empty() const {
+		// Empty is the only marker with the second lowest bit clear.
+		return ctrl & ~(ctrl << 6) & MSBS;
+	}
+	_FORCE_INLINE_ uint64_t match_empty_or_deleted() const {
+		return ctrl & MSBS;
+	}
+#endif
+
+	static _FORCE_INLINE_ uint32_t lowest(uint64_t p_mask) {
+#if defined(__GNUC__)
+		return (uint32_t)__builtin_ctzll(p_mask) >> SHIFT;
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+		unsigned long index;
+		_BitScanForward64(&index, p_mask);
+		return (uint32_t)index >> SHIFT;
+#else
+		uint32_t index = 0;
+		while (!(p_mask & 1)) {
+			p_mask >>= 1;
+			index++;
+		}
+		return index >> SHIFT;
+#endif
+	}
+};
+
+template <typename TKey, typename TValue,
+		typename Hasher = HashMapHasherDefault,
+		typename Comparator = HashMapComparatorDefault<TKey>>
+class FlatHashMap {
+public:
+	static constexpr uint32_t GROUP_WIDTH = FlatHashMapGroup::WIDTH;
+	static constexpr uint32_t MIN_CAPACITY = 16; // Power of 2, at least a group.
+
+private:
+	typedef KeyValue<TKey, TValue> Slot;
+
+	// capacity + GROUP_WIDTH bytes. The first group is mirrored past the end,
+	// so a group can be loaded starting at any slot without wrapping.
+	int8_t *ctrl = nullptr;
+	Slot *slots = nullptr;
+	uint32_t capacity = 0;
+	uint32_t num_elements = 0;
+	uint32_t growth_left = 0;
+
+	static _FORCE_INLINE_ uint32_t _hash(const TKey &p_key) {
+		// Probing relies on both the low and high bits, so mix in case the hasher is weak.
+		return hash_fmix32(Hasher::hash(p_key));
+	}
+	static _FORCE_INLINE_ int8_t _h2(uint32_t p_hash) { return (int8_t)(p_hash & 0x7F); }
+	static _FORCE_INLINE_ uint32_t _max_load(uint32_t p_capacity) { return p_capacity - p_capacity / 8; }
+
+	_FORCE_INLINE_ void _set_ctrl(uint32_t p_pos, int8_t p_value) {
+		ctrl[p_pos] = p_value;
+		if (p_pos < GROUP_WIDTH) {
+			ctrl[capacity + p_pos] = p_value;
+		}
+	}
+
+	bool _lookup_pos(const TKey &p_key, uint32_t &r_pos) const {
+		if (num_elements == 0) {
+			return false;
+		}
+
+		const uint32_t hash = _hash(p_key);
+		const int8_t h2 = _h2(hash);
+		const uint32_t mask = capacity - 1;
+		uint32_t pos = (hash >> 7) & mask;
+		uint32_t step = 0;
+
+		while (true) {
+			const FlatHashMapGroup group(ctrl + pos);
+			for (uint64_t match = group.match(h2); match; match &= match - 1) {
+				const uint32_t index = (pos + FlatHashMapGroup::lowest(match)) & mask;
+				if (Comparator::compare(slots[index].key, p_key)) {
+					r_pos = index;
+					return true;
+				}
+			}
+			if (group.match_empty()) {
+				return false;
+			}
+			// Triangular probing over groups visits every group once for power of 2 capacities.
+			step += GROUP_WIDTH;
+			pos = (pos + step) & mask;
+		}
+	}
+
+	uint32_t _find_free(uint32_t p_hash) const {
+		const uint32_t mask = capacity - 1;
+		uint32_t pos = (p_hash >> 7) & mask;
+		uint32_t step = 0;
+
+		while (true) {
+			const uint64_t match = FlatHashMapGroup(ctrl + pos).match_empty_or_deleted();
+			if (match) {
+				return (pos + FlatHashMapGroup::lowest(match)) & mask;
+			}
+			step += GROUP_WIDTH;
+			pos = (pos + step) & mask;
+		}
+	}
+
+	void _resize_and_rehash(uint32_t p_new_capacity) {
+		int8_t *old_ctrl = ctrl;
+		Slot *old_slots = slots;
+		const uint32_t old_capacity = capacity;
+
+		capacity = p_new_capacity;
+		ctrl = reinterpret_cast<int8_t *>(Memory::alloc_static(capacity + GROUP_WIDTH));
+		slots = reinterpret_cast<Slot *>(Memory::alloc_static(sizeof(Slot) * capacity));
+		memset(ctrl, FlatHashMapGroup::CTRL_EMPTY, capacity + GROUP_WIDTH);
+		growth_left = _max_load(capacity) - num_elements;
+
+		if (old_ctrl == nullptr) {
+			return;
+		}
+
+		for (uint32_t i = 0; i < old_capacity; i++) {
+			if (old_ctrl[i] < 0) {
+				continue;
+			}
+			const uint32_t hash = _hash(old_slots[i].key);
+			const uint32_t pos = _find_free(hash);
+			_set_ctrl(pos, _h2(hash));
+			memnew_placement(&slots[pos], Slot(old_slots[i]));
+			old_slots[i].~Slot();
+		}
+
+		Memory::free_static(old_ctrl);
+		Memory::free_static(old_slots);
+	}
+
+	void _grow() {
+		if (capacity == 0) {
+			_resize_and_rehash(MIN_CAPACITY);
+		} else if (num_elements < _max_load(capacity) / 2) {
+			// Mostly tombstones, rehashing at the same size is enough.
+			_resize_and_rehash(capacity);
+		} else {
+			ERR_FAIL_COND_MSG(capacity >= (1u << 31), "Hash table maximum capacity reached, aborting insertion.");
+			_resize_and_rehash(capacity * 2);
+		}
+	}
+
+	Slot *_insert(const TKey &p_key, const TValue &p_value) {
+		uint32_t pos = 0;
+		if (_lookup_pos(p_key, pos)) {
+			slots[pos].value = p_value;
+			return &slots[pos];
+		}
+
+		if (unlikely(growth_left == 0)) {
+			_grow();
+			ERR_FAIL_COND_V(growth_left == 0, nullptr);
+		}
+
+		const uint32_t hash = _hash(p_key);
+		pos = _find_free(hash);
+		if (ctrl[pos] == FlatHashMapGroup::CTRL_EMPTY) {
+			growth_left--; // Reusing a tombstone doesn't shorten any probe sequence.
+		}
+		_set_ctrl(pos, _h2(hash));
+		memnew_placement(&slots[pos], Slot(p_key, p_value));
+		num_elements++;
+		return &slots[pos];
+	}
+
+	void _erase_pos(uint32_t p_pos) {
+		slots[p_pos].~Slot();
+		num_elements--;
+		if (num_elements == 0) {
+			// Drop all tombstones while it's free to do so.
+			memset(ctrl, FlatHashMapGroup::CTRL_EMPTY, capacity + GROUP_WIDTH);
+			growth_left = _max_load(capacity);
+		} else {
+			_set_ctrl(p_pos, FlatHashMapGroup::CTRL_DELETED);
+		}
+	}
+
+	void _destroy_slots() {
+		if constexpr (!std::is_trivially_destructible_v<Slot>) {
+			for (uint32_t i = 0; i < capacity && num_elements > 0; i++) {
+				if (ctrl[i] >= 0) {
+					slots[i].~Slot();
+					num_elements--;
+				}
+			}
+		}
+		num_elements = 0;
+	}
+
+public:
+	_FORCE_INLINE_ uint32_t get_capacity() const { return capacity; }
+	_FORCE_INLINE_ uint32_t size() const { return num_elements; }
+
+	/* Standard Godot Container API */
+
+	bool is_empty() const {
+		return num_elements == 0;
+	}
+
+	void clear() {
+		if (num_elements == 0) {
+			return;
+		}
+		_destroy_slots();
+		memset(ctrl, FlatHashMapGroup::CTRL_EMPTY, capacity + GROUP_WIDTH);
+		growth_left = _max_load(capacity);
+	}
+
+	// Clears and releases the storage.
+	void reset() {
+		_destroy_slots();
+		if (ctrl != nullptr) {
+			Memory::free_static(ctrl);
+			Memory::free_static(slots);
+			ctrl = nullptr;
+			slots = nullptr;
+		}
+		capacity = 0;
+		growth_left = 0;
+	}
+
+	TValue &get(const TKey &p_key) {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+		CRASH_COND_MSG(!exists, "FlatHashMap key not found.");
+		return slots[pos].value;
+	}
+
+	const TValue &get(const TKey &p_key) const {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+		CRASH_COND_MSG(!exists, "FlatHashMap key not found.");
+		return slots[pos].value;
+	}
+
+	const TValue *getptr(const TKey &p_key) const {
+		uint32_t pos = 0;
+		if (_lookup_pos(p_key, pos)) {
+			return &slots[pos].value;
+		}
+		return nullptr;
+	}
+
+	TValue *getptr(const TKey &p_key) {
+		uint32_t pos = 0;
+		if (_lookup_pos(p_key, pos)) {
+			return &slots[pos].value;
+		}
+		return nullptr;
+	}
+
+	_FORCE_INLINE_ bool has(const TKey &p_key) const {
+		uint32_t _pos = 0;
+		return _lookup_pos(p_key, _pos);
+	}
+
+	bool erase(const TKey &p_key) {
+		uint32_t pos = 0;
+		if (!_lookup_pos(p_key, pos)) {
+			return false;
+		}
+		_erase_pos(pos);
+		return true;
+	}
+
+	// Reserves space for a number of elements, useful to avoid many resizes and rehashes.
+	void reserve(uint32_t p_new_capacity) {
+		if (p_new_capacity == 0 || (capacity > 0 && _max_load(capacity) >= p_new_capacity)) {
+			return;
+		}
+		uint32_t new_capacity = MAX(capacity, MIN_CAPACITY);
+		while (_max_load(new_capacity) < p_new_capacity) {
+			ERR_FAIL_COND_MSG(new_capacity >= (1u << 31), "Hash table maximum capacity reached.");
+			new_capacity *= 2;
+		}
+		if (new_capacity != capacity) {
+			_resize_and_rehash(new_capacity);
+		}
+	}
+
+	/** Iterator API **/
+
+	struct ConstIterator {
+		_FORCE_INLINE_ const KeyValue<TKey, TValue> &operator*() const {
+			return slots[pos];
+		}
+		_FORCE_INLINE_ const KeyValue<TKey, TValue> *operator->() const { return &slots[pos]; }
+		_FORCE_INLINE_ ConstIterator &operator++() {
+			pos++;
+			_skip_free();
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const ConstIterator &b) const { return pos == b.pos; }
+		_FORCE_INLINE_ bool operator!=(const ConstIterator &b) const { return pos != b.pos; }
+
+		_FORCE_INLINE_ explicit operator bool() const {
+			return pos < capacity;
+		}
+
+		_FORCE_INLINE_ ConstIterator(const int8_t *p_ctrl, const Slot *p_slots, uint32_t p_capacity, uint32_t p_pos) :
+				ctrl(p_ctrl), slots(p_slots), capacity(p_capacity), pos(p_pos) {
+			_skip_free();
+		}
+		_FORCE_INLINE_ ConstIterator() {}
+
+	private:
+		_FORCE_INLINE_ void _skip_free() {
+			while (pos < capacity && ctrl[pos] < 0) {
+				pos++;
+			}
+		}
+
+		const int8_t *ctrl = nullptr;
+		const Slot *slots = nullptr;
+		uint32_t capacity = 0;
+		uint32_t pos = 0;
+	};
+
+	struct Iterator {
+		_FORCE_INLINE_ KeyValue<TKey, TValue> &operator*() const {
+			return slots[pos];
+		}
+		_FORCE_INLINE_ KeyValue<TKey, TValue> *operator->() const { return &slots[pos]; }
+		_FORCE_INLINE_ Iterator &operator++() {
+			pos++;
+			_skip_free();
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const Iterator &b) const { return pos == b.pos; }
+		_FORCE_INLINE_ bool operator!=(const Iterator &b) const { return pos != b.pos; }
+
+		_FORCE_INLINE_ explicit operator bool() const {
+			return pos < capacity;
+		}
+
+		_FORCE_INLINE_ Iterator(const int8_t *p_ctrl, Slot *p_slots, uint32_t p_capacity, uint32_t p_pos) :
+				ctrl(p_ctrl), slots(p_slots), capacity(p_capacity), pos(p_pos) {
+			_skip_free();
+		}
+		_FORCE_INLINE_ Iterator() {}
+
+		operator ConstIterator() const {
+			return ConstIterator(ctrl, slots, capacity, pos);
+		}
+
+	private:
+		_FORCE_INLINE_ void _skip_free() {
+			while (pos < capacity && ctrl[pos] < 0) {
+				pos++;
+			}
+		}
+
+		const int8_t *ctrl = nullptr;
+		Slot *slots = nullptr;
+		uint32_t capacity = 0;
+		uint32_t pos = 0;
+	};
+
+	_FORCE_INLINE_ Iterator begin() {
+		return Iterator(ctrl, slots, num_elements ? capacity : 0, 0);
+	}
+	_FORCE_INLINE_ Iterator end() {
+		return Iterator(ctrl, slots, num_elements ? capacity : 0, num_elements ? capacity : 0);
+	}
+
+	_FORCE_INLINE_ ConstIterator begin() const {
+		return ConstIterator(ctrl, slots, num_elements ? capacity : 0, 0);
+	}
+	_FORCE_INLINE_ ConstIterator end() const {
+		return ConstIterator(ctrl, slots, num_elements ? capacity : 0, num_elements ? capacity : 0);
+	}
+
+	_FORCE_INLINE_ Iterator find(const TKey &p_key) {
+		uint32_t pos = 0;
+		if (!_lookup_pos(p_key, pos)) {
+			return end();
+		}
+		return Iterator(ctrl, slots, capacity, pos);
+	}
+
+	_FORCE_INLINE_ ConstIterator find(const TKey &p_key) const {
+		uint32_t pos = 0;
+		if (!_lookup_pos(p_key, pos)) {
+			return end();
+		}
+		return ConstIterator(ctrl, slots, capacity, pos);
+	}
+
+	_FORCE_INLINE_ void remove(const Iterator &p_iter) {
+		if (p_iter) {
+			erase(p_iter->key);
+		}
+	}
+
+	/* Indexing */
+
+	const TValue &operator[](const TKey &p_key) const {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+		CRASH_COND(!exists);
+		return slots[pos].value;
+	}
+
+	TValue &operator[](const TKey &p_key) {
+		uint32_t pos = 0;
+		if (_lookup_pos(p_key, pos)) {
+			return slots[pos].value;
+		}
+		return _insert(p_key, TValue())->value;
+	}
+
+	/* Insert */
+
+	Iterator insert(const TKey &p_key, const TValue &p_value) {
+		Slot *slot = _insert(p_key, p_value);
+		if (slot == nullptr) {
+			return end();
+		}
+		return Iterator(ctrl, slots, capacity, slot - slots);
+	}
+
+	/* Constructors */
+
+	FlatHashMap(const FlatHashMap &p_other) {
+		reserve(p_other.num_elements);
+		for (const KeyValue<TKey, TValue> &E : p_other) {
+			insert(E.key, E.value);
+		}
+	}
+
+	void operator=(const FlatHashMap &p_other) {
+		if (this == &p_other) {
+			return; // Ignore self assignment.
+		}
+		clear();
+		reserve(p_other.num_elements);
+		for (const KeyValue<TKey, TValue> &E : p_other) {
+			insert(E.key, E.value);
+		}
+	}
+
+	FlatHashMap(uint32_t p_initial_capacity) {
+		reserve(p_initial_capacity);
+	}
+	FlatHashMap() {}
+
+	~FlatHashMap() {
+		reset();
+	}
+};
+
+#endif // FLAT_HASH_MAP_H
@@ -40,7 +40,8 @@
 #include <type_traits>
 #include <typeinfo>
 
-template <typename T, bool thread_safe = false, uint32_t DEFAULT_PAGE_SIZE = 4096>
+// Pages are requested from A, which must provide static alloc(), realloc() and free() (see DefaultAllocator).
+template <typename T, bool thread_safe = false, uint32_t DEFAULT_PAGE_SIZE = 4096, typename A = DefaultAllocator>
 class PagedAllocator {
 	T **page_pool = nullptr;
 	T ***available_pool = nullptr;
@@ -62,11 +63,11 @@ public:
 			uint32_t pages_used = pages_allocated;
 
 			pages_allocated++;
-			page_pool = (T **)memrealloc(page_pool, sizeof(T *) * pages_allocated);
-			available_pool = (T ***)memrealloc(available_pool, sizeof(T **) * pages_allocated);
+			page_pool = (T **)A::realloc(page_pool, sizeof(T *) * pages_allocated);
+			available_pool = (T ***)A::realloc(available_pool, sizeof(T **) * pages_allocated);
 
-			page_pool[pages_used] = (T *)memalloc(sizeof(T) * page_size);
-			available_pool[pages_used] = (T **)memalloc(sizeof(T *) * page_size);
+			page_pool[pages_used] = (T *)A::alloc(sizeof(T) * page_size);
+			available_pool[pages_used] = (T **)A::alloc(sizeof(T *) * page_size);
 
 			for (uint32_t i = 0; i < page_size; i++) {
 				available_pool[0][i] = &page_pool[pages_used][i];
@@ -106,11 +107,11 @@ private:
 		}
 		if (pages_allocated) {
 			for (uint32_t i = 0; i < pages_allocated; i++) {
-				memfree(page_pool[i]);
-				memfree(available_pool[i]);
+				A::free(page_pool[i]);
+				A::free(available_pool[i]);
 			}
-			memfree(page_pool);
-			memfree(available_pool);
+			A::free(page_pool);
+			A::free(available_pool);
 			page_pool = nullptr;
 			available_pool = nullptr;
 			pages_allocated = 0;
@@ -0,0 +1,109 @@
+/**************************************************************************/
+/*  vector_slice.h                                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef VECTOR_SLICE_H
+#define VECTOR_SLICE_H
+
+#include "core/error/error_macros.h"
+#include "core/templates/vector.h"
+
+// Read-only window on a sub-range of a Vector. Unlike Vector::slice(), no
+// elements are ever copied: the slice holds a reference on the source buffer,
+// so it stays valid even if the source Vector is modified (copy-on-write then
+// gives the source its own buffer) or destroyed.
+//
+// Slices are C++ only: Variant can't hold one, as CowData has no notion of an
+// offset. Use to_vector() to get a Vector back.
+template <typename T>
+class VectorSlice {
+public:
+	typedef int64_t Size;
+
+private:
+	Vector<T> _source;
+	Size _offset = 0;
+	Size _size = 0;
+
+public:
+	_FORCE_INLINE_ const T *ptr() const { return _source.ptr() + _offset; }
+	_FORCE_INLINE_ Size size() const { return _size; }
+	_FORCE_INLINE_ bool is_empty() const { return _size == 0; }
+
+	_FORCE_INLINE_ const T &operator[](Size p_index) const {
+		CRASH_BAD_INDEX(p_index, _size);
+		return ptr()[p_index];
+	}
+
+	_FORCE_INLINE_ const T *begin() const { return ptr(); }
+	_FORCE_INLINE_ const T *end() const { return ptr() + _size; }
+
+	// Same index rules as Vector::slice(), negative indices count from the end.
+	VectorSlice<T> slice(Size p_begin, Size p_end = INT64_MAX) const {
+		Size begin = CLAMP(p_begin, -_size, _size);
+		if (begin < 0) {
+			begin += _size;
+		}
+		Size end = CLAMP(p_end, -_size, _size);
+		if (end < 0) {
+			end += _size;
+		}
+
+		ERR_FAIL_COND_V(begin > end, VectorSlice<T>());
+
+		return VectorSlice<T>(_source, _offset + begin, end - begin);
+	}
+
+	// Only copies if the slice doesn't cover the whole source.
+	Vector<T> to_vector() const {
+		if (_offset == 0 && _size == _source.size()) {
+			return _source;
+		}
+		Vector<T> result;
+		result.resize(_size);
+		T *w = result.ptrw();
+		const T *r = ptr();
+		for (Size i = 0; i < _size; i++) {
+			w[i] = r[i];
+		}
+		return result;
+	}
+
+	VectorSlice() {}
+	VectorSlice(const Vector<T> &p_source) :
+			_source(p_source), _size(p_source.size()) {}
+	VectorSlice(const Vector<T> &p_source, Size p_offset, Size p_size) {
+		ERR_FAIL_COND(p_offset < 0 || p_size < 0 || p_offset + p_size > p_source.size());
+		_source = p_source;
+		_offset = p_offset;
+		_size = p_size;
+	}
+};
+
+#endif // VECTOR_SLICE_H
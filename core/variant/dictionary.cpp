@@ -40,24 +40,220 @@
 #include "core/variant/variant_internal.h"
 
 struct DictionaryPrivate {
+	// Most dictionaries only hold a few keys (records returned by the API, parsed JSON objects,
+	// named arguments), so the first SMALL_CAPACITY entries live in a table that is scanned
+	// linearly, comparing hashes first. Only keys added once the table is full go to the hash map.
+	// Entries added with a StringName key remember it, so looking them up with the same
+	// StringName again is a pointer comparison.
+	// Entries never move, and erased slots are only handed out again when nothing was inserted
+	// after them, so references to values stay valid and iteration keeps insertion order (the
+	// table first, then the map), like with the hash map alone.
+	static constexpr uint32_t SMALL_CAPACITY = 8;
+
+	typedef KeyValue<Variant, Variant> Entry;
+	typedef HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator> Map;
+
+	struct SmallEntry {
+		Entry data;
+		StringName name;
+		uint32_t hash;
+	};
+
+	struct Iterator {
+		DictionaryPrivate *dict = nullptr;
+		uint32_t slot = SMALL_CAPACITY; // Slot in the small table, or SMALL_CAPACITY when walking the map.
+		Map::Iterator map_iterator;
+
+		_FORCE_INLINE_ Entry &operator*() const {
+			return slot < SMALL_CAPACITY ? dict->small_entries[slot].data : *map_iterator;
+		}
+		_FORCE_INLINE_ Entry *operator->() const { return &operator*(); }
+		_FORCE_INLINE_ Iterator &operator++() {
+			if (slot < SMALL_CAPACITY) {
+				slot = dict->_next_small_slot(slot + 1);
+				if (slot == SMALL_CAPACITY) {
+					map_iterator = dict->variant_map.begin();
+				}
+			} else {
+				++map_iterator;
+			}
+			return *this;
+		}
+
+		_FORCE_INLINE_ explicit operator bool() const {
+			return slot < SMALL_CAPACITY || map_iterator;
+		}
+		_FORCE_INLINE_ bool operator!=(const Iterator &p_other) const {
+			return slot != p_other.slot || map_iterator != p_other.map_iterator;
+		}
+	};
+
 	SafeRefCount refcount;
 	Variant *read_only = nullptr; // If enabled, a pointer is used to a temporary value that is used to return read-only values.
-	HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator> variant_map;
-};
+	SmallEntry *small_entries = nullptr; // SMALL_CAPACITY slots, allocated on first insertion.
+	uint32_t small_used = 0; // Slots handed out, including erased ones.
+	uint32_t small_live = 0; // Bit mask of the slots holding an entry.
+	uint32_t small_count = 0;
+	Map variant_map;
+
+	static _FORCE_INLINE_ uint32_t _hash(const Variant &p_key) {
+		// StringName keys come with a precomputed hash, which matches the one of the equivalent String.
+		if (p_key.get_type() == Variant::STRING_NAME) {
+			return VariantInternal::get_string_name(&p_key)->hash();
+		}
+		return VariantHasher::hash(p_key);
+	}
 
-void Dictionary::get_key_list(List<Variant> *p_keys) const {
-	if (_p->variant_map.is_empty()) {
-		return;
+	_FORCE_INLINE_ uint32_t _next_small_slot(uint32_t p_from) const {
+		for (uint32_t i = p_from; i < small_used; i++) {
+			if (small_live & (1u << i)) {
+				return i;
+			}
+		}
+		return SMALL_CAPACITY;
+	}
+
+	_FORCE_INLINE_ uint32_t _find_small(const Variant &p_key, uint32_t p_hash) const {
+		const void *name = p_key.get_type() == Variant::STRING_NAME ? VariantInternal::get_string_name(&p_key)->data_unique_pointer() : nullptr;
+		for (uint32_t i = 0; i < small_used; i++) {
+			if (!(small_live & (1u << i))) {
+				continue;
+			}
+			const SmallEntry &entry = small_entries[i];
+			if (name && entry.name.data_unique_pointer() == name) {
+				return i;
+			}
+			if (entry.hash == p_hash && StringLikeVariantComparator::compare(entry.data.key, p_key)) {
+				return i;
+			}
+		}
+		return SMALL_CAPACITY;
+	}
+
+	void _trim_small() {
+		// Trailing erased slots can be reused as long as no entry was added after them.
+		if (variant_map.is_empty()) {
+			while (small_used > 0 && !(small_live & (1u << (small_used - 1)))) {
+				small_used--;
+			}
+		}
 	}
 
-	for (const KeyValue<Variant, Variant> &E : _p->variant_map) {
+	_FORCE_INLINE_ uint32_t size() const {
+		return small_count + variant_map.size();
+	}
+
+	_FORCE_INLINE_ Iterator begin() {
+		Iterator it;
+		it.dict = this;
+		it.slot = _next_small_slot(0);
+		if (it.slot == SMALL_CAPACITY) {
+			it.map_iterator = variant_map.begin();
+		}
+		return it;
+	}
+
+	_FORCE_INLINE_ Iterator end() {
+		return Iterator();
+	}
+
+	Iterator find(const Variant &p_key) {
+		Iterator it;
+		it.dict = this;
+		if (small_count > 0) {
+			it.slot = _find_small(p_key, _hash(p_key));
+			if (it.slot < SMALL_CAPACITY) {
+				return it;
+			}
+		}
+		if (!variant_map.is_empty()) {
+			it.map_iterator = variant_map.find(p_key);
+		}
+		return it;
+	}
+
+	Variant &get_or_insert(const Variant &p_key) {
+		const uint32_t hash = _hash(p_key);
+		if (small_count > 0) {
+			const uint32_t slot = _find_small(p_key, hash);
+			if (slot < SMALL_CAPACITY) {
+				return small_entries[slot].data.value;
+			}
+		}
+		if (!variant_map.is_empty()) {
+			Map::Iterator E = variant_map.find(p_key);
+			if (E) {
+				return E->value;
+			}
+		}
+
+		// StringName keys are stored as String, as they compare equal anyway.
+		const Variant key = p_key.get_type() == Variant::STRING_NAME ? Variant(VariantInternal::get_string_name(&p_key)->operator String()) : p_key;
+		if (small_used < SMALL_CAPACITY) {
+			if (!small_entries) {
+				small_entries = (SmallEntry *)Memory::alloc_static(sizeof(SmallEntry) * SMALL_CAPACITY);
+			}
+			SmallEntry &entry = small_entries[small_used];
+			memnew_placement(&entry.data, Entry(key, Variant()));
+			memnew_placement(&entry.name, StringName(p_key.get_type() == Variant::STRING_NAME ? *VariantInternal::get_string_name(&p_key) : StringName()));
+			entry.hash = hash;
+			small_live |= 1u << small_used;
+			small_used++;
+			small_count++;
+			return entry.data.value;
+		}
+		return variant_map.insert(key, Variant())->value;
+	}
+
+	bool erase(const Variant &p_key) {
+		if (small_count > 0) {
+			const uint32_t slot = _find_small(p_key, _hash(p_key));
+			if (slot < SMALL_CAPACITY) {
+				small_entries[slot].data.~Entry();
+				small_entries[slot].name.~StringName();
+				small_live &= ~(1u << slot);
+				small_count--;
+				_trim_small();
+				return true;
+			}
+		}
+		if (variant_map.erase(p_key)) {
+			_trim_small();
+			return true;
+		}
+		return false;
+	}
+
+	void clear() {
+		for (uint32_t i = 0; i < small_used; i++) {
+			if (small_live & (1u << i)) {
+				small_entries[i].data.~Entry();
+				small_entries[i].name.~StringName();
+			}
+		}
+		small_used = 0;
+		small_live = 0;
+		small_count = 0;
+		variant_map.clear();
+	}
+
+	~DictionaryPrivate() {
+		clear();
+		if (small_entries) {
+			Memory::free_static(small_entries);
+		}
+	}
+};
+
+void Dictionary::get_key_list(List<Variant> *p_keys) const {
+	for (const KeyValue<Variant, Variant> &E : *_p) {
 		p_keys->push_back(E.key);
 	}
 }
 
 Variant Dictionary::get_key_at_index(int p_index) const {
 	int index = 0;
-	for (const KeyValue<Variant, Variant> &E : _p->variant_map) {
+	for (const KeyValue<Variant, Variant> &E : *_p) {
 		if (index == p_index) {
 			return E.key;
 		}
@@ -69,7 +265,7 @@ Variant Dictionary::get_key_at_index(int p_index) const {
 
 Variant Dictionary::get_value_at_index(int p_index) const {
 	int index = 0;
-	for (const KeyValue<Variant, Variant> &E : _p->variant_map) {
+	for (const KeyValue<Variant, Variant> &E : *_p) {
 		if (index == p_index) {
 			return E.value;
 		}
@@ -81,38 +277,28 @@ Variant Dictionary::get_value_at_index(int p_index) const {
 
 Variant &Dictionary::operator[](const Variant &p_key) {
 	if (unlikely(_p->read_only)) {
-		if (p_key.get_type() == Variant::STRING_NAME) {
-			const StringName *sn = VariantInternal::get_string_name(&p_key);
-			const String &key = sn->operator String();
-			if (likely(_p->variant_map.has(key))) {
-				*_p->read_only = _p->variant_map[key];
-			} else {
-				*_p->read_only = Variant();
-			}
-		} else if (likely(_p->variant_map.has(p_key))) {
-			*_p->read_only = _p->variant_map[p_key];
+		DictionaryPrivate::Iterator E = _p->find(p_key);
+		if (likely(E)) {
+			*_p->read_only = E->value;
 		} else {
 			*_p->read_only = Variant();
 		}
 
 		return *_p->read_only;
 	} else {
-		if (p_key.get_type() == Variant::STRING_NAME) {
-			const StringName *sn = VariantInternal::get_string_name(&p_key);
-			return _p->variant_map[sn->operator String()];
-		} else {
-			return _p->variant_map[p_key];
-		}
+		return _p->get_or_insert(p_key);
 	}
 }
 
 const Variant &Dictionary::operator[](const Variant &p_key) const {
 	// Will not insert key, so no conversion is necessary.
-	return _p->variant_map[p_key];
+	DictionaryPrivate::Iterator E = _p->find(p_key);
+	CRASH_COND(!E);
+	return E->value;
 }
 
 const Variant *Dictionary::getptr(const Variant &p_key) const {
-	HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator>::ConstIterator E(_p->variant_map.find(p_key));
+	DictionaryPrivate::Iterator E = _p->find(p_key);
 	if (!E) {
 		return nullptr;
 	}
@@ -120,7 +306,7 @@ const Variant *Dictionary::getptr(const Variant &p_key) const {
 }
 
 Variant *Dictionary::getptr(const Variant &p_key) {
-	HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator>::Iterator E(_p->variant_map.find(p_key));
+	DictionaryPrivate::Iterator E = _p->find(p_key);
 	if (!E) {
 		return nullptr;
 	}
@@ -133,7 +319,7 @@ Variant *Dictionary::getptr(const Variant &p_key) {
 }
 
 Variant Dictionary::get_valid(const Variant &p_key) const {
-	HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator>::ConstIterator E(_p->variant_map.find(p_key));
+	DictionaryPrivate::Iterator E = _p->find(p_key);
 
 	if (!E) {
 		return Variant();
@@ -160,15 +346,15 @@ Variant Dictionary::get_or_add(const Variant &p_key, const Variant &p_default) {
 }
 
 int Dictionary::size() const {
-	return _p->variant_map.size();
+	return _p->size();
 }
 
 bool Dictionary::is_empty() const {
-	return !_p->variant_map.size();
+	return !_p->size();
 }
 
 bool Dictionary::has(const Variant &p_key) const {
-	return _p->variant_map.has(p_key);
+	return bool(_p->find(p_key));
 }
 
 bool Dictionary::has_all(const Array &p_keys) const {
@@ -181,7 +367,7 @@ bool Dictionary::has_all(const Array &p_keys) const {
 }
 
 Variant Dictionary::find_key(const Variant &p_value) const {
-	for (const KeyValue<Variant, Variant> &E : _p->variant_map) {
+	for (const KeyValue<Variant, Variant> &E : *_p) {
 		if (E.value == p_value) {
 			return E.key;
 		}
@@ -191,7 +377,7 @@ Variant Dictionary::find_key(const Variant &p_value) const {
 
 bool Dictionary::erase(const Variant &p_key) {
 	ERR_FAIL_COND_V_MSG(_p->read_only, false, "Dictionary is in read-only state.");
-	return _p->variant_map.erase(p_key);
+	return _p->erase(p_key);
 }
 
 bool Dictionary::operator==(const Dictionary &p_dictionary) const {
@@ -207,7 +393,7 @@ bool Dictionary::recursive_equal(const Dictionary &p_dictionary, int recursion_c
 	if (_p == p_dictionary._p) {
 		return true;
 	}
-	if (_p->variant_map.size() != p_dictionary._p->variant_map.size()) {
+	if (_p->size() != p_dictionary._p->size()) {
 		return false;
 	}
 
@@ -217,8 +403,8 @@ bool Dictionary::recursive_equal(const Dictionary &p_dictionary, int recursion_c
 		return true;
 	}
 	recursion_count++;
-	for (const KeyValue<Variant, Variant> &this_E : _p->variant_map) {
-		HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator>::ConstIterator other_E(p_dictionary._p->variant_map.find(this_E.key));
+	for (const KeyValue<Variant, Variant> &this_E : *_p) {
+		DictionaryPrivate::Iterator other_E = p_dictionary._p->find(this_E.key);
 		if (!other_E || !this_E.value.hash_compare(other_E->value, recursion_count, false)) {
 			return false;
 		}
@@ -245,12 +431,12 @@ void Dictionary::_ref(const Dictionary &p_from) const {
 
 void Dictionary::clear() {
 	ERR_FAIL_COND_MSG(_p->read_only, "Dictionary is in read-only state.");
-	_p->variant_map.clear();
+	_p->clear();
 }
 
 void Dictionary::merge(const Dictionary &p_dictionary, bool p_overwrite) {
 	ERR_FAIL_COND_MSG(_p->read_only, "Dictionary is in read-only state.");
-	for (const KeyValue<Variant, Variant> &E : p_dictionary._p->variant_map) {
+	for (const KeyValue<Variant, Variant> &E : *p_dictionary._p) {
 		if (p_overwrite || !has(E.key)) {
 			operator[](E.key) = E.value;
 		}
@@ -287,7 +473,7 @@ uint32_t Dictionary::recursive_hash(int recursion_count) const {
 	uint32_t h = hash_murmur3_one_32(Variant::DICTIONARY);
 
 	recursion_count++;
-	for (const KeyValue<Variant, Variant> &E : _p->variant_map) {
+	for (const KeyValue<Variant, Variant> &E : *_p) {
 		h = hash_murmur3_one_32(E.key.recursive_hash(recursion_count), h);
 		h = hash_murmur3_one_32(E.value.recursive_hash(recursion_count), h);
 	}
@@ -297,14 +483,14 @@ uint32_t Dictionary::recursive_hash(int recursion_count) const {
 
 Array Dictionary::keys() const {
 	Array varr;
-	if (_p->variant_map.is_empty()) {
+	if (_p->size() == 0) {
 		return varr;
 	}
 
 	varr.resize(size());
 
 	int i = 0;
-	for (const KeyValue<Variant, Variant> &E : _p->variant_map) {
+	for (const KeyValue<Variant, Variant> &E : *_p) {
 		varr[i] = E.key;
 		i++;
 	}
@@ -314,14 +500,14 @@ Array Dictionary::keys() const {
 
 Array Dictionary::values() const {
 	Array varr;
-	if (_p->variant_map.is_empty()) {
+	if (_p->size() == 0) {
 		return varr;
 	}
 
 	varr.resize(size());
 
 	int i = 0;
-	for (const KeyValue<Variant, Variant> &E : _p->variant_map) {
+	for (const KeyValue<Variant, Variant> &E : *_p) {
 		varr[i] = E.value;
 		i++;
 	}
@@ -332,12 +518,13 @@ Array Dictionary::values() const {
 const Variant *Dictionary::next(const Variant *p_key) const {
 	if (p_key == nullptr) {
 		// caller wants to get the first element
-		if (_p->variant_map.begin()) {
-			return &_p->variant_map.begin()->key;
+		DictionaryPrivate::Iterator E = _p->begin();
+		if (E) {
+			return &E->key;
 		}
 		return nullptr;
 	}
-	HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator>::Iterator E = _p->variant_map.find(*p_key);
+	DictionaryPrivate::Iterator E = _p->find(*p_key);
 
 	if (!E) {
 		return nullptr;
@@ -375,11 +562,11 @@ Dictionary Dictionary::recursive_duplicate(bool p_deep, int recursion_count) con
 
 	if (p_deep) {
 		recursion_count++;
-		for (const KeyValue<Variant, Variant> &E : _p->variant_map) {
+		for (const KeyValue<Variant, Variant> &E : *_p) {
 			n[E.key.recursive_duplicate(true, recursion_count)] = E.value.recursive_duplicate(true, recursion_count);
 		}
 	} else {
-		for (const KeyValue<Variant, Variant> &E : _p->variant_map) {
+		for (const KeyValue<Variant, Variant> &E : *_p) {
 			n[E.key] = E.value;
 		}
 	}
@@ -34,6 +34,7 @@
 #include "core/debugger/engine_debugger.h"
 #include "core/io/compression.h"
 #include "core/io/marshalls.h"
+#include "core/math/batch_math.h"
 #include "core/object/class_db.h"
 #include "core/os/os.h"
 #include "core/templates/local_vector.h"
@@ -1018,6 +1019,103 @@ struct _VariantCall {
 		return len;
 	}
 
+	// Bulk math on number and vector arrays, done in place by BatchMath on the
+	// numbers they are made of.
+	template <typename T>
+	struct PackedComponent {
+		typedef T Type;
+	};
+
+	template <typename T>
+	static void func_Packed_add_scalar(Vector<T> *p_instance, double p_value) {
+		T *w = p_instance->ptrw();
+		BatchMath::scale_offset(w, (T)1, (T)p_value, w, p_instance->size());
+	}
+
+	template <typename T>
+	static void func_Packed_multiply_scalar(Vector<T> *p_instance, double p_value) {
+		typedef typename PackedComponent<T>::Type C;
+		C *w = (C *)p_instance->ptrw();
+		BatchMath::scale_offset(w, (C)p_value, (C)0, w, p_instance->size() * (sizeof(T) / sizeof(C)));
+	}
+
+	template <typename T>
+	static void func_Packed_add_array(Vector<T> *p_instance, const Vector<T> &p_array) {
+		typedef typename PackedComponent<T>::Type C;
+		ERR_FAIL_COND_MSG(p_array.size() != p_instance->size(), vformat("The array to add must have the same size as this one (%d), but has %d elements.", p_instance->size(), p_array.size()));
+		C *w = (C *)p_instance->ptrw();
+		BatchMath::add(w, (const C *)p_array.ptr(), w, p_instance->size() * (sizeof(T) / sizeof(C)));
+	}
+
+	template <typename T>
+	static void func_Packed_multiply_array(Vector<T> *p_instance, const Vector<T> &p_array) {
+		typedef typename PackedComponent<T>::Type C;
+		ERR_FAIL_COND_MSG(p_array.size() != p_instance->size(), vformat("The array to multiply by must have the same size as this one (%d), but has %d elements.", p_instance->size(), p_array.size()));
+		C *w = (C *)p_instance->ptrw();
+		BatchMath::multiply(w, (const C *)p_array.ptr(), w, p_instance->size() * (sizeof(T) / sizeof(C)));
+	}
+
+	template <typename T>
+	static void func_Packed_lerp_array(Vector<T> *p_instance, const Vector<T> &p_to, double p_weight) {
+		typedef typename PackedComponent<T>::Type C;
+		ERR_FAIL_COND_MSG(p_to.size() != p_instance->size(), vformat("The array to interpolate to must have the same size as this one (%d), but has %d elements.", p_instance->size(), p_to.size()));
+		C *w = (C *)p_instance->ptrw();
+		BatchMath::lerp(w, (const C *)p_to.ptr(), (C)p_weight, w, p_instance->size() * (sizeof(T) / sizeof(C)));
+	}
+
+	template <typename T>
+	static void func_Packed_clamp(Vector<T> *p_instance, double p_min, double p_max) {
+		T *w = p_instance->ptrw();
+		BatchMath::clamp(w, (T)p_min, (T)p_max, w, p_instance->size());
+	}
+
+	template <typename T>
+	static void func_Packed_fill_range(Vector<T> *p_instance, double p_from, double p_step) {
+		BatchMath::fill_range((T)p_from, (T)p_step, p_instance->ptrw(), p_instance->size());
+	}
+
+	template <typename T>
+	static double func_Packed_sum(Vector<T> *p_instance) {
+		return BatchMath::sum(p_instance->ptr(), p_instance->size());
+	}
+
+	template <typename T>
+	static double func_Packed_dot(Vector<T> *p_instance, const Vector<T> &p_with) {
+		ERR_FAIL_COND_V_MSG(p_with.size() != p_instance->size(), 0, vformat("The array to compute the dot product with must have the same size as this one (%d), but has %d elements.", p_instance->size(), p_with.size()));
+		return BatchMath::dot(p_instance->ptr(), p_with.ptr(), p_instance->size());
+	}
+
+	template <typename T>
+	static double func_Packed_min(Vector<T> *p_instance) {
+		return BatchMath::min(p_instance->ptr(), p_instance->size());
+	}
+
+	template <typename T>
+	static double func_Packed_max(Vector<T> *p_instance) {
+		return BatchMath::max(p_instance->ptr(), p_instance->size());
+	}
+
+	template <typename T>
+	static T func_PackedVector_sum(Vector<T> *p_instance) {
+		T sum;
+		for (const T &v : *p_instance) {
+			sum += v;
+		}
+		return sum;
+	}
+
+	static void func_PackedVector2Array_transform(PackedVector2Array *p_instance, const Transform2D &p_transform) {
+		Vector2 *w = p_instance->ptrw();
+		for (int i = 0; i < p_instance->size(); i++) {
+			w[i] = p_transform.xform(w[i]);
+		}
+	}
+
+	static void func_PackedVector3Array_transform(PackedVector3Array *p_instance, const Transform3D &p_transform) {
+		Vector3 *w = p_instance->ptrw();
+		BatchMath::xform_points(p_transform, w, w, p_instance->size());
+	}
+
 	static void func_Callable_call(Variant *v, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_error) {
 		Callable *callable = VariantGetInternalPtr<Callable>::get_ptr(v);
 		callable->callp(p_args, p_argcount, r_ret, r_error);
@@ -1099,6 +1197,16 @@ struct _VariantCall {
 	}
 };
 
+template <>
+struct _VariantCall::PackedComponent<Vector2> {
+	typedef real_t Type;
+};
+
+template <>
+struct _VariantCall::PackedComponent<Vector3> {
+	typedef real_t Type;
+};
+
 _VariantCall::ConstantData *_VariantCall::constant_data = nullptr;
 _VariantCall::EnumData *_VariantCall::enum_data = nullptr;
 
@@ -2454,6 +2562,17 @@ static void _register_variant_builtin_methods_array() {
 	bind_method(PackedFloat32Array, find, sarray("value", "from"), varray(0));
 	bind_method(PackedFloat32Array, rfind, sarray("value", "from"), varray(-1));
 	bind_method(PackedFloat32Array, count, sarray("value"), varray());
+	bind_functionnc(PackedFloat32Array, add_scalar, _VariantCall::func_Packed_add_scalar<float>, sarray("value"), varray());
+	bind_functionnc(PackedFloat32Array, multiply_scalar, _VariantCall::func_Packed_multiply_scalar<float>, sarray("value"), varray());
+	bind_functionnc(PackedFloat32Array, add_array, _VariantCall::func_Packed_add_array<float>, sarray("array"), varray());
+	bind_functionnc(PackedFloat32Array, multiply_array, _VariantCall::func_Packed_multiply_array<float>, sarray("array"), varray());
+	bind_functionnc(PackedFloat32Array, lerp_array, _VariantCall::func_Packed_lerp_array<float>, sarray("to", "weight"), varray());
+	bind_functionnc(PackedFloat32Array, clamp, _VariantCall::func_Packed_clamp<float>, sarray("min", "max"), varray());
+	bind_functionnc(PackedFloat32Array, fill_range, _VariantCall::func_Packed_fill_range<float>, sarray("from", "step"), varray(1.0));
+	bind_function(PackedFloat32Array, sum, _VariantCall::func_Packed_sum<float>, sarray(), varray());
+	bind_function(PackedFloat32Array, dot, _VariantCall::func_Packed_dot<float>, sarray("with"), varray());
+	bind_function(PackedFloat32Array, min, _VariantCall::func_Packed_min<float>, sarray(), varray());
+	bind_function(PackedFloat32Array, max, _VariantCall::func_Packed_max<float>, sarray(), varray());
 
 	/* Float64 Array */
 
@@ -2478,6 +2597,17 @@ static void _register_variant_builtin_methods_array() {
 	bind_method(PackedFloat64Array, find, sarray("value", "from"), varray(0));
 	bind_method(PackedFloat64Array, rfind, sarray("value", "from"), varray(-1));
 	bind_method(PackedFloat64Array, count, sarray("value"), varray());
+	bind_functionnc(PackedFloat64Array, add_scalar, _VariantCall::func_Packed_add_scalar<double>, sarray("value"), varray());
+	bind_functionnc(PackedFloat64Array, multiply_scalar, _VariantCall::func_Packed_multiply_scalar<double>, sarray("value"), varray());
+	bind_functionnc(PackedFloat64Array, add_array, _VariantCall::func_Packed_add_array<double>, sarray("array"), varray());
+	bind_functionnc(PackedFloat64Array, multiply_array, _VariantCall::func_Packed_multiply_array<double>, sarray("array"), varray());
+	bind_functionnc(PackedFloat64Array, lerp_array, _VariantCall::func_Packed_lerp_array<double>, sarray("to", "weight"), varray());
+	bind_functionnc(PackedFloat64Array, clamp, _VariantCall::func_Packed_clamp<double>, sarray("min", "max"), varray());
+	bind_functionnc(PackedFloat64Array, fill_range, _VariantCall::func_Packed_fill_range<double>, sarray("from", "step"), varray(1.0));
+	bind_function(PackedFloat64Array, sum, _VariantCall::func_Packed_sum<double>, sarray(), varray());
+	bind_function(PackedFloat64Array, dot, _VariantCall::func_Packed_dot<double>, sarray("with"), varray());
+	bind_function(PackedFloat64Array, min, _VariantCall::func_Packed_min<double>, sarray(), varray());
+	bind_function(PackedFloat64Array, max, _VariantCall::func_Packed_max<double>, sarray(), varray());
 
 	/* String Array */
 
@@ -2526,6 +2656,12 @@ static void _register_variant_builtin_methods_array() {
 	bind_method(PackedVector2Array, find, sarray("value", "from"), varray(0));
 	bind_method(PackedVector2Array, rfind, sarray("value", "from"), varray(-1));
 	bind_method(PackedVector2Array, count, sarray("value"), varray());
+	bind_functionnc(PackedVector2Array, multiply_scalar, _VariantCall::func_Packed_multiply_scalar<Vector2>, sarray("value"), varray());
+	bind_functionnc(PackedVector2Array, add_array, _VariantCall::func_Packed_add_array<Vector2>, sarray("array"), varray());
+	bind_functionnc(PackedVector2Array, multiply_array, _VariantCall::func_Packed_multiply_array<Vector2>, sarray("array"), varray());
+	bind_functionnc(PackedVector2Array, lerp_array, _VariantCall::func_Packed_lerp_array<Vector2>, sarray("to", "weight"), varray());
+	bind_functionnc(PackedVector2Array, transform, _VariantCall::func_PackedVector2Array_transform, sarray("transform"), varray());
+	bind_function(PackedVector2Array, sum, _VariantCall::func_PackedVector_sum<Vector2>, sarray(), varray());
 
 	/* Vector3 Array */
 
@@ -2550,6 +2686,12 @@ static void _register_variant_builtin_methods_array() {
 	bind_method(PackedVector3Array, find, sarray("value", "from"), varray(0));
 	bind_method(PackedVector3Array, rfind, sarray("value", "from"), varray(-1));
 	bind_method(PackedVector3Array, count, sarray("value"), varray());
+	bind_functionnc(PackedVector3Array, multiply_scalar, _VariantCall::func_Packed_multiply_scalar<Vector3>, sarray("value"), varray());
+	bind_functionnc(PackedVector3Array, add_array, _VariantCall::func_Packed_add_array<Vector3>, sarray("array"), varray());
+	bind_functionnc(PackedVector3Array, multiply_array, _VariantCall::func_Packed_multiply_array<Vector3>, sarray("array"), varray());
+	bind_functionnc(PackedVector3Array, lerp_array, _VariantCall::func_Packed_lerp_array<Vector3>, sarray("to", "weight"), varray());
+	bind_functionnc(PackedVector3Array, transform, _VariantCall::func_PackedVector3Array_transform, sarray("transform"), varray());
+	bind_function(PackedVector3Array, sum, _VariantCall::func_PackedVector_sum<Vector3>, sarray(), varray());
 
 	/* Color Array */
 
@@ -365,7 +365,12 @@ void EditorProfiler::_update_frame() {
 			item->set_metadata(1, it.script);
 			item->set_metadata(2, it.line);
 			item->set_text_alignment(2, HORIZONTAL_ALIGNMENT_RIGHT);
-			item->set_tooltip_text(0, it.name + "\n" + it.script + ":" + itos(it.line));
+			String tooltip = it.name + "\n" + it.script + ":" + itos(it.line);
+			const uint64_t inline_cache_lookups = it.inline_cache_hits + it.inline_cache_misses;
+			if (inline_cache_lookups > 0) {
+				tooltip += "\n" + vformat(TTR("Inline cache hit rate: %.1f%% (%d/%d)"), 100.0 * it.inline_cache_hits / inline_cache_lookups, it.inline_cache_hits, inline_cache_lookups);
+			}
+			item->set_tooltip_text(0, tooltip);
 
 			float time = dtime == DISPLAY_SELF_TIME ? it.self : it.total;
 			if (dtime == DISPLAY_SELF_TIME && !display_internal_profiles->is_pressed()) {
@@ -70,6 +70,8 @@ public:
 				float total = 0;
 				float internal = 0;
 				int calls = 0;
+				uint64_t inline_cache_hits = 0;
+				uint64_t inline_cache_misses = 0;
 			};
 
 			Vector<Item> items;
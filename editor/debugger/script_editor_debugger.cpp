@@ -785,6 +785,8 @@ void ScriptEditorDebugger::_parse_message(const String &p_msg, uint64_t p_thread
 			item.self = self;
 			item.total = total;
 			item.internal = internal;
+			item.inline_cache_hits = frame.script_functions[i].inline_cache_hits;
+			item.inline_cache_misses = frame.script_functions[i].inline_cache_misses;
 			funcs.items.write[i] = item;
 		}
 
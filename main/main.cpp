@@ -34,6 +34,7 @@
 #include "core/core_globals.h"
 #include "core/crypto/crypto.h"
 #include "core/debugger/engine_debugger.h"
+#include "core/debugger/trace_profiler.h"
 #include "core/extension/extension_api_dump.h"
 #include "core/extension/gdextension_interface_dump.gen.h"
 #include "core/extension/gdextension_manager.h"
@@ -46,6 +47,7 @@
 #include "core/io/ip.h"
 #include "core/io/resource_loader.h"
 #include "core/object/message_queue.h"
+#include "core/os/frame_arena.h"
 #include "core/os/os.h"
 #include "core/os/time.h"
 #include "core/register_core_types.h"
@@ -126,6 +128,7 @@
 
 #ifdef MODULE_GDSCRIPT_ENABLED
 #include "modules/gdscript/gdscript.h"
+#include "modules/gdscript/gdscript_sampler.h"
 #if defined(TOOLS_ENABLED) && !defined(GDSCRIPT_NO_LSP)
 #include "modules/gdscript/language_server/gdscript_language_server.h"
 #endif // TOOLS_ENABLED && !GDSCRIPT_NO_LSP
@@ -226,6 +229,10 @@ static Vector2 init_custom_pos;
 // Debug
 
 static bool use_debug_profiler = false;
+static String profile_trace_path;
+#ifdef MODULE_GDSCRIPT_ENABLED
+static String profile_scripts_path;
+#endif // MODULE_GDSCRIPT_ENABLED
 #ifdef DEBUG_ENABLED
 static bool debug_collisions = false;
 static bool debug_paths = false;
@@ -599,6 +606,10 @@ void Main::print_help(const char *p_binary) {
 	print_help_option("-d, --debug", "Debug (local stdout debugger).\n");
 	print_help_option("-b, --breakpoints", "Breakpoint list as source::line comma-separated pairs, no spaces (use %%20 instead).\n");
 	print_help_option("--profiling", "Enable profiling in the script debugger.\n");
+	print_help_option("--profile-trace <file>", "Record a CPU timeline of the engine threads until exit, and save it to the given file in the Chrome trace format (viewable in Perfetto or chrome://tracing).\n");
+#ifdef MODULE_GDSCRIPT_ENABLED
+	print_help_option("--profile-scripts <file>", "Sample the GDScript call stacks of all threads every millisecond until exit, and save them to the given file as folded stacks (for flame graph tools).\n");
+#endif // MODULE_GDSCRIPT_ENABLED
 	print_help_option("--gpu-profile", "Show a GPU profile of the tasks that took the most time during frame rendering.\n");
 	print_help_option("--gpu-validation", "Enable graphics API validation layers for debugging.\n");
 #ifdef DEBUG_ENABLED
@@ -661,6 +672,7 @@ void Main::print_help(const char *p_binary) {
 	print_help_option("--benchmark-file <path>", "Benchmark the run time and save it to a given file in JSON format. The path should be absolute.\n", CLI_OPTION_AVAILABILITY_EDITOR);
 #ifdef TESTS_ENABLED
 	print_help_option("--test [--help]", "Run unit tests. Use --test --help for more information.\n", CLI_OPTION_AVAILABILITY_EDITOR);
+	print_help_option("--test --benchmarks", "Run the benchmarks instead, see tests/test_benchmark.h for options to save and compare results.\n", CLI_OPTION_AVAILABILITY_EDITOR);
 #endif
 #endif
 	OS::get_singleton()->print("\n");
@@ -1326,6 +1338,30 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 
 			use_debug_profiler = true;
 
+		} else if (arg == "--profile-trace") { // record a timeline of the engine threads
+
+			if (N) {
+				profile_trace_path = N->get();
+				TraceProfiler::start();
+				N = N->next();
+			} else {
+				OS::get_singleton()->print("Missing profile trace file path argument, aborting.\n");
+				goto error;
+			}
+
+#ifdef MODULE_GDSCRIPT_ENABLED
+		} else if (arg == "--profile-scripts") { // sample the script call stacks
+
+			if (N) {
+				profile_scripts_path = N->get();
+				GDScriptSampler::start();
+				N = N->next();
+			} else {
+				OS::get_singleton()->print("Missing script profile file path argument, aborting.\n");
+				goto error;
+			}
+
+#endif // MODULE_GDSCRIPT_ENABLED
 		} else if (arg == "-l" || arg == "--language") { // language
 
 			if (N) {
@@ -2512,6 +2548,12 @@ error:
 	}
 
 	unregister_core_types();
+	TraceProfiler::finish();
+	profile_trace_path = String();
+#ifdef MODULE_GDSCRIPT_ENABLED
+	GDScriptSampler::finish();
+	profile_scripts_path = String();
+#endif // MODULE_GDSCRIPT_ENABLED
 
 	OS::get_singleton()->_cmdline.clear();
 	OS::get_singleton()->_user_args.clear();
@@ -3994,13 +4036,20 @@ bool Main::is_iterating() {
 static uint64_t physics_process_max = 0;
 static uint64_t process_max = 0;
 static uint64_t navigation_process_max = 0;
+static uint64_t message_queue_messages_max = 0;
+static uint64_t message_queue_bytes_max = 0;
+static uint64_t message_queue_flush_max = 0;
 
 // Return false means iterating further, returning true means `OS::run`
 // will terminate the program. In case of failure, the OS exit code needs
 // to be set explicitly here (defaults to EXIT_SUCCESS).
 bool Main::iteration() {
+	TRACE_ZONE("Main::iteration");
 	iterating++;
 
+	// Scratch memory handed out during the previous frame is no longer valid.
+	FrameArena::advance_frame();
+
 	const uint64_t ticks = OS::get_singleton()->get_ticks_usec();
 	Engine::get_singleton()->_frame_ticks = ticks;
 	main_timer_sync.set_cpu_ticks_usec(ticks);
@@ -4049,6 +4098,7 @@ bool Main::iteration() {
 			Input::get_singleton()->flush_buffered_events();
 		}
 
+		TRACE_ZONE("Main::physics_step");
 		Engine::get_singleton()->_in_physics = true;
 		Engine::get_singleton()->_physics_frames++;
 
@@ -4079,7 +4129,10 @@ bool Main::iteration() {
 
 		uint64_t navigation_begin = OS::get_singleton()->get_ticks_usec();
 
-		NavigationServer3D::get_singleton()->process(physics_step * time_scale);
+		{
+			TRACE_ZONE("NavigationServer3D::process");
+			NavigationServer3D::get_singleton()->process(physics_step * time_scale);
+		}
 
 		navigation_process_ticks = MAX(navigation_process_ticks, OS::get_singleton()->get_ticks_usec() - navigation_begin); // keep the largest one for reference
 		navigation_process_max = MAX(OS::get_singleton()->get_ticks_usec() - navigation_begin, navigation_process_max);
@@ -4143,6 +4196,16 @@ bool Main::iteration() {
 		EngineDebugger::get_singleton()->iteration(frame_time, process_ticks, physics_process_ticks, physics_step);
 	}
 
+	{
+		uint64_t messages = 0;
+		uint64_t bytes = 0;
+		uint64_t flush_usec = 0;
+		MessageQueue::take_statistics(messages, bytes, flush_usec);
+		message_queue_messages_max = MAX(messages, message_queue_messages_max);
+		message_queue_bytes_max = MAX(bytes, message_queue_bytes_max);
+		message_queue_flush_max = MAX(flush_usec, message_queue_flush_max);
+	}
+
 	frames++;
 	Engine::get_singleton()->_process_frames++;
 
@@ -4164,9 +4227,13 @@ bool Main::iteration() {
 		performance->set_process_time(USEC_TO_SEC(process_max));
 		performance->set_physics_process_time(USEC_TO_SEC(physics_process_max));
 		performance->set_navigation_process_time(USEC_TO_SEC(navigation_process_max));
+		performance->set_message_queue_statistics(message_queue_messages_max, message_queue_bytes_max, USEC_TO_SEC(message_queue_flush_max));
 		process_max = 0;
 		physics_process_max = 0;
 		navigation_process_max = 0;
+		message_queue_messages_max = 0;
+		message_queue_bytes_max = 0;
+		message_queue_flush_max = 0;
 
 		frame %= 1000000;
 		frames = 0;
@@ -4256,6 +4323,28 @@ void Main::cleanup(bool p_force) {
 		movie_writer->end();
 	}
 
+	if (!profile_trace_path.is_empty()) {
+		TraceProfiler::stop();
+		Error err = TraceProfiler::save_chrome_trace(profile_trace_path);
+		if (err == OK) {
+			print_line(vformat("Profile trace saved to: %s", profile_trace_path));
+		} else {
+			ERR_PRINT(vformat("Failed to save profile trace to: %s (%s)", profile_trace_path, error_names[err]));
+		}
+		profile_trace_path = String();
+	}
+
+#ifdef MODULE_GDSCRIPT_ENABLED
+	if (!profile_scripts_path.is_empty()) {
+		GDScriptSampler::stop();
+		Error err = GDScriptSampler::save_folded_stacks(profile_scripts_path);
+		if (err == OK) {
+			print_line(vformat("Script profile saved to: %s (%d samples)", profile_scripts_path, GDScriptSampler::get_sample_count()));
+		}
+		profile_scripts_path = String();
+	}
+#endif // MODULE_GDSCRIPT_ENABLED
+
 	ResourceLoader::clear_thread_load_tasks();
 
 	ResourceLoader::remove_custom_loaders();
@@ -4380,6 +4469,8 @@ void Main::cleanup(bool p_force) {
 	message_queue->flush();
 	memdelete(message_queue);
 
+	FrameArena::release_thread();
+
 #if defined(STEAMAPI_ENABLED)
 	if (steam_tracker) {
 		memdelete(steam_tracker);
@@ -4395,6 +4486,11 @@ void Main::cleanup(bool p_force) {
 	}
 
 	unregister_core_types();
+	// All engine threads are gone by now.
+	TraceProfiler::finish();
+#ifdef MODULE_GDSCRIPT_ENABLED
+	GDScriptSampler::finish();
+#endif // MODULE_GDSCRIPT_ENABLED
 
 	OS::get_singleton()->benchmark_end_measure("Shutdown", "Main::Cleanup");
 	OS::get_singleton()->benchmark_dump();
@@ -91,6 +91,9 @@ void Performance::_bind_methods() {
 	BIND_ENUM_CONSTANT(NAVIGATION_EDGE_MERGE_COUNT);
 	BIND_ENUM_CONSTANT(NAVIGATION_EDGE_CONNECTION_COUNT);
 	BIND_ENUM_CONSTANT(NAVIGATION_EDGE_FREE_COUNT);
+	BIND_ENUM_CONSTANT(MESSAGE_QUEUE_MESSAGES);
+	BIND_ENUM_CONSTANT(MESSAGE_QUEUE_BYTES);
+	BIND_ENUM_CONSTANT(MESSAGE_QUEUE_FLUSH_TIME);
 	BIND_ENUM_CONSTANT(MONITOR_MAX);
 }
 
@@ -141,6 +144,9 @@ String Performance::get_monitor_name(Monitor p_monitor) const {
 		PNAME("navigation/edges_merged"),
 		PNAME("navigation/edges_connected"),
 		PNAME("navigation/edges_free"),
+		PNAME("message_queue/messages"),
+		PNAME("message_queue/bytes"),
+		PNAME("message_queue/flush_time"),
 
 	};
 
@@ -225,6 +231,12 @@ double Performance::get_monitor(Monitor p_monitor) const {
 			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_EDGE_CONNECTION_COUNT);
 		case NAVIGATION_EDGE_FREE_COUNT:
 			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_EDGE_FREE_COUNT);
+		case MESSAGE_QUEUE_MESSAGES:
+			return _message_queue_messages;
+		case MESSAGE_QUEUE_BYTES:
+			return _message_queue_bytes;
+		case MESSAGE_QUEUE_FLUSH_TIME:
+			return _message_queue_flush_time;
 
 		default: {
 		}
@@ -272,6 +284,9 @@ Performance::MonitorType Performance::get_monitor_type(Monitor p_monitor) const
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_TIME,
 
 	};
 
@@ -290,6 +305,12 @@ void Performance::set_navigation_process_time(double p_pt) {
 	_navigation_process_time = p_pt;
 }
 
+void Performance::set_message_queue_statistics(uint64_t p_messages, uint64_t p_bytes, double p_flush_time) {
+	_message_queue_messages = p_messages;
+	_message_queue_bytes = p_bytes;
+	_message_queue_flush_time = p_flush_time;
+}
+
 void Performance::add_custom_monitor(const StringName &p_id, const Callable &p_callable, const Vector<Variant> &p_args) {
 	ERR_FAIL_COND_MSG(has_custom_monitor(p_id), "Custom monitor with id '" + String(p_id) + "' already exists.");
 	_monitor_map.insert(p_id, MonitorCall(p_callable, p_args));
@@ -337,6 +358,9 @@ Performance::Performance() {
 	_process_time = 0;
 	_physics_process_time = 0;
 	_navigation_process_time = 0;
+	_message_queue_messages = 0;
+	_message_queue_bytes = 0;
+	_message_queue_flush_time = 0;
 	_monitor_modification_time = 0;
 	singleton = this;
 }
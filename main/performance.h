@@ -51,6 +51,9 @@ class Performance : public Object {
 	double _process_time;
 	double _physics_process_time;
 	double _navigation_process_time;
+	uint64_t _message_queue_messages;
+	uint64_t _message_queue_bytes;
+	double _message_queue_flush_time;
 
 	class MonitorCall {
 		Callable _callable;
@@ -100,6 +103,9 @@ public:
 		NAVIGATION_EDGE_MERGE_COUNT,
 		NAVIGATION_EDGE_CONNECTION_COUNT,
 		NAVIGATION_EDGE_FREE_COUNT,
+		MESSAGE_QUEUE_MESSAGES,
+		MESSAGE_QUEUE_BYTES,
+		MESSAGE_QUEUE_FLUSH_TIME,
 		MONITOR_MAX
 	};
 
@@ -117,6 +123,7 @@ public:
 	void set_process_time(double p_pt);
 	void set_physics_process_time(double p_pt);
 	void set_navigation_process_time(double p_pt);
+	void set_message_queue_statistics(uint64_t p_messages, uint64_t p_bytes, double p_flush_time);
 
 	void add_custom_monitor(const StringName &p_id, const Callable &p_callable, const Vector<Variant> &p_args);
 	void remove_custom_monitor(const StringName &p_id);
@@ -31,6 +31,7 @@
 #include "gdscript.h"
 
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode_buffer.h"
 #include "gdscript_cache.h"
 #include "gdscript_compiler.h"
 #include "gdscript_parser.h"
@@ -53,6 +54,7 @@
 #include "core/io/file_access_encrypted.h"
 #include "core/os/os.h"
 
+#include "scene/main/node.h"
 #include "scene/scene_string_names.h"
 
 #ifdef TOOLS_ENABLED
@@ -590,6 +592,7 @@ bool GDScript::_update_exports(bool *r_err, bool p_recursive_call, PlaceHolderSc
 				}
 				valid = false; // to show error in the editor
 				base_cache->valid = false;
+				GDScriptFunction::InlineCache::invalidate_all();
 				base_cache->inheriters_cache.clear(); // to prevent future stackoverflows
 				base_cache.unref();
 				base.unref();
@@ -762,6 +765,7 @@ Error GDScript::reload(bool p_keep_state) {
 	}
 #endif
 
+	Ref<GDScriptParserRef> parsed_ref;
 	{
 		String source_path = path;
 		if (source_path.is_empty()) {
@@ -787,6 +791,8 @@ Error GDScript::reload(bool p_keep_state) {
 					}
 				}
 			}
+			// Parsed ahead of time on a worker thread, in which case only the analysis is left to do.
+			parsed_ref = GDScriptCache::get_parsed_script(source_path);
 		}
 	}
 
@@ -799,32 +805,67 @@ Error GDScript::reload(bool p_keep_state) {
 #endif
 
 	valid = false;
-	GDScriptParser parser;
+	GDScriptFunction::InlineCache::invalidate_all();
+
+	if (!bytecode.is_empty()) {
+		Error err = GDScriptBytecodeBuffer::load(this);
+		bytecode.clear();
+		if (valid) {
+			if (err) {
+				// The script itself is loaded, but not everything it depends on.
+				_err_print_error("GDScript::reload", path.utf8().get_data(), 0, "Compile Error: Failed to load dependencies.", false, ERR_HANDLER_SCRIPT);
+				reloading = false;
+				return ERR_COMPILATION_FAILED;
+			}
+			can_run = ScriptServer::is_scripting_enabled() || tool;
+			if (can_run) {
+				err = _static_init();
+				if (err) {
+					return err;
+				}
+			}
+			reloading = false;
+			return OK;
+		}
+		print_verbose(vformat(R"(GDScript: Compiling "%s" from its tokens instead.)", path));
+	}
+
+	GDScriptParser own_parser;
+	GDScriptParser *parser = parsed_ref.is_valid() ? parsed_ref->get_parser() : &own_parser;
 	Error err;
-	if (!binary_tokens.is_empty()) {
-		err = parser.parse_binary(binary_tokens, path);
+	if (parsed_ref.is_valid()) {
+		err = parsed_ref->raise_status(GDScriptParserRef::PARSED);
+	} else if (!binary_tokens.is_empty()) {
+		err = parser->parse_binary(binary_tokens, path);
 	} else {
-		err = parser.parse(source, path, false);
+		err = parser->parse(source, path, false);
 	}
 	if (err) {
 		if (EngineDebugger::is_active()) {
-			GDScriptLanguage::get_singleton()->debug_break_parse(_get_debug_path(), parser.get_errors().front()->get().line, "Parser Error: " + parser.get_errors().front()->get().message);
+			GDScriptLanguage::get_singleton()->debug_break_parse(_get_debug_path(), parser->get_errors().front()->get().line, "Parser Error: " + parser->get_errors().front()->get().message);
 		}
 		// TODO: Show all error messages.
-		_err_print_error("GDScript::reload", path.is_empty() ? "built-in" : (const char *)path.utf8().get_data(), parser.get_errors().front()->get().line, ("Parse Error: " + parser.get_errors().front()->get().message).utf8().get_data(), false, ERR_HANDLER_SCRIPT);
+		_err_print_error("GDScript::reload", path.is_empty() ? "built-in" : (const char *)path.utf8().get_data(), parser->get_errors().front()->get().line, ("Parse Error: " + parser->get_errors().front()->get().message).utf8().get_data(), false, ERR_HANDLER_SCRIPT);
 		reloading = false;
 		return ERR_PARSE_ERROR;
 	}
 
-	GDScriptAnalyzer analyzer(&parser);
-	err = analyzer.analyze();
+	if (parsed_ref.is_valid()) {
+		err = parsed_ref->raise_status(GDScriptParserRef::FULLY_SOLVED);
+		if (!err) {
+			err = parsed_ref->get_analyzer()->resolve_dependencies();
+		}
+	} else {
+		GDScriptAnalyzer analyzer(parser);
+		err = analyzer.analyze();
+	}
 
 	if (err) {
 		if (EngineDebugger::is_active()) {
-			GDScriptLanguage::get_singleton()->debug_break_parse(_get_debug_path(), parser.get_errors().front()->get().line, "Parser Error: " + parser.get_errors().front()->get().message);
+			GDScriptLanguage::get_singleton()->debug_break_parse(_get_debug_path(), parser->get_errors().front()->get().line, "Parser Error: " + parser->get_errors().front()->get().message);
 		}
 
-		const List<GDScriptParser::ParserError>::Element *e = parser.get_errors().front();
+		const List<GDScriptParser::ParserError>::Element *e = parser->get_errors().front();
 		while (e != nullptr) {
 			_err_print_error("GDScript::reload", path.is_empty() ? "built-in" : (const char *)path.utf8().get_data(), e->get().line, ("Parse Error: " + e->get().message).utf8().get_data(), false, ERR_HANDLER_SCRIPT);
 			e = e->next();
@@ -833,10 +874,10 @@ Error GDScript::reload(bool p_keep_state) {
 		return ERR_PARSE_ERROR;
 	}
 
-	can_run = ScriptServer::is_scripting_enabled() || parser.is_tool();
+	can_run = ScriptServer::is_scripting_enabled() || parser->is_tool();
 
 	GDScriptCompiler compiler;
-	err = compiler.compile(&parser, this, p_keep_state);
+	err = compiler.compile(parser, this, p_keep_state);
 
 	if (err) {
 		_err_print_error("GDScript::reload", path.is_empty() ? "built-in" : (const char *)path.utf8().get_data(), compiler.get_error_line(), ("Compile Error: " + compiler.get_error()).utf8().get_data(), false, ERR_HANDLER_SCRIPT);
@@ -855,11 +896,11 @@ Error GDScript::reload(bool p_keep_state) {
 #ifdef TOOLS_ENABLED
 	// Done after compilation because it needs the GDScript object's inner class GDScript objects,
 	// which are made by calling make_scripts() within compiler.compile() above.
-	GDScriptDocGen::generate_docs(this, parser.get_tree());
+	GDScriptDocGen::generate_docs(this, parser->get_tree());
 #endif
 
 #ifdef DEBUG_ENABLED
-	for (const GDScriptWarning &warning : parser.get_warnings()) {
+	for (const GDScriptWarning &warning : parser->get_warnings()) {
 		if (EngineDebugger::is_active()) {
 			Vector<ScriptLanguage::StackInfo> si;
 			EngineDebugger::get_script_debugger()->send_error("", get_script_path(), warning.start_line, warning.get_name(), warning.get_message(), false, ERR_HANDLER_WARNING, si);
@@ -2140,9 +2181,8 @@ GDScriptInstance::GDScriptInstance() {
 	base_ref_counted = false;
 }
 
-GDScriptInstance::~GDScriptInstance() {
-	MutexLock lock(GDScriptLanguage::get_singleton()->mutex);
-
+void GDScriptInstance::_clear_pending_func_states() {
+	// Must be called with the language mutex locked.
 	while (SelfList<GDScriptFunctionState> *E = pending_func_states.first()) {
 		// Order matters since clearing the stack may already cause
 		// the GDSCriptFunctionState to be destroyed and thus removed from the list.
@@ -2154,6 +2194,49 @@ GDScriptInstance::~GDScriptInstance() {
 			state->_clear_stack();
 		}
 	}
+}
+
+bool GDScriptInstance::reset_members() {
+	ERR_FAIL_COND_V(script.is_null() || !script->valid, false);
+
+	{
+		// Functions awaiting on the previous use of the object must not resume.
+		MutexLock lock(GDScriptLanguage::get_singleton()->mutex);
+		_clear_pending_func_states();
+	}
+
+	Variant *member_ptr = members.ptrw();
+	for (int i = 0; i < members.size(); i++) {
+		member_ptr[i] = Variant();
+	}
+
+	Callable::CallError err;
+	script->_super_implicit_constructor(script.ptr(), this, err);
+	if (err.error != Callable::CallError::CALL_OK) {
+		return false;
+	}
+
+	// Like a new instance, which the pool creates without arguments too.
+	GDScriptFunction *initializer = script->_super_constructor(script.ptr());
+	if (initializer != nullptr) {
+		initializer->call(this, nullptr, 0, err);
+		if (err.error != Callable::CallError::CALL_OK) {
+			return false;
+		}
+	}
+
+	// Nodes that got ready keep their children, so @onready members can be assigned again right away.
+	const Node *node = Object::cast_to<Node>(owner);
+	if (node && node->is_ready()) {
+		_call_implicit_ready_recursively(script.ptr());
+	}
+	return true;
+}
+
+GDScriptInstance::~GDScriptInstance() {
+	MutexLock lock(GDScriptLanguage::get_singleton()->mutex);
+
+	_clear_pending_func_states();
 
 	if (script.is_valid() && owner) {
 		script->instances.erase(owner);
@@ -2236,6 +2319,23 @@ void GDScriptLanguage::init() {
 		_add_global(E.name, E.ptr);
 	}
 
+	// Get the scripts the project is going to load first parsed on all threads, along with
+	// everything they depend on. They are kept until the first frame, see frame().
+	if (!Engine::get_singleton()->is_editor_hint()) {
+		Vector<String> paths;
+		List<StringName> global_classes;
+		ScriptServer::get_global_class_list(&global_classes);
+		for (const StringName &class_name : global_classes) {
+			if (ScriptServer::get_global_class_language(class_name) == get_name()) {
+				paths.push_back(ScriptServer::get_global_class_path(class_name));
+			}
+		}
+		for (const KeyValue<StringName, ProjectSettings::AutoloadInfo> &E : ProjectSettings::get_singleton()->get_autoload_list()) {
+			paths.push_back(E.value.path);
+		}
+		GDScriptCache::parse_scripts(paths);
+	}
+
 #ifdef TESTS_ENABLED
 	GDScriptTests::GDScriptTestRunner::handle_cmdline();
 #endif
@@ -2309,6 +2409,12 @@ void GDScriptLanguage::profiling_start() {
 		elem->self()->profile.last_frame_call_count = 0;
 		elem->self()->profile.last_frame_self_time = 0;
 		elem->self()->profile.last_frame_total_time = 0;
+		elem->self()->profile.inline_cache_hits.set(0);
+		elem->self()->profile.inline_cache_misses.set(0);
+		elem->self()->profile.frame_inline_cache_hits.set(0);
+		elem->self()->profile.frame_inline_cache_misses.set(0);
+		elem->self()->profile.last_frame_inline_cache_hits = 0;
+		elem->self()->profile.last_frame_inline_cache_misses = 0;
 		elem->self()->profile.native_calls.clear();
 		elem->self()->profile.last_native_calls.clear();
 		elem = elem->next();
@@ -2349,6 +2455,8 @@ int GDScriptLanguage::profiling_get_accumulated_data(ProfilingInfo *p_info_arr,
 		p_info_arr[current].call_count = elem->self()->profile.call_count.get();
 		p_info_arr[current].self_time = elem->self()->profile.self_time.get();
 		p_info_arr[current].total_time = elem->self()->profile.total_time.get();
+		p_info_arr[current].inline_cache_hits = elem->self()->profile.inline_cache_hits.get();
+		p_info_arr[current].inline_cache_misses = elem->self()->profile.inline_cache_misses.get();
 		p_info_arr[current].signature = elem->self()->profile.signature;
 		current++;
 
@@ -2358,6 +2466,8 @@ int GDScriptLanguage::profiling_get_accumulated_data(ProfilingInfo *p_info_arr,
 			p_info_arr[current].call_count = nat_calls->value.call_count;
 			p_info_arr[current].total_time = nat_calls->value.total_time;
 			p_info_arr[current].self_time = nat_calls->value.total_time;
+			p_info_arr[current].inline_cache_hits = 0;
+			p_info_arr[current].inline_cache_misses = 0;
 			p_info_arr[current].signature = nat_calls->value.signature;
 			nat_time += nat_calls->value.total_time;
 			current++;
@@ -2388,6 +2498,8 @@ int GDScriptLanguage::profiling_get_frame_data(ProfilingInfo *p_info_arr, int p_
 			p_info_arr[current].call_count = elem->self()->profile.last_frame_call_count;
 			p_info_arr[current].self_time = elem->self()->profile.last_frame_self_time;
 			p_info_arr[current].total_time = elem->self()->profile.last_frame_total_time;
+			p_info_arr[current].inline_cache_hits = elem->self()->profile.last_frame_inline_cache_hits;
+			p_info_arr[current].inline_cache_misses = elem->self()->profile.last_frame_inline_cache_misses;
 			p_info_arr[current].signature = elem->self()->profile.signature;
 			current++;
 
@@ -2398,6 +2510,8 @@ int GDScriptLanguage::profiling_get_frame_data(ProfilingInfo *p_info_arr, int p_
 				p_info_arr[current].total_time = nat_calls->value.total_time;
 				p_info_arr[current].self_time = nat_calls->value.total_time;
 				p_info_arr[current].internal_time = nat_calls->value.total_time;
+				p_info_arr[current].inline_cache_hits = 0;
+				p_info_arr[current].inline_cache_misses = 0;
 				p_info_arr[current].signature = nat_calls->value.signature;
 				nat_time += nat_calls->value.total_time;
 				current++;
@@ -2628,6 +2742,12 @@ void GDScriptLanguage::reload_tool_script(const Ref<Script> &p_script, bool p_so
 void GDScriptLanguage::frame() {
 	calls = 0;
 
+	if (unlikely(first_frame)) {
+		// Startup is over, scripts parsed ahead of time that weren't loaded by now aren't needed yet.
+		GDScriptCache::release_parsed_scripts();
+		first_frame = false;
+	}
+
 #ifdef DEBUG_ENABLED
 	if (profiling) {
 		MutexLock lock(mutex);
@@ -2637,10 +2757,14 @@ void GDScriptLanguage::frame() {
 			elem->self()->profile.last_frame_call_count = elem->self()->profile.frame_call_count.get();
 			elem->self()->profile.last_frame_self_time = elem->self()->profile.frame_self_time.get();
 			elem->self()->profile.last_frame_total_time = elem->self()->profile.frame_total_time.get();
+			elem->self()->profile.last_frame_inline_cache_hits = elem->self()->profile.frame_inline_cache_hits.get();
+			elem->self()->profile.last_frame_inline_cache_misses = elem->self()->profile.frame_inline_cache_misses.get();
 			elem->self()->profile.last_native_calls = elem->self()->profile.native_calls;
 			elem->self()->profile.frame_call_count.set(0);
 			elem->self()->profile.frame_self_time.set(0);
 			elem->self()->profile.frame_total_time.set(0);
+			elem->self()->profile.frame_inline_cache_hits.set(0);
+			elem->self()->profile.frame_inline_cache_misses.set(0);
 			elem->self()->profile.native_calls.clear();
 			elem = elem->next();
 		}
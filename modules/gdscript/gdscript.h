@@ -84,6 +84,7 @@ class GDScript : public Script {
 	friend class GDScriptInstance;
 	friend class GDScriptFunction;
 	friend class GDScriptAnalyzer;
+	friend class GDScriptBytecodeBuffer;
 	friend class GDScriptCompiler;
 	friend class GDScriptDocGen;
 	friend class GDScriptLambdaCallable;
@@ -178,6 +179,7 @@ private:
 	//exported members
 	String source;
 	Vector<uint8_t> binary_tokens;
+	Vector<uint8_t> bytecode; // Loaded instead of compiling the tokens, when exported with them.
 	String path;
 	bool path_valid = false; // False if using default path.
 	StringName local_name; // Inner class identifier or `class_name`.
@@ -367,6 +369,7 @@ class GDScriptInstance : public ScriptInstance {
 	SelfList<GDScriptFunctionState>::List pending_func_states;
 
 	void _call_implicit_ready_recursively(GDScript *p_script);
+	void _clear_pending_func_states();
 
 public:
 	virtual Object *get_owner() { return owner; }
@@ -399,6 +402,7 @@ public:
 	void set_path(const String &p_path);
 
 	void reload_members();
+	virtual bool reset_members() override;
 
 	virtual const Variant get_rpc_config() const;
 
@@ -465,6 +469,8 @@ class GDScriptLanguage : public ScriptLanguage {
 
 	HashMap<String, ObjectID> orphan_subclasses;
 
+	bool first_frame = true;
+
 public:
 	int calls;
 
@@ -152,6 +152,7 @@ void GDScriptByteCodeGenerator::start_parameters() {
 	if (function->_default_arg_count > 0) {
 		append(GDScriptFunction::OPCODE_JUMP_TO_DEF_ARGUMENT);
 		function->default_arguments.push_back(opcodes.size());
+		add_jump_target(opcodes.size());
 	}
 }
 
@@ -395,6 +396,9 @@ GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
 		function->_lambdas_count = 0;
 	}
 
+	function->_inline_caches_ptr = inline_cache_count ? memnew_arr(GDScriptFunction::InlineCache, inline_cache_count) : nullptr;
+	function->_inline_caches_count = inline_cache_count;
+
 	if (debug_stack) {
 		function->stack_debug = stack_debug;
 	}
@@ -554,12 +558,159 @@ void GDScriptByteCodeGenerator::write_type_adjust(const Address &p_target, Varia
 	append(p_target);
 }
 
+static GDScriptFunction::Opcode get_typed_operator_opcode(Variant::Operator p_operator, Variant::Type p_left_type, Variant::Type p_right_type) {
+	if (p_right_type == Variant::NIL) {
+		// Unary operators.
+		if (p_left_type == Variant::INT && p_operator == Variant::OP_NEGATE) {
+			return GDScriptFunction::OPCODE_OPERATOR_NEGATE_INT;
+		} else if (p_left_type == Variant::FLOAT && p_operator == Variant::OP_NEGATE) {
+			return GDScriptFunction::OPCODE_OPERATOR_NEGATE_FLOAT;
+		} else if (p_left_type == Variant::BOOL && p_operator == Variant::OP_NOT) {
+			return GDScriptFunction::OPCODE_OPERATOR_NOT_BOOL;
+		}
+		return GDScriptFunction::OPCODE_OPERATOR_VALIDATED;
+	}
+
+#define TYPED_OPERATOR(m_operator, m_type) \
+	case Variant::OP_##m_operator:         \
+		return GDScriptFunction::OPCODE_OPERATOR_##m_operator##_##m_type
+
+#define TYPED_COMPARISONS(m_type)       \
+	TYPED_OPERATOR(EQUAL, m_type);      \
+	TYPED_OPERATOR(NOT_EQUAL, m_type);  \
+	TYPED_OPERATOR(LESS, m_type);       \
+	TYPED_OPERATOR(LESS_EQUAL, m_type); \
+	TYPED_OPERATOR(GREATER, m_type);    \
+	TYPED_OPERATOR(GREATER_EQUAL, m_type)
+
+	if (p_left_type == Variant::INT && p_right_type == Variant::INT) {
+		// Division and modulo are left out, they need to check for division by zero.
+		switch (p_operator) {
+			TYPED_OPERATOR(ADD, INT);
+			TYPED_OPERATOR(SUBTRACT, INT);
+			TYPED_OPERATOR(MULTIPLY, INT);
+			TYPED_COMPARISONS(INT);
+			default:
+				break;
+		}
+	} else if (p_left_type == Variant::FLOAT && p_right_type == Variant::FLOAT) {
+		switch (p_operator) {
+			TYPED_OPERATOR(ADD, FLOAT);
+			TYPED_OPERATOR(SUBTRACT, FLOAT);
+			TYPED_OPERATOR(MULTIPLY, FLOAT);
+			TYPED_OPERATOR(DIVIDE, FLOAT);
+			TYPED_COMPARISONS(FLOAT);
+			default:
+				break;
+		}
+	} else if (p_left_type == Variant::BOOL && p_right_type == Variant::BOOL) {
+		switch (p_operator) {
+			TYPED_OPERATOR(EQUAL, BOOL);
+			TYPED_OPERATOR(NOT_EQUAL, BOOL);
+			default:
+				break;
+		}
+	} else if (p_left_type == Variant::VECTOR2 && p_right_type == Variant::VECTOR2) {
+		switch (p_operator) {
+			TYPED_OPERATOR(ADD, VECTOR2);
+			TYPED_OPERATOR(SUBTRACT, VECTOR2);
+			TYPED_OPERATOR(MULTIPLY, VECTOR2);
+			default:
+				break;
+		}
+	} else if (p_left_type == Variant::VECTOR3 && p_right_type == Variant::VECTOR3) {
+		switch (p_operator) {
+			TYPED_OPERATOR(ADD, VECTOR3);
+			TYPED_OPERATOR(SUBTRACT, VECTOR3);
+			TYPED_OPERATOR(MULTIPLY, VECTOR3);
+			default:
+				break;
+		}
+	} else if (p_left_type == Variant::VECTOR2 && p_right_type == Variant::FLOAT && p_operator == Variant::OP_MULTIPLY) {
+		return GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_VECTOR2_FLOAT;
+	} else if (p_left_type == Variant::VECTOR3 && p_right_type == Variant::FLOAT && p_operator == Variant::OP_MULTIPLY) {
+		return GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_VECTOR3_FLOAT;
+	}
+
+#undef TYPED_COMPARISONS
+#undef TYPED_OPERATOR
+
+	return GDScriptFunction::OPCODE_OPERATOR_VALIDATED;
+}
+
+static GDScriptFunction::Opcode get_typed_jump_if_not_opcode(int p_operator_opcode) {
+	switch (p_operator_opcode) {
+		case GDScriptFunction::OPCODE_OPERATOR_EQUAL_INT:
+			return GDScriptFunction::OPCODE_JUMP_IF_NOT_EQUAL_INT;
+		case GDScriptFunction::OPCODE_OPERATOR_NOT_EQUAL_INT:
+			return GDScriptFunction::OPCODE_JUMP_IF_NOT_NOT_EQUAL_INT;
+		case GDScriptFunction::OPCODE_OPERATOR_LESS_INT:
+			return GDScriptFunction::OPCODE_JUMP_IF_NOT_LESS_INT;
+		case GDScriptFunction::OPCODE_OPERATOR_LESS_EQUAL_INT:
+			return GDScriptFunction::OPCODE_JUMP_IF_NOT_LESS_EQUAL_INT;
+		case GDScriptFunction::OPCODE_OPERATOR_GREATER_INT:
+			return GDScriptFunction::OPCODE_JUMP_IF_NOT_GREATER_INT;
+		case GDScriptFunction::OPCODE_OPERATOR_GREATER_EQUAL_INT:
+			return GDScriptFunction::OPCODE_JUMP_IF_NOT_GREATER_EQUAL_INT;
+		case GDScriptFunction::OPCODE_OPERATOR_EQUAL_FLOAT:
+			return GDScriptFunction::OPCODE_JUMP_IF_NOT_EQUAL_FLOAT;
+		case GDScriptFunction::OPCODE_OPERATOR_NOT_EQUAL_FLOAT:
+			return GDScriptFunction::OPCODE_JUMP_IF_NOT_NOT_EQUAL_FLOAT;
+		case GDScriptFunction::OPCODE_OPERATOR_LESS_FLOAT:
+			return GDScriptFunction::OPCODE_JUMP_IF_NOT_LESS_FLOAT;
+		case GDScriptFunction::OPCODE_OPERATOR_LESS_EQUAL_FLOAT:
+			return GDScriptFunction::OPCODE_JUMP_IF_NOT_LESS_EQUAL_FLOAT;
+		case GDScriptFunction::OPCODE_OPERATOR_GREATER_FLOAT:
+			return GDScriptFunction::OPCODE_JUMP_IF_NOT_GREATER_FLOAT;
+		case GDScriptFunction::OPCODE_OPERATOR_GREATER_EQUAL_FLOAT:
+			return GDScriptFunction::OPCODE_JUMP_IF_NOT_GREATER_EQUAL_FLOAT;
+		default:
+			return GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT;
+	}
+}
+
+bool GDScriptByteCodeGenerator::promote_int_constant(Address &r_address) {
+	if (r_address.mode != Address::CONSTANT || !HAS_BUILTIN_TYPE(r_address) || r_address.type.builtin_type != Variant::INT) {
+		return false;
+	}
+
+	int64_t value = 0;
+	bool found = false;
+	for (const KeyValue<Variant, int> &E : constant_map) {
+		if (E.value == (int)r_address.address) {
+			value = E.key;
+			found = true;
+			break;
+		}
+	}
+	// Only when the conversion is exact, so the result is the same as converting at runtime.
+	constexpr int64_t max_exact = int64_t(1) << 53;
+	if (!found || value < -max_exact || value > max_exact) {
+		return false;
+	}
+
+	r_address.address = get_constant_pos(double(value));
+	r_address.type.builtin_type = Variant::FLOAT;
+	return true;
+}
+
 void GDScriptByteCodeGenerator::write_unary_operator(const Address &p_target, Variant::Operator p_operator, const Address &p_left_operand) {
 	if (HAS_BUILTIN_TYPE(p_left_operand)) {
+		if (p_target.mode == Address::TEMPORARY) {
+			Variant::Type result_type = Variant::get_operator_return_type(p_operator, p_left_operand.type.builtin_type, Variant::NIL);
+			if (result_type != temporaries[p_target.address].type) {
+				write_type_adjust(p_target, result_type);
+			}
+
+			last_operator_pos = opcodes.size();
+			last_operator_target = p_target.address;
+			last_operator_type = result_type;
+		}
+
 		// Gather specific operator.
 		Variant::ValidatedOperatorEvaluator op_func = Variant::get_validated_operator_evaluator(p_operator, p_left_operand.type.builtin_type, Variant::NIL);
 
-		append_opcode(GDScriptFunction::OPCODE_OPERATOR_VALIDATED);
+		append_opcode(get_typed_operator_opcode(p_operator, p_left_operand.type.builtin_type, Variant::NIL));
 		append(p_left_operand);
 		append(Address());
 		append(p_target);
@@ -571,6 +722,7 @@ void GDScriptByteCodeGenerator::write_unary_operator(const Address &p_target, Va
 	}
 
 	// No specific types, perform variant evaluation.
+	function->relocations.push_back(opcodes.size()); // The evaluator is cached in the code.
 	append_opcode(GDScriptFunction::OPCODE_OPERATOR);
 	append(p_left_operand);
 	append(Address());
@@ -585,22 +737,40 @@ void GDScriptByteCodeGenerator::write_unary_operator(const Address &p_target, Va
 }
 
 void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, Variant::Operator p_operator, const Address &p_left_operand, const Address &p_right_operand) {
+	Address left_operand = p_left_operand;
+	Address right_operand = p_right_operand;
+	if (HAS_BUILTIN_TYPE(left_operand) && HAS_BUILTIN_TYPE(right_operand)) {
+		// Typed code often mixes floats with int literals (e.g. `x * 2`), use the float literal instead when it allows a typed operator.
+		const Variant::Type left_type = left_operand.type.builtin_type;
+		const Variant::Type right_type = right_operand.type.builtin_type;
+		if (get_typed_operator_opcode(p_operator, left_type, Variant::FLOAT) != GDScriptFunction::OPCODE_OPERATOR_VALIDATED && right_type == Variant::INT) {
+			promote_int_constant(right_operand);
+		} else if (get_typed_operator_opcode(p_operator, Variant::FLOAT, right_type) != GDScriptFunction::OPCODE_OPERATOR_VALIDATED && left_type == Variant::INT) {
+			promote_int_constant(left_operand);
+		}
+	}
+
 	// Avoid validated evaluator for modulo and division when operands are int, since there's no check for division by zero.
-	if (HAS_BUILTIN_TYPE(p_left_operand) && HAS_BUILTIN_TYPE(p_right_operand) && ((p_operator != Variant::OP_DIVIDE && p_operator != Variant::OP_MODULE) || p_left_operand.type.builtin_type != Variant::INT || p_right_operand.type.builtin_type != Variant::INT)) {
+	if (HAS_BUILTIN_TYPE(left_operand) && HAS_BUILTIN_TYPE(right_operand) && ((p_operator != Variant::OP_DIVIDE && p_operator != Variant::OP_MODULE) || left_operand.type.builtin_type != Variant::INT || right_operand.type.builtin_type != Variant::INT)) {
+		Variant::Type result_type = Variant::get_operator_return_type(p_operator, left_operand.type.builtin_type, right_operand.type.builtin_type);
 		if (p_target.mode == Address::TEMPORARY) {
-			Variant::Type result_type = Variant::get_operator_return_type(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
 			Variant::Type temp_type = temporaries[p_target.address].type;
 			if (result_type != temp_type) {
 				write_type_adjust(p_target, result_type);
 			}
+
+			last_operator_pos = opcodes.size();
+			last_operator_target = p_target.address;
+			last_operator_type = result_type;
 		}
 
 		// Gather specific operator.
-		Variant::ValidatedOperatorEvaluator op_func = Variant::get_validated_operator_evaluator(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
+		Variant::ValidatedOperatorEvaluator op_func = Variant::get_validated_operator_evaluator(p_operator, left_operand.type.builtin_type, right_operand.type.builtin_type);
 
-		append_opcode(GDScriptFunction::OPCODE_OPERATOR_VALIDATED);
-		append(p_left_operand);
-		append(p_right_operand);
+		// The evaluator is still referenced by typed operators, for the disassembler and in case they get fused.
+		append_opcode(get_typed_operator_opcode(p_operator, left_operand.type.builtin_type, right_operand.type.builtin_type));
+		append(left_operand);
+		append(right_operand);
 		append(p_target);
 		append(op_func);
 #ifdef DEBUG_ENABLED
@@ -610,9 +780,10 @@ void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, V
 	}
 
 	// No specific types, perform variant evaluation.
+	function->relocations.push_back(opcodes.size()); // The evaluator is cached in the code.
 	append_opcode(GDScriptFunction::OPCODE_OPERATOR);
-	append(p_left_operand);
-	append(p_right_operand);
+	append(left_operand);
+	append(right_operand);
 	append(p_target);
 	append(p_operator);
 	append(0); // Signature storage.
@@ -663,16 +834,29 @@ void GDScriptByteCodeGenerator::write_type_test(const Address &p_target, const A
 	}
 }
 
+void GDScriptByteCodeGenerator::append_conditional_jump(bool p_jump_if_true, const Address &p_condition) {
+	// A comparison right before the jump becomes a single instruction, which still stores its result.
+	const bool fuse = p_condition.mode == Address::TEMPORARY && last_operator_type == Variant::BOOL && last_operator_target == (int)p_condition.address &&
+			last_operator_pos + 5 == opcodes.size() && last_operator_pos >= jump_target_barrier;
+	if (fuse) {
+		// Conditions of `if` and `while` jump when false, these have typed versions for comparisons.
+		opcodes.write[last_operator_pos] = p_jump_if_true ? GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF : get_typed_jump_if_not_opcode(opcodes[last_operator_pos]);
+		last_operator_pos = -1;
+		return;
+	}
+
+	append_opcode(p_jump_if_true ? GDScriptFunction::OPCODE_JUMP_IF : GDScriptFunction::OPCODE_JUMP_IF_NOT);
+	append(p_condition);
+}
+
 void GDScriptByteCodeGenerator::write_and_left_operand(const Address &p_left_operand) {
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-	append(p_left_operand);
+	append_conditional_jump(false, p_left_operand);
 	logic_op_jump_pos1.push_back(opcodes.size());
 	append(0); // Jump target, will be patched.
 }
 
 void GDScriptByteCodeGenerator::write_and_right_operand(const Address &p_right_operand) {
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-	append(p_right_operand);
+	append_conditional_jump(false, p_right_operand);
 	logic_op_jump_pos2.push_back(opcodes.size());
 	append(0); // Jump target, will be patched.
 }
@@ -683,7 +867,8 @@ void GDScriptByteCodeGenerator::write_end_and(const Address &p_target) {
 	append(p_target);
 	// Jump away from the fail condition.
 	append_opcode(GDScriptFunction::OPCODE_JUMP);
-	append(opcodes.size() + 3);
+	append_jump_address(opcodes.size() + 3);
+	add_jump_target(opcodes.size() + 2);
 	// Here it means one of operands is false.
 	patch_jump(logic_op_jump_pos1.back()->get());
 	patch_jump(logic_op_jump_pos2.back()->get());
@@ -694,15 +879,13 @@ void GDScriptByteCodeGenerator::write_end_and(const Address &p_target) {
 }
 
 void GDScriptByteCodeGenerator::write_or_left_operand(const Address &p_left_operand) {
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF);
-	append(p_left_operand);
+	append_conditional_jump(true, p_left_operand);
 	logic_op_jump_pos1.push_back(opcodes.size());
 	append(0); // Jump target, will be patched.
 }
 
 void GDScriptByteCodeGenerator::write_or_right_operand(const Address &p_right_operand) {
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF);
-	append(p_right_operand);
+	append_conditional_jump(true, p_right_operand);
 	logic_op_jump_pos2.push_back(opcodes.size());
 	append(0); // Jump target, will be patched.
 }
@@ -713,7 +896,8 @@ void GDScriptByteCodeGenerator::write_end_or(const Address &p_target) {
 	append(p_target);
 	// Jump away from the success condition.
 	append_opcode(GDScriptFunction::OPCODE_JUMP);
-	append(opcodes.size() + 3);
+	append_jump_address(opcodes.size() + 3);
+	add_jump_target(opcodes.size() + 2);
 	// Here it means one of operands is true.
 	patch_jump(logic_op_jump_pos1.back()->get());
 	patch_jump(logic_op_jump_pos2.back()->get());
@@ -728,8 +912,7 @@ void GDScriptByteCodeGenerator::write_start_ternary(const Address &p_target) {
 }
 
 void GDScriptByteCodeGenerator::write_ternary_condition(const Address &p_condition) {
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-	append(p_condition);
+	append_conditional_jump(false, p_condition);
 	ternary_jump_fail_pos.push_back(opcodes.size());
 	append(0); // Jump target, will be patched.
 }
@@ -850,6 +1033,7 @@ void GDScriptByteCodeGenerator::write_get_named(const Address &p_target, const S
 	append(p_source);
 	append(p_target);
 	append(p_name);
+	append_inline_cache();
 }
 
 void GDScriptByteCodeGenerator::write_set_member(const Address &p_value, const StringName &p_name) {
@@ -878,7 +1062,59 @@ void GDScriptByteCodeGenerator::write_get_static_variable(const Address &p_targe
 	append(p_index);
 }
 
+bool GDScriptByteCodeGenerator::fuse_operator_assign(const Address &p_target, const Address &p_source) {
+	if (p_source.mode != Address::TEMPORARY || last_operator_target != (int)p_source.address || last_operator_pos + 5 != opcodes.size() || last_operator_pos < jump_target_barrier) {
+		return false;
+	}
+	if (p_target.type.has_type && (p_target.type.kind != GDScriptDataType::BUILTIN || p_target.type.builtin_type != last_operator_type)) {
+		return false; // Needs conversion.
+	}
+	switch (last_operator_type) {
+		// Only types stored inline, which the operators can write to even when the destination is also an operand.
+		case Variant::BOOL:
+		case Variant::INT:
+		case Variant::FLOAT:
+		case Variant::VECTOR2:
+		case Variant::VECTOR2I:
+		case Variant::RECT2:
+		case Variant::RECT2I:
+		case Variant::VECTOR3:
+		case Variant::VECTOR3I:
+		case Variant::VECTOR4:
+		case Variant::VECTOR4I:
+		case Variant::PLANE:
+		case Variant::QUATERNION:
+		case Variant::COLOR:
+			break;
+		default:
+			return false;
+	}
+
+	// Write the result straight to the target instead of through the temporary.
+	const int target_index = last_operator_pos + 3;
+	Vector<int> &source_indices = temporaries.write[p_source.address].bytecode_indices;
+	ERR_FAIL_COND_V(source_indices.is_empty() || source_indices[source_indices.size() - 1] != target_index, false);
+	source_indices.resize(source_indices.size() - 1);
+	if (p_target.mode == Address::TEMPORARY) {
+		temporaries.write[p_target.address].bytecode_indices.push_back(target_index);
+	} else {
+		opcodes.write[target_index] = address_of(p_target);
+	}
+
+	// Typed operators already adjust the destination type.
+	if (opcodes[last_operator_pos] == GDScriptFunction::OPCODE_OPERATOR_VALIDATED) {
+		opcodes.write[last_operator_pos] = GDScriptFunction::OPCODE_OPERATOR_VALIDATED_ASSIGN;
+		append(last_operator_type);
+	}
+	last_operator_pos = -1;
+	return true;
+}
+
 void GDScriptByteCodeGenerator::write_assign_with_conversion(const Address &p_target, const Address &p_source) {
+	if (fuse_operator_assign(p_target, p_source)) {
+		return;
+	}
+
 	switch (p_target.type.kind) {
 		case GDScriptDataType::BUILTIN: {
 			if (p_target.type.builtin_type == Variant::ARRAY && p_target.type.has_container_element_type(0)) {
@@ -927,6 +1163,10 @@ void GDScriptByteCodeGenerator::write_assign_with_conversion(const Address &p_ta
 }
 
 void GDScriptByteCodeGenerator::write_assign(const Address &p_target, const Address &p_source) {
+	if (fuse_operator_assign(p_target, p_source)) {
+		return;
+	}
+
 	if (p_target.type.kind == GDScriptDataType::BUILTIN && p_target.type.builtin_type == Variant::ARRAY && p_target.type.has_container_element_type(0)) {
 		const GDScriptDataType &element_type = p_target.type.get_container_element_type(0);
 		append_opcode(GDScriptFunction::OPCODE_ASSIGN_TYPED_ARRAY);
@@ -970,15 +1210,18 @@ void GDScriptByteCodeGenerator::write_assign_default_parameter(const Address &p_
 		write_assign(p_dst, p_src);
 	}
 	function->default_arguments.push_back(opcodes.size());
+	add_jump_target(opcodes.size());
 }
 
 void GDScriptByteCodeGenerator::write_store_global(const Address &p_dst, int p_global_index) {
+	function->relocations.push_back(opcodes.size()); // Global indices depend on what's registered.
 	append_opcode(GDScriptFunction::OPCODE_STORE_GLOBAL);
 	append(p_dst);
 	append(p_global_index);
 }
 
 void GDScriptByteCodeGenerator::write_store_named_global(const Address &p_dst, const StringName &p_global) {
+	function->relocations.push_back(opcodes.size()); // Only available in the editor.
 	append_opcode(GDScriptFunction::OPCODE_STORE_NAMED_GLOBAL);
 	append(p_dst);
 	append(p_global);
@@ -1040,6 +1283,7 @@ void GDScriptByteCodeGenerator::write_call(const Address &p_target, const Addres
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1065,6 +1309,7 @@ void GDScriptByteCodeGenerator::write_call_async(const Address &p_target, const
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1299,6 +1544,7 @@ void GDScriptByteCodeGenerator::write_call_self(const Address &p_target, const S
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1312,6 +1558,7 @@ void GDScriptByteCodeGenerator::write_call_self_async(const Address &p_target, c
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1325,6 +1572,7 @@ void GDScriptByteCodeGenerator::write_call_script_function(const Address &p_targ
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1442,8 +1690,7 @@ void GDScriptByteCodeGenerator::write_await(const Address &p_target, const Addre
 }
 
 void GDScriptByteCodeGenerator::write_if(const Address &p_condition) {
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-	append(p_condition);
+	append_conditional_jump(false, p_condition);
 	if_jmp_addrs.push_back(opcodes.size());
 	append(0); // Jump destination, will be patched.
 }
@@ -1603,11 +1850,13 @@ void GDScriptByteCodeGenerator::write_for(const Address &p_variable, bool p_use_
 	for_jmp_addrs.push_back(opcodes.size());
 	append(0); // End of loop address, will be patched.
 	append_opcode(GDScriptFunction::OPCODE_JUMP);
-	append(opcodes.size() + 6); // Skip over 'continue' code.
+	append_jump_address(opcodes.size() + 6); // Skip over 'continue' code.
+	add_jump_target(opcodes.size() + 5);
 
 	// Next iteration.
 	int continue_addr = opcodes.size();
 	continue_addrs.push_back(continue_addr);
+	add_jump_target(continue_addr);
 	append_opcode(iterate_opcode);
 	append(counter);
 	append(container);
@@ -1626,7 +1875,7 @@ void GDScriptByteCodeGenerator::write_for(const Address &p_variable, bool p_use_
 void GDScriptByteCodeGenerator::write_endfor() {
 	// Jump back to loop check.
 	append_opcode(GDScriptFunction::OPCODE_JUMP);
-	append(continue_addrs.back()->get());
+	append_jump_address(continue_addrs.back()->get());
 	continue_addrs.pop_back();
 
 	// Patch end jumps (two of them).
@@ -1649,12 +1898,12 @@ void GDScriptByteCodeGenerator::write_endfor() {
 void GDScriptByteCodeGenerator::start_while_condition() {
 	current_breaks_to_patch.push_back(List<int>());
 	continue_addrs.push_back(opcodes.size());
+	add_jump_target(opcodes.size());
 }
 
 void GDScriptByteCodeGenerator::write_while(const Address &p_condition) {
 	// Condition check.
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-	append(p_condition);
+	append_conditional_jump(false, p_condition);
 	while_jmp_addrs.push_back(opcodes.size());
 	append(0); // End of loop address, will be patched.
 }
@@ -1662,7 +1911,7 @@ void GDScriptByteCodeGenerator::write_while(const Address &p_condition) {
 void GDScriptByteCodeGenerator::write_endwhile() {
 	// Jump back to loop check.
 	append_opcode(GDScriptFunction::OPCODE_JUMP);
-	append(continue_addrs.back()->get());
+	append_jump_address(continue_addrs.back()->get());
 	continue_addrs.pop_back();
 
 	// Patch end jump.
@@ -1684,14 +1933,16 @@ void GDScriptByteCodeGenerator::write_break() {
 
 void GDScriptByteCodeGenerator::write_continue() {
 	append_opcode(GDScriptFunction::OPCODE_JUMP);
-	append(continue_addrs.back()->get());
+	append_jump_address(continue_addrs.back()->get());
 }
 
 void GDScriptByteCodeGenerator::write_breakpoint() {
+	function->debug_instructions.push_back(opcodes.size());
 	append_opcode(GDScriptFunction::OPCODE_BREAKPOINT);
 }
 
 void GDScriptByteCodeGenerator::write_newline(int p_line) {
+	function->debug_instructions.push_back(opcodes.size());
 	append_opcode(GDScriptFunction::OPCODE_LINE);
 	append(p_line);
 	current_line = p_line;
@@ -1770,6 +2021,7 @@ void GDScriptByteCodeGenerator::write_return(const Address &p_return_value) {
 }
 
 void GDScriptByteCodeGenerator::write_assert(const Address &p_test, const Address &p_message) {
+	function->relocations.push_back(opcodes.size()); // The condition is only compiled in debug builds.
 	append_opcode(GDScriptFunction::OPCODE_ASSERT);
 	append(p_test);
 	append(p_message);
@@ -121,6 +121,7 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 	RBMap<GDScriptUtilityFunctions::FunctionPtr, int> gds_utilities_map;
 	RBMap<MethodBind *, int> method_bind_map;
 	RBMap<GDScriptFunction *, int> lambdas_map;
+	int inline_cache_count = 0;
 
 #ifdef DEBUG_ENABLED
 	// Keep method and property names for pointer and validated operations.
@@ -158,6 +159,13 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 
 	List<List<int>> current_breaks_to_patch;
 
+	// Typed or validated operator written last, which can be fused with the instruction consuming its result.
+	int last_operator_pos = -1;
+	int last_operator_target = -1; // Temporary slot.
+	Variant::Type last_operator_type = Variant::NIL;
+	// Highest address jumped to so far, instructions can't be fused across it.
+	int jump_target_barrier = 0;
+
 	void add_stack_identifier(const StringName &p_id, int p_stackpos) {
 		if (locals.size() > max_locals) {
 			max_locals = locals.size();
@@ -447,10 +455,29 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 		opcodes.push_back(get_lambda_function_pos(p_lambda_function));
 	}
 
+	void append_inline_cache() {
+		opcodes.push_back(inline_cache_count++);
+	}
+
+	void append_jump_address(int p_address) {
+		function->jump_operands.push_back(opcodes.size());
+		opcodes.push_back(p_address);
+	}
+
 	void patch_jump(int p_address) {
 		opcodes.write[p_address] = opcodes.size();
+		function->jump_operands.push_back(p_address);
+		add_jump_target(opcodes.size());
+	}
+
+	void add_jump_target(int p_address) {
+		jump_target_barrier = MAX(jump_target_barrier, p_address);
 	}
 
+	bool promote_int_constant(Address &r_address);
+	bool fuse_operator_assign(const Address &p_target, const Address &p_source);
+	void append_conditional_jump(bool p_jump_if_true, const Address &p_condition);
+
 public:
 	virtual uint32_t add_parameter(const StringName &p_name, bool p_is_optional, const GDScriptDataType &p_type) override;
 	virtual uint32_t add_local(const StringName &p_name, const GDScriptDataType &p_type) override;
@@ -0,0 +1,1870 @@
+/**************************************************************************/
+/*  gdscript_bytecode_buffer.cpp                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_bytecode_buffer.h"
+
+#include "gdscript.h"
+#include "gdscript_cache.h"
+#include "gdscript_function.h"
+#include "gdscript_utility_functions.h"
+
+#include "core/config/engine.h"
+#include "core/debugger/engine_debugger.h"
+#include "core/io/compression.h"
+#include "core/io/marshalls.h"
+#include "core/io/resource_loader.h"
+#include "core/version.h"
+
+#define BYTECODE_VERSION 2
+#define BYTECODE_HEADER_SIZE 16
+
+enum BytecodeScriptKind {
+	BYTECODE_SCRIPT_NONE,
+	BYTECODE_SCRIPT_GDSCRIPT, // Saved as its file and the names of its outer classes.
+	BYTECODE_SCRIPT_RESOURCE, // Any other script, saved as its file.
+};
+
+enum BytecodeConstantKind {
+	BYTECODE_CONSTANT_VALUE,
+	BYTECODE_CONSTANT_NULL_OBJECT,
+	BYTECODE_CONSTANT_ARRAY,
+	BYTECODE_CONSTANT_DICTIONARY,
+	BYTECODE_CONSTANT_SCRIPT,
+	BYTECODE_CONSTANT_NATIVE_CLASS,
+	BYTECODE_CONSTANT_SINGLETON,
+	BYTECODE_CONSTANT_RESOURCE,
+};
+
+// The opcodes and what they point to have to be the same as when the buffer was saved.
+// Debug builds also expect the line markers and assertions release builds don't compile.
+static uint32_t _get_build_hash(bool p_debug) {
+	uint32_t hash = hash_murmur3_one_32(String(VERSION_FULL_CONFIG).hash());
+	hash = hash_murmur3_one_32(p_debug, hash);
+	hash = hash_murmur3_one_32(String(VERSION_HASH).hash(), hash);
+	hash = hash_murmur3_one_32(GDScriptFunction::OPCODE_END, hash);
+	hash = hash_murmur3_one_32(Variant::VARIANT_MAX, hash);
+	hash = hash_murmur3_one_32(Variant::OP_MAX, hash);
+	// Untyped operators keep room for a function pointer in the bytecode.
+	hash = hash_murmur3_one_32(sizeof(Variant::ValidatedOperatorEvaluator), hash);
+	return hash_fmix32(hash);
+}
+
+static bool _is_file_path(const String &p_path) {
+	// Built-in resources can't be loaded on their own.
+	return !p_path.is_empty() && !p_path.contains("::");
+}
+
+/* Saving */
+
+// Names of everything the bytecode points to, by address.
+struct BytecodeReverseTables {
+	RBMap<Variant::ValidatedOperatorEvaluator, uint32_t> operators;
+	RBMap<Variant::ValidatedSetter, Pair<Variant::Type, StringName>> setters;
+	RBMap<Variant::ValidatedGetter, Pair<Variant::Type, StringName>> getters;
+	RBMap<Variant::ValidatedKeyedSetter, Variant::Type> keyed_setters;
+	RBMap<Variant::ValidatedKeyedGetter, Variant::Type> keyed_getters;
+	RBMap<Variant::ValidatedIndexedSetter, Variant::Type> indexed_setters;
+	RBMap<Variant::ValidatedIndexedGetter, Variant::Type> indexed_getters;
+	RBMap<Variant::ValidatedBuiltInMethod, Pair<Variant::Type, StringName>> builtin_methods;
+	RBMap<Variant::ValidatedConstructor, Pair<Variant::Type, int>> constructors;
+	RBMap<Variant::ValidatedUtilityFunction, StringName> utilities;
+	RBMap<GDScriptUtilityFunctions::FunctionPtr, StringName> gds_utilities;
+
+	BytecodeReverseTables() {
+		for (int type = 0; type < Variant::VARIANT_MAX; type++) {
+			const Variant::Type t = Variant::Type(type);
+
+			for (int op = 0; op < Variant::OP_MAX; op++) {
+				for (int type_b = 0; type_b < Variant::VARIANT_MAX; type_b++) {
+					Variant::ValidatedOperatorEvaluator evaluator = Variant::get_validated_operator_evaluator(Variant::Operator(op), t, Variant::Type(type_b));
+					if (evaluator && !operators.has(evaluator)) {
+						operators.insert(evaluator, op | (type << 8) | (type_b << 16));
+					}
+				}
+			}
+
+			List<StringName> members;
+			Variant::get_member_list(t, &members);
+			for (const StringName &E : members) {
+				Variant::ValidatedSetter setter = Variant::get_member_validated_setter(t, E);
+				if (setter && !setters.has(setter)) {
+					setters.insert(setter, Pair<Variant::Type, StringName>(t, E));
+				}
+				Variant::ValidatedGetter getter = Variant::get_member_validated_getter(t, E);
+				if (getter && !getters.has(getter)) {
+					getters.insert(getter, Pair<Variant::Type, StringName>(t, E));
+				}
+			}
+
+			Variant::ValidatedKeyedSetter keyed_setter = Variant::get_member_validated_keyed_setter(t);
+			if (keyed_setter && !keyed_setters.has(keyed_setter)) {
+				keyed_setters.insert(keyed_setter, t);
+			}
+			Variant::ValidatedKeyedGetter keyed_getter = Variant::get_member_validated_keyed_getter(t);
+			if (keyed_getter && !keyed_getters.has(keyed_getter)) {
+				keyed_getters.insert(keyed_getter, t);
+			}
+			Variant::ValidatedIndexedSetter indexed_setter = Variant::get_member_validated_indexed_setter(t);
+			if (indexed_setter && !indexed_setters.has(indexed_setter)) {
+				indexed_setters.insert(indexed_setter, t);
+			}
+			Variant::ValidatedIndexedGetter indexed_getter = Variant::get_member_validated_indexed_getter(t);
+			if (indexed_getter && !indexed_getters.has(indexed_getter)) {
+				indexed_getters.insert(indexed_getter, t);
+			}
+
+			List<StringName> methods;
+			Variant::get_builtin_method_list(t, &methods);
+			for (const StringName &E : methods) {
+				Variant::ValidatedBuiltInMethod method = Variant::get_validated_builtin_method(t, E);
+				if (method && !builtin_methods.has(method)) {
+					builtin_methods.insert(method, Pair<Variant::Type, StringName>(t, E));
+				}
+			}
+
+			for (int i = 0; i < Variant::get_constructor_count(t); i++) {
+				Variant::ValidatedConstructor constructor = Variant::get_validated_constructor(t, i);
+				if (constructor && !constructors.has(constructor)) {
+					constructors.insert(constructor, Pair<Variant::Type, int>(t, i));
+				}
+			}
+		}
+
+		List<StringName> functions;
+		Variant::get_utility_function_list(&functions);
+		for (const StringName &E : functions) {
+			Variant::ValidatedUtilityFunction function = Variant::get_validated_utility_function(E);
+			if (function && !utilities.has(function)) {
+				utilities.insert(function, E);
+			}
+		}
+
+		functions.clear();
+		GDScriptUtilityFunctions::get_function_list(&functions);
+		for (const StringName &E : functions) {
+			GDScriptUtilityFunctions::FunctionPtr function = GDScriptUtilityFunctions::get_function(E);
+			if (function && !gds_utilities.has(function)) {
+				gds_utilities.insert(function, E);
+			}
+		}
+	}
+};
+
+template <typename K, typename V>
+static const V *_find(const RBMap<K, V> &p_map, const K &p_key) {
+	const typename RBMap<K, V>::Element *E = p_map.find(p_key);
+	return E ? &E->value() : nullptr;
+}
+
+class GDScriptBytecodeBuffer::Writer {
+	const GDScript *main_script = nullptr;
+	const BytecodeReverseTables &tables;
+	bool debug = false;
+	HashMap<int, StringName> global_names_by_index;
+	HashMap<StringName, uint32_t> name_map;
+	Vector<StringName> names;
+	String error;
+
+public:
+	LocalVector<uint8_t> data;
+
+	void fail(const String &p_error) {
+		if (error.is_empty()) {
+			error = p_error;
+		}
+	}
+
+	const String &get_error() const { return error; }
+
+	void put_u8(uint8_t p_value) {
+		data.push_back(p_value);
+	}
+
+	void put_u32(uint32_t p_value) {
+		uint32_t pos = data.size();
+		data.resize(pos + 4);
+		encode_uint32(p_value, &data[pos]);
+	}
+
+	void put_name(const StringName &p_name) {
+		HashMap<StringName, uint32_t>::Iterator E = name_map.find(p_name);
+		if (E) {
+			put_u32(E->value);
+			return;
+		}
+		name_map.insert(p_name, names.size());
+		put_u32(names.size());
+		names.push_back(p_name);
+	}
+
+	void put_string(const String &p_string) {
+		const CharString utf8 = p_string.utf8();
+		put_u32(utf8.length());
+		uint32_t pos = data.size();
+		data.resize(pos + utf8.length());
+		memcpy(data.ptr() + pos, utf8.get_data(), utf8.length());
+	}
+
+	void put_variant(const Variant &p_value) {
+		int len = 0;
+		Error err = encode_variant(p_value, nullptr, len, false);
+		if (err != OK) {
+			fail(vformat(R"(Can't save value of type "%s".)", Variant::get_type_name(p_value.get_type())));
+			return;
+		}
+		put_u32(len);
+		uint32_t pos = data.size();
+		data.resize(pos + len);
+		encode_variant(p_value, &data[pos], len, false);
+	}
+
+	void put_script(const Script *p_script) {
+		if (p_script == nullptr) {
+			put_u8(BYTECODE_SCRIPT_NONE);
+			return;
+		}
+
+		const GDScript *gdscript = Object::cast_to<GDScript>(p_script);
+		if (gdscript == nullptr) {
+			if (!_is_file_path(p_script->get_path())) {
+				fail(vformat(R"(Can't refer to the built-in script "%s".)", p_script->get_path()));
+				return;
+			}
+			put_u8(BYTECODE_SCRIPT_RESOURCE);
+			put_string(p_script->get_path());
+			return;
+		}
+
+		Vector<StringName> class_names;
+		while (gdscript->_owner != nullptr) {
+			class_names.push_back(gdscript->local_name);
+			gdscript = gdscript->_owner;
+		}
+		if (!_is_file_path(gdscript->path)) {
+			fail(vformat(R"(Can't refer to the built-in script "%s".)", gdscript->path));
+			return;
+		}
+
+		put_u8(BYTECODE_SCRIPT_GDSCRIPT);
+		put_string(gdscript->path);
+		put_u32(class_names.size());
+		for (int i = class_names.size() - 1; i >= 0; i--) {
+			put_name(class_names[i]);
+		}
+	}
+
+	void put_constant(const Variant &p_value) {
+		switch (p_value.get_type()) {
+			case Variant::OBJECT: {
+				Object *object = p_value.get_validated_object();
+				if (object == nullptr) {
+					put_u8(BYTECODE_CONSTANT_NULL_OBJECT);
+					return;
+				}
+
+				if (const Script *script = Object::cast_to<Script>(object)) {
+					put_u8(BYTECODE_CONSTANT_SCRIPT);
+					put_script(script);
+					return;
+				}
+
+				if (const GDScriptNativeClass *native_class = Object::cast_to<GDScriptNativeClass>(object)) {
+					put_u8(BYTECODE_CONSTANT_NATIVE_CLASS);
+					put_name(native_class->get_name());
+					return;
+				}
+
+				if (const Resource *resource = Object::cast_to<Resource>(object)) {
+					if (!_is_file_path(resource->get_path())) {
+						fail(vformat(R"(Can't refer to the built-in resource "%s".)", resource->get_path()));
+						return;
+					}
+					put_u8(BYTECODE_CONSTANT_RESOURCE);
+					put_string(resource->get_path());
+					return;
+				}
+
+				List<Engine::Singleton> singletons;
+				Engine::get_singleton()->get_singletons(&singletons);
+				for (const Engine::Singleton &E : singletons) {
+					if (E.ptr == object && !Engine::get_singleton()->is_singleton_editor_only(E.name)) {
+						put_u8(BYTECODE_CONSTANT_SINGLETON);
+						put_name(E.name);
+						return;
+					}
+				}
+
+				fail(vformat(R"(Can't save constant object of class "%s".)", object->get_class()));
+			} break;
+
+			case Variant::ARRAY: {
+				const Array array = p_value;
+				put_u8(BYTECODE_CONSTANT_ARRAY);
+				put_u8(array.is_read_only());
+				put_u8(array.get_typed_builtin());
+				put_name(array.get_typed_class_name());
+				put_script(Object::cast_to<Script>(array.get_typed_script().get_validated_object()));
+				put_u32(array.size());
+				for (int i = 0; i < array.size(); i++) {
+					put_constant(array[i]);
+				}
+			} break;
+
+			case Variant::DICTIONARY: {
+				const Dictionary dictionary = p_value;
+				put_u8(BYTECODE_CONSTANT_DICTIONARY);
+				put_u8(dictionary.is_read_only());
+				put_u32(dictionary.size());
+				for (const Variant *key = dictionary.next(nullptr); key; key = dictionary.next(key)) {
+					put_constant(*key);
+					put_constant(dictionary[*key]);
+				}
+			} break;
+
+			case Variant::RID: {
+				if (RID(p_value).is_valid()) {
+					fail(R"(Can't save constant of type "RID".)");
+					return;
+				}
+				put_u8(BYTECODE_CONSTANT_VALUE);
+				put_variant(p_value);
+			} break;
+
+			case Variant::CALLABLE:
+			case Variant::SIGNAL: {
+				fail(vformat(R"(Can't save constant of type "%s".)", Variant::get_type_name(p_value.get_type())));
+			} break;
+
+			default: {
+				put_u8(BYTECODE_CONSTANT_VALUE);
+				put_variant(p_value);
+			} break;
+		}
+	}
+
+	void put_data_type(const GDScriptDataType &p_type) {
+		put_u8(p_type.has_type);
+		put_u8(p_type.kind);
+		put_u8(p_type.builtin_type);
+		put_name(p_type.native_type);
+		if (p_type.kind == GDScriptDataType::SCRIPT || p_type.kind == GDScriptDataType::GDSCRIPT) {
+			put_script(p_type.script_type);
+		}
+		put_u32(p_type.container_element_types.size());
+		for (const GDScriptDataType &element_type : p_type.container_element_types) {
+			put_data_type(element_type);
+		}
+	}
+
+	void put_property_info(const PropertyInfo &p_info) {
+		put_u8(p_info.type);
+		put_string(p_info.name);
+		put_name(p_info.class_name);
+		put_u32(p_info.hint);
+		put_string(p_info.hint_string);
+		put_u32(p_info.usage);
+	}
+
+	void put_method_info(const MethodInfo &p_info) {
+		put_string(p_info.name);
+		put_property_info(p_info.return_val);
+		put_u32(p_info.flags);
+		put_u32(p_info.id);
+		put_u32(p_info.arguments.size());
+		for (const PropertyInfo &E : p_info.arguments) {
+			put_property_info(E);
+		}
+		put_u32(p_info.default_arguments.size());
+		for (const Variant &E : p_info.default_arguments) {
+			put_constant(E);
+		}
+		put_u32(p_info.return_val_metadata);
+		put_u32(p_info.arguments_metadata.size());
+		for (int E : p_info.arguments_metadata) {
+			put_u32(E);
+		}
+	}
+
+	void put_member_info(const StringName &p_name, const GDScript::MemberInfo &p_info) {
+		put_name(p_name);
+		put_u32(p_info.index);
+		put_name(p_info.setter);
+		put_name(p_info.getter);
+		put_data_type(p_info.data_type);
+		put_property_info(p_info.property_info);
+	}
+
+	void strip_debug_instructions(const GDScriptFunction *p_function, Vector<int> &r_code, Vector<int> &r_default_arguments, Vector<int> &r_relocations);
+	void put_function(const GDScriptFunction *p_function);
+	void put_class_skeleton(const GDScript *p_class);
+	void put_class(const GDScript *p_class);
+	Vector<uint8_t> get_payload() const;
+
+	Writer(const GDScript *p_main_script, const BytecodeReverseTables &p_tables, bool p_debug) :
+			main_script(p_main_script), tables(p_tables), debug(p_debug) {
+		for (const KeyValue<StringName, int> &E : GDScriptLanguage::get_singleton()->get_global_map()) {
+			global_names_by_index.insert(E.value, E.key);
+		}
+	}
+};
+
+// Release builds don't compile line markers and breakpoints, so they're removed and every position in the code is moved along.
+void GDScriptBytecodeBuffer::Writer::strip_debug_instructions(const GDScriptFunction *p_function, Vector<int> &r_code, Vector<int> &r_default_arguments, Vector<int> &r_relocations) {
+	const int code_size = r_code.size();
+	LocalVector<bool> removed;
+	removed.resize(code_size);
+	for (int i = 0; i < code_size; i++) {
+		removed[i] = false;
+	}
+	for (int pos : p_function->debug_instructions) {
+		const int size = pos >= 0 && pos < code_size && r_code[pos] == GDScriptFunction::OPCODE_LINE ? 2 : 1;
+		if (pos < 0 || pos + size > code_size || (size == 1 && r_code[pos] != GDScriptFunction::OPCODE_BREAKPOINT)) {
+			fail(vformat(R"(Invalid code in "%s".)", p_function->name));
+			return;
+		}
+		for (int i = 0; i < size; i++) {
+			removed[pos + i] = true;
+		}
+	}
+
+	// Where each position ends up, a jump to a removed instruction goes to the one after it.
+	LocalVector<int> new_positions;
+	new_positions.resize(code_size + 1);
+	int new_size = 0;
+	for (int i = 0; i < code_size; i++) {
+		new_positions[i] = new_size;
+		if (!removed[i]) {
+			new_size++;
+		}
+	}
+	new_positions[code_size] = new_size;
+
+	for (int pos : p_function->jump_operands) {
+		if (pos < 0 || pos >= code_size || r_code[pos] < 0 || r_code[pos] > code_size) {
+			fail(vformat(R"(Invalid code in "%s".)", p_function->name));
+			return;
+		}
+		r_code.write[pos] = new_positions[r_code[pos]];
+	}
+	for (int &E : r_default_arguments) {
+		E = new_positions[E];
+	}
+	for (int &E : r_relocations) {
+		E = new_positions[E];
+	}
+
+	Vector<int> stripped;
+	stripped.resize(new_size);
+	for (int i = 0; i < code_size; i++) {
+		if (!removed[i]) {
+			stripped.write[new_positions[i]] = r_code[i];
+		}
+	}
+	r_code = stripped;
+}
+
+void GDScriptBytecodeBuffer::Writer::put_function(const GDScriptFunction *p_function) {
+	put_name(p_function->name);
+	put_u8(p_function->_static);
+	put_constant(p_function->rpc_config);
+	put_data_type(p_function->return_type);
+	put_method_info(p_function->method_info);
+	put_u32(p_function->_argument_count);
+	put_u32(p_function->argument_types.size());
+	for (const GDScriptDataType &E : p_function->argument_types) {
+		put_data_type(E);
+	}
+	put_u32(p_function->_initial_line);
+	put_u32(p_function->_stack_size);
+	put_u32(p_function->_instruction_args_size);
+
+	put_u32(p_function->temporary_slots.size());
+	for (const KeyValue<int, Variant::Type> &E : p_function->temporary_slots) {
+		put_u32(E.key);
+		put_u8(E.value);
+	}
+
+	Vector<int> code = p_function->code;
+	Vector<int> default_arguments = p_function->default_arguments;
+	Vector<int> relocation_positions = p_function->relocations;
+	if (!debug) {
+		strip_debug_instructions(p_function, code, default_arguments, relocation_positions);
+		if (!error.is_empty()) {
+			return;
+		}
+	}
+
+	put_u32(default_arguments.size());
+	for (int E : default_arguments) {
+		put_u32(E);
+	}
+
+	// What the VM caches in the code itself is cleared, and global indices are saved by name.
+	LocalVector<Pair<int, StringName>> relocations;
+	for (int pos : relocation_positions) {
+		switch (code[pos]) {
+			case GDScriptFunction::OPCODE_OPERATOR: {
+				constexpr int _pointer_size = sizeof(Variant::ValidatedOperatorEvaluator) / sizeof(int);
+				for (int i = 5; i < 7 + _pointer_size; i++) {
+					code.write[pos + i] = 0;
+				}
+				relocations.push_back(Pair<int, StringName>(pos, StringName()));
+			} break;
+			case GDScriptFunction::OPCODE_STORE_GLOBAL: {
+				const HashMap<int, StringName>::ConstIterator E = global_names_by_index.find(code[pos + 2]);
+				if (!E) {
+					fail(vformat(R"(Unknown global in "%s".)", p_function->name));
+					break;
+				}
+				relocations.push_back(Pair<int, StringName>(pos, E->value));
+			} break;
+			case GDScriptFunction::OPCODE_STORE_NAMED_GLOBAL: {
+				fail(vformat(R"(Function "%s" uses editor-only globals.)", p_function->name));
+			} break;
+			case GDScriptFunction::OPCODE_ASSERT: {
+				if (debug) {
+					relocations.push_back(Pair<int, StringName>(pos, StringName()));
+					break;
+				}
+				// The editor compiles the condition, release builds would evaluate it without checking the result.
+				fail(vformat(R"(Function "%s" has assertions.)", p_function->name));
+			} break;
+			default: {
+				fail(vformat(R"(Unexpected instruction in "%s".)", p_function->name));
+			} break;
+		}
+	}
+
+	put_u32(code.size());
+	for (int E : code) {
+		put_u32(E);
+	}
+	put_u32(relocations.size());
+	for (const Pair<int, StringName> &E : relocations) {
+		put_u32(E.first);
+		if (code[E.first] == GDScriptFunction::OPCODE_STORE_GLOBAL) {
+			put_name(E.second);
+		}
+	}
+
+	put_u32(p_function->constants.size());
+	for (const Variant &E : p_function->constants) {
+		put_constant(E);
+	}
+	put_u32(p_function->global_names.size());
+	for (const StringName &E : p_function->global_names) {
+		put_name(E);
+	}
+
+	put_u32(p_function->operator_funcs.size());
+	for (Variant::ValidatedOperatorEvaluator E : p_function->operator_funcs) {
+		const uint32_t *signature = _find(tables.operators, E);
+		if (signature == nullptr) {
+			fail(vformat(R"(Unknown operator in "%s".)", p_function->name));
+			return;
+		}
+		put_u32(*signature);
+	}
+
+	put_u32(p_function->setters.size());
+	for (Variant::ValidatedSetter E : p_function->setters) {
+		const Pair<Variant::Type, StringName> *setter = _find(tables.setters, E);
+		if (setter == nullptr) {
+			fail(vformat(R"(Unknown setter in "%s".)", p_function->name));
+			return;
+		}
+		put_u8(setter->first);
+		put_name(setter->second);
+	}
+
+	put_u32(p_function->getters.size());
+	for (Variant::ValidatedGetter E : p_function->getters) {
+		const Pair<Variant::Type, StringName> *getter = _find(tables.getters, E);
+		if (getter == nullptr) {
+			fail(vformat(R"(Unknown getter in "%s".)", p_function->name));
+			return;
+		}
+		put_u8(getter->first);
+		put_name(getter->second);
+	}
+
+	put_u32(p_function->keyed_setters.size());
+	for (Variant::ValidatedKeyedSetter E : p_function->keyed_setters) {
+		const Variant::Type *type = _find(tables.keyed_setters, E);
+		if (type == nullptr) {
+			fail(vformat(R"(Unknown keyed setter in "%s".)", p_function->name));
+			return;
+		}
+		put_u8(*type);
+	}
+
+	put_u32(p_function->keyed_getters.size());
+	for (Variant::ValidatedKeyedGetter E : p_function->keyed_getters) {
+		const Variant::Type *type = _find(tables.keyed_getters, E);
+		if (type == nullptr) {
+			fail(vformat(R"(Unknown keyed getter in "%s".)", p_function->name));
+			return;
+		}
+		put_u8(*type);
+	}
+
+	put_u32(p_function->indexed_setters.size());
+	for (Variant::ValidatedIndexedSetter E : p_function->indexed_setters) {
+		const Variant::Type *type = _find(tables.indexed_setters, E);
+		if (type == nullptr) {
+			fail(vformat(R"(Unknown indexed setter in "%s".)", p_function->name));
+			return;
+		}
+		put_u8(*type);
+	}
+
+	put_u32(p_function->indexed_getters.size());
+	for (Variant::ValidatedIndexedGetter E : p_function->indexed_getters) {
+		const Variant::Type *type = _find(tables.indexed_getters, E);
+		if (type == nullptr) {
+			fail(vformat(R"(Unknown indexed getter in "%s".)", p_function->name));
+			return;
+		}
+		put_u8(*type);
+	}
+
+	put_u32(p_function->builtin_methods.size());
+	for (Variant::ValidatedBuiltInMethod E : p_function->builtin_methods) {
+		const Pair<Variant::Type, StringName> *method = _find(tables.builtin_methods, E);
+		if (method == nullptr) {
+			fail(vformat(R"(Unknown built-in method in "%s".)", p_function->name));
+			return;
+		}
+		put_u8(method->first);
+		put_name(method->second);
+	}
+
+	put_u32(p_function->constructors.size());
+	for (Variant::ValidatedConstructor E : p_function->constructors) {
+		const Pair<Variant::Type, int> *constructor = _find(tables.constructors, E);
+		if (constructor == nullptr) {
+			fail(vformat(R"(Unknown constructor in "%s".)", p_function->name));
+			return;
+		}
+		put_u8(constructor->first);
+		put_u32(constructor->second);
+	}
+
+	put_u32(p_function->utilities.size());
+	for (Variant::ValidatedUtilityFunction E : p_function->utilities) {
+		const StringName *utility = _find(tables.utilities, E);
+		if (utility == nullptr) {
+			fail(vformat(R"(Unknown utility function in "%s".)", p_function->name));
+			return;
+		}
+		put_name(*utility);
+	}
+
+	put_u32(p_function->gds_utilities.size());
+	for (GDScriptUtilityFunctions::FunctionPtr E : p_function->gds_utilities) {
+		const StringName *utility = _find(tables.gds_utilities, E);
+		if (utility == nullptr) {
+			fail(vformat(R"(Unknown GDScript utility function in "%s".)", p_function->name));
+			return;
+		}
+		put_name(*utility);
+	}
+
+	put_u32(p_function->methods.size());
+	for (const MethodBind *E : p_function->methods) {
+		put_name(E->get_instance_class());
+		put_name(E->get_name());
+	}
+
+	put_u32(p_function->lambdas.size());
+	for (const GDScriptFunction *E : p_function->lambdas) {
+		put_function(E);
+		const GDScript::LambdaInfo *info = E->_script->lambda_info.getptr(const_cast<GDScriptFunction *>(E));
+		put_u32(info ? info->capture_count : 0);
+		put_u8(info ? info->use_self : false);
+	}
+
+	// Inline caches start empty, only their count is needed.
+	put_u32(p_function->_inline_caches_count);
+
+	// Only used for error messages and the disassembler, but written in any case so release builds read the same data.
+#ifdef DEBUG_ENABLED
+	const Vector<String> *debug_names[] = {
+		&p_function->operator_names,
+		&p_function->setter_names,
+		&p_function->getter_names,
+		&p_function->builtin_methods_names,
+		&p_function->constructors_names,
+		&p_function->utilities_names,
+		&p_function->gds_utilities_names,
+	};
+	for (const Vector<String> *names_list : debug_names) {
+		put_u32(names_list->size());
+		for (const String &E : *names_list) {
+			put_string(E);
+		}
+	}
+#else
+	for (int i = 0; i < 7; i++) {
+		put_u32(0);
+	}
+#endif
+}
+
+void GDScriptBytecodeBuffer::Writer::put_class_skeleton(const GDScript *p_class) {
+	put_string(p_class->fully_qualified_name);
+	put_name(p_class->local_name);
+	put_name(p_class->global_name);
+	put_string(p_class->simplified_icon_path);
+	put_u32(p_class->subclasses.size());
+	for (const KeyValue<StringName, Ref<GDScript>> &E : p_class->subclasses) {
+		put_name(E.key);
+		put_class_skeleton(E.value.ptr());
+	}
+}
+
+void GDScriptBytecodeBuffer::Writer::put_class(const GDScript *p_class) {
+	put_u8(p_class->tool);
+	put_name(p_class->native.is_valid() ? p_class->native->get_name() : StringName());
+	put_script(p_class->base.ptr());
+
+	const int base_member_count = p_class->base.is_valid() ? p_class->base->member_indices.size() : 0;
+	put_u32(base_member_count);
+
+	// Saved by index, members are looked up by name in base classes too.
+	Vector<StringName> member_names;
+	member_names.resize(p_class->member_indices.size() - base_member_count);
+	for (const KeyValue<StringName, GDScript::MemberInfo> &E : p_class->member_indices) {
+		if (E.value.index >= base_member_count && E.value.index - base_member_count < member_names.size()) {
+			member_names.write[E.value.index - base_member_count] = E.key;
+		}
+	}
+	put_u32(member_names.size());
+	for (const StringName &E : member_names) {
+		if (E == StringName()) {
+			fail(vformat(R"(Unexpected member layout in "%s".)", p_class->fully_qualified_name));
+			return;
+		}
+		put_member_info(E, p_class->member_indices[E]);
+	}
+
+	Vector<StringName> static_names;
+	static_names.resize(p_class->static_variables_indices.size());
+	for (const KeyValue<StringName, GDScript::MemberInfo> &E : p_class->static_variables_indices) {
+		if (E.value.index >= 0 && E.value.index < static_names.size()) {
+			static_names.write[E.value.index] = E.key;
+		}
+	}
+	put_u32(static_names.size());
+	for (const StringName &E : static_names) {
+		if (E == StringName()) {
+			fail(vformat(R"(Unexpected static variable layout in "%s".)", p_class->fully_qualified_name));
+			return;
+		}
+		put_member_info(E, p_class->static_variables_indices[E]);
+	}
+
+	put_u32(p_class->constants.size());
+	for (const KeyValue<StringName, Variant> &E : p_class->constants) {
+		put_name(E.key);
+		put_constant(E.value);
+	}
+
+	put_u32(p_class->_signals.size());
+	for (const KeyValue<StringName, MethodInfo> &E : p_class->_signals) {
+		put_name(E.key);
+		put_method_info(E.value);
+	}
+
+	put_constant(p_class->rpc_config);
+
+	put_u32(p_class->member_functions.size());
+	for (const KeyValue<StringName, GDScriptFunction *> &E : p_class->member_functions) {
+		put_function(E.value);
+	}
+
+	const GDScriptFunction *implicit_functions[] = {
+		p_class->implicit_initializer,
+		p_class->implicit_ready,
+		p_class->static_initializer,
+	};
+	for (const GDScriptFunction *function : implicit_functions) {
+		put_u8(function != nullptr);
+		if (function != nullptr) {
+			put_function(function);
+		}
+	}
+
+	put_u32(p_class->subclasses.size());
+	for (const KeyValue<StringName, Ref<GDScript>> &E : p_class->subclasses) {
+		put_class(E.value.ptr());
+	}
+}
+
+Vector<uint8_t> GDScriptBytecodeBuffer::Writer::get_payload() const {
+	Writer table(main_script, tables, debug);
+	table.put_u32(names.size());
+	for (const StringName &E : names) {
+		table.put_string(E);
+	}
+
+	Vector<uint8_t> payload;
+	payload.resize(table.data.size() + data.size());
+	memcpy(payload.ptrw(), table.data.ptr(), table.data.size());
+	memcpy(payload.ptrw() + table.data.size(), data.ptr(), data.size());
+	return payload;
+}
+
+/* Loading */
+
+struct GDScriptBytecodeBuffer::ClassData {
+	GDScript *script = nullptr;
+	bool tool = false;
+	Ref<GDScriptNativeClass> native;
+	Ref<GDScript> base;
+	bool base_is_local = false;
+	uint32_t base_member_count = 0;
+	LocalVector<Pair<StringName, GDScript::MemberInfo>> members;
+	LocalVector<Pair<StringName, GDScript::MemberInfo>> static_variables;
+	LocalVector<Pair<StringName, Variant>> constants;
+	LocalVector<Pair<StringName, MethodInfo>> signals;
+	Dictionary rpc_config;
+	LocalVector<GDScriptFunction *> functions;
+	GDScriptFunction *implicit_initializer = nullptr;
+	GDScriptFunction *implicit_ready = nullptr;
+	GDScriptFunction *static_initializer = nullptr;
+	HashMap<GDScriptFunction *, GDScript::LambdaInfo> lambda_info;
+	LocalVector<ClassData> subclasses;
+	bool applied = false;
+
+	void map_classes(HashMap<GDScript *, ClassData *> &r_classes) {
+		r_classes.insert(script, this);
+		for (ClassData &E : subclasses) {
+			E.map_classes(r_classes);
+		}
+	}
+
+	// Done base first, as inherited members come first.
+	void apply_layout(const HashMap<GDScript *, ClassData *> &p_classes) {
+		if (applied) {
+			return;
+		}
+		applied = true;
+
+		if (base_is_local) {
+			p_classes[base.ptr()]->apply_layout(p_classes);
+		}
+
+		script->tool = tool;
+		script->native = native;
+		script->base = base;
+		script->_base = base.ptr();
+		if (base.is_valid()) {
+			script->member_indices = base->member_indices;
+		}
+		for (const Pair<StringName, GDScript::MemberInfo> &E : members) {
+			script->member_indices[E.first] = E.second;
+			script->members.insert(E.first);
+		}
+		for (const Pair<StringName, GDScript::MemberInfo> &E : static_variables) {
+			script->static_variables_indices[E.first] = E.second;
+		}
+		script->static_variables.resize(script->static_variables_indices.size());
+		for (const Pair<StringName, Variant> &E : constants) {
+			script->constants.insert(E.first, E.second);
+		}
+		for (const Pair<StringName, MethodInfo> &E : signals) {
+			script->_signals[E.first] = E.second;
+		}
+		script->rpc_config = rpc_config;
+
+		for (GDScriptFunction *E : functions) {
+			script->member_functions[E->name] = E;
+		}
+		GDScriptFunction **initializer = script->member_functions.getptr(GDScriptLanguage::get_singleton()->strings._init);
+		script->initializer = initializer ? *initializer : nullptr;
+		script->implicit_initializer = implicit_initializer;
+		script->implicit_ready = implicit_ready;
+		script->static_initializer = static_initializer;
+		script->lambda_info = lambda_info;
+
+		for (ClassData &E : subclasses) {
+			E.apply_layout(p_classes);
+		}
+	}
+
+	void finish() {
+		for (ClassData &E : subclasses) {
+			E.finish();
+		}
+		script->_static_default_init();
+		script->valid = true;
+	}
+
+	// Only needed when loading fails, the script owns the functions otherwise.
+	void free_functions() {
+		for (GDScriptFunction *E : functions) {
+			memdelete(E);
+		}
+		functions.clear();
+		GDScriptFunction **implicit_functions[] = { &implicit_initializer, &implicit_ready, &static_initializer };
+		for (GDScriptFunction **function : implicit_functions) {
+			if (*function != nullptr) {
+				memdelete(*function);
+				*function = nullptr;
+			}
+		}
+		for (ClassData &E : subclasses) {
+			E.free_functions();
+		}
+	}
+};
+
+class GDScriptBytecodeBuffer::Reader {
+	GDScript *main_script = nullptr;
+	const uint8_t *buffer = nullptr;
+	uint32_t buffer_size = 0;
+	uint32_t pos = 0;
+	Vector<StringName> names;
+	String error;
+
+public:
+	bool has_failed() const { return !error.is_empty(); }
+	const String &get_error() const { return error; }
+
+	void fail(const String &p_error) {
+		if (error.is_empty()) {
+			error = p_error;
+		}
+	}
+
+	bool can_read(uint32_t p_size) {
+		if (has_failed()) {
+			return false;
+		}
+		if (p_size > buffer_size - pos) {
+			fail("Unexpected end of data.");
+			return false;
+		}
+		return true;
+	}
+
+	uint8_t get_u8() {
+		if (!can_read(1)) {
+			return 0;
+		}
+		return buffer[pos++];
+	}
+
+	uint32_t get_u32() {
+		if (!can_read(4)) {
+			return 0;
+		}
+		uint32_t value = decode_uint32(&buffer[pos]);
+		pos += 4;
+		return value;
+	}
+
+	// Counts are checked against the remaining data, to fail before allocating anything huge.
+	uint32_t get_count() {
+		uint32_t count = get_u32();
+		if (count > buffer_size - pos) {
+			fail("Invalid count.");
+			return 0;
+		}
+		return count;
+	}
+
+	Variant::Type get_variant_type() {
+		uint8_t type = get_u8();
+		if (type >= Variant::VARIANT_MAX) {
+			fail("Invalid type.");
+			return Variant::NIL;
+		}
+		return Variant::Type(type);
+	}
+
+	StringName get_name() {
+		uint32_t index = get_u32();
+		if (has_failed()) {
+			return StringName();
+		}
+		if (index >= (uint32_t)names.size()) {
+			fail("Invalid name.");
+			return StringName();
+		}
+		return names[index];
+	}
+
+	String get_string() {
+		uint32_t len = get_u32();
+		if (!can_read(len)) {
+			return String();
+		}
+		String string;
+		string.parse_utf8((const char *)&buffer[pos], len);
+		pos += len;
+		return string;
+	}
+
+	bool get_names() {
+		uint32_t count = get_count();
+		names.resize(count);
+		for (uint32_t i = 0; i < count && !has_failed(); i++) {
+			names.write[i] = get_string();
+		}
+		return !has_failed();
+	}
+
+	Variant get_variant() {
+		uint32_t len = get_u32();
+		if (!can_read(len)) {
+			return Variant();
+		}
+		Variant value;
+		if (decode_variant(value, &buffer[pos], len, nullptr, false) != OK) {
+			fail("Invalid value.");
+			return Variant();
+		}
+		pos += len;
+		return value;
+	}
+
+	Ref<Script> get_script(bool *r_local = nullptr, bool p_full = false);
+	Variant get_constant();
+	GDScriptDataType get_data_type();
+	PropertyInfo get_property_info();
+	MethodInfo get_method_info();
+	Pair<StringName, GDScript::MemberInfo> get_member_info();
+	GDScriptFunction *get_function(ClassData &r_class, bool p_lambda = false);
+	void get_class_skeleton(GDScript *p_class, bool p_create);
+	void get_class(GDScript *p_class, ClassData &r_data);
+
+	Reader(GDScript *p_main_script, const Vector<uint8_t> &p_buffer) :
+			main_script(p_main_script), buffer(p_buffer.ptr()), buffer_size(p_buffer.size()) {}
+};
+
+Ref<Script> GDScriptBytecodeBuffer::Reader::get_script(bool *r_local, bool p_full) {
+	if (r_local) {
+		*r_local = false;
+	}
+
+	switch (get_u8()) {
+		case BYTECODE_SCRIPT_NONE: {
+			return Ref<Script>();
+		}
+
+		case BYTECODE_SCRIPT_GDSCRIPT: {
+			const String path = get_string();
+			const uint32_t class_count = get_count();
+			if (has_failed()) {
+				return Ref<Script>();
+			}
+
+			Ref<GDScript> script;
+			if (path == main_script->path) {
+				script = Ref<GDScript>(main_script);
+				if (r_local) {
+					*r_local = true;
+				}
+			} else {
+				Error err = OK;
+				if (p_full) {
+					script = GDScriptCache::get_full_script(path, err, main_script->path);
+				} else {
+					script = GDScriptCache::get_shallow_script(path, err, main_script->path);
+				}
+				if (err != OK || script.is_null()) {
+					fail(vformat(R"(Can't load script "%s".)", path));
+					return Ref<Script>();
+				}
+			}
+
+			for (uint32_t i = 0; i < class_count; i++) {
+				const StringName class_name = get_name();
+				const Ref<GDScript> *subclass = script->subclasses.getptr(class_name);
+				if (has_failed() || subclass == nullptr) {
+					fail(vformat(R"(Can't find class "%s" in "%s".)", class_name, path));
+					return Ref<Script>();
+				}
+				script = *subclass;
+			}
+			return script;
+		}
+
+		case BYTECODE_SCRIPT_RESOURCE: {
+			const String path = get_string();
+			if (has_failed()) {
+				return Ref<Script>();
+			}
+			Ref<Script> script = ResourceLoader::load(path);
+			if (script.is_null()) {
+				fail(vformat(R"(Can't load script "%s".)", path));
+			}
+			return script;
+		}
+
+		default: {
+			fail("Invalid script.");
+			return Ref<Script>();
+		}
+	}
+}
+
+Variant GDScriptBytecodeBuffer::Reader::get_constant() {
+	switch (get_u8()) {
+		case BYTECODE_CONSTANT_VALUE: {
+			return get_variant();
+		}
+
+		case BYTECODE_CONSTANT_NULL_OBJECT: {
+			return Variant((Object *)nullptr);
+		}
+
+		case BYTECODE_CONSTANT_ARRAY: {
+			const bool read_only = get_u8();
+			const Variant::Type typed_builtin = get_variant_type();
+			const StringName typed_class_name = get_name();
+			const Ref<Script> typed_script = get_script();
+			const uint32_t size = get_count();
+
+			Array array;
+			if (typed_builtin != Variant::NIL) {
+				array.set_typed(typed_builtin, typed_class_name, typed_script);
+			}
+			array.resize(size);
+			for (uint32_t i = 0; i < size && !has_failed(); i++) {
+				array[i] = get_constant();
+			}
+			if (read_only) {
+				array.make_read_only();
+			}
+			return array;
+		}
+
+		case BYTECODE_CONSTANT_DICTIONARY: {
+			const bool read_only = get_u8();
+			const uint32_t size = get_count();
+
+			Dictionary dictionary;
+			for (uint32_t i = 0; i < size && !has_failed(); i++) {
+				const Variant key = get_constant();
+				dictionary[key] = get_constant();
+			}
+			if (read_only) {
+				dictionary.make_read_only();
+			}
+			return dictionary;
+		}
+
+		case BYTECODE_CONSTANT_SCRIPT: {
+			return get_script();
+		}
+
+		case BYTECODE_CONSTANT_NATIVE_CLASS: {
+			const StringName class_name = get_name();
+			const int *index = GDScriptLanguage::get_singleton()->get_global_map().getptr(class_name);
+			if (has_failed() || index == nullptr) {
+				fail(vformat(R"(Unknown native class "%s".)", class_name));
+				return Variant();
+			}
+			return GDScriptLanguage::get_singleton()->get_global_array()[*index];
+		}
+
+		case BYTECODE_CONSTANT_SINGLETON: {
+			const StringName singleton_name = get_name();
+			Object *singleton = has_failed() ? nullptr : Engine::get_singleton()->get_singleton_object(singleton_name);
+			if (singleton == nullptr) {
+				fail(vformat(R"(Unknown singleton "%s".)", singleton_name));
+				return Variant();
+			}
+			return singleton;
+		}
+
+		case BYTECODE_CONSTANT_RESOURCE: {
+			const String path = get_string();
+			if (has_failed()) {
+				return Variant();
+			}
+			Ref<Resource> resource = ResourceLoader::load(path);
+			if (resource.is_null()) {
+				fail(vformat(R"(Can't load resource "%s".)", path));
+			}
+			return resource;
+		}
+
+		default: {
+			fail("Invalid constant.");
+			return Variant();
+		}
+	}
+}
+
+GDScriptDataType GDScriptBytecodeBuffer::Reader::get_data_type() {
+	GDScriptDataType type;
+	type.has_type = get_u8();
+	const uint8_t kind = get_u8();
+	if (kind > GDScriptDataType::GDSCRIPT) {
+		fail("Invalid data type.");
+		return type;
+	}
+	type.kind = GDScriptDataType::Kind(kind);
+	type.builtin_type = get_variant_type();
+	type.native_type = get_name();
+
+	if (type.kind == GDScriptDataType::SCRIPT || type.kind == GDScriptDataType::GDSCRIPT) {
+		bool local = false;
+		Ref<Script> script = get_script(&local);
+		type.script_type = script.ptr();
+		// Same as the compiler, classes of the same file aren't referenced to avoid cycles.
+		if (!local || type.kind != GDScriptDataType::GDSCRIPT) {
+			type.script_type_ref = script;
+		}
+	}
+
+	const uint32_t container_count = get_count();
+	for (uint32_t i = 0; i < container_count && !has_failed(); i++) {
+		type.container_element_types.push_back(get_data_type());
+	}
+	return type;
+}
+
+PropertyInfo GDScriptBytecodeBuffer::Reader::get_property_info() {
+	PropertyInfo info;
+	info.type = get_variant_type();
+	info.name = get_string();
+	info.class_name = get_name();
+	info.hint = PropertyHint(get_u32());
+	info.hint_string = get_string();
+	info.usage = get_u32();
+	return info;
+}
+
+MethodInfo GDScriptBytecodeBuffer::Reader::get_method_info() {
+	MethodInfo info;
+	info.name = get_string();
+	info.return_val = get_property_info();
+	info.flags = get_u32();
+	info.id = get_u32();
+	const uint32_t argument_count = get_count();
+	for (uint32_t i = 0; i < argument_count && !has_failed(); i++) {
+		info.arguments.push_back(get_property_info());
+	}
+	const uint32_t default_argument_count = get_count();
+	for (uint32_t i = 0; i < default_argument_count && !has_failed(); i++) {
+		info.default_arguments.push_back(get_constant());
+	}
+	info.return_val_metadata = get_u32();
+	const uint32_t metadata_count = get_count();
+	for (uint32_t i = 0; i < metadata_count && !has_failed(); i++) {
+		info.arguments_metadata.push_back(get_u32());
+	}
+	return info;
+}
+
+Pair<StringName, GDScript::MemberInfo> GDScriptBytecodeBuffer::Reader::get_member_info() {
+	Pair<StringName, GDScript::MemberInfo> member;
+	member.first = get_name();
+	member.second.index = get_u32();
+	member.second.setter = get_name();
+	member.second.getter = get_name();
+	member.second.data_type = get_data_type();
+	member.second.property_info = get_property_info();
+	return member;
+}
+
+template <typename T>
+static void _update_table(const Vector<T> &p_table, int &r_count, const T *&r_ptr) {
+	r_count = p_table.size();
+	r_ptr = p_table.is_empty() ? nullptr : p_table.ptr();
+}
+
+GDScriptFunction *GDScriptBytecodeBuffer::Reader::get_function(ClassData &r_class, bool p_lambda) {
+	GDScriptFunction *function = memnew(GDScriptFunction);
+	function->_script = r_class.script;
+	function->source = r_class.script->get_script_path();
+
+	function->name = get_name();
+	function->_static = get_u8();
+	function->rpc_config = get_constant();
+	function->return_type = get_data_type();
+	function->method_info = get_method_info();
+	function->_argument_count = get_u32();
+	const uint32_t argument_type_count = get_count();
+	for (uint32_t i = 0; i < argument_type_count && !has_failed(); i++) {
+		function->argument_types.push_back(get_data_type());
+	}
+	function->_initial_line = get_u32();
+	function->_stack_size = get_u32();
+	function->_instruction_args_size = get_u32();
+
+	const uint32_t temporary_slot_count = get_count();
+	for (uint32_t i = 0; i < temporary_slot_count && !has_failed(); i++) {
+		const int slot = get_u32();
+		function->temporary_slots[slot] = get_variant_type();
+	}
+
+	const uint32_t default_argument_count = get_count();
+	for (uint32_t i = 0; i < default_argument_count && !has_failed(); i++) {
+		function->default_arguments.push_back(get_u32());
+	}
+
+	const uint32_t code_size = get_count();
+	function->code.resize(code_size);
+	for (uint32_t i = 0; i < code_size && !has_failed(); i++) {
+		function->code.write[i] = get_u32();
+	}
+
+	const uint32_t relocation_count = get_count();
+	for (uint32_t i = 0; i < relocation_count && !has_failed(); i++) {
+		const uint32_t relocation = get_u32();
+		if (relocation + 2 >= code_size) {
+			fail(vformat(R"(Invalid code in "%s".)", function->name));
+			break;
+		}
+		function->relocations.push_back(relocation);
+		if (function->code[relocation] == GDScriptFunction::OPCODE_STORE_GLOBAL) {
+			const StringName global_name = get_name();
+			const int *index = GDScriptLanguage::get_singleton()->get_global_map().getptr(global_name);
+			if (has_failed() || index == nullptr) {
+				fail(vformat(R"(Unknown global "%s".)", global_name));
+				break;
+			}
+			function->code.write[relocation + 2] = *index;
+		}
+	}
+
+	const uint32_t constant_count = get_count();
+	for (uint32_t i = 0; i < constant_count && !has_failed(); i++) {
+		function->constants.push_back(get_constant());
+	}
+
+	const uint32_t global_name_count = get_count();
+	for (uint32_t i = 0; i < global_name_count && !has_failed(); i++) {
+		function->global_names.push_back(get_name());
+	}
+
+	const uint32_t operator_count = get_count();
+	for (uint32_t i = 0; i < operator_count && !has_failed(); i++) {
+		const uint32_t signature = get_u32();
+		const uint32_t op = signature & 0xFF;
+		const uint32_t type_a = (signature >> 8) & 0xFF;
+		const uint32_t type_b = (signature >> 16) & 0xFF;
+		Variant::ValidatedOperatorEvaluator evaluator = nullptr;
+		if (op < Variant::OP_MAX && type_a < Variant::VARIANT_MAX && type_b < Variant::VARIANT_MAX) {
+			evaluator = Variant::get_validated_operator_evaluator(Variant::Operator(op), Variant::Type(type_a), Variant::Type(type_b));
+		}
+		if (evaluator == nullptr) {
+			fail("Unknown operator.");
+			break;
+		}
+		function->operator_funcs.push_back(evaluator);
+	}
+
+	const uint32_t setter_count = get_count();
+	for (uint32_t i = 0; i < setter_count && !has_failed(); i++) {
+		const Variant::Type type = get_variant_type();
+		const StringName member = get_name();
+		Variant::ValidatedSetter setter = has_failed() ? nullptr : Variant::get_member_validated_setter(type, member);
+		if (setter == nullptr) {
+			fail(vformat(R"(Unknown setter "%s.%s".)", Variant::get_type_name(type), member));
+			break;
+		}
+		function->setters.push_back(setter);
+	}
+
+	const uint32_t getter_count = get_count();
+	for (uint32_t i = 0; i < getter_count && !has_failed(); i++) {
+		const Variant::Type type = get_variant_type();
+		const StringName member = get_name();
+		Variant::ValidatedGetter getter = has_failed() ? nullptr : Variant::get_member_validated_getter(type, member);
+		if (getter == nullptr) {
+			fail(vformat(R"(Unknown getter "%s.%s".)", Variant::get_type_name(type), member));
+			break;
+		}
+		function->getters.push_back(getter);
+	}
+
+	const uint32_t keyed_setter_count = get_count();
+	for (uint32_t i = 0; i < keyed_setter_count && !has_failed(); i++) {
+		Variant::ValidatedKeyedSetter setter = Variant::get_member_validated_keyed_setter(get_variant_type());
+		if (setter == nullptr) {
+			fail("Unknown keyed setter.");
+			break;
+		}
+		function->keyed_setters.push_back(setter);
+	}
+
+	const uint32_t keyed_getter_count = get_count();
+	for (uint32_t i = 0; i < keyed_getter_count && !has_failed(); i++) {
+		Variant::ValidatedKeyedGetter getter = Variant::get_member_validated_keyed_getter(get_variant_type());
+		if (getter == nullptr) {
+			fail("Unknown keyed getter.");
+			break;
+		}
+		function->keyed_getters.push_back(getter);
+	}
+
+	const uint32_t indexed_setter_count = get_count();
+	for (uint32_t i = 0; i < indexed_setter_count && !has_failed(); i++) {
+		Variant::ValidatedIndexedSetter setter = Variant::get_member_validated_indexed_setter(get_variant_type());
+		if (setter == nullptr) {
+			fail("Unknown indexed setter.");
+			break;
+		}
+		function->indexed_setters.push_back(setter);
+	}
+
+	const uint32_t indexed_getter_count = get_count();
+	for (uint32_t i = 0; i < indexed_getter_count && !has_failed(); i++) {
+		Variant::ValidatedIndexedGetter getter = Variant::get_member_validated_indexed_getter(get_variant_type());
+		if (getter == nullptr) {
+			fail("Unknown indexed getter.");
+			break;
+		}
+		function->indexed_getters.push_back(getter);
+	}
+
+	const uint32_t builtin_method_count = get_count();
+	for (uint32_t i = 0; i < builtin_method_count && !has_failed(); i++) {
+		const Variant::Type type = get_variant_type();
+		const StringName method_name = get_name();
+		Variant::ValidatedBuiltInMethod method = has_failed() ? nullptr : Variant::get_validated_builtin_method(type, method_name);
+		if (method == nullptr) {
+			fail(vformat(R"(Unknown method "%s.%s".)", Variant::get_type_name(type), method_name));
+			break;
+		}
+		function->builtin_methods.push_back(method);
+	}
+
+	const uint32_t constructor_count = get_count();
+	for (uint32_t i = 0; i < constructor_count && !has_failed(); i++) {
+		const Variant::Type type = get_variant_type();
+		const uint32_t index = get_u32();
+		Variant::ValidatedConstructor constructor = nullptr;
+		if (!has_failed() && index < (uint32_t)Variant::get_constructor_count(type)) {
+			constructor = Variant::get_validated_constructor(type, index);
+		}
+		if (constructor == nullptr) {
+			fail(vformat(R"(Unknown constructor of "%s".)", Variant::get_type_name(type)));
+			break;
+		}
+		function->constructors.push_back(constructor);
+	}
+
+	const uint32_t utility_count = get_count();
+	for (uint32_t i = 0; i < utility_count && !has_failed(); i++) {
+		const StringName utility_name = get_name();
+		Variant::ValidatedUtilityFunction utility = has_failed() ? nullptr : Variant::get_validated_utility_function(utility_name);
+		if (utility == nullptr) {
+			fail(vformat(R"(Unknown utility function "%s".)", utility_name));
+			break;
+		}
+		function->utilities.push_back(utility);
+	}
+
+	const uint32_t gds_utility_count = get_count();
+	for (uint32_t i = 0; i < gds_utility_count && !has_failed(); i++) {
+		const StringName utility_name = get_name();
+		GDScriptUtilityFunctions::FunctionPtr utility = has_failed() ? nullptr : GDScriptUtilityFunctions::get_function(utility_name);
+		if (utility == nullptr) {
+			fail(vformat(R"(Unknown GDScript utility function "%s".)", utility_name));
+			break;
+		}
+		function->gds_utilities.push_back(utility);
+	}
+
+	const uint32_t method_count = get_count();
+	for (uint32_t i = 0; i < method_count && !has_failed(); i++) {
+		const StringName class_name = get_name();
+		const StringName method_name = get_name();
+		MethodBind *method = has_failed() ? nullptr : ClassDB::get_method(class_name, method_name);
+		if (method == nullptr) {
+			fail(vformat(R"(Unknown method "%s.%s".)", class_name, method_name));
+			break;
+		}
+		function->methods.push_back(method);
+	}
+
+	const uint32_t lambda_count = get_count();
+	for (uint32_t i = 0; i < lambda_count && !has_failed(); i++) {
+		GDScriptFunction *lambda = get_function(r_class, true);
+		function->lambdas.push_back(lambda);
+		GDScript::LambdaInfo info;
+		info.capture_count = get_u32();
+		info.use_self = get_u8();
+		r_class.lambda_info.insert(lambda, info);
+	}
+
+	const uint32_t inline_cache_count = get_u32();
+	if (inline_cache_count > code_size) {
+		fail(vformat(R"(Invalid code in "%s".)", function->name));
+	}
+
+#ifdef DEBUG_ENABLED
+	Vector<String> *debug_names[] = {
+		&function->operator_names,
+		&function->setter_names,
+		&function->getter_names,
+		&function->builtin_methods_names,
+		&function->constructors_names,
+		&function->utilities_names,
+		&function->gds_utilities_names,
+	};
+	for (Vector<String> *names_list : debug_names) {
+		const uint32_t count = get_count();
+		for (uint32_t i = 0; i < count && !has_failed(); i++) {
+			names_list->push_back(get_string());
+		}
+	}
+#else
+	for (int i = 0; i < 7; i++) {
+		const uint32_t count = get_count();
+		for (uint32_t j = 0; j < count && !has_failed(); j++) {
+			get_string();
+		}
+	}
+#endif
+
+	if (has_failed()) {
+		return function;
+	}
+
+	// Same as GDScriptByteCodeGenerator::write_end().
+	function->_code_ptr = function->code.is_empty() ? nullptr : function->code.ptrw();
+	function->_code_size = function->code.size();
+	function->_default_arg_ptr = function->default_arguments.is_empty() ? nullptr : function->default_arguments.ptr();
+	function->_default_arg_count = function->default_arguments.is_empty() ? 0 : function->default_arguments.size() - 1;
+	function->_constants_ptr = function->constants.is_empty() ? nullptr : function->constants.ptrw();
+	function->_constant_count = function->constants.size();
+	_update_table(function->global_names, function->_global_names_count, function->_global_names_ptr);
+	_update_table(function->operator_funcs, function->_operator_funcs_count, function->_operator_funcs_ptr);
+	_update_table(function->setters, function->_setters_count, function->_setters_ptr);
+	_update_table(function->getters, function->_getters_count, function->_getters_ptr);
+	_update_table(function->keyed_setters, function->_keyed_setters_count, function->_keyed_setters_ptr);
+	_update_table(function->keyed_getters, function->_keyed_getters_count, function->_keyed_getters_ptr);
+	_update_table(function->indexed_setters, function->_indexed_setters_count, function->_indexed_setters_ptr);
+	_update_table(function->indexed_getters, function->_indexed_getters_count, function->_indexed_getters_ptr);
+	_update_table(function->builtin_methods, function->_builtin_methods_count, function->_builtin_methods_ptr);
+	_update_table(function->constructors, function->_constructors_count, function->_constructors_ptr);
+	_update_table(function->utilities, function->_utilities_count, function->_utilities_ptr);
+	_update_table(function->gds_utilities, function->_gds_utilities_count, function->_gds_utilities_ptr);
+	function->_methods_ptr = function->methods.is_empty() ? nullptr : function->methods.ptrw();
+	function->_methods_count = function->methods.size();
+	function->_lambdas_ptr = function->lambdas.is_empty() ? nullptr : function->lambdas.ptrw();
+	function->_lambdas_count = function->lambdas.size();
+	function->_inline_caches_ptr = inline_cache_count ? memnew_arr(GDScriptFunction::InlineCache, inline_cache_count) : nullptr;
+	function->_inline_caches_count = inline_cache_count;
+
+#ifdef DEBUG_ENABLED
+	function->func_cname = (String(function->source) + " - " + String(function->name)).utf8();
+	function->_func_cname = function->func_cname.get_data();
+
+	if (EngineDebugger::is_active()) {
+		// Same format as the compiler's, the line is the one of the declaration rather than of the body.
+		const StringName class_name = r_class.script->is_root_script() ? r_class.script->global_name : r_class.script->local_name;
+		String signature = String(function->source) + "::" + itos(function->_initial_line);
+		if (class_name != StringName()) {
+			signature += "::" + String(class_name) + "." + String(function->name);
+		} else {
+			signature += "::" + String(function->name);
+		}
+		if (p_lambda) {
+			signature += "(lambda)";
+		}
+		function->profile.signature = signature;
+	}
+#endif
+
+	return function;
+}
+
+void GDScriptBytecodeBuffer::Reader::get_class_skeleton(GDScript *p_class, bool p_create) {
+	const String fully_qualified_name = get_string();
+	const StringName local_name = get_name();
+	const StringName global_name = get_name();
+	const String simplified_icon_path = get_string();
+	const uint32_t subclass_count = get_count();
+	if (has_failed()) {
+		return;
+	}
+
+	if (p_create) {
+		p_class->fully_qualified_name = fully_qualified_name;
+		p_class->local_name = local_name;
+		p_class->global_name = global_name;
+		p_class->simplified_icon_path = simplified_icon_path;
+		p_class->subclasses.clear();
+	} else if (p_class->fully_qualified_name != fully_qualified_name || (uint32_t)p_class->subclasses.size() != subclass_count) {
+		fail("Classes don't match.");
+		return;
+	}
+
+	for (uint32_t i = 0; i < subclass_count && !has_failed(); i++) {
+		const StringName name = get_name();
+		if (has_failed()) {
+			return;
+		}
+
+		Ref<GDScript> subclass;
+		if (p_create) {
+			subclass = GDScriptLanguage::get_singleton()->get_orphan_subclass(p_class->fully_qualified_name + "::" + name);
+			if (subclass.is_null()) {
+				subclass.instantiate();
+			}
+			subclass->_owner = p_class;
+			subclass->path = p_class->path;
+			p_class->subclasses.insert(name, subclass);
+		} else {
+			Ref<GDScript> *existing = p_class->subclasses.getptr(name);
+			if (existing == nullptr) {
+				fail("Classes don't match.");
+				return;
+			}
+			subclass = *existing;
+		}
+		get_class_skeleton(subclass.ptr(), p_create);
+	}
+}
+
+void GDScriptBytecodeBuffer::Reader::get_class(GDScript *p_class, ClassData &r_data) {
+	r_data.script = p_class;
+	r_data.tool = get_u8();
+
+	const StringName native_name = get_name();
+	const int *native_index = GDScriptLanguage::get_singleton()->get_global_map().getptr(native_name);
+	if (has_failed() || native_index == nullptr) {
+		fail(vformat(R"(Unknown native class "%s".)", native_name));
+		return;
+	}
+	r_data.native = GDScriptLanguage::get_singleton()->get_global_array()[*native_index];
+	if (r_data.native.is_null()) {
+		fail(vformat(R"(Unknown native class "%s".)", native_name));
+		return;
+	}
+
+	// Classes from other files have to be ready to be inherited from, the same as when compiling.
+	const Ref<Script> base = get_script(&r_data.base_is_local, true);
+	r_data.base = base;
+	if (base.is_valid() && r_data.base.is_null()) {
+		fail("Invalid base class.");
+		return;
+	}
+	r_data.base_member_count = get_u32();
+	if (r_data.base.is_valid() && !r_data.base_is_local) {
+		if (!r_data.base->is_valid() || (uint32_t)r_data.base->member_indices.size() != r_data.base_member_count) {
+			fail(vformat(R"(Base class "%s" has changed.)", r_data.base->fully_qualified_name));
+			return;
+		}
+	}
+
+	const uint32_t member_count = get_count();
+	for (uint32_t i = 0; i < member_count && !has_failed(); i++) {
+		r_data.members.push_back(get_member_info());
+	}
+
+	const uint32_t static_variable_count = get_count();
+	for (uint32_t i = 0; i < static_variable_count && !has_failed(); i++) {
+		r_data.static_variables.push_back(get_member_info());
+	}
+
+	const uint32_t constant_count = get_count();
+	for (uint32_t i = 0; i < constant_count && !has_failed(); i++) {
+		const StringName name = get_name();
+		r_data.constants.push_back(Pair<StringName, Variant>(name, get_constant()));
+	}
+
+	const uint32_t signal_count = get_count();
+	for (uint32_t i = 0; i < signal_count && !has_failed(); i++) {
+		const StringName name = get_name();
+		r_data.signals.push_back(Pair<StringName, MethodInfo>(name, get_method_info()));
+	}
+
+	r_data.rpc_config = get_constant();
+
+	const uint32_t function_count = get_count();
+	for (uint32_t i = 0; i < function_count && !has_failed(); i++) {
+		r_data.functions.push_back(get_function(r_data));
+	}
+
+	GDScriptFunction **implicit_functions[] = { &r_data.implicit_initializer, &r_data.implicit_ready, &r_data.static_initializer };
+	for (GDScriptFunction **function : implicit_functions) {
+		if (get_u8() && !has_failed()) {
+			*function = get_function(r_data);
+		}
+	}
+
+	const uint32_t subclass_count = get_count();
+	if (has_failed()) {
+		return;
+	}
+	if (subclass_count != (uint32_t)p_class->subclasses.size()) {
+		fail("Classes don't match.");
+		return;
+	}
+	r_data.subclasses.resize(subclass_count);
+	uint32_t i = 0;
+	for (const KeyValue<StringName, Ref<GDScript>> &E : p_class->subclasses) {
+		get_class(E.value.ptr(), r_data.subclasses[i++]);
+		if (has_failed()) {
+			return;
+		}
+	}
+}
+
+/* Public API */
+
+Error GDScriptBytecodeBuffer::make_scripts(GDScript *p_script, const Vector<uint8_t> &p_buffer) {
+	if (p_buffer.size() < BYTECODE_HEADER_SIZE) {
+		return ERR_INVALID_DATA;
+	}
+
+	const uint8_t *buf = p_buffer.ptr();
+	if (buf[0] != 'G' || buf[1] != 'D' || buf[2] != 'B' || buf[3] != 'C') {
+		return ERR_INVALID_DATA;
+	}
+#ifdef DEBUG_ENABLED
+	const bool debug = true;
+#else
+	const bool debug = false;
+#endif
+	if (decode_uint32(&buf[4]) != BYTECODE_VERSION || decode_uint32(&buf[8]) != _get_build_hash(debug)) {
+		return ERR_FILE_UNRECOGNIZED;
+	}
+
+	const int decompressed_size = decode_uint32(&buf[12]);
+	Vector<uint8_t> contents;
+	if (decompressed_size == 0) {
+		contents = p_buffer.slice(BYTECODE_HEADER_SIZE);
+	} else {
+		contents.resize(decompressed_size);
+		const int result = Compression::decompress(contents.ptrw(), contents.size(), &buf[BYTECODE_HEADER_SIZE], p_buffer.size() - BYTECODE_HEADER_SIZE, Compression::MODE_ZSTD);
+		ERR_FAIL_COND_V_MSG(result != decompressed_size, ERR_INVALID_DATA, "Error decompressing GDScript bytecode buffer.");
+	}
+
+	Reader reader(p_script, contents);
+	if (reader.get_names()) {
+		reader.get_class_skeleton(p_script, true);
+	}
+	if (reader.has_failed()) {
+		p_script->subclasses.clear();
+		return ERR_INVALID_DATA;
+	}
+
+	p_script->bytecode = contents;
+	return OK;
+}
+
+Error GDScriptBytecodeBuffer::load(GDScript *p_script) {
+	ERR_FAIL_COND_V(p_script->bytecode.is_empty(), ERR_UNAVAILABLE);
+
+	Reader reader(p_script, p_script->bytecode);
+	ClassData root;
+	bool static_cached = false;
+	if (reader.get_names()) {
+		reader.get_class_skeleton(p_script, false);
+		static_cached = reader.get_u8();
+		reader.get_class(p_script, root);
+	}
+	if (reader.has_failed()) {
+		root.free_functions();
+		print_verbose(vformat(R"(GDScript: Can't use the bytecode of "%s": %s)", p_script->path, reader.get_error()));
+		return ERR_INVALID_DATA;
+	}
+
+	HashMap<GDScript *, ClassData *> classes;
+	root.map_classes(classes);
+	root.apply_layout(classes);
+	root.finish();
+
+	if (static_cached) {
+		GDScriptCache::add_static_script(p_script);
+	}
+
+	return GDScriptCache::finish_compiling(p_script->path);
+}
+
+Vector<uint8_t> GDScriptBytecodeBuffer::serialize(const GDScript *p_script, GDScriptTokenizerBuffer::CompressMode p_compress_mode, bool p_debug, String *r_error) {
+	ERR_FAIL_COND_V(!p_script->is_root_script() || !p_script->valid, Vector<uint8_t>());
+
+	// Built once, mapping what the bytecode points to back to names.
+	static const BytecodeReverseTables tables;
+
+	bool static_cached;
+	{
+		MutexLock lock(GDScriptCache::singleton->mutex);
+		static_cached = GDScriptCache::singleton->static_gdscript_cache.has(p_script->fully_qualified_name);
+	}
+
+	Writer writer(p_script, tables, p_debug);
+	writer.put_class_skeleton(p_script);
+	writer.put_u8(static_cached);
+	writer.put_class(p_script);
+	if (!writer.get_error().is_empty()) {
+		if (r_error) {
+			*r_error = writer.get_error();
+		}
+		return Vector<uint8_t>();
+	}
+
+	const Vector<uint8_t> contents = writer.get_payload();
+
+	Vector<uint8_t> buf;
+	buf.resize(BYTECODE_HEADER_SIZE);
+	uint8_t *header = buf.ptrw();
+	header[0] = 'G';
+	header[1] = 'D';
+	header[2] = 'B';
+	header[3] = 'C';
+	encode_uint32(BYTECODE_VERSION, &header[4]);
+	encode_uint32(_get_build_hash(p_debug), &header[8]);
+
+	switch (p_compress_mode) {
+		case GDScriptTokenizerBuffer::COMPRESS_NONE:
+			encode_uint32(0u, &buf.write[12]);
+			buf.append_array(contents);
+			break;
+
+		case GDScriptTokenizerBuffer::COMPRESS_ZSTD: {
+			encode_uint32(contents.size(), &buf.write[12]);
+			Vector<uint8_t> compressed;
+			int max_size = Compression::get_max_compressed_buffer_size(contents.size(), Compression::MODE_ZSTD);
+			compressed.resize(max_size);
+
+			int compressed_size = Compression::compress(compressed.ptrw(), contents.ptr(), contents.size(), Compression::MODE_ZSTD);
+			ERR_FAIL_COND_V_MSG(compressed_size < 0, Vector<uint8_t>(), "Error compressing GDScript bytecode buffer.");
+			compressed.resize(compressed_size);
+
+			buf.append_array(compressed);
+		} break;
+	}
+
+	return buf;
+}
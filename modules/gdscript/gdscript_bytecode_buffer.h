@@ -0,0 +1,59 @@
+/**************************************************************************/
+/*  gdscript_bytecode_buffer.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GDSCRIPT_BYTECODE_BUFFER_H
+#define GDSCRIPT_BYTECODE_BUFFER_H
+
+#include "gdscript_tokenizer_buffer.h"
+
+class GDScript;
+
+// Compiled scripts, saved at export so they load without being parsed, analyzed
+// and compiled again. Everything the bytecode points to (operators, methods,
+// utility functions, other scripts...) is saved by name and looked up again
+// when loading, which only works with the same engine version, so a buffer
+// from any other version is rejected and the binary tokens are used instead.
+class GDScriptBytecodeBuffer {
+	class Writer;
+	class Reader;
+	struct ClassData;
+
+public:
+	// Creates the inner classes, so the script can be referenced before it's loaded.
+	static Error make_scripts(GDScript *p_script, const Vector<uint8_t> &p_buffer);
+	// Replaces compiling the script, returns an error if it has to be compiled instead.
+	static Error load(GDScript *p_script);
+
+	// Returns an empty buffer if something in the script can't be saved.
+	// Without `p_debug`, the line markers and breakpoints are left out, and the buffer is only loaded by release builds.
+	static Vector<uint8_t> serialize(const GDScript *p_script, GDScriptTokenizerBuffer::CompressMode p_compress_mode, bool p_debug, String *r_error = nullptr);
+};
+
+#endif // GDSCRIPT_BYTECODE_BUFFER_H
@@ -32,6 +32,7 @@
 
 #include "gdscript.h"
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode_buffer.h"
 #include "gdscript_compiler.h"
 #include "gdscript_parser.h"
 
@@ -202,6 +203,7 @@ void GDScriptCache::remove_script(const String &p_path) {
 
 	remove_parser(p_path);
 
+	singleton->parsed_scripts.erase(p_path);
 	singleton->dependencies.erase(p_path);
 	singleton->shallow_gdscript_cache.erase(p_path);
 	singleton->full_gdscript_cache.erase(p_path);
@@ -316,6 +318,13 @@ Ref<GDScript> GDScriptCache::get_shallow_script(const String &p_path, Error &r_e
 			r_error = ERR_FILE_CANT_READ;
 		}
 		script->set_binary_tokens_source(buffer);
+
+		// Compiled ahead of time when exporting, the tokens are only parsed if it can't be used.
+		const String bytecode_path = remapped_path.get_basename() + ".gdbc";
+		if (r_error == OK && FileAccess::exists(bytecode_path) && GDScriptBytecodeBuffer::make_scripts(script.ptr(), get_binary_tokens(bytecode_path)) == OK) {
+			singleton->shallow_gdscript_cache[p_path] = script;
+			return script;
+		}
 	} else {
 		r_error = script->load_source_code(remapped_path);
 	}
@@ -438,6 +447,119 @@ void GDScriptCache::remove_static_script(const String &p_fqcn) {
 	singleton->static_gdscript_cache.erase(p_fqcn);
 }
 
+void GDScriptCache::_parse_script(void *p_userdata, uint32_t p_index) {
+	Ref<GDScriptParserRef> *parser_refs = (Ref<GDScriptParserRef> *)p_userdata;
+	parser_refs[p_index]->raise_status(GDScriptParserRef::PARSED);
+}
+
+static void _get_script_dependencies(const GDScriptParser::ClassNode *p_class, const String &p_script_path, Vector<String> &r_paths) {
+	if (!p_class->extends_path.is_empty()) {
+		if (p_class->extends_path.is_relative_path()) {
+			r_paths.push_back(p_script_path.get_base_dir().path_join(p_class->extends_path).simplify_path());
+		} else {
+			r_paths.push_back(p_class->extends_path);
+		}
+	} else if (!p_class->extends.is_empty() && ScriptServer::is_global_class(p_class->extends[0]->name)) {
+		r_paths.push_back(ScriptServer::get_global_class_path(p_class->extends[0]->name));
+	}
+
+	for (const GDScriptParser::ClassNode::Member &member : p_class->members) {
+		if (member.type == GDScriptParser::ClassNode::Member::CLASS) {
+			_get_script_dependencies(member.m_class, p_script_path, r_paths);
+		}
+	}
+}
+
+// Parses the scripts and, as they are discovered, the scripts they extend or preload,
+// spreading each round over the worker threads. Only parsing is done here: analysis
+// resolves dependencies through the cache and loads resources, so it still happens when
+// the scripts are loaded, on the thread that loads them, reusing these parsers.
+void GDScriptCache::parse_scripts(const Vector<String> &p_paths) {
+	MutexLock lock(singleton->mutex);
+
+	Vector<String> paths = p_paths;
+	while (!paths.is_empty()) {
+		LocalVector<Ref<GDScriptParserRef>> parser_refs;
+		HashSet<String> queued;
+		for (const String &path : paths) {
+			if (path.get_extension().to_lower() != "gd" || queued.has(path) || singleton->parser_map.has(path)) {
+				continue;
+			}
+			String remapped_path = ResourceLoader::path_remap(path);
+			if (!FileAccess::exists(remapped_path)) {
+				continue;
+			}
+			if (remapped_path.get_extension().to_lower() == "gdc" && FileAccess::exists(remapped_path.get_basename() + ".gdbc")) {
+				continue; // Loaded from its bytecode instead, see GDScriptBytecodeBuffer.
+			}
+
+			Ref<GDScriptParserRef> parser_ref;
+			parser_ref.instantiate();
+			parser_ref->path = path;
+			// The first parser made sets up static data, which isn't safe to do on the worker threads.
+			parser_ref->get_parser();
+			parser_refs.push_back(parser_ref);
+			queued.insert(path);
+		}
+		paths.clear();
+
+		if (parser_refs.is_empty()) {
+			break;
+		}
+
+		// Nothing else can see these parsers until they are added to the map below, so the lock
+		// can be lifted while waiting.
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(&_parse_script, parser_refs.ptr(), parser_refs.size(), -1, true, "GDScript parsing");
+		uint32_t allowance_id = WorkerThreadPool::thread_enter_unlock_allowance_zone(&singleton->mutex);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+		WorkerThreadPool::thread_exit_unlock_allowance_zone(allowance_id);
+
+		for (Ref<GDScriptParserRef> &parser_ref : parser_refs) {
+			if (singleton->parser_map.has(parser_ref->path)) {
+				// Requested and parsed again by another thread in the meantime.
+				parser_ref->abandoned = true;
+				continue;
+			}
+			singleton->parser_map[parser_ref->path] = parser_ref.ptr();
+			singleton->parsed_scripts[parser_ref->path] = parser_ref;
+
+			if (parser_ref->result != OK) {
+				continue;
+			}
+			GDScriptParser *parser = parser_ref->get_parser();
+			_get_script_dependencies(parser->get_tree(), parser_ref->path, paths);
+			for (const String &preload_path : parser->get_preload_paths()) {
+				if (preload_path.is_relative_path()) {
+					paths.push_back(parser_ref->path.get_base_dir().path_join(preload_path).simplify_path());
+				} else {
+					paths.push_back(preload_path.simplify_path());
+				}
+			}
+		}
+	}
+}
+
+// The parser made by parse_scripts() for this path, if it's still up to date.
+Ref<GDScriptParserRef> GDScriptCache::get_parsed_script(const String &p_path) {
+	MutexLock lock(singleton->mutex);
+
+	HashMap<String, Ref<GDScriptParserRef>>::Iterator E = singleton->parsed_scripts.find(p_path);
+	if (!E) {
+		return Ref<GDScriptParserRef>();
+	}
+	HashMap<String, GDScriptParserRef *>::Iterator P = singleton->parser_map.find(p_path);
+	if (!P || P->value != E->value.ptr()) {
+		singleton->parsed_scripts.remove(E);
+		return Ref<GDScriptParserRef>();
+	}
+	return E->value;
+}
+
+void GDScriptCache::release_parsed_scripts() {
+	MutexLock lock(singleton->mutex);
+	singleton->parsed_scripts.clear();
+}
+
 void GDScriptCache::clear() {
 	if (singleton == nullptr) {
 		return;
@@ -469,6 +591,7 @@ void GDScriptCache::clear() {
 	}
 
 	singleton->parser_map.clear();
+	singleton->parsed_scripts.clear();
 
 	for (Ref<GDScriptParserRef> &E : parser_map_refs) {
 		if (E.is_valid()) {
@@ -86,8 +86,10 @@ class GDScriptCache {
 	HashMap<String, Ref<GDScript>> static_gdscript_cache;
 	HashMap<String, HashSet<String>> dependencies;
 	HashMap<String, HashSet<String>> parser_inverse_dependencies;
+	HashMap<String, Ref<GDScriptParserRef>> parsed_scripts;
 
 	friend class GDScript;
+	friend class GDScriptBytecodeBuffer;
 	friend class GDScriptParserRef;
 	friend class GDScriptInstance;
 
@@ -97,6 +99,8 @@ class GDScriptCache {
 
 	Mutex mutex;
 
+	static void _parse_script(void *p_userdata, uint32_t p_index);
+
 public:
 	static void move_script(const String &p_from, const String &p_to);
 	static void remove_script(const String &p_path);
@@ -112,6 +116,10 @@ public:
 	static void add_static_script(Ref<GDScript> p_script);
 	static void remove_static_script(const String &p_fqcn);
 
+	static void parse_scripts(const Vector<String> &p_paths);
+	static Ref<GDScriptParserRef> get_parsed_script(const String &p_path);
+	static void release_parsed_scripts();
+
 	static void clear();
 
 	GDScriptCache();
@@ -2635,6 +2635,9 @@ Error GDScriptCompiler::_prepare_compilation(GDScript *p_script, const GDScriptP
 
 	parsing_classes.insert(p_script);
 
+	// Member indices and functions are about to change.
+	GDScriptFunction::InlineCache::invalidate_all();
+
 	p_script->clearing = true;
 
 	p_script->native = Ref<GDScriptNativeClass>();
@@ -31,6 +31,9 @@
 #include "gdscript_function.h"
 
 #include "gdscript.h"
+#include "gdscript_sampler.h"
+
+#include "scene/scene_string_names.h"
 
 Variant GDScriptFunction::get_constant(int p_idx) const {
 	ERR_FAIL_INDEX_V(p_idx, constants.size(), "<errconst>");
@@ -104,6 +107,146 @@ void GDScriptFunction::debug_get_stack_member_state(int p_line, List<Pair<String
 	}
 }
 
+SafeNumeric<uint32_t> GDScriptFunction::InlineCache::epoch;
+
+void GDScriptFunction::InlineCache::store(uint64_t p_key, const void *p_native_class, uint32_t p_tag, const Target &p_target) {
+	const uint32_t fill = fills.fetch_add(1, std::memory_order_relaxed);
+	uint32_t v = version.load(std::memory_order_relaxed);
+	if ((v & 1) || !version.compare_exchange_strong(v, v + 1, std::memory_order_relaxed)) {
+		return; // Another thread is writing, this receiver gets cached on a later miss.
+	}
+	std::atomic_thread_fence(std::memory_order_release);
+
+	// Replace the entry of the same receiver or a stale one first, then in turn.
+	Entry *entry = &entries[fill % ENTRY_COUNT];
+	for (Entry &E : entries) {
+		const uint32_t tag = E.tag.load(std::memory_order_relaxed);
+		if ((tag >> RECEIVER_BITS) != (p_tag >> RECEIVER_BITS) || (E.key.load(std::memory_order_relaxed) == p_key && E.native_class.load(std::memory_order_relaxed) == p_native_class)) {
+			entry = &E;
+			break;
+		}
+	}
+	entry->key.store(p_key, std::memory_order_relaxed);
+	entry->native_class.store(p_native_class, std::memory_order_relaxed);
+	entry->tag.store(p_tag, std::memory_order_relaxed);
+	entry->kind.store(p_target.kind, std::memory_order_relaxed);
+	entry->ptr.store(p_target.ptr, std::memory_order_relaxed);
+	entry->index.store(p_target.index, std::memory_order_relaxed);
+
+	version.store(v + 2, std::memory_order_release);
+}
+
+// Only classes whose lookups can't change at runtime, and, for calls, which don't override Object::callp().
+static bool _is_inline_cacheable_class(const StringName &p_class, bool p_call) {
+	const ClassDB::APIType api = ClassDB::get_api_type(p_class);
+	if (api != ClassDB::API_CORE && api != ClassDB::API_EDITOR) {
+		return false;
+	}
+	return !p_call || !ClassDB::class_overrides_callp(p_class);
+}
+
+bool GDScriptFunction::_resolve_get_named(const Variant *p_base, Object *p_object, const GDScriptInstance *p_instance, const StringName &p_name, InlineCache::Target &r_target) {
+	if (!p_object) {
+		// Same search as Variant::get_named(), anything other than a member isn't cached.
+		const Variant::ValidatedGetter getter = Variant::get_member_validated_getter(p_base->get_type(), p_name);
+		if (!getter) {
+			return false;
+		}
+		r_target.kind = InlineCache::KIND_BUILTIN_GETTER;
+		r_target.ptr = reinterpret_cast<void *>(getter);
+		r_target.index = Variant::get_member_type(p_base->get_type(), p_name);
+		return true;
+	}
+
+	if (p_instance) {
+		const GDScript *script = p_instance->script.ptr();
+		if (!script->valid) {
+			return false;
+		}
+		const GDScript::MemberInfo *member = script->member_indices.getptr(p_name);
+		if (member) {
+			if (member->getter) {
+				return false;
+			}
+			r_target.kind = InlineCache::KIND_SCRIPT_MEMBER;
+			r_target.index = member->index;
+			return true;
+		}
+		// Anything else GDScriptInstance::get() finds before the native class isn't cached.
+		for (const GDScript *sptr = script; sptr; sptr = sptr->_base) {
+			if (sptr->constants.has(p_name) || sptr->static_variables_indices.has(p_name) || sptr->_signals.has(p_name) || sptr->subclasses.has(p_name)) {
+				return false;
+			}
+			if (likely(sptr->valid) && (sptr->member_functions.has(p_name) || sptr->member_functions.has(GDScriptLanguage::get_singleton()->strings._get))) {
+				return false;
+			}
+		}
+	}
+
+	// Same search as ClassDB::get_property(), which Object::get() tries next.
+	const StringName &class_name = p_object->get_class_name();
+	if (!_is_inline_cacheable_class(class_name, false)) {
+		return false;
+	}
+	for (StringName level = class_name; level != StringName(); level = ClassDB::get_parent_class_nocheck(level)) {
+		if (ClassDB::has_property(level, p_name, true)) {
+			const StringName getter_name = ClassDB::get_property_getter(level, p_name);
+			MethodBind *getter = getter_name == StringName() ? nullptr : ClassDB::get_method(level, getter_name);
+			const int index = ClassDB::get_property_index(level, p_name);
+			if (index >= 0) {
+				// Indexed getters are called by name, so go through the object's own call.
+				if (p_instance || !_is_inline_cacheable_class(class_name, true)) {
+					return false;
+				}
+				getter = getter_name == StringName() ? nullptr : ClassDB::get_method(class_name, getter_name);
+			}
+			if (!getter) {
+				return false;
+			}
+			r_target.kind = InlineCache::KIND_NATIVE_GETTER;
+			r_target.ptr = getter;
+			r_target.index = index;
+			return true;
+		}
+		if (ClassDB::has_integer_constant(level, p_name, true) || ClassDB::has_method(level, p_name, true) || ClassDB::has_signal(level, p_name, true)) {
+			return false;
+		}
+	}
+	return false;
+}
+
+bool GDScriptFunction::_resolve_call(Object *p_object, const GDScriptInstance *p_instance, const StringName &p_method, InlineCache::Target &r_target) {
+	const StringName &class_name = p_object->get_class_name();
+	if (p_method == CoreStringName(free_) || !_is_inline_cacheable_class(class_name, true)) {
+		return false;
+	}
+
+	// Same search as Object::callp().
+	if (p_instance) {
+		if (p_method == SceneStringName(_ready)) {
+			return false;
+		}
+		for (const GDScript *sptr = p_instance->script.ptr(); sptr; sptr = sptr->_base) {
+			if (likely(sptr->valid)) {
+				GDScriptFunction *const *function = sptr->member_functions.getptr(p_method);
+				if (function) {
+					r_target.kind = InlineCache::KIND_SCRIPT_FUNCTION;
+					r_target.ptr = *function;
+					return true;
+				}
+			}
+		}
+	}
+
+	MethodBind *method = ClassDB::get_method(class_name, p_method);
+	if (!method) {
+		return false;
+	}
+	r_target.kind = InlineCache::KIND_NATIVE_METHOD;
+	r_target.ptr = method;
+	return true;
+}
+
 GDScriptFunction::GDScriptFunction() {
 	name = "<anonymous>";
 #ifdef DEBUG_ENABLED
@@ -126,6 +269,13 @@ GDScriptFunction::~GDScriptFunction() {
 	}
 	return_type.script_type_ref = Ref<Script>();
 
+	if (_inline_caches_ptr) {
+		memdelete_arr(_inline_caches_ptr);
+	}
+	// Caches of other functions may point to this one.
+	InlineCache::invalidate_all();
+	GDScriptSampler::function_freed(this);
+
 #ifdef DEBUG_ENABLED
 	MutexLock lock(GDScriptLanguage::get_singleton()->mutex);
 	GDScriptLanguage::get_singleton()->function_list.remove(&function_list);
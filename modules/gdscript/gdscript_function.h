@@ -38,9 +38,12 @@
 #include "core/os/thread.h"
 #include "core/string/string_name.h"
 #include "core/templates/pair.h"
+#include "core/templates/safe_refcount.h"
 #include "core/templates/self_list.h"
 #include "core/variant/variant.h"
 
+#include <atomic>
+
 class GDScriptInstance;
 class GDScript;
 
@@ -218,6 +221,53 @@ public:
 	enum Opcode {
 		OPCODE_OPERATOR,
 		OPCODE_OPERATOR_VALIDATED,
+		OPCODE_OPERATOR_VALIDATED_ASSIGN,
+		OPCODE_OPERATOR_VALIDATED_JUMP_IF,
+		OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT,
+		OPCODE_OPERATOR_ADD_INT,
+		OPCODE_OPERATOR_SUBTRACT_INT,
+		OPCODE_OPERATOR_MULTIPLY_INT,
+		OPCODE_OPERATOR_NEGATE_INT,
+		OPCODE_OPERATOR_EQUAL_INT,
+		OPCODE_OPERATOR_NOT_EQUAL_INT,
+		OPCODE_OPERATOR_LESS_INT,
+		OPCODE_OPERATOR_LESS_EQUAL_INT,
+		OPCODE_OPERATOR_GREATER_INT,
+		OPCODE_OPERATOR_GREATER_EQUAL_INT,
+		OPCODE_OPERATOR_ADD_FLOAT,
+		OPCODE_OPERATOR_SUBTRACT_FLOAT,
+		OPCODE_OPERATOR_MULTIPLY_FLOAT,
+		OPCODE_OPERATOR_DIVIDE_FLOAT,
+		OPCODE_OPERATOR_NEGATE_FLOAT,
+		OPCODE_OPERATOR_EQUAL_FLOAT,
+		OPCODE_OPERATOR_NOT_EQUAL_FLOAT,
+		OPCODE_OPERATOR_LESS_FLOAT,
+		OPCODE_OPERATOR_LESS_EQUAL_FLOAT,
+		OPCODE_OPERATOR_GREATER_FLOAT,
+		OPCODE_OPERATOR_GREATER_EQUAL_FLOAT,
+		OPCODE_OPERATOR_EQUAL_BOOL,
+		OPCODE_OPERATOR_NOT_EQUAL_BOOL,
+		OPCODE_OPERATOR_NOT_BOOL,
+		OPCODE_OPERATOR_ADD_VECTOR2,
+		OPCODE_OPERATOR_SUBTRACT_VECTOR2,
+		OPCODE_OPERATOR_MULTIPLY_VECTOR2,
+		OPCODE_OPERATOR_MULTIPLY_VECTOR2_FLOAT,
+		OPCODE_OPERATOR_ADD_VECTOR3,
+		OPCODE_OPERATOR_SUBTRACT_VECTOR3,
+		OPCODE_OPERATOR_MULTIPLY_VECTOR3,
+		OPCODE_OPERATOR_MULTIPLY_VECTOR3_FLOAT,
+		OPCODE_JUMP_IF_NOT_EQUAL_INT,
+		OPCODE_JUMP_IF_NOT_NOT_EQUAL_INT,
+		OPCODE_JUMP_IF_NOT_LESS_INT,
+		OPCODE_JUMP_IF_NOT_LESS_EQUAL_INT,
+		OPCODE_JUMP_IF_NOT_GREATER_INT,
+		OPCODE_JUMP_IF_NOT_GREATER_EQUAL_INT,
+		OPCODE_JUMP_IF_NOT_EQUAL_FLOAT,
+		OPCODE_JUMP_IF_NOT_NOT_EQUAL_FLOAT,
+		OPCODE_JUMP_IF_NOT_LESS_FLOAT,
+		OPCODE_JUMP_IF_NOT_LESS_EQUAL_FLOAT,
+		OPCODE_JUMP_IF_NOT_GREATER_FLOAT,
+		OPCODE_JUMP_IF_NOT_GREATER_EQUAL_FLOAT,
 		OPCODE_TYPE_TEST_BUILTIN,
 		OPCODE_TYPE_TEST_ARRAY,
 		OPCODE_TYPE_TEST_NATIVE,
@@ -397,8 +447,84 @@ public:
 		StringName identifier;
 	};
 
+	// Remembers what a named property or method resolved to for the last few receiver types at one
+	// OPCODE_GET_NAMED or OPCODE_CALL site. Shared by every thread running the function, so entries
+	// are written under a sequence lock and read without blocking.
+	struct InlineCache {
+		enum Receiver {
+			RECEIVER_BUILTIN = 1, // Key is the Variant type.
+			RECEIVER_NATIVE, // Key is the address of the class name, which is static for native classes.
+			RECEIVER_SCRIPT, // Key is the GDScript instance ID, along with the native class, as the same script can extend several.
+			RECEIVER_BITS = 2,
+		};
+
+		enum Kind {
+			KIND_BUILTIN_GETTER, // Target is the getter, index the member type.
+			KIND_NATIVE_GETTER, // Target is the getter MethodBind, index the property index or -1.
+			KIND_NATIVE_METHOD, // Target is the MethodBind.
+			KIND_SCRIPT_MEMBER, // Index is the member index.
+			KIND_SCRIPT_FUNCTION, // Target is the GDScriptFunction.
+		};
+
+		enum {
+			ENTRY_COUNT = 4,
+			MAX_FILLS = 32, // Past this the site is megamorphic, and misses no longer try to fill it.
+		};
+
+		struct Target {
+			uint32_t kind = 0;
+			void *ptr = nullptr;
+			int32_t index = 0;
+		};
+
+		struct Entry {
+			std::atomic<uint64_t> key{ 0 };
+			std::atomic<const void *> native_class{ nullptr }; // Only set for script receivers.
+			std::atomic<uint32_t> tag{ 0 }; // Receiver and epoch, zero when empty.
+			std::atomic<uint32_t> kind{ 0 };
+			std::atomic<void *> ptr{ nullptr };
+			std::atomic<int32_t> index{ 0 };
+		};
+
+		std::atomic<uint32_t> version{ 0 }; // Odd while an entry is written.
+		std::atomic<uint32_t> fills{ 0 };
+		Entry entries[ENTRY_COUNT];
+
+		static uint32_t make_tag(Receiver p_receiver) { return (epoch.get() << RECEIVER_BITS) | p_receiver; }
+		// Bumped whenever a cached function, member layout or validity may go stale, dropping every entry.
+		static void invalidate_all() { epoch.increment(); }
+
+		_FORCE_INLINE_ bool lookup(uint64_t p_key, const void *p_native_class, uint32_t p_tag, Target &r_target) const {
+			const uint32_t v = version.load(std::memory_order_acquire);
+			if (unlikely(v & 1)) {
+				return false;
+			}
+			bool found = false;
+			for (const Entry &E : entries) {
+				if (E.key.load(std::memory_order_relaxed) == p_key && E.native_class.load(std::memory_order_relaxed) == p_native_class && E.tag.load(std::memory_order_relaxed) == p_tag) {
+					r_target.kind = E.kind.load(std::memory_order_relaxed);
+					r_target.ptr = E.ptr.load(std::memory_order_relaxed);
+					r_target.index = E.index.load(std::memory_order_relaxed);
+					found = true;
+					break;
+				}
+			}
+			std::atomic_thread_fence(std::memory_order_acquire);
+			return found && version.load(std::memory_order_relaxed) == v;
+		}
+
+		bool is_megamorphic() const { return fills.load(std::memory_order_relaxed) >= MAX_FILLS; }
+		void store(uint64_t p_key, const void *p_native_class, uint32_t p_tag, const Target &p_target);
+		// Counts a receiver that can't be cached towards the fill limit.
+		void skip() { fills.fetch_add(1, std::memory_order_relaxed); }
+
+	private:
+		static SafeNumeric<uint32_t> epoch;
+	};
+
 private:
 	friend class GDScript;
+	friend class GDScriptBytecodeBuffer;
 	friend class GDScriptCompiler;
 	friend class GDScriptByteCodeGenerator;
 	friend class GDScriptLanguage;
@@ -423,6 +549,9 @@ private:
 	List<StackDebug> stack_debug;
 
 	Vector<int> code;
+	Vector<int> relocations; // Instructions with operands only valid in this process, which are patched when saving the bytecode.
+	Vector<int> debug_instructions; // Line markers and breakpoints, which are stripped when saving the bytecode for release builds.
+	Vector<int> jump_operands; // Operands holding a position in the code, moved along with the instructions when stripping.
 	Vector<int> default_arguments;
 	Vector<Variant> constants;
 	Vector<StringName> global_names;
@@ -457,6 +586,7 @@ private:
 	int _gds_utilities_count = 0;
 	int _methods_count = 0;
 	int _lambdas_count = 0;
+	int _inline_caches_count = 0;
 
 	int *_code_ptr = nullptr;
 	const int *_default_arg_ptr = nullptr;
@@ -475,6 +605,7 @@ private:
 	const GDScriptUtilityFunctions::FunctionPtr *_gds_utilities_ptr = nullptr;
 	MethodBind **_methods_ptr = nullptr;
 	GDScriptFunction **_lambdas_ptr = nullptr;
+	InlineCache *_inline_caches_ptr = nullptr; // Owned, one per named get or call site.
 
 #ifdef DEBUG_ENABLED
 	CharString func_cname;
@@ -499,6 +630,12 @@ private:
 		uint64_t last_frame_call_count = 0;
 		uint64_t last_frame_self_time = 0;
 		uint64_t last_frame_total_time = 0;
+		SafeNumeric<uint64_t> inline_cache_hits;
+		SafeNumeric<uint64_t> inline_cache_misses;
+		SafeNumeric<uint64_t> frame_inline_cache_hits;
+		SafeNumeric<uint64_t> frame_inline_cache_misses;
+		uint64_t last_frame_inline_cache_hits = 0;
+		uint64_t last_frame_inline_cache_misses = 0;
 		typedef struct NativeProfile {
 			uint64_t call_count;
 			uint64_t total_time;
@@ -512,6 +649,12 @@ private:
 	_FORCE_INLINE_ String _get_call_error(const Callable::CallError &p_err, const String &p_where, const Variant **argptrs) const;
 	Variant _get_default_variant_for_data_type(const GDScriptDataType &p_data_type);
 
+	_FORCE_INLINE_ static bool _get_inline_cache_receiver(const Variant *p_base, Object *&r_object, GDScriptInstance *&r_instance, uint64_t &r_key, const void *&r_native_class, InlineCache::Receiver &r_receiver);
+	static bool _resolve_get_named(const Variant *p_base, Object *p_object, const GDScriptInstance *p_instance, const StringName &p_name, InlineCache::Target &r_target);
+	static bool _resolve_call(Object *p_object, const GDScriptInstance *p_instance, const StringName &p_method, InlineCache::Target &r_target);
+	_FORCE_INLINE_ void _get_named_cached(InlineCache *p_cache, const Variant *p_base, const StringName &p_name, Variant &r_ret, bool &r_valid);
+	_FORCE_INLINE_ void _call_cached(InlineCache *p_cache, Variant *p_base, const StringName &p_method, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_err);
+
 public:
 	static constexpr int MAX_CALL_DEPTH = 2048; // Limit to try to avoid crash because of a stack overflow.
 
@@ -548,7 +691,8 @@ public:
 
 #ifdef DEBUG_ENABLED
 	void _profile_native_call(uint64_t p_t_taken, const String &p_function_name, const String &p_instance_class_name = String());
-	void disassemble(const Vector<String> &p_code_lines) const;
+	// Returns the number of instructions, which are only printed if `p_print` is `true`.
+	int disassemble(const Vector<String> &p_code_lines, bool p_print = true) const;
 #endif
 
 	GDScriptFunction();
@@ -0,0 +1,220 @@
+/**************************************************************************/
+/*  gdscript_sampler.cpp                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_sampler.h"
+
+#include "gdscript.h"
+
+#include "core/io/file_access.h"
+
+std::atomic<bool> GDScriptSampler::sampling(false);
+std::atomic<bool> GDScriptSampler::thread_running(false);
+uint32_t GDScriptSampler::interval_usec = 1000;
+Thread GDScriptSampler::thread;
+
+BinaryMutex GDScriptSampler::mutex;
+LocalVector<GDScriptSampler::ThreadStack *> GDScriptSampler::stacks;
+std::atomic<uint32_t> GDScriptSampler::generation(0);
+thread_local GDScriptSampler::ThreadStack *GDScriptSampler::thread_stack = nullptr;
+thread_local uint32_t GDScriptSampler::thread_generation = 0;
+
+HashMap<const GDScriptFunction *, uint32_t> GDScriptSampler::function_name_ids;
+HashMap<String, uint32_t> GDScriptSampler::name_ids;
+LocalVector<String> GDScriptSampler::names;
+HashMap<Vector<uint64_t>, uint64_t, GDScriptSampler::StackHasher> GDScriptSampler::stack_counts;
+uint64_t GDScriptSampler::sample_count = 0;
+
+GDScriptSampler::ThreadStack *GDScriptSampler::_create_thread_stack() {
+	ThreadStack *stack = memnew(ThreadStack);
+	stack->depth.store(0, std::memory_order_relaxed);
+
+	MutexLock lock(mutex);
+	stacks.push_back(stack);
+	return stack;
+}
+
+GDScriptSampler::Frame *GDScriptSampler::push_frame(const GDScriptFunction *p_function, int p_line) {
+	ThreadStack *stack = thread_stack;
+	const uint32_t current_generation = generation.load(std::memory_order_acquire);
+	if (unlikely(!stack || thread_generation != current_generation)) {
+		stack = _create_thread_stack();
+		thread_stack = stack;
+		thread_generation = current_generation;
+	}
+
+	// Only this thread writes, the sampler uses the depth to know what's valid.
+	const uint32_t depth = stack->depth.load(std::memory_order_relaxed);
+	if (unlikely(depth >= (uint32_t)GDScriptFunction::MAX_CALL_DEPTH)) {
+		return nullptr;
+	}
+	Frame &frame = stack->frames[depth];
+	frame.function.store(p_function, std::memory_order_relaxed);
+	frame.line.store(p_line, std::memory_order_relaxed);
+	stack->depth.store(depth + 1, std::memory_order_release);
+	return &frame;
+}
+
+void GDScriptSampler::pop_frame() {
+	ThreadStack *stack = thread_stack;
+	stack->depth.store(stack->depth.load(std::memory_order_relaxed) - 1, std::memory_order_release);
+}
+
+void GDScriptSampler::function_freed(const GDScriptFunction *p_function) {
+	if (!is_sampling() && !thread_running.load(std::memory_order_acquire)) {
+		return;
+	}
+	// Waits for a sample that may be reading this function to be done.
+	MutexLock lock(mutex);
+	function_name_ids.erase(p_function);
+}
+
+uint32_t GDScriptSampler::_get_name_id(const GDScriptFunction *p_function) {
+	const uint32_t *function_name_id = function_name_ids.getptr(p_function);
+	if (function_name_id) {
+		return *function_name_id;
+	}
+
+	String name = p_function->get_name();
+	const GDScript *script = p_function->get_script();
+	if (script && script->get_local_name() != StringName()) {
+		name = String(script->get_local_name()) + "." + name;
+	}
+	// The line is only known per sample, it's appended when saving.
+	name = vformat("%s (%s", name, p_function->get_source()).replace(";", ",");
+
+	uint32_t id;
+	const uint32_t *name_id = name_ids.getptr(name);
+	if (name_id) {
+		// Same function as before a reload.
+		id = *name_id;
+	} else {
+		id = names.size();
+		names.push_back(name);
+		name_ids.insert(name, id);
+	}
+	function_name_ids.insert(p_function, id);
+	return id;
+}
+
+void GDScriptSampler::_take_sample() {
+	MutexLock lock(mutex);
+	Vector<uint64_t> sample;
+	for (ThreadStack *stack : stacks) {
+		const uint32_t depth = stack->depth.load(std::memory_order_acquire);
+		if (depth == 0) {
+			continue;
+		}
+		// The thread keeps running, so frames above the depth read may have changed
+		// since. Frames are only ever replaced with valid ones, so at worst the
+		// sample mixes two nearby stacks.
+		sample.resize(depth);
+		uint64_t *frames = sample.ptrw();
+		for (uint32_t i = 0; i < depth; i++) {
+			const Frame &frame = stack->frames[i];
+			const uint64_t name_id = _get_name_id(frame.function.load(std::memory_order_relaxed));
+			frames[i] = (name_id << 32) | (uint32_t)frame.line.load(std::memory_order_relaxed);
+		}
+		stack_counts[sample]++;
+		sample_count++;
+	}
+}
+
+void GDScriptSampler::_thread_func(void *p_user) {
+	Thread::set_name("GDScript Sampler");
+	while (is_sampling()) {
+		OS::get_singleton()->delay_usec(interval_usec);
+		_take_sample();
+	}
+}
+
+void GDScriptSampler::start(uint32_t p_interval_usec) {
+	ERR_FAIL_COND_MSG(p_interval_usec == 0, "The sampling interval must be greater than zero.");
+	if (is_sampling()) {
+		return;
+	}
+	interval_usec = p_interval_usec;
+	thread_running.store(true, std::memory_order_release);
+	sampling.store(true, std::memory_order_relaxed);
+	thread.start(_thread_func, nullptr);
+}
+
+void GDScriptSampler::stop() {
+	sampling.store(false, std::memory_order_relaxed);
+	if (thread.is_started()) {
+		thread.wait_to_finish();
+	}
+
+	MutexLock lock(mutex);
+	function_name_ids.clear();
+	thread_running.store(false, std::memory_order_release);
+}
+
+void GDScriptSampler::clear() {
+	ERR_FAIL_COND_MSG(is_sampling(), "Can't clear the samples while sampling.");
+	MutexLock lock(mutex);
+	stack_counts.clear();
+	names.clear();
+	name_ids.clear();
+	sample_count = 0;
+}
+
+uint64_t GDScriptSampler::get_sample_count() {
+	MutexLock lock(mutex);
+	return sample_count;
+}
+
+Error GDScriptSampler::save_folded_stacks(const String &p_path) {
+	Error err = OK;
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(err != OK, err, "Can't open folded stacks file for writing: " + p_path);
+
+	MutexLock lock(mutex);
+	for (const KeyValue<Vector<uint64_t>, uint64_t> &E : stack_counts) {
+		String line;
+		for (int i = 0; i < E.key.size(); i++) {
+			const uint64_t frame = E.key[i];
+			line += vformat("%s%s:%d)", i > 0 ? ";" : "", names[frame >> 32], (int32_t)(frame & 0xFFFFFFFF));
+		}
+		f->store_line(line + " " + itos(E.value));
+	}
+
+	return OK;
+}
+
+void GDScriptSampler::finish() {
+	stop();
+	clear();
+	MutexLock lock(mutex);
+	for (ThreadStack *stack : stacks) {
+		memdelete(stack);
+	}
+	stacks.clear();
+	generation.fetch_add(1, std::memory_order_release);
+}
@@ -0,0 +1,127 @@
+/**************************************************************************/
+/*  gdscript_sampler.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GDSCRIPT_SAMPLER_H
+#define GDSCRIPT_SAMPLER_H
+
+#include "gdscript_function.h"
+
+#include "core/os/mutex.h"
+#include "core/os/thread.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+
+#include <atomic>
+
+// Samples the GDScript call stacks of all threads running scripts at a fixed
+// interval, from a thread of its own, and counts how often each stack was seen.
+// The counts are saved as folded stacks (one line per stack, callers first,
+// followed by its count), which most flame graph tools take as input. Works in
+// release builds too, so it can be left running on servers, see the
+// --profile-scripts command line option.
+//
+// Functions only publish their frames while sampling, which costs a relaxed
+// atomic load per call otherwise. Calls that were already running when sampling
+// started are not known, so the functions they call show up as roots.
+class GDScriptSampler {
+public:
+	struct Frame {
+		std::atomic<const GDScriptFunction *> function;
+		// The line being run, only tracked in debug builds, where lines are emitted.
+		// Otherwise the line the function starts at.
+		std::atomic<int> line;
+	};
+
+private:
+	struct ThreadStack {
+		Frame frames[GDScriptFunction::MAX_CALL_DEPTH];
+		std::atomic<uint32_t> depth;
+	};
+
+	struct StackHasher {
+		static _FORCE_INLINE_ uint32_t hash(const Vector<uint64_t> &p_stack) {
+			return hash_murmur3_buffer(p_stack.ptr(), p_stack.size() * sizeof(uint64_t));
+		}
+	};
+
+	static std::atomic<bool> sampling;
+	// Stays set until the sampling thread is done, as it may still be reading
+	// frames right after sampling is turned off.
+	static std::atomic<bool> thread_running;
+	static uint32_t interval_usec;
+	static Thread thread;
+
+	// Guards everything below. Also held while taking a sample, so functions can't
+	// be freed while their frames are being read.
+	static BinaryMutex mutex;
+	static LocalVector<ThreadStack *> stacks;
+	// Bumped by finish(), so threads drop their pointer to freed stacks.
+	static std::atomic<uint32_t> generation;
+	static thread_local ThreadStack *thread_stack;
+	static thread_local uint32_t thread_generation;
+
+	// Functions are named once, and only while sampling, as freed ones may be
+	// reallocated at the same address.
+	static HashMap<const GDScriptFunction *, uint32_t> function_name_ids;
+	static HashMap<String, uint32_t> name_ids;
+	static LocalVector<String> names;
+	// Each frame is its name index in the high half, and its line in the low half.
+	static HashMap<Vector<uint64_t>, uint64_t, StackHasher> stack_counts;
+	static uint64_t sample_count;
+
+	static ThreadStack *_create_thread_stack();
+	static uint32_t _get_name_id(const GDScriptFunction *p_function);
+	static void _take_sample();
+	static void _thread_func(void *p_user);
+
+public:
+	_FORCE_INLINE_ static bool is_sampling() { return sampling.load(std::memory_order_relaxed); }
+
+	// Publishes a call on the calling thread's stack, to be popped when it returns.
+	// Returns null when the stack is full, in which case nothing is to be popped.
+	static Frame *push_frame(const GDScriptFunction *p_function, int p_line);
+	static void pop_frame();
+	static void function_freed(const GDScriptFunction *p_function);
+
+	static void start(uint32_t p_interval_usec = 1000);
+	static void stop();
+	// Forgets all samples. Not while sampling.
+	static void clear();
+
+	static uint64_t get_sample_count();
+	// Writes the stacks seen as "caller;callee count" lines. Each frame reads as
+	// "Class.function (path:line)".
+	static Error save_folded_stacks(const String &p_path);
+
+	// Frees all stacks. Not while any thread may still be running scripts.
+	static void finish();
+};
+
+#endif // GDSCRIPT_SAMPLER_H
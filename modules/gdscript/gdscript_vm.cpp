@@ -31,6 +31,7 @@
 #include "gdscript.h"
 #include "gdscript_function.h"
 #include "gdscript_lambda_callable.h"
+#include "gdscript_sampler.h"
 
 #include "core/os/os.h"
 
@@ -168,6 +169,157 @@ String GDScriptFunction::_get_call_error(const Callable::CallError &p_err, const
 	return err_text;
 }
 
+bool GDScriptFunction::_get_inline_cache_receiver(const Variant *p_base, Object *&r_object, GDScriptInstance *&r_instance, uint64_t &r_key, const void *&r_native_class, InlineCache::Receiver &r_receiver) {
+	if (p_base->get_type() != Variant::OBJECT) {
+		r_key = p_base->get_type();
+		r_receiver = InlineCache::RECEIVER_BUILTIN;
+		return true;
+	}
+
+	Object *object = p_base->get_validated_object();
+	if (unlikely(!object)) {
+		return false;
+	}
+	ScriptInstance *script_instance = object->get_script_instance();
+	if (script_instance) {
+#ifdef TOOLS_ENABLED
+		if (script_instance->is_placeholder()) {
+			return false;
+		}
+#endif
+		if (script_instance->get_language() != GDScriptLanguage::get_singleton()) {
+			return false;
+		}
+		r_instance = static_cast<GDScriptInstance *>(script_instance);
+		r_key = r_instance->script->get_instance_id();
+		r_native_class = &object->get_class_name();
+		r_receiver = InlineCache::RECEIVER_SCRIPT;
+	} else {
+		r_key = uint64_t(uintptr_t(&object->get_class_name()));
+		r_receiver = InlineCache::RECEIVER_NATIVE;
+	}
+	r_object = object;
+	return true;
+}
+
+#ifdef DEBUG_ENABLED
+#define PROFILE_INLINE_CACHE(m_hit)                                           \
+	if (unlikely(GDScriptLanguage::get_singleton()->profiling)) {             \
+		if (m_hit) {                                                          \
+			profile.inline_cache_hits.increment();                            \
+			profile.frame_inline_cache_hits.increment();                      \
+		} else {                                                              \
+			profile.inline_cache_misses.increment();                          \
+			profile.frame_inline_cache_misses.increment();                    \
+		}                                                                     \
+	}
+#else
+#define PROFILE_INLINE_CACHE(m_hit)
+#endif
+
+void GDScriptFunction::_get_named_cached(InlineCache *p_cache, const Variant *p_base, const StringName &p_name, Variant &r_ret, bool &r_valid) {
+	Object *object = nullptr;
+	GDScriptInstance *instance = nullptr;
+	uint64_t key = 0;
+	const void *native_class = nullptr;
+	InlineCache::Receiver receiver;
+	InlineCache::Target target;
+	bool hit = false;
+	bool cached = false;
+
+	if (likely(_get_inline_cache_receiver(p_base, object, instance, key, native_class, receiver))) {
+		const uint32_t tag = InlineCache::make_tag(receiver);
+		hit = p_cache->lookup(key, native_class, tag, target);
+		if (!hit && !p_cache->is_megamorphic()) {
+			if (_resolve_get_named(p_base, object, instance, p_name, target)) {
+				p_cache->store(key, native_class, tag, target);
+				cached = true;
+			} else {
+				p_cache->skip();
+			}
+		}
+	}
+	PROFILE_INLINE_CACHE(hit);
+
+	if (!hit && !cached) {
+		r_ret = p_base->get_named(p_name, r_valid);
+		return;
+	}
+
+	r_valid = true;
+	switch (target.kind) {
+		case InlineCache::KIND_BUILTIN_GETTER: {
+			VariantInternal::initialize(&r_ret, Variant::Type(target.index));
+			reinterpret_cast<Variant::ValidatedGetter>(target.ptr)(p_base, &r_ret);
+		} break;
+		case InlineCache::KIND_NATIVE_GETTER: {
+			MethodBind *getter = static_cast<MethodBind *>(target.ptr);
+			Callable::CallError ce;
+			if (target.index >= 0) {
+				Variant index = target.index;
+				const Variant *args[1] = { &index };
+#ifdef DEBUG_ENABLED
+				_ObjectDebugLock debug_lock(object);
+#endif
+				r_ret = getter->call(object, args, 1, ce);
+			} else {
+				r_ret = getter->call(object, nullptr, 0, ce);
+			}
+		} break;
+		case InlineCache::KIND_SCRIPT_MEMBER: {
+			r_ret = instance->members[target.index];
+		} break;
+	}
+}
+
+void GDScriptFunction::_call_cached(InlineCache *p_cache, Variant *p_base, const StringName &p_method, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_err) {
+	Object *object = nullptr;
+	GDScriptInstance *instance = nullptr;
+	uint64_t key = 0;
+	const void *native_class = nullptr;
+	InlineCache::Receiver receiver;
+	InlineCache::Target target;
+	bool hit = false;
+	bool cached = false;
+
+	// Built-in types already look their methods up in a single table.
+	if (p_base->get_type() != Variant::OBJECT) {
+		p_base->callp(p_method, p_args, p_argcount, r_ret, r_err);
+		return;
+	}
+
+	if (likely(_get_inline_cache_receiver(p_base, object, instance, key, native_class, receiver))) {
+		const uint32_t tag = InlineCache::make_tag(receiver);
+		hit = p_cache->lookup(key, native_class, tag, target);
+		if (!hit && !p_cache->is_megamorphic()) {
+			if (_resolve_call(object, instance, p_method, target)) {
+				p_cache->store(key, native_class, tag, target);
+				cached = true;
+			} else {
+				p_cache->skip();
+			}
+		}
+	}
+	PROFILE_INLINE_CACHE(hit);
+
+	if (!hit && !cached) {
+		p_base->callp(p_method, p_args, p_argcount, r_ret, r_err);
+		return;
+	}
+
+	r_err.error = Callable::CallError::CALL_OK;
+#ifdef DEBUG_ENABLED
+	_ObjectDebugLock debug_lock(object);
+#endif
+	if (target.kind == InlineCache::KIND_SCRIPT_FUNCTION) {
+		r_ret = static_cast<GDScriptFunction *>(target.ptr)->call(instance, p_args, p_argcount, r_err);
+	} else {
+		r_ret = static_cast<MethodBind *>(target.ptr)->call(object, p_args, p_argcount, r_err);
+	}
+}
+
+#undef PROFILE_INLINE_CACHE
+
 void (*type_init_function_table[])(Variant *) = {
 	nullptr, // NIL (shouldn't be called).
 	&VariantInitializer<bool>::init, // BOOL.
@@ -215,6 +367,53 @@ void (*type_init_function_table[])(Variant *) = {
 	static const void *switch_table_ops[] = {            \
 		&&OPCODE_OPERATOR,                               \
 		&&OPCODE_OPERATOR_VALIDATED,                     \
+		&&OPCODE_OPERATOR_VALIDATED_ASSIGN,              \
+		&&OPCODE_OPERATOR_VALIDATED_JUMP_IF,             \
+		&&OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT,         \
+		&&OPCODE_OPERATOR_ADD_INT,                       \
+		&&OPCODE_OPERATOR_SUBTRACT_INT,                  \
+		&&OPCODE_OPERATOR_MULTIPLY_INT,                  \
+		&&OPCODE_OPERATOR_NEGATE_INT,                    \
+		&&OPCODE_OPERATOR_EQUAL_INT,                     \
+		&&OPCODE_OPERATOR_NOT_EQUAL_INT,                 \
+		&&OPCODE_OPERATOR_LESS_INT,                      \
+		&&OPCODE_OPERATOR_LESS_EQUAL_INT,                \
+		&&OPCODE_OPERATOR_GREATER_INT,                   \
+		&&OPCODE_OPERATOR_GREATER_EQUAL_INT,             \
+		&&OPCODE_OPERATOR_ADD_FLOAT,                     \
+		&&OPCODE_OPERATOR_SUBTRACT_FLOAT,                \
+		&&OPCODE_OPERATOR_MULTIPLY_FLOAT,                \
+		&&OPCODE_OPERATOR_DIVIDE_FLOAT,                  \
+		&&OPCODE_OPERATOR_NEGATE_FLOAT,                  \
+		&&OPCODE_OPERATOR_EQUAL_FLOAT,                   \
+		&&OPCODE_OPERATOR_NOT_EQUAL_FLOAT,               \
+		&&OPCODE_OPERATOR_LESS_FLOAT,                    \
+		&&OPCODE_OPERATOR_LESS_EQUAL_FLOAT,              \
+		&&OPCODE_OPERATOR_GREATER_FLOAT,                 \
+		&&OPCODE_OPERATOR_GREATER_EQUAL_FLOAT,           \
+		&&OPCODE_OPERATOR_EQUAL_BOOL,                    \
+		&&OPCODE_OPERATOR_NOT_EQUAL_BOOL,                \
+		&&OPCODE_OPERATOR_NOT_BOOL,                      \
+		&&OPCODE_OPERATOR_ADD_VECTOR2,                   \
+		&&OPCODE_OPERATOR_SUBTRACT_VECTOR2,              \
+		&&OPCODE_OPERATOR_MULTIPLY_VECTOR2,              \
+		&&OPCODE_OPERATOR_MULTIPLY_VECTOR2_FLOAT,        \
+		&&OPCODE_OPERATOR_ADD_VECTOR3,                   \
+		&&OPCODE_OPERATOR_SUBTRACT_VECTOR3,              \
+		&&OPCODE_OPERATOR_MULTIPLY_VECTOR3,              \
+		&&OPCODE_OPERATOR_MULTIPLY_VECTOR3_FLOAT,        \
+		&&OPCODE_JUMP_IF_NOT_EQUAL_INT,                  \
+		&&OPCODE_JUMP_IF_NOT_NOT_EQUAL_INT,              \
+		&&OPCODE_JUMP_IF_NOT_LESS_INT,                   \
+		&&OPCODE_JUMP_IF_NOT_LESS_EQUAL_INT,             \
+		&&OPCODE_JUMP_IF_NOT_GREATER_INT,                \
+		&&OPCODE_JUMP_IF_NOT_GREATER_EQUAL_INT,          \
+		&&OPCODE_JUMP_IF_NOT_EQUAL_FLOAT,                \
+		&&OPCODE_JUMP_IF_NOT_NOT_EQUAL_FLOAT,            \
+		&&OPCODE_JUMP_IF_NOT_LESS_FLOAT,                 \
+		&&OPCODE_JUMP_IF_NOT_LESS_EQUAL_FLOAT,           \
+		&&OPCODE_JUMP_IF_NOT_GREATER_FLOAT,              \
+		&&OPCODE_JUMP_IF_NOT_GREATER_EQUAL_FLOAT,        \
 		&&OPCODE_TYPE_TEST_BUILTIN,                      \
 		&&OPCODE_TYPE_TEST_ARRAY,                        \
 		&&OPCODE_TYPE_TEST_NATIVE,                       \
@@ -597,6 +796,11 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 	String err_text;
 
+	GDScriptSampler::Frame *sampler_frame = nullptr;
+	if (unlikely(GDScriptSampler::is_sampling())) {
+		sampler_frame = GDScriptSampler::push_frame(this, line);
+	}
+
 #ifdef DEBUG_ENABLED
 
 	if (EngineDebugger::is_active()) {
@@ -792,6 +996,167 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_OPERATOR_VALIDATED_ASSIGN) {
+				CHECK_SPACE(6);
+
+				int operator_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(operator_idx < 0 || operator_idx >= _operator_funcs_count);
+				Variant::ValidatedOperatorEvaluator operator_func = _operator_funcs_ptr[operator_idx];
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(dst, 2);
+				Variant::Type ret_type = (Variant::Type)_code_ptr[ip + 5];
+
+				// Unlike temporaries, the destination may not hold the result type yet (e.g. uninitialized or untyped variables).
+				if (unlikely(dst->get_type() != ret_type)) {
+					VariantInternal::initialize(dst, ret_type);
+				}
+				operator_func(a, b, dst);
+
+				ip += 6;
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_OPERATOR_VALIDATED_JUMP_IF) {
+				CHECK_SPACE(6);
+
+				int operator_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(operator_idx < 0 || operator_idx >= _operator_funcs_count);
+				Variant::ValidatedOperatorEvaluator operator_func = _operator_funcs_ptr[operator_idx];
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(dst, 2);
+
+				operator_func(a, b, dst);
+
+				if (*VariantInternal::get_bool(dst)) {
+					int to = _code_ptr[ip + 5];
+					GD_ERR_BREAK(to < 0 || to > _code_size);
+					ip = to;
+				} else {
+					ip += 6;
+				}
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT) {
+				CHECK_SPACE(6);
+
+				int operator_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(operator_idx < 0 || operator_idx >= _operator_funcs_count);
+				Variant::ValidatedOperatorEvaluator operator_func = _operator_funcs_ptr[operator_idx];
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(dst, 2);
+
+				operator_func(a, b, dst);
+
+				if (!*VariantInternal::get_bool(dst)) {
+					int to = _code_ptr[ip + 5];
+					GD_ERR_BREAK(to < 0 || to > _code_size);
+					ip = to;
+				} else {
+					ip += 6;
+				}
+			}
+			DISPATCH_OPCODE;
+
+			// Operators on types proven by the analyzer, which use the values directly instead of going through the evaluators.
+			// Unlike the validated evaluators, they adjust the destination type, so they can also write to variables.
+#define OPCODE_OPERATOR_TYPED(m_name, m_ret_type, m_left_type, m_right_type, m_op)   \
+	OPCODE(OPCODE_OPERATOR_##m_name) {                                               \
+		CHECK_SPACE(5);                                                              \
+		GET_VARIANT_PTR(a, 0);                                                       \
+		GET_VARIANT_PTR(b, 1);                                                       \
+		GET_VARIANT_PTR(dst, 2);                                                     \
+		const m_ret_type result = *VariantGetInternalPtr<m_left_type>::get_ptr(a)    \
+				m_op *VariantGetInternalPtr<m_right_type>::get_ptr(b);               \
+		if (unlikely(dst->get_type() != GetTypeInfo<m_ret_type>::VARIANT_TYPE)) {    \
+			VariantInternal::initialize(dst, GetTypeInfo<m_ret_type>::VARIANT_TYPE); \
+		}                                                                            \
+		*VariantGetInternalPtr<m_ret_type>::get_ptr(dst) = result;                   \
+		ip += 5;                                                                     \
+	}                                                                                \
+	DISPATCH_OPCODE
+
+#define OPCODE_OPERATOR_TYPED_UNARY(m_name, m_type, m_op)                        \
+	OPCODE(OPCODE_OPERATOR_##m_name) {                                           \
+		CHECK_SPACE(5);                                                          \
+		GET_VARIANT_PTR(a, 0);                                                   \
+		GET_VARIANT_PTR(dst, 2);                                                 \
+		const m_type result = m_op *VariantGetInternalPtr<m_type>::get_ptr(a);   \
+		if (unlikely(dst->get_type() != GetTypeInfo<m_type>::VARIANT_TYPE)) {    \
+			VariantInternal::initialize(dst, GetTypeInfo<m_type>::VARIANT_TYPE); \
+		}                                                                        \
+		*VariantGetInternalPtr<m_type>::get_ptr(dst) = result;                   \
+		ip += 5;                                                                 \
+	}                                                                            \
+	DISPATCH_OPCODE
+
+#define OPCODE_OPERATOR_TYPED_COMPARISONS(m_type, m_c_type)                   \
+	OPCODE_OPERATOR_TYPED(EQUAL_##m_type, bool, m_c_type, m_c_type, ==);      \
+	OPCODE_OPERATOR_TYPED(NOT_EQUAL_##m_type, bool, m_c_type, m_c_type, !=);  \
+	OPCODE_OPERATOR_TYPED(LESS_##m_type, bool, m_c_type, m_c_type, <);        \
+	OPCODE_OPERATOR_TYPED(LESS_EQUAL_##m_type, bool, m_c_type, m_c_type, <=); \
+	OPCODE_OPERATOR_TYPED(GREATER_##m_type, bool, m_c_type, m_c_type, >);     \
+	OPCODE_OPERATOR_TYPED(GREATER_EQUAL_##m_type, bool, m_c_type, m_c_type, >=)
+
+			OPCODE_OPERATOR_TYPED(ADD_INT, int64_t, int64_t, int64_t, +);
+			OPCODE_OPERATOR_TYPED(SUBTRACT_INT, int64_t, int64_t, int64_t, -);
+			OPCODE_OPERATOR_TYPED(MULTIPLY_INT, int64_t, int64_t, int64_t, *);
+			OPCODE_OPERATOR_TYPED_UNARY(NEGATE_INT, int64_t, -);
+			OPCODE_OPERATOR_TYPED_COMPARISONS(INT, int64_t);
+			OPCODE_OPERATOR_TYPED(ADD_FLOAT, double, double, double, +);
+			OPCODE_OPERATOR_TYPED(SUBTRACT_FLOAT, double, double, double, -);
+			OPCODE_OPERATOR_TYPED(MULTIPLY_FLOAT, double, double, double, *);
+			OPCODE_OPERATOR_TYPED(DIVIDE_FLOAT, double, double, double, /);
+			OPCODE_OPERATOR_TYPED_UNARY(NEGATE_FLOAT, double, -);
+			OPCODE_OPERATOR_TYPED_COMPARISONS(FLOAT, double);
+			OPCODE_OPERATOR_TYPED(EQUAL_BOOL, bool, bool, bool, ==);
+			OPCODE_OPERATOR_TYPED(NOT_EQUAL_BOOL, bool, bool, bool, !=);
+			OPCODE_OPERATOR_TYPED_UNARY(NOT_BOOL, bool, !);
+			OPCODE_OPERATOR_TYPED(ADD_VECTOR2, Vector2, Vector2, Vector2, +);
+			OPCODE_OPERATOR_TYPED(SUBTRACT_VECTOR2, Vector2, Vector2, Vector2, -);
+			OPCODE_OPERATOR_TYPED(MULTIPLY_VECTOR2, Vector2, Vector2, Vector2, *);
+			OPCODE_OPERATOR_TYPED(MULTIPLY_VECTOR2_FLOAT, Vector2, Vector2, double, *);
+			OPCODE_OPERATOR_TYPED(ADD_VECTOR3, Vector3, Vector3, Vector3, +);
+			OPCODE_OPERATOR_TYPED(SUBTRACT_VECTOR3, Vector3, Vector3, Vector3, -);
+			OPCODE_OPERATOR_TYPED(MULTIPLY_VECTOR3, Vector3, Vector3, Vector3, *);
+			OPCODE_OPERATOR_TYPED(MULTIPLY_VECTOR3_FLOAT, Vector3, Vector3, double, *);
+
+			// Typed comparisons fused with the conditional jump consuming them, the condition is a boolean temporary.
+#define OPCODE_JUMP_IF_NOT_TYPED(m_name, m_c_type, m_op)                                                                    \
+	OPCODE(OPCODE_JUMP_IF_NOT_##m_name) {                                                                                   \
+		CHECK_SPACE(6);                                                                                                     \
+		GET_VARIANT_PTR(a, 0);                                                                                              \
+		GET_VARIANT_PTR(b, 1);                                                                                              \
+		GET_VARIANT_PTR(dst, 2);                                                                                            \
+		const bool result = *VariantGetInternalPtr<m_c_type>::get_ptr(a) m_op *VariantGetInternalPtr<m_c_type>::get_ptr(b); \
+		*VariantInternal::get_bool(dst) = result;                                                                           \
+		if (!result) {                                                                                                      \
+			int to = _code_ptr[ip + 5];                                                                                     \
+			GD_ERR_BREAK(to < 0 || to > _code_size);                                                                        \
+			ip = to;                                                                                                        \
+		} else {                                                                                                            \
+			ip += 6;                                                                                                        \
+		}                                                                                                                   \
+	}                                                                                                                       \
+	DISPATCH_OPCODE
+
+#define OPCODE_JUMP_IF_NOT_TYPED_COMPARISONS(m_type, m_c_type)   \
+	OPCODE_JUMP_IF_NOT_TYPED(EQUAL_##m_type, m_c_type, ==);      \
+	OPCODE_JUMP_IF_NOT_TYPED(NOT_EQUAL_##m_type, m_c_type, !=);  \
+	OPCODE_JUMP_IF_NOT_TYPED(LESS_##m_type, m_c_type, <);        \
+	OPCODE_JUMP_IF_NOT_TYPED(LESS_EQUAL_##m_type, m_c_type, <=); \
+	OPCODE_JUMP_IF_NOT_TYPED(GREATER_##m_type, m_c_type, >);     \
+	OPCODE_JUMP_IF_NOT_TYPED(GREATER_EQUAL_##m_type, m_c_type, >=)
+
+			OPCODE_JUMP_IF_NOT_TYPED_COMPARISONS(INT, int64_t);
+			OPCODE_JUMP_IF_NOT_TYPED_COMPARISONS(FLOAT, double);
+
 			OPCODE(OPCODE_TYPE_TEST_BUILTIN) {
 				CHECK_SPACE(4);
 
@@ -1158,7 +1523,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			DISPATCH_OPCODE;
 
 			OPCODE(OPCODE_GET_NAMED) {
-				CHECK_SPACE(4);
+				CHECK_SPACE(5);
 
 				GET_VARIANT_PTR(src, 0);
 				GET_VARIANT_PTR(dst, 1);
@@ -1168,22 +1533,21 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
-				bool valid;
-#ifdef DEBUG_ENABLED
-				//allow better error message in cases where src and dst are the same stack position
-				Variant ret = src->get_named(*index, valid);
+				int cache_index = _code_ptr[ip + 4];
+				GD_ERR_BREAK(cache_index < 0 || cache_index >= _inline_caches_count);
 
-#else
-				*dst = src->get_named(*index, valid);
-#endif
+				bool valid;
+				// Also allows a better error message in cases where src and dst are the same stack position.
+				Variant ret;
+				_get_named_cached(&_inline_caches_ptr[cache_index], src, *index, ret, valid);
 #ifdef DEBUG_ENABLED
 				if (!valid) {
 					err_text = "Invalid access to property or key '" + index->operator String() + "' on a base object of type '" + _get_var_type(src) + "'.";
 					OPCODE_BREAK;
 				}
-				*dst = ret;
 #endif
-				ip += 4;
+				*dst = ret;
+				ip += 5;
 			}
 			DISPATCH_OPCODE;
 
@@ -1719,7 +2083,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				bool call_async = (_code_ptr[ip]) == OPCODE_CALL_ASYNC;
 #endif
 				LOAD_INSTRUCTION_ARGS
-				CHECK_SPACE(3 + instr_arg_count);
+				CHECK_SPACE(4 + instr_arg_count);
 
 				ip += instr_arg_count;
 
@@ -1730,6 +2094,10 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(methodname_idx < 0 || methodname_idx >= _global_names_count);
 				const StringName *methodname = &_global_names_ptr[methodname_idx];
 
+				int cache_index = _code_ptr[ip + 3];
+				GD_ERR_BREAK(cache_index < 0 || cache_index >= _inline_caches_count);
+				InlineCache *cache = &_inline_caches_ptr[cache_index];
+
 				GET_INSTRUCTION_ARG(base, argc);
 				Variant **argptrs = instruction_args;
 
@@ -1747,7 +2115,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				Callable::CallError err;
 				if (call_ret) {
 					GET_INSTRUCTION_ARG(ret, argc + 1);
-					base->callp(*methodname, (const Variant **)argptrs, argc, *ret, err);
+					_call_cached(cache, base, *methodname, (const Variant **)argptrs, argc, *ret, err);
 #ifdef DEBUG_ENABLED
 					if (ret->get_type() == Variant::NIL) {
 						if (base_type == Variant::OBJECT) {
@@ -1777,7 +2145,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 #endif
 				} else {
 					Variant ret;
-					base->callp(*methodname, (const Variant **)argptrs, argc, ret, err);
+					_call_cached(cache, base, *methodname, (const Variant **)argptrs, argc, ret, err);
 				}
 #ifdef DEBUG_ENABLED
 
@@ -1827,7 +2195,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				}
 #endif
 
-				ip += 3;
+				ip += 4;
 			}
 			DISPATCH_OPCODE;
 
@@ -3591,6 +3959,10 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				line = _code_ptr[ip + 1];
 				ip += 2;
 
+				if (unlikely(sampler_frame)) {
+					sampler_frame->line.store(line, std::memory_order_relaxed);
+				}
+
 				if (EngineDebugger::is_active()) {
 					// line
 					bool do_break = false;
@@ -3706,6 +4078,10 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 		stack[i].~Variant();
 	}
 
+	if (sampler_frame) {
+		GDScriptSampler::pop_frame();
+	}
+
 	call_depth--;
 
 	return retvalue;
@@ -32,6 +32,7 @@
 
 #include "gdscript.h"
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode_buffer.h"
 #include "gdscript_cache.h"
 #include "gdscript_tokenizer.h"
 #include "gdscript_tokenizer_buffer.h"
@@ -84,14 +85,24 @@ class EditorExportGDScript : public EditorExportPlugin {
 
 	static constexpr int DEFAULT_SCRIPT_MODE = EditorExportPreset::MODE_SCRIPT_BINARY_TOKENS_COMPRESSED;
 	int script_mode = DEFAULT_SCRIPT_MODE;
+	bool export_bytecode = false;
+	bool export_debug = false;
 
 protected:
+	virtual void _get_export_options(const Ref<EditorExportPlatform> &p_export_platform, List<EditorExportPlatform::ExportOption> *r_options) const override {
+		// Only used with binary tokens, which are loaded instead if the engine version doesn't match.
+		r_options->push_back(EditorExportPlatform::ExportOption(PropertyInfo(Variant::BOOL, "gdscript/export_bytecode"), false));
+	}
+
 	virtual void _export_begin(const HashSet<String> &p_features, bool p_debug, const String &p_path, int p_flags) override {
 		script_mode = DEFAULT_SCRIPT_MODE;
+		export_bytecode = false;
+		export_debug = p_debug;
 
 		const Ref<EditorExportPreset> &preset = get_export_preset();
 		if (preset.is_valid()) {
 			script_mode = preset->get_script_export_mode();
+			export_bytecode = get_option("gdscript/export_bytecode");
 		}
 	}
 
@@ -114,6 +125,27 @@ protected:
 		}
 
 		add_file(p_path.get_basename() + ".gdc", file, true);
+
+		if (export_bytecode) {
+			_export_bytecode(p_path, source, compress_mode);
+		}
+	}
+
+	void _export_bytecode(const String &p_path, const String &p_source, GDScriptTokenizerBuffer::CompressMode p_compress_mode) {
+		Ref<GDScript> script = ResourceLoader::load(p_path);
+		if (script.is_null() || !script->is_valid() || script->get_source_code() != p_source) {
+			print_verbose(vformat(R"(GDScript: Not exporting the bytecode of "%s", it doesn't compile.)", p_path));
+			return;
+		}
+
+		String error;
+		Vector<uint8_t> bytecode = GDScriptBytecodeBuffer::serialize(script.ptr(), p_compress_mode, export_debug, &error);
+		if (bytecode.is_empty()) {
+			print_verbose(vformat(R"(GDScript: Not exporting the bytecode of "%s": %s)", p_path, error));
+			return;
+		}
+
+		add_file(p_path.get_basename() + ".gdbc", bytecode, false);
 	}
 
 public:
@@ -0,0 +1,35 @@
+extends RefCounted
+
+const COUNT = 100000
+
+func bench_int_arithmetic() -> int:
+	var sum := 0
+	var step := 3
+	for i in COUNT:
+		sum += i * step
+		sum -= i
+		step = step + 1 - 1
+	return sum
+
+func bench_float_arithmetic() -> float:
+	var value := 0.0
+	var scale := 0.5
+	for i in COUNT:
+		value += scale * 2.0
+		value = value * 0.999
+	return value
+
+func bench_vector_arithmetic() -> Vector2:
+	var position := Vector2()
+	var velocity := Vector2(1.0, 0.5)
+	var delta := 0.016
+	for i in COUNT:
+		position += velocity * delta
+		velocity = velocity * 0.99
+	return position
+
+func bench_untyped_arithmetic():
+	var sum = 0
+	for i in COUNT:
+		sum += i * 3
+	return sum
@@ -0,0 +1,35 @@
+extends RefCounted
+
+const COUNT = 100000
+
+func bench_while_compare() -> int:
+	var i := 0
+	var sum := 0
+	while i < COUNT:
+		sum += i
+		i += 1
+	return sum
+
+func bench_if_compare() -> int:
+	var evens := 0
+	for i in COUNT:
+		if i % 2 == 0:
+			evens += 1
+		elif i > COUNT:
+			evens -= 1
+	return evens
+
+func bench_logic_operators() -> int:
+	var hits := 0
+	for i in COUNT:
+		if i > 10 and i < COUNT - 10:
+			hits += 1
+		if i == 0 or i == COUNT - 1:
+			hits += 2
+	return hits
+
+func bench_ternary() -> int:
+	var sum := 0
+	for i in COUNT:
+		sum += 1 if i < 500 else 2
+	return sum
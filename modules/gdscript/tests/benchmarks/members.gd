@@ -0,0 +1,27 @@
+extends RefCounted
+
+const COUNT = 100000
+
+var counter: int = 0
+var total: float = 0.0
+var position := Vector3()
+
+func bench_member_increment() -> int:
+	counter = 0
+	for i in COUNT:
+		counter += 1
+	return counter
+
+func bench_member_accumulate() -> float:
+	total = 0.0
+	for i in COUNT:
+		total += 0.5
+		total *= 0.999
+	return total
+
+func bench_member_vector() -> Vector3:
+	position = Vector3()
+	var step := Vector3(0.1, 0.2, 0.3)
+	for i in COUNT:
+		position += step
+	return position
@@ -0,0 +1,53 @@
+extends RefCounted
+
+const COUNT = 10000
+const ALIVE = 100
+
+class Bullet extends RefCounted:
+	var velocity := Vector2(10.0, 0.0)
+	var damage := 5
+	var tags: Array[StringName] = [&"bullet"]
+
+var bullet_pool := ObjectPool.new()
+var node_pool := ObjectPool.new()
+
+func _init():
+	bullet_pool.object_script = Bullet
+	node_pool.object_class = &"Node2D"
+
+func bench_spawn_new() -> int:
+	var alive: Array[Bullet] = []
+	alive.resize(ALIVE)
+	for i in COUNT:
+		var bullet := Bullet.new()
+		bullet.damage += i
+		alive[i % ALIVE] = bullet
+	return alive[0].damage
+
+func bench_spawn_pooled() -> int:
+	var alive: Array[Bullet] = []
+	alive.resize(ALIVE)
+	for i in COUNT:
+		var slot := i % ALIVE
+		if alive[slot]:
+			bullet_pool.release(alive[slot])
+		var bullet: Bullet = bullet_pool.acquire()
+		bullet.damage += i
+		alive[slot] = bullet
+	for bullet in alive:
+		bullet_pool.release(bullet)
+	return bullet_pool.get_available_count()
+
+func bench_spawn_node_new() -> int:
+	for i in COUNT:
+		var node := Node2D.new()
+		node.position.x = i
+		node.free()
+	return COUNT
+
+func bench_spawn_node_pooled() -> int:
+	for i in COUNT:
+		var node: Node2D = node_pool.acquire()
+		node.position.x = i
+		node_pool.release(node)
+	return node_pool.get_available_count()
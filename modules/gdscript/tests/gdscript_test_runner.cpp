@@ -32,6 +32,7 @@
 
 #include "../gdscript.h"
 #include "../gdscript_analyzer.h"
+#include "../gdscript_bytecode_buffer.h"
 #include "../gdscript_compiler.h"
 #include "../gdscript_parser.h"
 #include "../gdscript_tokenizer_buffer.h"
@@ -131,11 +132,12 @@ void finish_language() {
 
 StringName GDScriptTestRunner::test_function_name;
 
-GDScriptTestRunner::GDScriptTestRunner(const String &p_source_dir, bool p_init_language, bool p_print_filenames, bool p_use_binary_tokens) {
+GDScriptTestRunner::GDScriptTestRunner(const String &p_source_dir, bool p_init_language, bool p_print_filenames, bool p_use_binary_tokens, bool p_use_bytecode) {
 	test_function_name = StaticCString::create("test");
 	do_init_languages = p_init_language;
 	print_filenames = p_print_filenames;
 	binary_tokens = p_use_binary_tokens;
+	bytecode = p_use_bytecode;
 
 	source_dir = p_source_dir;
 	if (!source_dir.ends_with("/")) {
@@ -314,6 +316,7 @@ bool GDScriptTestRunner::make_tests_for_dir(const String &p_dir) {
 					if (binary_tokens) {
 						test.set_tokenizer_mode(GDScriptTest::TOKENIZER_BUFFER);
 					}
+					test.set_use_bytecode(bytecode);
 					tests.push_back(test);
 				}
 			}
@@ -644,6 +647,27 @@ GDScriptTest::TestResult GDScriptTest::execute_test_code(bool p_is_generating) {
 		ERR_FAIL_V_MSG(result, "\nCould not find test function on: '" + source_file + "'");
 	}
 
+	if (use_bytecode) {
+		// Loaded by the reload below, scripts which can't be saved are compiled from their source instead, the same as when exported.
+		// Saved with the line markers, which the expected errors refer to.
+		Vector<uint8_t> buffer = GDScriptBytecodeBuffer::serialize(script.ptr(), GDScriptTokenizerBuffer::COMPRESS_ZSTD, true);
+		if (!buffer.is_empty()) {
+			GDScriptCache::remove_script(source_file);
+
+			Ref<GDScript> loaded;
+			loaded.instantiate();
+			loaded->set_path(source_file, true);
+			if (tokenizer_mode == TOKENIZER_TEXT) {
+				loaded->set_source_code(script->get_source_code());
+			} else {
+				loaded->set_binary_tokens_source(script->get_binary_tokens_source());
+			}
+			if (GDScriptBytecodeBuffer::make_scripts(loaded.ptr(), buffer) == OK) {
+				script = loaded;
+			}
+		}
+	}
+
 	// Setup output handlers.
 	ErrorHandlerData error_data(&result, this);
 
@@ -85,6 +85,7 @@ private:
 	ErrorHandlerList _error_handler;
 
 	TokenizerMode tokenizer_mode = TOKENIZER_TEXT;
+	bool use_bytecode = false; // Run the test from the saved and reloaded bytecode.
 
 	void enable_stdout();
 	void disable_stdout();
@@ -105,6 +106,8 @@ public:
 
 	void set_tokenizer_mode(TokenizerMode p_tokenizer_mode) { tokenizer_mode = p_tokenizer_mode; }
 	TokenizerMode get_tokenizer_mode() const { return tokenizer_mode; }
+	void set_use_bytecode(bool p_use_bytecode) { use_bytecode = p_use_bytecode; }
+	bool get_use_bytecode() const { return use_bytecode; }
 
 	GDScriptTest(const String &p_source_path, const String &p_output_path, const String &p_base_dir);
 	GDScriptTest() :
@@ -119,6 +122,7 @@ class GDScriptTestRunner {
 	bool do_init_languages = false;
 	bool print_filenames; // Whether filenames should be printed when generated/running tests
 	bool binary_tokens; // Test with buffer tokenizer.
+	bool bytecode; // Test with saved bytecode.
 
 	bool make_tests();
 	bool make_tests_for_dir(const String &p_dir);
@@ -131,7 +135,7 @@ public:
 	int run_tests();
 	bool generate_outputs();
 
-	GDScriptTestRunner(const String &p_source_dir, bool p_init_language, bool p_print_filenames = false, bool p_use_binary_tokens = false);
+	GDScriptTestRunner(const String &p_source_dir, bool p_init_language, bool p_print_filenames = false, bool p_use_binary_tokens = false, bool p_use_bytecode = false);
 	~GDScriptTestRunner();
 };
 
@@ -33,6 +33,9 @@
 
 #include "gdscript_test_runner.h"
 
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "tests/test_benchmark.h"
 #include "tests/test_macros.h"
 
 namespace GDScriptTests {
@@ -43,7 +46,8 @@ TEST_SUITE("[Modules][GDScript]") {
 	TEST_CASE("Script compilation and runtime") {
 		bool print_filenames = OS::get_singleton()->get_cmdline_args().find("--print-filenames") != nullptr;
 		bool use_binary_tokens = OS::get_singleton()->get_cmdline_args().find("--use-binary-tokens") != nullptr;
-		GDScriptTestRunner runner("modules/gdscript/tests/scripts", true, print_filenames, use_binary_tokens);
+		bool use_bytecode = OS::get_singleton()->get_cmdline_args().find("--use-bytecode") != nullptr;
+		GDScriptTestRunner runner("modules/gdscript/tests/scripts", true, print_filenames, use_binary_tokens, use_bytecode);
 		int fail_count = runner.run_tests();
 		INFO("Make sure `*.out` files have expected results.");
 		REQUIRE_MESSAGE(fail_count == 0, "All GDScript tests should pass.");
@@ -70,6 +74,105 @@ func _init():
 	ref_counted->set_script(gdscript);
 	CHECK_MESSAGE(int(ref_counted->get_meta("result")) == 42, "The script should assign object metadata successfully.");
 }
+
+TEST_CASE("[Modules][GDScript][Benchmark] Virtual machine loops" * doctest::skip()) {
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(R"(
+extends RefCounted
+
+func typed_sum(n: int) -> int:
+	var sum := 0
+	for i in n:
+		sum += i * 2
+	return sum
+
+func untyped_sum(n):
+	var sum = 0
+	for i in n:
+		sum += i * 2
+	return sum
+
+func vector_math(n: int) -> float:
+	var v := Vector2()
+	for i in n:
+		v += Vector2(i, 1.0).normalized()
+	return v.length()
+
+func _double(x: int) -> int:
+	return x * 2
+
+func calls(n: int) -> int:
+	var sum := 0
+	for i in n:
+		sum += _double(i)
+	return sum
+
+func array_iteration(n: int) -> int:
+	var array: Array[int] = []
+	for i in n:
+		array.push_back(i)
+	var sum := 0
+	for value in array:
+		sum += value
+	return sum
+)");
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	REQUIRE_MESSAGE(error == OK, "The script should parse successfully.");
+
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(gdscript);
+
+	const int count = 100000;
+	for (const char *function : { "typed_sum", "untyped_sum", "vector_math", "calls", "array_iteration" }) {
+		TestBenchmark::measure(vformat("GDScript/%s", function), 1, [&]() {
+			ref_counted->call(function, count);
+		});
+	}
+	CHECK(int64_t(ref_counted->call("typed_sum", count)) == int64_t(count) * (count - 1));
+	CHECK(ref_counted->call("untyped_sum", count) == ref_counted->call("calls", count));
+}
+
+TEST_CASE("[Modules][GDScript][Benchmark] Benchmark corpus" * doctest::skip()) {
+	// Every `bench_*` function of the scripts in the corpus is measured, along with its instruction count.
+	const String corpus_path = "modules/gdscript/tests/benchmarks";
+	PackedStringArray files = DirAccess::get_files_at(corpus_path);
+	REQUIRE_MESSAGE(!files.is_empty(), "The benchmark corpus should be found (tests must run from the repository root).");
+	files.sort();
+
+	for (const String &file : files) {
+		if (file.get_extension() != "gd") {
+			continue;
+		}
+
+		Ref<GDScript> gdscript = memnew(GDScript);
+		gdscript->set_source_code(FileAccess::get_file_as_string(corpus_path.path_join(file)));
+		ERR_PRINT_OFF;
+		const Error error = gdscript->reload();
+		ERR_PRINT_ON;
+		REQUIRE_MESSAGE(error == OK, vformat("The benchmark script \"%s\" should compile.", file));
+
+		Ref<RefCounted> ref_counted = memnew(RefCounted);
+		ref_counted->set_script(gdscript);
+
+		List<StringName> functions;
+		for (const KeyValue<StringName, GDScriptFunction *> &E : gdscript->get_member_functions()) {
+			if (String(E.key).begins_with("bench_")) {
+				functions.push_back(E.key);
+			}
+		}
+		functions.sort_custom<StringName::AlphCompare>();
+
+		for (const StringName &function : functions) {
+			const String name = vformat("GDScript/%s/%s", file.get_basename(), function);
+			print_line(vformat("%s: %d instructions.", name, gdscript->get_member_functions()[function]->disassemble(Vector<String>(), false)));
+			TestBenchmark::measure(name, 1, [&]() {
+				ref_counted->call(function);
+			});
+		}
+	}
+}
 #endif // TOOLS_ENABLED
 
 TEST_CASE("[Modules][GDScript] Validate built-in API") {
@@ -0,0 +1,58 @@
+# Validated operators are fused with the assignment or the conditional jump that follows them.
+
+var member_int: int = 1
+var member_float: float = 0.5
+var member_untyped = "not a number"
+static var static_int: int = 10
+
+func with_defaults(a: int = 2 + 3, b: int = a * 2) -> int:
+	return a + b
+
+func test():
+	var local_int := 0
+	for i in 5:
+		local_int += i
+	print(local_int)
+
+	member_int += local_int
+	member_float *= 3.0
+	static_int -= member_int
+	print(member_int, " ", member_float, " ", static_int)
+
+	var a := 2
+	var b := 3
+	member_untyped = a * b
+	print(member_untyped, " ", type_string(typeof(member_untyped)))
+
+	if true:
+		var text := "reused slot"
+		print(text)
+	if true:
+		var sum: int = a + b
+		print(sum, " ", type_string(typeof(sum)))
+
+	var vector := Vector2(1, 2)
+	vector += Vector2(0.5, 0.5)
+	vector = vector * vector
+	print(vector)
+
+	var count := 0
+	while count < 10 and a > 0:
+		count += 3
+		if count == 6:
+			continue
+		if count > 8 or b < 0:
+			break
+	print(count)
+
+	var smaller := 1 if a < b else 2
+	var larger := 1 if a > b else 2
+	print(smaller, " ", larger)
+
+	match a + b:
+		5:
+			print("matched")
+		_:
+			print("not matched")
+
+	print(with_defaults(), " ", with_defaults(1), " ", with_defaults(1, 1))
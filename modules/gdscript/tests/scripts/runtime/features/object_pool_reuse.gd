@@ -0,0 +1,42 @@
+class Bullet:
+	var speed := 5.0
+	var hits: Array[int] = []
+	var target = null
+
+	func _init():
+		speed = 10.0
+
+
+func test():
+	var pool := ObjectPool.new()
+	pool.object_script = Bullet
+
+	var bullet: Bullet = pool.acquire()
+	print(bullet.speed)
+	bullet.speed = 2.0
+	bullet.hits.append(1)
+	bullet.target = pool
+	var id := bullet.get_instance_id()
+	pool.release(bullet)
+	print(pool.get_available_count())
+
+	# Recycled objects get the default values of their members, and _init() runs again.
+	bullet = pool.acquire()
+	print(bullet.get_instance_id() == id)
+	print(bullet.speed, " ", bullet.hits, " ", bullet.target)
+	print(pool.get_available_count())
+	var fresh := Bullet.new()
+	print(bullet.speed == fresh.speed and bullet.hits == fresh.hits and bullet.target == fresh.target)
+
+	pool.max_size = 2
+	pool.prewarm(5)
+	print(pool.get_available_count())
+	pool.release(bullet)
+	print(pool.get_available_count())
+
+	var plain := ObjectPool.new()
+	plain.object_class = &"RefCounted"
+	var object: RefCounted = plain.acquire()
+	print(object.get_class())
+	plain.release(object)
+	print(plain.acquire() == object)
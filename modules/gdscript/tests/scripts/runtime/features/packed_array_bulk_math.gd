@@ -0,0 +1,37 @@
+func test():
+	var a := PackedFloat32Array([1.0, 2.0, 3.0, 4.0, 5.0])
+	var b := PackedFloat32Array([5.0, 4.0, 3.0, 2.0, 1.0])
+	a.add_array(b)
+	print(a)
+	a.multiply_scalar(0.5)
+	a.add_scalar(-1.0)
+	print(a)
+	a.multiply_array(b)
+	print(a)
+	a.lerp_array(b, 0.5)
+	print(a)
+	a.clamp(2.0, 3.0)
+	print(a)
+	print(b.sum(), " ", b.dot(b), " ", b.min(), " ", b.max())
+
+	var steps := PackedFloat64Array([0, 0, 0, 0, 0, 0])
+	steps.fill_range(1.0, 0.5)
+	print(steps)
+	print(PackedFloat64Array().max())
+
+	var points := PackedVector3Array([Vector3(1, 0, 0), Vector3(0, 1, 0), Vector3(0, 0, 1)])
+	points.transform(Transform3D(Basis(), Vector3(1, 2, 3)))
+	print(points)
+	points.multiply_scalar(2.0)
+	points.add_array(PackedVector3Array([Vector3.ONE, Vector3.ONE, Vector3.ONE]))
+	print(points, " ", points.sum())
+
+	var points_2d := PackedVector2Array([Vector2(1, 2), Vector2(3, 4)])
+	points_2d.lerp_array(PackedVector2Array([Vector2(3, 2), Vector2(1, 0)]), 0.5)
+	points_2d.transform(Transform2D(0.0, Vector2(10, 0)))
+	print(points_2d, " ", points_2d.sum())
+
+	# Packed arrays are passed by reference, so these work on the caller's array.
+	var shared := a
+	shared.fill_range(0.0)
+	print(a)
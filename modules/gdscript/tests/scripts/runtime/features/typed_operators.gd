@@ -0,0 +1,79 @@
+# Operators on int, float, bool, Vector2 and Vector3 have their own instructions when the types are known,
+# they must give the same results as the untyped operators.
+
+func check(typed: Variant, untyped: Variant) -> void:
+	if typeof(typed) != typeof(untyped) or typed != untyped:
+		print("Mismatch: ", var_to_str(typed), " != ", var_to_str(untyped))
+
+func test():
+	var i1 := 7
+	var i2 := -3
+	var u1: Variant = i1
+	var u2: Variant = i2
+	check(i1 + i2, u1 + u2)
+	check(i1 - i2, u1 - u2)
+	check(i1 * i2, u1 * u2)
+	check(-i1, -u1)
+	check(i1 < i2, u1 < u2)
+	check(i1 >= i2, u1 >= u2)
+	check(i1 == 7, u1 == 7)
+	check(i1 != 7, u1 != 7)
+
+	var f1 := 2.5
+	var f2 := -0.5
+	var v1: Variant = f1
+	var v2: Variant = f2
+	check(f1 + f2, v1 + v2)
+	check(f1 - f2, v1 - v2)
+	check(f1 * f2, v1 * v2)
+	check(f1 / f2, v1 / v2)
+	check(-f1, -v1)
+	check(f1 <= f2, v1 <= v2)
+	check(f1 > f2, v1 > v2)
+	# Int literals used with floats.
+	check(f1 * 2, v1 * 2)
+	check(3 - f1, 3 - v1)
+	check(f1 < 3, v1 < 3)
+	check(f1 / 2, v1 / 2)
+
+	var nan := NAN
+	print(nan < 1.0, " ", nan >= 1.0, " ", nan == nan, " ", nan != nan)
+	if nan < 1.0:
+		print("not reached")
+	if not nan < 1.0:
+		print("NaN is unordered")
+
+	var b1 := true
+	var b2 := false
+	check(b1 == b2, (b1 as Variant) == (b2 as Variant))
+	check(b1 != b2, (b1 as Variant) != (b2 as Variant))
+	check(not b1, not (b1 as Variant))
+
+	var a2 := Vector2(1.5, -2)
+	var b2v := Vector2(0.5, 4)
+	check(a2 + b2v, (a2 as Variant) + (b2v as Variant))
+	check(a2 - b2v, (a2 as Variant) - (b2v as Variant))
+	check(a2 * b2v, (a2 as Variant) * (b2v as Variant))
+	check(a2 * 0.25, (a2 as Variant) * 0.25)
+	check(a2 * 3, (a2 as Variant) * 3)
+
+	var a3 := Vector3(1.5, -2, 3)
+	var b3 := Vector3(0.5, 4, -1)
+	check(a3 + b3, (a3 as Variant) + (b3 as Variant))
+	check(a3 - b3, (a3 as Variant) - (b3 as Variant))
+	check(a3 * b3, (a3 as Variant) * (b3 as Variant))
+	check(a3 * 0.25, (a3 as Variant) * 0.25)
+
+	# Typed results stored into untyped and reused variables.
+	var untyped = "text"
+	untyped = i1 * i2
+	print(untyped, " ", type_string(typeof(untyped)))
+	untyped = a2 - b2v
+	print(untyped, " ", type_string(typeof(untyped)))
+
+	var total := 0.0
+	var step := 0
+	while step < 10:
+		total += step * 0.5
+		step += 1
+	print(total)
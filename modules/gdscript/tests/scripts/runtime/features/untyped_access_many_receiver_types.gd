@@ -0,0 +1,44 @@
+# The same untyped access sees different receiver types, including ones resolved differently.
+
+class A:
+	var x = 1
+	func f():
+		return "A.f"
+
+class B extends A:
+	var y = 2
+	func f():
+		return "B.f"
+
+class WithGetter:
+	var x:
+		get: return 3
+	func f():
+		return "WithGetter.f"
+
+class WithGet:
+	func _get(property):
+		if property == &"x":
+			return 4
+		return null
+
+func test():
+	var receivers = [A.new(), B.new(), WithGetter.new(), WithGet.new(), Vector2(5, 6), Vector3i(7, 8, 9), { x = 10 }]
+	for i in 2:
+		for receiver in receivers:
+			print(receiver.x)
+
+	var callees = [A.new(), B.new(), WithGetter.new(), A.new()]
+	for i in 2:
+		for callee in callees:
+			@warning_ignore("unsafe_method_access")
+			print(callee.f())
+
+	# Native methods, called on scripted and plain objects.
+	var objects = [A.new(), RefCounted.new(), WithGet.new(), Object.new()]
+	for i in 2:
+		for object in objects:
+			@warning_ignore("unsafe_method_access")
+			print(object.get_class())
+	@warning_ignore("unsafe_method_access")
+	objects[3].free()
@@ -0,0 +1,28 @@
+# The same script runs on objects of different native classes, whose native members are resolved differently.
+
+class Extension extends Node:
+	var x = 1
+
+func test():
+	var node_2d = Node2D.new()
+	node_2d.position = Vector2(1, 2)
+	var control = Control.new()
+	control.position = Vector2(3, 4)
+
+	var objects = [node_2d, control]
+	for object in objects:
+		@warning_ignore("unsafe_method_access")
+		object.set_script(Extension)
+
+	for i in 2:
+		for object in objects:
+			@warning_ignore("unsafe_property_access")
+			print(object.position)
+			@warning_ignore("unsafe_method_access")
+			print(object.get_position())
+			@warning_ignore("unsafe_property_access")
+			print(object.x)
+
+	for object in objects:
+		@warning_ignore("unsafe_method_access")
+		object.free()
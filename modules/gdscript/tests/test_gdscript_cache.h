@@ -0,0 +1,197 @@
+/**************************************************************************/
+/*  test_gdscript_cache.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_GDSCRIPT_CACHE_H
+#define TEST_GDSCRIPT_CACHE_H
+
+#include "../gdscript.h"
+#include "../gdscript_cache.h"
+#include "../gdscript_parser.h"
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "tests/test_benchmark.h"
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestGDScriptCache {
+
+static void write_script(const String &p_path, const String &p_source_code) {
+	DirAccess::make_dir_recursive_absolute(p_path.get_base_dir());
+	Ref<FileAccess> file = FileAccess::open(p_path, FileAccess::WRITE);
+	REQUIRE(file.is_valid());
+	file->store_string(p_source_code);
+}
+
+// Scripts that extend and preload each other, along with one that doesn't parse and one
+// that doesn't pass the analysis.
+static void write_scripts(const String &p_dir) {
+	write_script(p_dir.path_join("helper.gd"), R"(
+static func twice(p_value: int) -> int:
+	return p_value * 2
+)");
+	write_script(p_dir.path_join("base.gd"), R"(
+extends RefCounted
+
+const Helper = preload("helper.gd")
+
+func value() -> int:
+	return Helper.twice(base_value())
+
+func base_value() -> int:
+	return 2
+)");
+	write_script(p_dir.path_join("derived.gd"), R"(
+extends "base.gd"
+
+func base_value() -> int:
+	return 5
+)");
+	write_script(p_dir.path_join("parse_error.gd"), R"(
+extends "base.gd"
+
+func broken(
+)");
+	write_script(p_dir.path_join("type_error.gd"), R"(
+extends "base.gd"
+
+func base_value() -> int:
+	return "five"
+)");
+}
+
+static Vector<String> get_errors(const Ref<GDScriptParserRef> &p_parser_ref) {
+	Vector<String> errors;
+	for (const GDScriptParser::ParserError &error : p_parser_ref->get_parser()->get_errors()) {
+		errors.push_back(vformat("%d:%d: %s", error.line, error.column, error.message));
+	}
+	return errors;
+}
+
+// What loading the script gives: the value it computes, or that it failed to compile.
+static Variant get_loaded_value(const String &p_path) {
+	Error err = OK;
+	ERR_PRINT_OFF;
+	const Ref<GDScript> script = GDScriptCache::get_full_script(p_path, err);
+	ERR_PRINT_ON;
+	if (script.is_null() || !script->is_valid()) {
+		return Variant();
+	}
+	const Ref<RefCounted> instance = Object::cast_to<RefCounted>(ClassDB::instantiate(script->get_instance_base_type()));
+	REQUIRE(instance.is_valid());
+	instance->set_script(script);
+	return instance->call("value");
+}
+
+TEST_CASE("[Modules][GDScript][Cache] Scripts parsed ahead of time compile like scripts parsed on load") {
+	const String serial_dir = TestUtils::get_temp_path("gdscript_cache/serial").simplify_path();
+	const String parallel_dir = TestUtils::get_temp_path("gdscript_cache/parallel").simplify_path();
+	write_scripts(serial_dir);
+	write_scripts(parallel_dir);
+
+	const char *names[] = { "helper.gd", "base.gd", "derived.gd", "parse_error.gd", "type_error.gd" };
+
+	// Only the leaves are given, what they extend and preload is found while parsing.
+	Vector<String> paths;
+	paths.push_back(parallel_dir.path_join("derived.gd"));
+	paths.push_back(parallel_dir.path_join("parse_error.gd"));
+	paths.push_back(parallel_dir.path_join("type_error.gd"));
+	GDScriptCache::parse_scripts(paths);
+	for (const char *name : names) {
+		const Ref<GDScriptParserRef> parser_ref = GDScriptCache::get_parsed_script(parallel_dir.path_join(name));
+		REQUIRE_MESSAGE(parser_ref.is_valid(), vformat("%s should have been parsed ahead of time.", name));
+		CHECK(parser_ref->get_status() == GDScriptParserRef::PARSED);
+	}
+	CHECK_FALSE(get_errors(GDScriptCache::get_parsed_script(parallel_dir.path_join("parse_error.gd"))).is_empty());
+
+	for (const char *name : names) {
+		if (String(name) == "helper.gd") {
+			continue; // Has no value().
+		}
+		const Variant serial_value = get_loaded_value(serial_dir.path_join(name));
+		const Variant parallel_value = get_loaded_value(parallel_dir.path_join(name));
+		CHECK_MESSAGE(parallel_value == serial_value, vformat("%s should compile the same when parsed ahead of time.", name));
+	}
+	CHECK(get_loaded_value(parallel_dir.path_join("base.gd")) == Variant(4));
+	CHECK(get_loaded_value(parallel_dir.path_join("derived.gd")) == Variant(10));
+	CHECK(get_loaded_value(parallel_dir.path_join("parse_error.gd")) == Variant());
+	CHECK(get_loaded_value(parallel_dir.path_join("type_error.gd")) == Variant());
+
+	// Loading took the parsers parsed ahead of time through the analysis, so they hold the
+	// same errors as parsers made on load.
+	for (const char *name : names) {
+		const Ref<GDScriptParserRef> parallel_ref = GDScriptCache::get_parsed_script(parallel_dir.path_join(name));
+		REQUIRE(parallel_ref.is_valid());
+		Error err = OK;
+		const Ref<GDScriptParserRef> serial_ref = GDScriptCache::get_parser(serial_dir.path_join(name), parallel_ref->get_status(), err);
+		REQUIRE(serial_ref.is_valid());
+		CHECK_MESSAGE(get_errors(parallel_ref) == get_errors(serial_ref), vformat("%s should report the same errors when parsed ahead of time.", name));
+	}
+	CHECK_FALSE(get_errors(GDScriptCache::get_parsed_script(parallel_dir.path_join("type_error.gd"))).is_empty());
+
+	GDScriptCache::release_parsed_scripts();
+	for (const char *name : names) {
+		GDScriptCache::remove_script(serial_dir.path_join(name));
+		GDScriptCache::remove_script(parallel_dir.path_join(name));
+	}
+}
+
+TEST_CASE("[Modules][GDScript][Cache][Benchmark] Parsing scripts ahead of time" * doctest::skip()) {
+	const String dir = TestUtils::get_temp_path("gdscript_cache/benchmark").simplify_path();
+
+	String functions;
+	for (int i = 0; i < 50; i++) {
+		functions += vformat("func function_%d(p_value: int) -> int:\n\tvar result := p_value\n\tfor i in range(%d):\n\t\tresult += i * p_value\n\treturn result\n\n", i, i);
+	}
+	write_script(dir.path_join("base.gd"), "extends RefCounted\n\n" + functions);
+	Vector<String> paths;
+	for (int i = 0; i < 64; i++) {
+		const String path = dir.path_join(vformat("script_%d.gd", i));
+		write_script(path, "extends \"base.gd\"\n\n" + functions);
+		paths.push_back(path);
+	}
+
+	TestBenchmark::measure("GDScriptCache/parse_64_scripts_serial", 1, [&]() {
+		Vector<Ref<GDScriptParserRef>> parser_refs;
+		Error err = OK;
+		parser_refs.push_back(GDScriptCache::get_parser(dir.path_join("base.gd"), GDScriptParserRef::PARSED, err));
+		for (const String &path : paths) {
+			parser_refs.push_back(GDScriptCache::get_parser(path, GDScriptParserRef::PARSED, err));
+		}
+	});
+	TestBenchmark::measure("GDScriptCache/parse_64_scripts_parallel", 1, [&]() {
+		GDScriptCache::parse_scripts(paths);
+		GDScriptCache::release_parsed_scripts();
+	});
+}
+
+} // namespace TestGDScriptCache
+
+#endif // TEST_GDSCRIPT_CACHE_H
@@ -0,0 +1,201 @@
+/**************************************************************************/
+/*  test_gdscript_sampler.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_GDSCRIPT_SAMPLER_H
+#define TEST_GDSCRIPT_SAMPLER_H
+
+#include "../gdscript.h"
+#include "../gdscript_sampler.h"
+
+#include "core/io/file_access.h"
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestGDScriptSampler {
+
+static Ref<GDScript> compile_script(const String &p_source_code) {
+	Ref<GDScript> script;
+	script.instantiate();
+	script->set_source_code(p_source_code);
+	ERR_PRINT_OFF;
+	const Error err = script->reload();
+	ERR_PRINT_ON;
+	CHECK(err == OK);
+	return script;
+}
+
+static const GDScriptFunction *get_function(const Ref<GDScript> &p_script, const StringName &p_name) {
+	GDScriptFunction *const *function = p_script->get_member_functions().getptr(p_name);
+	REQUIRE(function);
+	return *function;
+}
+
+// The frame as it reads in folded stacks.
+static String frame_name(const GDScriptFunction *p_function, int p_line) {
+	return vformat("%s (%s:%d)", p_function->get_name(), p_function->get_source(), p_line);
+}
+
+static bool wait_for_samples(uint64_t p_count) {
+	for (int i = 0; i < 5000; i++) {
+		if (GDScriptSampler::get_sample_count() >= p_count) {
+			return true;
+		}
+		OS::get_singleton()->delay_usec(1000);
+	}
+	return false;
+}
+
+// Maps each stack to its count.
+static HashMap<String, uint64_t> load_folded_stacks() {
+	const String path = TestUtils::get_temp_path("gdscript_sampler.folded");
+	REQUIRE(GDScriptSampler::save_folded_stacks(path) == OK);
+
+	HashMap<String, uint64_t> stacks;
+	const Vector<String> lines = FileAccess::get_file_as_string(path).split("\n", false);
+	for (const String &line : lines) {
+		const int count_pos = line.rfind(" ");
+		REQUIRE(count_pos > 0);
+		stacks[line.substr(0, count_pos)] += line.substr(count_pos + 1).to_int();
+	}
+	return stacks;
+}
+
+TEST_CASE("[Modules][GDScript][Sampler] Samples are attributed to the published frames") {
+	const Ref<GDScript> script = compile_script(R"(
+func outer():
+	return inner()
+
+func inner():
+	return 1
+)");
+	const GDScriptFunction *outer = get_function(script, "outer");
+	const GDScriptFunction *inner = get_function(script, "inner");
+
+	GDScriptSampler::start(100);
+	REQUIRE(GDScriptSampler::push_frame(outer, 3) != nullptr);
+	REQUIRE(GDScriptSampler::push_frame(inner, 6) != nullptr);
+	CHECK(wait_for_samples(5));
+	GDScriptSampler::pop_frame();
+	GDScriptSampler::pop_frame();
+
+	// Threads without frames aren't sampled.
+	const uint64_t sample_count = GDScriptSampler::get_sample_count();
+	OS::get_singleton()->delay_usec(5000);
+	CHECK(GDScriptSampler::get_sample_count() == sample_count);
+	GDScriptSampler::stop();
+
+	const HashMap<String, uint64_t> stacks = load_folded_stacks();
+	REQUIRE(stacks.size() == 1);
+	const String stack = frame_name(outer, 3) + ";" + frame_name(inner, 6);
+	REQUIRE(stacks.has(stack));
+	CHECK(stacks[stack] == sample_count);
+
+	GDScriptSampler::clear();
+	CHECK(GDScriptSampler::get_sample_count() == 0);
+	CHECK(load_folded_stacks().is_empty());
+
+	GDScriptSampler::finish();
+}
+
+TEST_CASE("[Modules][GDScript][Sampler] Running scripts publish their calls") {
+	const Ref<GDScript> script = compile_script(R"(
+extends RefCounted
+
+func outer():
+	return inner()
+
+func inner():
+	var total = 0
+	for i in 100000:
+		total += i
+	return total
+)");
+	Ref<RefCounted> object;
+	object.instantiate();
+	object->set_script(script);
+
+	GDScriptSampler::start(100);
+	for (int i = 0; i < 10000 && GDScriptSampler::get_sample_count() < 5; i++) {
+		object->call("outer");
+	}
+	GDScriptSampler::stop();
+	CHECK(GDScriptSampler::get_sample_count() >= 5);
+
+	// Lines are only tracked in debug builds, so only the functions are checked.
+	const String outer_prefix = vformat("outer (%s:", get_function(script, "outer")->get_source());
+	const String inner_prefix = vformat(";inner (%s:", get_function(script, "inner")->get_source());
+	bool all_in_outer = true;
+	bool any_in_inner = false;
+	for (const KeyValue<String, uint64_t> &E : load_folded_stacks()) {
+		all_in_outer &= E.key.begins_with(outer_prefix);
+		any_in_inner |= E.key.contains(inner_prefix);
+	}
+	CHECK(all_in_outer);
+	CHECK(any_in_inner);
+
+	GDScriptSampler::finish();
+}
+
+TEST_CASE("[Modules][GDScript][Sampler] Functions freed while sampling") {
+	GDScriptSampler::start(100);
+
+	Ref<GDScript> script = compile_script(R"(
+func freed():
+	pass
+)");
+	const String freed_name = frame_name(get_function(script, "freed"), 3);
+	REQUIRE(GDScriptSampler::push_frame(get_function(script, "freed"), 3) != nullptr);
+	CHECK(wait_for_samples(1));
+	GDScriptSampler::pop_frame();
+	const uint64_t freed_samples = GDScriptSampler::get_sample_count();
+	script.unref();
+
+	// Its name must not be reused for a function allocated in its place.
+	const Ref<GDScript> other_script = compile_script(R"(
+func other():
+	pass
+)");
+	const GDScriptFunction *other = get_function(other_script, "other");
+	REQUIRE(GDScriptSampler::push_frame(other, 3) != nullptr);
+	CHECK(wait_for_samples(freed_samples + 1));
+	GDScriptSampler::pop_frame();
+	GDScriptSampler::stop();
+
+	const HashMap<String, uint64_t> stacks = load_folded_stacks();
+	CHECK(stacks.size() == 2);
+	CHECK(stacks.has(freed_name));
+	CHECK(stacks.has(frame_name(other, 3)));
+
+	GDScriptSampler::finish();
+}
+
+} // namespace TestGDScriptSampler
+
+#endif // TEST_GDSCRIPT_SAMPLER_H
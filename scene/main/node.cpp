@@ -1168,6 +1168,15 @@ BitField<Node::ProcessThreadMessages> Node::get_process_thread_messages() const
 	return data.process_thread_messages;
 }
 
+void Node::set_process_thread_parallel_nodes(bool p_enabled) {
+	ERR_THREAD_GUARD
+	data.process_thread_parallel_nodes = p_enabled;
+}
+
+bool Node::is_process_thread_parallel_nodes() const {
+	return data.process_thread_parallel_nodes;
+}
+
 void Node::set_process_input(bool p_enable) {
 	ERR_THREAD_GUARD
 	if (p_enable == data.input) {
@@ -3385,6 +3394,9 @@ void Node::_validate_property(PropertyInfo &p_property) const {
 	if ((p_property.name == "process_thread_group_order" || p_property.name == "process_thread_messages") && data.process_thread_group == PROCESS_THREAD_GROUP_INHERIT) {
 		p_property.usage = 0;
 	}
+	if (p_property.name == "process_thread_parallel_nodes" && data.process_thread_group != PROCESS_THREAD_GROUP_SUB_THREAD) {
+		p_property.usage = 0;
+	}
 }
 
 void Node::input(const Ref<InputEvent> &p_event) {
@@ -3562,6 +3574,9 @@ void Node::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_process_thread_messages", "flags"), &Node::set_process_thread_messages);
 	ClassDB::bind_method(D_METHOD("get_process_thread_messages"), &Node::get_process_thread_messages);
 
+	ClassDB::bind_method(D_METHOD("set_process_thread_parallel_nodes", "enabled"), &Node::set_process_thread_parallel_nodes);
+	ClassDB::bind_method(D_METHOD("is_process_thread_parallel_nodes"), &Node::is_process_thread_parallel_nodes);
+
 	ClassDB::bind_method(D_METHOD("set_process_thread_group_order", "order"), &Node::set_process_thread_group_order);
 	ClassDB::bind_method(D_METHOD("get_process_thread_group_order"), &Node::get_process_thread_group_order);
 
@@ -3769,6 +3784,7 @@ void Node::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "process_thread_group", PROPERTY_HINT_ENUM, "Inherit,Main Thread,Sub Thread"), "set_process_thread_group", "get_process_thread_group");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "process_thread_group_order"), "set_process_thread_group_order", "get_process_thread_group_order");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "process_thread_messages", PROPERTY_HINT_FLAGS, "Process,Physics Process"), "set_process_thread_messages", "get_process_thread_messages");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "process_thread_parallel_nodes"), "set_process_thread_parallel_nodes", "is_process_thread_parallel_nodes");
 
 	ADD_GROUP("Physics Interpolation", "physics_interpolation_");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "physics_interpolation_mode", PROPERTY_HINT_ENUM, "Inherit,On,Off"), "set_physics_interpolation_mode", "get_physics_interpolation_mode");
@@ -3818,6 +3834,7 @@ Node::Node() {
 
 	data.physics_process_internal = false;
 	data.process_internal = false;
+	data.process_thread_parallel_nodes = false;
 
 	data.input = false;
 	data.shortcut_input = false;
@@ -3895,6 +3912,11 @@ Error Node::emit_signalp(const StringName &p_name, const Variant **p_args, int p
 	return Object::emit_signalp(p_name, p_args, p_argcount);
 }
 
+Error Node::emit_signalp(const SignalID &p_signal, const Variant **p_args, int p_argcount) {
+	ERR_THREAD_GUARD_V(ERR_INVALID_PARAMETER);
+	return Object::emit_signalp(p_signal, p_args, p_argcount);
+}
+
 bool Node::has_signal(const StringName &p_name) const {
 	ERR_THREAD_GUARD_V(false);
 	return Object::has_signal(p_name);
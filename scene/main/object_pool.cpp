@@ -0,0 +1,217 @@
+/**************************************************************************/
+/*  object_pool.cpp                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "object_pool.h"
+
+#include "core/object/class_db.h"
+#include "scene/main/node.h"
+#include "scene/main/scene_tree.h"
+
+StringName ObjectPool::_get_instance_class() const {
+	if (object_script.is_valid()) {
+		return object_script->get_instance_base_type();
+	}
+	return object_class;
+}
+
+bool ObjectPool::_is_compatible(const Object *p_object) const {
+	if (object_script.is_valid()) {
+		const ScriptInstance *script_instance = p_object->get_script_instance();
+		return script_instance && script_instance->get_script() == object_script;
+	}
+	return p_object->get_class_name() == object_class && !p_object->get_script_instance();
+}
+
+Variant ObjectPool::_create() {
+	const StringName class_name = _get_instance_class();
+	ERR_FAIL_COND_V_MSG(class_name == StringName(), Variant(), "An object class or script must be set to create objects.");
+	ERR_FAIL_COND_V_MSG(!ClassDB::can_instantiate(class_name), Variant(), vformat("Class \"%s\" can't be instantiated.", class_name));
+	if (object_script.is_valid()) {
+		ERR_FAIL_COND_V_MSG(!object_script->can_instantiate(), Variant(), vformat("Script \"%s\" can't be instantiated.", object_script->get_path()));
+	}
+
+	Object *object = ClassDB::instantiate(class_name);
+	ERR_FAIL_NULL_V(object, Variant());
+	// Taken as a Variant right away, so RefCounted objects are freed if anything fails below.
+	Variant ret = object;
+	if (object_script.is_valid()) {
+		object->set_script(object_script);
+	}
+	return ret;
+}
+
+void ObjectPool::_free(const Variant &p_object) {
+	Object *object = p_object.get_validated_object();
+	if (!object || object->is_ref_counted()) {
+		return;
+	}
+
+	Node *node = Object::cast_to<Node>(object);
+	if (node && SceneTree::get_singleton()) {
+		// The node may be releasing itself from one of its own methods.
+		node->queue_free();
+	} else {
+		memdelete(object);
+	}
+}
+
+void ObjectPool::_push(const Variant &p_object) {
+	available.push_back(p_object);
+	available_ids.insert(p_object);
+}
+
+Variant ObjectPool::_pop() {
+	Variant object = available[available.size() - 1];
+	available.resize(available.size() - 1);
+	available_ids.erase(object);
+	return object;
+}
+
+void ObjectPool::set_object_class(const StringName &p_class) {
+	if (object_class == p_class) {
+		return;
+	}
+	clear();
+	object_class = p_class;
+}
+
+StringName ObjectPool::get_object_class() const {
+	return object_class;
+}
+
+void ObjectPool::set_object_script(const Ref<Script> &p_script) {
+	if (object_script == p_script) {
+		return;
+	}
+	clear();
+	object_script = p_script;
+}
+
+Ref<Script> ObjectPool::get_object_script() const {
+	return object_script;
+}
+
+void ObjectPool::set_max_size(int p_max_size) {
+	ERR_FAIL_COND(p_max_size < 0);
+	max_size = p_max_size;
+	while (max_size > 0 && available.size() > (uint32_t)max_size) {
+		_free(_pop());
+	}
+}
+
+int ObjectPool::get_max_size() const {
+	return max_size;
+}
+
+Variant ObjectPool::acquire() {
+	while (!available.is_empty()) {
+		Variant object = _pop();
+
+		Object *obj = object.get_validated_object();
+		if (!obj) {
+			// Freed while in the pool.
+			continue;
+		}
+		ScriptInstance *script_instance = obj->get_script_instance();
+		if (script_instance && !script_instance->reset_members()) {
+			_free(object);
+			continue;
+		}
+		return object;
+	}
+	return _create();
+}
+
+void ObjectPool::release(Object *p_object) {
+	ERR_FAIL_NULL(p_object);
+	ERR_FAIL_COND_MSG(available_ids.has(p_object->get_instance_id()), "The object was already released to this pool.");
+	ERR_FAIL_COND_MSG(!_is_compatible(p_object), vformat("Can't release an object of class \"%s\" to a pool of \"%s\" objects.", p_object->get_class_name(), _get_instance_class()));
+
+	Node *node = Object::cast_to<Node>(p_object);
+	if (node && node->get_parent()) {
+		// Keeps its name, which stays unique when added back to the same parent.
+		node->get_parent()->remove_child(node);
+	}
+
+	if (max_size > 0 && available.size() >= (uint32_t)max_size) {
+		_free(p_object);
+		return;
+	}
+	_push(p_object);
+}
+
+void ObjectPool::prewarm(int p_count) {
+	ERR_FAIL_COND(p_count < 0);
+	for (int i = 0; i < p_count; i++) {
+		if (max_size > 0 && available.size() >= (uint32_t)max_size) {
+			break;
+		}
+		Variant object = _create();
+		if (object.get_type() == Variant::NIL) {
+			break;
+		}
+		_push(object);
+	}
+}
+
+void ObjectPool::clear() {
+	for (const Variant &object : available) {
+		_free(object);
+	}
+	available.clear();
+	available_ids.clear();
+}
+
+int ObjectPool::get_available_count() const {
+	return available.size();
+}
+
+void ObjectPool::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("set_object_class", "class"), &ObjectPool::set_object_class);
+	ClassDB::bind_method(D_METHOD("get_object_class"), &ObjectPool::get_object_class);
+	ClassDB::bind_method(D_METHOD("set_object_script", "script"), &ObjectPool::set_object_script);
+	ClassDB::bind_method(D_METHOD("get_object_script"), &ObjectPool::get_object_script);
+	ClassDB::bind_method(D_METHOD("set_max_size", "max_size"), &ObjectPool::set_max_size);
+	ClassDB::bind_method(D_METHOD("get_max_size"), &ObjectPool::get_max_size);
+
+	ClassDB::bind_method(D_METHOD("acquire"), &ObjectPool::acquire);
+	ClassDB::bind_method(D_METHOD("release", "object"), &ObjectPool::release);
+	ClassDB::bind_method(D_METHOD("prewarm", "count"), &ObjectPool::prewarm);
+	ClassDB::bind_method(D_METHOD("clear"), &ObjectPool::clear);
+	ClassDB::bind_method(D_METHOD("get_available_count"), &ObjectPool::get_available_count);
+
+	ADD_PROPERTY(PropertyInfo(Variant::STRING_NAME, "object_class"), "set_object_class", "get_object_class");
+	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "object_script", PROPERTY_HINT_RESOURCE_TYPE, "Script"), "set_object_script", "get_object_script");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "max_size", PROPERTY_HINT_RANGE, "0,65536,1,or_greater"), "set_max_size", "get_max_size");
+}
+
+ObjectPool::~ObjectPool() {
+	clear();
+}
@@ -0,0 +1,81 @@
+/**************************************************************************/
+/*  object_pool.h                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef OBJECT_POOL_H
+#define OBJECT_POOL_H
+
+#include "core/object/ref_counted.h"
+#include "core/object/script_language.h"
+#include "core/templates/hash_set.h"
+#include "core/templates/local_vector.h"
+
+// Keeps released objects of one class and script to hand them out again, so spawning
+// them doesn't go through ClassDB and script instance creation, nor freeing every time.
+class ObjectPool : public RefCounted {
+	GDCLASS(ObjectPool, RefCounted);
+
+	StringName object_class;
+	Ref<Script> object_script;
+	int max_size = 0;
+
+	// Holding the Variant keeps RefCounted objects alive. Nodes are owned by the pool and freed with it.
+	LocalVector<Variant> available;
+	HashSet<ObjectID> available_ids; // Catches objects released twice.
+
+	StringName _get_instance_class() const;
+	bool _is_compatible(const Object *p_object) const;
+	Variant _create();
+	void _free(const Variant &p_object);
+	void _push(const Variant &p_object);
+	Variant _pop();
+
+protected:
+	static void _bind_methods();
+
+public:
+	void set_object_class(const StringName &p_class);
+	StringName get_object_class() const;
+
+	void set_object_script(const Ref<Script> &p_script);
+	Ref<Script> get_object_script() const;
+
+	void set_max_size(int p_max_size);
+	int get_max_size() const;
+
+	Variant acquire();
+	void release(Object *p_object);
+	void prewarm(int p_count);
+	void clear();
+	int get_available_count() const;
+
+	~ObjectPool();
+};
+
+#endif // OBJECT_POOL_H
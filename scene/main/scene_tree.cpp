@@ -32,6 +32,7 @@
 
 #include "core/config/project_settings.h"
 #include "core/debugger/engine_debugger.h"
+#include "core/debugger/trace_profiler.h"
 #include "core/input/input.h"
 #include "core/io/dir_access.h"
 #include "core/io/image_loader.h"
@@ -473,6 +474,7 @@ void SceneTree::iteration_prepare() {
 }
 
 bool SceneTree::physics_process(double p_time) {
+	TRACE_ZONE("SceneTree::physics_process");
 	current_frame++;
 
 	flush_transform_notifications();
@@ -504,6 +506,7 @@ bool SceneTree::physics_process(double p_time) {
 }
 
 bool SceneTree::process(double p_time) {
+	TRACE_ZONE("SceneTree::process");
 	if (MainLoop::process(p_time)) {
 		_quit = true;
 	}
@@ -906,16 +909,8 @@ bool SceneTree::is_paused() const {
 	return paused;
 }
 
-void SceneTree::_process_group(ProcessGroup *p_group, bool p_physics) {
-	// When reading this function, keep in mind that this code must work in a way where
-	// if any node is removed, this needs to continue working.
-
-	p_group->call_queue.flush(); // Flush messages before processing.
-
+Vector<Node *> &SceneTree::_get_sorted_process_nodes(ProcessGroup *p_group, bool p_physics) {
 	Vector<Node *> &nodes = p_physics ? p_group->physics_nodes : p_group->nodes;
-	if (nodes.is_empty()) {
-		return;
-	}
 
 	if (p_physics) {
 		if (p_group->physics_node_order_dirty) {
@@ -929,14 +924,12 @@ void SceneTree::_process_group(ProcessGroup *p_group, bool p_physics) {
 		}
 	}
 
-	// Make a copy, so if nodes are added/removed from process, this does not break
-	Vector<Node *> nodes_copy = nodes;
-
-	uint32_t node_count = nodes_copy.size();
-	Node **nodes_ptr = (Node **)nodes_copy.ptr(); // Force cast, pointer will not change.
+	return nodes;
+}
 
-	for (uint32_t i = 0; i < node_count; i++) {
-		Node *n = nodes_ptr[i];
+void SceneTree::_process_nodes(Node *const *p_nodes, uint32_t p_count, bool p_physics) {
+	for (uint32_t i = 0; i < p_count; i++) {
+		Node *n = p_nodes[i];
 		if (nodes_removed_on_group_call.has(n)) {
 			// Node may have been removed during process, skip it.
 			// Keep in mind removals can only happen on the main thread.
@@ -963,6 +956,24 @@ void SceneTree::_process_group(ProcessGroup *p_group, bool p_physics) {
 			}
 		}
 	}
+}
+
+void SceneTree::_process_group(ProcessGroup *p_group, bool p_physics) {
+	// When reading this function, keep in mind that this code must work in a way where
+	// if any node is removed, this needs to continue working.
+
+	TRACE_ZONE(p_physics ? "SceneTree::physics_process_group" : "SceneTree::process_group");
+	p_group->call_queue.flush(); // Flush messages before processing.
+
+	Vector<Node *> &nodes = _get_sorted_process_nodes(p_group, p_physics);
+	if (nodes.is_empty()) {
+		return;
+	}
+
+	// Make a copy, so if nodes are added/removed from process, this does not break
+	Vector<Node *> nodes_copy = nodes;
+
+	_process_nodes(nodes_copy.ptr(), nodes_copy.size(), p_physics);
 
 	p_group->call_queue.flush(); // Flush messages also after processing (for potential deferred calls).
 }
@@ -973,6 +984,75 @@ void SceneTree::_process_groups_thread(uint32_t p_index, bool p_physics) {
 	Node::current_process_thread_group = nullptr;
 }
 
+// Only called for sub-thread groups. Main thread groups are never split, as their nodes may
+// access the whole tree.
+bool SceneTree::_add_process_group_chunks(ProcessGroup *p_group, bool p_physics) {
+	if (!p_group->owner->data.process_thread_parallel_nodes) {
+		return false;
+	}
+	const uint32_t node_count = (p_physics ? p_group->physics_nodes : p_group->nodes).size();
+	const uint32_t chunk_count = MIN(node_count / PROCESS_CHUNK_MIN_NODES, MAX(1, WorkerThreadPool::get_singleton()->get_thread_count()) * (uint32_t)PROCESS_CHUNKS_PER_THREAD);
+	if (chunk_count < 2) {
+		return false; // Not worth splitting, process it as a whole.
+	}
+
+	// Messages must be flushed before any chunk starts, so it's done here, on behalf of the group.
+	Node::current_process_thread_group = p_group->owner;
+	p_group->call_queue.flush();
+	Node::current_process_thread_group = nullptr;
+
+	// Copy, same as in _process_group(). The flush above may have changed which nodes process.
+	p_group->parallel_nodes = _get_sorted_process_nodes(p_group, p_physics);
+	const uint32_t count = p_group->parallel_nodes.size();
+
+	for (uint32_t i = 0; i < chunk_count; i++) {
+		const uint32_t index = local_process_chunk_cache.size();
+		if (index == process_chunk_call_queues.size()) {
+			process_chunk_call_queues.push_back(memnew(CallQueue(process_group_call_queue_allocator)));
+		}
+
+		ProcessGroupChunk chunk;
+		chunk.group = p_group;
+		chunk.from = (uint64_t)count * i / chunk_count;
+		chunk.to = (uint64_t)count * (i + 1) / chunk_count;
+		chunk.call_queue = process_chunk_call_queues[index];
+		local_process_chunk_cache.push_back(chunk);
+	}
+	return true;
+}
+
+void SceneTree::_process_group_chunks_thread(uint32_t p_index, bool p_physics) {
+	const ProcessGroupChunk &chunk = local_process_chunk_cache[p_index];
+	Node::current_process_thread_group = chunk.group->owner;
+	MessageQueue::set_thread_singleton_override(chunk.call_queue);
+	_process_nodes(chunk.group->parallel_nodes.ptr() + chunk.from, chunk.to - chunk.from, p_physics);
+	MessageQueue::set_thread_singleton_override(nullptr);
+	Node::current_process_thread_group = nullptr;
+}
+
+void SceneTree::_finish_process_group_chunks() {
+	for (uint32_t i = 0; i < local_process_chunk_cache.size(); i++) {
+		const ProcessGroupChunk &chunk = local_process_chunk_cache[i];
+		// Chunks are in node order, so deferred calls end up in the same order
+		// as if the nodes had been processed one after the other.
+		if (unlikely(chunk.call_queue->transfer_to(MessageQueue::get_main_singleton()) != OK)) {
+			// Run them now rather than losing them, even if out of order.
+			ERR_PRINT("Could not move the deferred calls of parallel processed nodes to the main message queue, running them right away.");
+			chunk.call_queue->flush();
+		}
+
+		if (i + 1 == local_process_chunk_cache.size() || local_process_chunk_cache[i + 1].group != chunk.group) {
+			// Last chunk of the group.
+			ProcessGroup *pg = chunk.group;
+			pg->parallel_nodes.clear();
+			Node::current_process_thread_group = pg->owner;
+			pg->call_queue.flush(); // Flush messages also after processing (for potential deferred calls).
+			Node::current_process_thread_group = nullptr;
+		}
+	}
+	local_process_chunk_cache.clear();
+}
+
 void SceneTree::_process(bool p_physics) {
 	if (process_groups_dirty) {
 		{
@@ -1034,7 +1114,10 @@ void SceneTree::_process(bool p_physics) {
 				for (uint32_t j = from; j < i; j++) {
 					if (process_groups[j]->last_pass == process_last_pass) {
 						if (using_threads) {
-							local_process_group_cache.push_back(process_groups[j]);
+							// Groups of independent nodes are split, others processed as a whole.
+							if (!_add_process_group_chunks(process_groups[j], p_physics)) {
+								local_process_group_cache.push_back(process_groups[j]);
+							}
 						} else {
 							_process_group(process_groups[j], p_physics);
 						}
@@ -1043,7 +1126,15 @@ void SceneTree::_process(bool p_physics) {
 
 				if (using_threads) {
 					WorkerThreadPool::GroupID id = WorkerThreadPool::get_singleton()->add_template_group_task(this, &SceneTree::_process_groups_thread, p_physics, local_process_group_cache.size(), -1, true);
+					WorkerThreadPool::GroupID chunks_id = WorkerThreadPool::INVALID_TASK_ID;
+					if (!local_process_chunk_cache.is_empty()) {
+						chunks_id = WorkerThreadPool::get_singleton()->add_template_group_task(this, &SceneTree::_process_group_chunks_thread, p_physics, local_process_chunk_cache.size(), -1, true);
+					}
 					WorkerThreadPool::get_singleton()->wait_for_group_task_completion(id);
+					if (chunks_id != WorkerThreadPool::INVALID_TASK_ID) {
+						WorkerThreadPool::get_singleton()->wait_for_group_task_completion(chunks_id);
+						_finish_process_group_chunks();
+					}
 				}
 			}
 
@@ -1906,6 +1997,9 @@ SceneTree::~SceneTree() {
 		}
 	}
 
+	for (CallQueue *call_queue : process_chunk_call_queues) {
+		memdelete(call_queue);
+	}
 	memdelete(process_group_call_queue_allocator);
 
 	if (singleton == this) {
@@ -98,6 +98,20 @@ private:
 		bool removed = false;
 		Node *owner = nullptr;
 		uint64_t last_pass = 0;
+		Vector<Node *> parallel_nodes; // Nodes being processed in parallel chunks.
+	};
+
+	// Part of a process group whose nodes are processed in parallel.
+	struct ProcessGroupChunk {
+		ProcessGroup *group = nullptr;
+		uint32_t from = 0;
+		uint32_t to = 0;
+		CallQueue *call_queue = nullptr; // Collects deferred calls, merged in order afterwards.
+	};
+
+	enum {
+		PROCESS_CHUNK_MIN_NODES = 64, // Below this, splitting costs more than it saves.
+		PROCESS_CHUNKS_PER_THREAD = 4, // Some slack to balance nodes that take longer.
 	};
 
 	struct ProcessGroupSort {
@@ -109,6 +123,8 @@ private:
 	LocalVector<ProcessGroup *> process_groups;
 	bool process_groups_dirty = true;
 	LocalVector<ProcessGroup *> local_process_group_cache; // Used when processing to group what needs to
+	LocalVector<ProcessGroupChunk> local_process_chunk_cache;
+	LocalVector<CallQueue *> process_chunk_call_queues; // Kept between frames, one per chunk.
 	uint64_t process_last_pass = 1;
 
 	ProcessGroup default_process_group;
@@ -214,8 +230,13 @@ private:
 	void remove_from_group(const StringName &p_group, Node *p_node);
 	void make_group_changed(const StringName &p_group);
 
+	Vector<Node *> &_get_sorted_process_nodes(ProcessGroup *p_group, bool p_physics);
+	void _process_nodes(Node *const *p_nodes, uint32_t p_count, bool p_physics);
 	void _process_group(ProcessGroup *p_group, bool p_physics);
 	void _process_groups_thread(uint32_t p_index, bool p_physics);
+	bool _add_process_group_chunks(ProcessGroup *p_group, bool p_physics);
+	void _process_group_chunks_thread(uint32_t p_index, bool p_physics);
+	void _finish_process_group_chunks();
 	void _process(bool p_physics);
 
 	void _remove_process_group(Node *p_node);
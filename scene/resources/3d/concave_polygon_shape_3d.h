@@ -38,6 +38,8 @@ class ConcavePolygonShape3D : public Shape3D {
 
 	Vector<Vector3> faces;
 	bool backface_collision = false;
+	// BVH baked by the physics server, loaded before the faces.
+	PackedByteArray bvh_data;
 
 	struct DrawEdge {
 		Vector3 a;
@@ -64,6 +66,9 @@ protected:
 
 	virtual void _update_shape() override;
 
+	void _set_bvh_data(const PackedByteArray &p_data);
+	PackedByteArray _get_bvh_data() const;
+
 public:
 	void set_faces(const Vector<Vector3> &p_faces);
 	Vector<Vector3> get_faces() const;
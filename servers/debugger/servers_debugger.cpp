@@ -106,13 +106,15 @@ Array ServersDebugger::ServersProfilerFrame::serialize() {
 		}
 	}
 
-	arr.push_back(script_functions.size() * 5);
+	arr.push_back(script_functions.size() * 7);
 	for (int i = 0; i < script_functions.size(); i++) {
 		arr.push_back(script_functions[i].sig_id);
 		arr.push_back(script_functions[i].call_count);
 		arr.push_back(script_functions[i].self_time);
 		arr.push_back(script_functions[i].total_time);
 		arr.push_back(script_functions[i].internal_time);
+		arr.push_back(script_functions[i].inline_cache_hits);
+		arr.push_back(script_functions[i].inline_cache_misses);
 	}
 	return arr;
 }
@@ -148,15 +150,17 @@ bool ServersDebugger::ServersProfilerFrame::deserialize(const Array &p_arr) {
 	int func_size = p_arr[idx];
 	idx += 1;
 	CHECK_SIZE(p_arr, idx + func_size, "ServersProfilerFrame");
-	for (int i = 0; i < func_size / 5; i++) {
+	for (int i = 0; i < func_size / 7; i++) {
 		ScriptFunctionInfo fi;
 		fi.sig_id = p_arr[idx];
 		fi.call_count = p_arr[idx + 1];
 		fi.self_time = p_arr[idx + 2];
 		fi.total_time = p_arr[idx + 3];
 		fi.internal_time = p_arr[idx + 4];
+		fi.inline_cache_hits = p_arr[idx + 5];
+		fi.inline_cache_misses = p_arr[idx + 6];
 		script_functions.push_back(fi);
-		idx += 5;
+		idx += 7;
 	}
 	CHECK_END(p_arr, idx, "ServersProfilerFrame");
 	return true;
@@ -269,6 +273,8 @@ public:
 			w[i].total_time = ptrs[i]->total_time / 1000000.0;
 			w[i].self_time = ptrs[i]->self_time / 1000000.0;
 			w[i].internal_time = ptrs[i]->internal_time / 1000000.0;
+			w[i].inline_cache_hits = ptrs[i]->inline_cache_hits;
+			w[i].inline_cache_misses = ptrs[i]->inline_cache_misses;
 		}
 	}
 
@@ -70,6 +70,8 @@ public:
 		double self_time = 0;
 		double total_time = 0;
 		double internal_time = 0;
+		uint64_t inline_cache_hits = 0;
+		uint64_t inline_cache_misses = 0;
 	};
 
 	// Servers profiler
@@ -151,6 +151,11 @@ class GodotBody2D : public GodotCollisionObject2D {
 	GodotPhysicsDirectBodyState2D *direct_state = nullptr;
 
 	uint64_t island_step = 0;
+	uint32_t island_index = 0;
+
+	// Motion from integrate_forces(), applied to the shapes by apply_integrated_forces().
+	Vector2 pending_motion;
+	bool has_pending_motion = false;
 
 	void _update_transform_dependent();
 
@@ -201,6 +206,9 @@ public:
 
 	_FORCE_INLINE_ uint64_t get_island_step() const { return island_step; }
 	_FORCE_INLINE_ void set_island_step(uint64_t p_step) { island_step = p_step; }
+	// Only valid during the step set with set_island_step().
+	_FORCE_INLINE_ uint32_t get_island_index() const { return island_index; }
+	_FORCE_INLINE_ void set_island_index(uint32_t p_index) { island_index = p_index; }
 
 	_FORCE_INLINE_ void add_constraint(GodotConstraint2D *p_constraint, int p_pos) { constraint_list.push_back({ p_constraint, p_pos }); }
 	_FORCE_INLINE_ void remove_constraint(GodotConstraint2D *p_constraint, int p_pos) { constraint_list.erase({ p_constraint, p_pos }); }
@@ -315,8 +323,12 @@ public:
 	_FORCE_INLINE_ real_t get_friction() const { return friction; }
 	_FORCE_INLINE_ real_t get_bounce() const { return bounce; }
 
+	// The integration only changes the body itself, so it can run for several bodies at once.
+	// The matching apply_*() call then updates the broadphase and the lists of the space.
 	void integrate_forces(real_t p_step);
+	void apply_integrated_forces();
 	void integrate_velocities(real_t p_step);
+	void apply_integrated_velocities();
 
 	_FORCE_INLINE_ Vector2 get_velocity_in_local_point(const Vector2 &rel_pos) const {
 		return linear_velocity + Vector2(-angular_velocity * rel_pos.y, angular_velocity * rel_pos.x);
@@ -36,6 +36,7 @@
 
 #include "core/config/project_settings.h"
 #include "core/debugger/engine_debugger.h"
+#include "core/debugger/trace_profiler.h"
 #include "core/os/os.h"
 
 #define FLUSH_QUERY_CHECK(m_object) \
@@ -1292,6 +1293,8 @@ void GodotPhysicsServer2D::step(real_t p_step) {
 		return;
 	}
 
+	TRACE_ZONE("PhysicsServer2D::step");
+
 	_update_shapes();
 
 	island_count = 0;
@@ -33,6 +33,7 @@
 #include "godot_collision_solver_2d.h"
 #include "godot_physics_server_2d.h"
 
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 #include "core/templates/pair.h"
 
@@ -117,14 +118,18 @@ int GodotPhysicsDirectSpaceState2D::intersect_point(const PointParameters &p_par
 bool GodotPhysicsDirectSpaceState2D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
 	ERR_FAIL_COND_V(space->locked, false);
 
+	int amount = space->broadphase->cull_segment(p_parameters.from, p_parameters.to, space->intersection_query_results, GodotSpace2D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+
+	return _intersect_ray(p_parameters, p_parameters.from, p_parameters.to, space->intersection_query_results, space->intersection_query_subindex_results, amount, r_result);
+}
+
+bool GodotPhysicsDirectSpaceState2D::_intersect_ray(const RayParameters &p_parameters, const Vector2 &p_from, const Vector2 &p_to, GodotCollisionObject2D *const *p_objects, const int *p_subindices, int p_amount, RayResult &r_result) const {
 	Vector2 begin, end;
 	Vector2 normal;
-	begin = p_parameters.from;
-	end = p_parameters.to;
+	begin = p_from;
+	end = p_to;
 	normal = (end - begin).normalized();
 
-	int amount = space->broadphase->cull_segment(begin, end, space->intersection_query_results, GodotSpace2D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
-
 	//todo, create another array that references results, compute AABBs and check closest point to ray origin, sort, and stop evaluating results when beyond first collision
 
 	bool collided = false;
@@ -133,18 +138,18 @@ bool GodotPhysicsDirectSpaceState2D::intersect_ray(const RayParameters &p_parame
 	const GodotCollisionObject2D *res_obj = nullptr;
 	real_t min_d = 1e10;
 
-	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+	for (int i = 0; i < p_amount; i++) {
+		if (!_can_collide_with(p_objects[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(p_objects[i]->get_self())) {
 			continue;
 		}
 
-		const GodotCollisionObject2D *col_obj = space->intersection_query_results[i];
+		const GodotCollisionObject2D *col_obj = p_objects[i];
 
-		int shape_idx = space->intersection_query_subindex_results[i];
+		int shape_idx = p_subindices[i];
 		Transform2D inv_xform = col_obj->get_shape_inv_transform(shape_idx) * col_obj->get_inv_transform();
 
 		Vector2 local_from = inv_xform.xform(begin);
@@ -253,43 +258,54 @@ int GodotPhysicsDirectSpaceState2D::intersect_shape(const ShapeParameters &p_par
 	return cc;
 }
 
+Rect2 GodotPhysicsDirectSpaceState2D::_get_motion_aabb(const GodotShape2D *p_shape, const Transform2D &p_transform, const Vector2 &p_motion, real_t p_margin) {
+	Rect2 aabb = p_transform.xform(p_shape->get_aabb());
+	aabb = aabb.merge(Rect2(aabb.position + p_motion, aabb.size)); //motion
+	aabb = aabb.grow(p_margin);
+	return aabb;
+}
+
 bool GodotPhysicsDirectSpaceState2D::cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe) {
 	GodotShape2D *shape = GodotPhysicsServer2D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
 	ERR_FAIL_NULL_V(shape, false);
 
-	Rect2 aabb = p_parameters.transform.xform(shape->get_aabb());
-	aabb = aabb.merge(Rect2(aabb.position + p_parameters.motion, aabb.size)); //motion
-	aabb = aabb.grow(p_parameters.margin);
+	Rect2 aabb = _get_motion_aabb(shape, p_parameters.transform, p_parameters.motion, p_parameters.margin);
 
 	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, GodotSpace2D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
 
+	_cast_motion(p_parameters, shape, p_parameters.transform, p_parameters.motion, space->intersection_query_results, space->intersection_query_subindex_results, amount, p_closest_safe, p_closest_unsafe);
+
+	return true;
+}
+
+void GodotPhysicsDirectSpaceState2D::_cast_motion(const ShapeParameters &p_parameters, GodotShape2D *p_shape, const Transform2D &p_transform, const Vector2 &p_motion, GodotCollisionObject2D *const *p_objects, const int *p_subindices, int p_amount, real_t &r_closest_safe, real_t &r_closest_unsafe) const {
 	real_t best_safe = 1;
 	real_t best_unsafe = 1;
 
-	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+	for (int i = 0; i < p_amount; i++) {
+		if (!_can_collide_with(p_objects[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(p_objects[i]->get_self())) {
 			continue; //ignore excluded
 		}
 
-		const GodotCollisionObject2D *col_obj = space->intersection_query_results[i];
-		int shape_idx = space->intersection_query_subindex_results[i];
+		const GodotCollisionObject2D *col_obj = p_objects[i];
+		int shape_idx = p_subindices[i];
 
 		Transform2D col_obj_xform = col_obj->get_transform() * col_obj->get_shape_transform(shape_idx);
 		//test initial overlap, does it collide if going all the way?
-		if (!GodotCollisionSolver2D::solve(shape, p_parameters.transform, p_parameters.motion, col_obj->get_shape(shape_idx), col_obj_xform, Vector2(), nullptr, nullptr, nullptr, p_parameters.margin)) {
+		if (!GodotCollisionSolver2D::solve(p_shape, p_transform, p_motion, col_obj->get_shape(shape_idx), col_obj_xform, Vector2(), nullptr, nullptr, nullptr, p_parameters.margin)) {
 			continue;
 		}
 
 		//test initial overlap, ignore objects it's inside of.
-		if (GodotCollisionSolver2D::solve(shape, p_parameters.transform, Vector2(), col_obj->get_shape(shape_idx), col_obj_xform, Vector2(), nullptr, nullptr, nullptr, p_parameters.margin)) {
+		if (GodotCollisionSolver2D::solve(p_shape, p_transform, Vector2(), col_obj->get_shape(shape_idx), col_obj_xform, Vector2(), nullptr, nullptr, nullptr, p_parameters.margin)) {
 			continue;
 		}
 
-		Vector2 mnormal = p_parameters.motion.normalized();
+		Vector2 mnormal = p_motion.normalized();
 
 		//just do kinematic solving
 		real_t low = 0.0;
@@ -299,7 +315,7 @@ bool GodotPhysicsDirectSpaceState2D::cast_motion(const ShapeParameters &p_parame
 			real_t fraction = low + (hi - low) * fraction_coeff;
 
 			Vector2 sep = mnormal; //important optimization for this to work fast enough
-			bool collided = GodotCollisionSolver2D::solve(shape, p_parameters.transform, p_parameters.motion * fraction, col_obj->get_shape(shape_idx), col_obj_xform, Vector2(), nullptr, nullptr, &sep, p_parameters.margin);
+			bool collided = GodotCollisionSolver2D::solve(p_shape, p_transform, p_motion * fraction, col_obj->get_shape(shape_idx), col_obj_xform, Vector2(), nullptr, nullptr, &sep, p_parameters.margin);
 
 			if (collided) {
 				hi = fraction;
@@ -330,10 +346,8 @@ bool GodotPhysicsDirectSpaceState2D::cast_motion(const ShapeParameters &p_parame
 		}
 	}
 
-	p_closest_safe = best_safe;
-	p_closest_unsafe = best_unsafe;
-
-	return true;
+	r_closest_safe = best_safe;
+	r_closest_unsafe = best_unsafe;
 }
 
 bool GodotPhysicsDirectSpaceState2D::collide_shape(const ShapeParameters &p_parameters, Vector2 *r_results, int p_result_max, int &r_result_count) {
@@ -502,6 +516,100 @@ bool GodotPhysicsDirectSpaceState2D::rest_info(const ShapeParameters &p_paramete
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+void GodotPhysicsDirectSpaceState2D::_run_batch(uint32_t p_count, void (GodotPhysicsDirectSpaceState2D::*p_method)(uint32_t, void *), void *p_batch, const StringName &p_description) {
+	if (p_count < BATCH_PARALLEL_MIN) {
+		for (uint32_t i = 0; i < p_count; i++) {
+			(this->*p_method)(i, p_batch);
+		}
+		return;
+	}
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, p_method, p_batch, p_count, -1, true, p_description);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
+void GodotPhysicsDirectSpaceState2D::_intersect_ray_batch(uint32_t p_index, void *p_batch) {
+	const RayBatch *batch = static_cast<const RayBatch *>(p_batch);
+	const uint32_t offset = batch_offsets[p_index];
+
+	RayResult &result = batch->results[p_index];
+	result = RayResult();
+	_intersect_ray(*batch->parameters, batch->from[p_index], batch->to[p_index], batch_objects.ptr() + offset, batch_subindices.ptr() + offset, batch_offsets[p_index + 1] - offset, result);
+}
+
+void GodotPhysicsDirectSpaceState2D::_cast_motion_batch(uint32_t p_index, void *p_batch) {
+	const MotionBatch *batch = static_cast<const MotionBatch *>(p_batch);
+	const uint32_t offset = batch_offsets[p_index];
+
+	_cast_motion(*batch->parameters, batch->shape, batch->transforms[p_index], batch->motions[p_index], batch_objects.ptr() + offset, batch_subindices.ptr() + offset, batch_offsets[p_index + 1] - offset, batch->closest_safe[p_index], batch->closest_unsafe[p_index]);
+}
+
+int GodotPhysicsDirectSpaceState2D::intersect_rays(const RayParameters &p_parameters, const Vector2 *p_from, const Vector2 *p_to, int p_count, RayResult *r_results) {
+	ERR_FAIL_COND_V(space->locked, 0);
+	ERR_FAIL_COND_V(p_count < 0, 0);
+
+	batch_objects.clear();
+	batch_subindices.clear();
+	batch_offsets.resize(p_count + 1);
+	for (int i = 0; i < p_count; i++) {
+		const uint32_t offset = batch_objects.size();
+		batch_objects.resize(offset + GodotSpace2D::INTERSECTION_QUERY_MAX);
+		batch_subindices.resize(offset + GodotSpace2D::INTERSECTION_QUERY_MAX);
+		int amount = space->broadphase->cull_segment(p_from[i], p_to[i], batch_objects.ptr() + offset, GodotSpace2D::INTERSECTION_QUERY_MAX, batch_subindices.ptr() + offset);
+		batch_objects.resize(offset + amount);
+		batch_subindices.resize(offset + amount);
+		batch_offsets[i] = offset;
+	}
+	batch_offsets[p_count] = batch_objects.size();
+
+	RayBatch batch;
+	batch.parameters = &p_parameters;
+	batch.from = p_from;
+	batch.to = p_to;
+	batch.results = r_results;
+	_run_batch(p_count, &GodotPhysicsDirectSpaceState2D::_intersect_ray_batch, &batch, SNAME("Physics2DIntersectRays"));
+
+	int hits = 0;
+	for (int i = 0; i < p_count; i++) {
+		if (r_results[i].rid.is_valid()) {
+			hits++;
+		}
+	}
+	return hits;
+}
+
+bool GodotPhysicsDirectSpaceState2D::cast_motions(const ShapeParameters &p_parameters, const Transform2D *p_transforms, const Vector2 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe) {
+	GodotShape2D *shape = GodotPhysicsServer2D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
+	ERR_FAIL_NULL_V(shape, false);
+	ERR_FAIL_COND_V(p_count < 0, false);
+
+	batch_objects.clear();
+	batch_subindices.clear();
+	batch_offsets.resize(p_count + 1);
+	for (int i = 0; i < p_count; i++) {
+		const uint32_t offset = batch_objects.size();
+		batch_objects.resize(offset + GodotSpace2D::INTERSECTION_QUERY_MAX);
+		batch_subindices.resize(offset + GodotSpace2D::INTERSECTION_QUERY_MAX);
+		Rect2 aabb = _get_motion_aabb(shape, p_transforms[i], p_motions[i], p_parameters.margin);
+		int amount = space->broadphase->cull_aabb(aabb, batch_objects.ptr() + offset, GodotSpace2D::INTERSECTION_QUERY_MAX, batch_subindices.ptr() + offset);
+		batch_objects.resize(offset + amount);
+		batch_subindices.resize(offset + amount);
+		batch_offsets[i] = offset;
+	}
+	batch_offsets[p_count] = batch_objects.size();
+
+	MotionBatch batch;
+	batch.parameters = &p_parameters;
+	batch.shape = shape;
+	batch.transforms = p_transforms;
+	batch.motions = p_motions;
+	batch.closest_safe = r_closest_safe;
+	batch.closest_unsafe = r_closest_unsafe;
+	_run_batch(p_count, &GodotPhysicsDirectSpaceState2D::_cast_motion_batch, &batch, SNAME("Physics2DCastMotions"));
+
+	return true;
+}
+
 int GodotSpace2D::_cull_aabb_for_body(GodotBody2D *p_body, const Rect2 &p_aabb) {
 	int amount = broadphase->cull_aabb(p_aabb, intersection_query_results, INTERSECTION_QUERY_MAX, intersection_query_subindex_results);
 
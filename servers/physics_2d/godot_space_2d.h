@@ -40,11 +40,46 @@
 
 #include "core/config/project_settings.h"
 #include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
 #include "core/typedefs.h"
 
 class GodotPhysicsDirectSpaceState2D : public PhysicsDirectSpaceState2D {
 	GDCLASS(GodotPhysicsDirectSpaceState2D, PhysicsDirectSpaceState2D);
 
+	enum {
+		BATCH_PARALLEL_MIN = 32 // Smaller batches aren't worth dispatching to the WorkerThreadPool.
+	};
+
+	struct RayBatch {
+		const RayParameters *parameters = nullptr;
+		const Vector2 *from = nullptr;
+		const Vector2 *to = nullptr;
+		RayResult *results = nullptr;
+	};
+
+	struct MotionBatch {
+		const ShapeParameters *parameters = nullptr;
+		GodotShape2D *shape = nullptr;
+		const Transform2D *transforms = nullptr;
+		const Vector2 *motions = nullptr;
+		real_t *closest_safe = nullptr;
+		real_t *closest_unsafe = nullptr;
+	};
+
+	// Broadphase results of each query of a batch, from batch_offsets[i] to batch_offsets[i + 1].
+	// The broadphase isn't reentrant, so queries are culled on the calling thread and only their
+	// narrowphase runs in parallel. Kept between batches to reuse the memory.
+	LocalVector<GodotCollisionObject2D *> batch_objects;
+	LocalVector<int> batch_subindices;
+	LocalVector<uint32_t> batch_offsets;
+
+	static Rect2 _get_motion_aabb(const GodotShape2D *p_shape, const Transform2D &p_transform, const Vector2 &p_motion, real_t p_margin);
+	bool _intersect_ray(const RayParameters &p_parameters, const Vector2 &p_from, const Vector2 &p_to, GodotCollisionObject2D *const *p_objects, const int *p_subindices, int p_amount, RayResult &r_result) const;
+	void _cast_motion(const ShapeParameters &p_parameters, GodotShape2D *p_shape, const Transform2D &p_transform, const Vector2 &p_motion, GodotCollisionObject2D *const *p_objects, const int *p_subindices, int p_amount, real_t &r_closest_safe, real_t &r_closest_unsafe) const;
+	void _run_batch(uint32_t p_count, void (GodotPhysicsDirectSpaceState2D::*p_method)(uint32_t, void *), void *p_batch, const StringName &p_description);
+	void _intersect_ray_batch(uint32_t p_index, void *p_batch);
+	void _cast_motion_batch(uint32_t p_index, void *p_batch);
+
 public:
 	GodotSpace2D *space = nullptr;
 
@@ -55,6 +90,9 @@ public:
 	virtual bool collide_shape(const ShapeParameters &p_parameters, Vector2 *r_results, int p_result_max, int &r_result_count) override;
 	virtual bool rest_info(const ShapeParameters &p_parameters, ShapeRestInfo *r_info) override;
 
+	virtual int intersect_rays(const RayParameters &p_parameters, const Vector2 *p_from, const Vector2 *p_to, int p_count, RayResult *r_results) override;
+	virtual bool cast_motions(const ShapeParameters &p_parameters, const Transform2D *p_transforms, const Vector2 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe) override;
+
 	GodotPhysicsDirectSpaceState2D() {}
 };
 
@@ -34,44 +34,136 @@
 #include "core/os/os.h"
 
 #define BODY_ISLAND_COUNT_RESERVE 128
-#define BODY_ISLAND_SIZE_RESERVE 512
 #define ISLAND_COUNT_RESERVE 128
-#define ISLAND_SIZE_RESERVE 512
 #define CONSTRAINT_COUNT_RESERVE 1024
 
-void GodotStep2D::_populate_island(GodotBody2D *p_body, LocalVector<GodotBody2D *> &p_body_island, LocalVector<GodotConstraint2D *> &p_constraint_island) {
+uint32_t GodotStep2D::_add_island_body(GodotBody2D *p_body) {
+	uint32_t index = island_bodies.size();
 	p_body->set_island_step(_step);
+	p_body->set_island_index(index);
+	island_bodies.push_back(p_body);
+	island_parents.push_back(index);
+	return index;
+}
 
-	if (p_body->get_mode() > PhysicsServer2D::BODY_MODE_KINEMATIC) {
-		// Only rigid bodies are tested for activation.
-		p_body_island.push_back(p_body);
+void GodotStep2D::_add_island_constraint(GodotConstraint2D *p_constraint, uint32_t p_body_index, int p_body_pos) {
+	if (p_constraint->get_island_step() == _step) {
+		return; // Already processed.
 	}
+	p_constraint->set_island_step(_step);
+	all_constraints.push_back(p_constraint);
+	island_constraint_bodies.push_back(p_body_index);
 
-	for (const Pair<GodotConstraint2D *, int> &E : p_body->get_constraint_list()) {
-		GodotConstraint2D *constraint = const_cast<GodotConstraint2D *>(E.first);
-		if (constraint->get_island_step() == _step) {
-			continue; // Already processed.
+	for (int i = 0; i < p_constraint->get_body_count(); i++) {
+		if (i == p_body_pos) {
+			continue;
+		}
+		GodotBody2D *other_body = p_constraint->get_body_ptr()[i];
+		if (other_body->get_mode() == PhysicsServer2D::BODY_MODE_STATIC) {
+			continue; // Static bodies don't connect islands.
 		}
-		constraint->set_island_step(_step);
-		p_constraint_island.push_back(constraint);
-		all_constraints.push_back(constraint);
+		uint32_t other_index = (other_body->get_island_step() == _step) ? other_body->get_island_index() : _add_island_body(other_body);
+		_join_islands(p_body_index, other_index);
+	}
+}
 
-		for (int i = 0; i < constraint->get_body_count(); i++) {
-			if (i == E.second) {
-				continue;
-			}
-			GodotBody2D *other_body = constraint->get_body_ptr()[i];
-			if (other_body->get_island_step() == _step) {
-				continue; // Already processed.
+uint32_t GodotStep2D::_find_island_root(uint32_t p_body_index) {
+	while (island_parents[p_body_index] != p_body_index) {
+		// Path halving.
+		island_parents[p_body_index] = island_parents[island_parents[p_body_index]];
+		p_body_index = island_parents[p_body_index];
+	}
+	return p_body_index;
+}
+
+void GodotStep2D::_join_islands(uint32_t p_body_index_a, uint32_t p_body_index_b) {
+	uint32_t root_a = _find_island_root(p_body_index_a);
+	uint32_t root_b = _find_island_root(p_body_index_b);
+	// The first body added stays the root, so islands keep the same order from one step to the next.
+	if (root_a < root_b) {
+		island_parents[root_b] = root_a;
+	} else if (root_b < root_a) {
+		island_parents[root_a] = root_b;
+	}
+}
+
+void GodotStep2D::_generate_islands(uint32_t &r_body_island_count, uint32_t &r_island_count) {
+	island_bodies.clear();
+	island_parents.clear();
+	island_constraint_bodies.clear();
+
+	// Start from the active bodies, then walk their constraints, which adds the inactive bodies they
+	// touch, so the whole island can be woken up or put to sleep.
+	for (GodotBody2D *body : active_bodies) {
+		if (body->get_island_step() != _step) {
+			_add_island_body(body);
+		}
+	}
+
+	const uint32_t first_constraint = all_constraints.size();
+
+	for (uint32_t body_index = 0; body_index < island_bodies.size(); body_index++) {
+		for (const Pair<GodotConstraint2D *, int> &E : island_bodies[body_index]->get_constraint_list()) {
+			_add_island_constraint(E.first, body_index, E.second);
+		}
+	}
+
+	// Number the islands in the order of their first body, skipping those without rigid bodies or constraints.
+	const uint32_t body_count = island_bodies.size();
+	island_slots.resize(body_count);
+
+	for (uint32_t body_index = 0; body_index < body_count; body_index++) {
+		island_slots[body_index] = UINT32_MAX;
+	}
+	for (uint32_t body_index = 0; body_index < body_count; body_index++) {
+		GodotBody2D *body = island_bodies[body_index];
+		if (body->get_mode() <= PhysicsServer2D::BODY_MODE_KINEMATIC) {
+			continue; // Only rigid bodies are tested for activation.
+		}
+		uint32_t &slot = island_slots[_find_island_root(body_index)];
+		if (slot == UINT32_MAX) {
+			slot = r_body_island_count++;
+			if (body_islands.size() < r_body_island_count) {
+				body_islands.resize(r_body_island_count);
 			}
-			if (other_body->get_mode() == PhysicsServer2D::BODY_MODE_STATIC) {
-				continue; // Static bodies don't connect islands.
+			body_islands[slot].clear();
+		}
+		body_islands[slot].push_back(body);
+	}
+
+	for (uint32_t body_index = 0; body_index < body_count; body_index++) {
+		island_slots[body_index] = UINT32_MAX;
+	}
+	for (uint32_t constraint_index = 0; constraint_index < island_constraint_bodies.size(); constraint_index++) {
+		uint32_t &slot = island_slots[_find_island_root(island_constraint_bodies[constraint_index])];
+		if (slot == UINT32_MAX) {
+			slot = r_island_count++;
+			if (constraint_islands.size() < r_island_count) {
+				constraint_islands.resize(r_island_count);
 			}
-			_populate_island(other_body, p_body_island, p_constraint_island);
+			constraint_islands[slot].clear();
 		}
+		constraint_islands[slot].push_back(all_constraints[first_constraint + constraint_index]);
+	}
+}
+
+void GodotStep2D::_fill_active_bodies(const SelfList<GodotBody2D>::List &p_body_list) {
+	active_bodies.clear();
+	const SelfList<GodotBody2D> *b = p_body_list.first();
+	while (b) {
+		active_bodies.push_back(b->self());
+		b = b->next();
 	}
 }
 
+void GodotStep2D::_integrate_forces(uint32_t p_body_index, void *p_userdata) {
+	active_bodies[p_body_index]->integrate_forces(delta);
+}
+
+void GodotStep2D::_integrate_velocities(uint32_t p_body_index, void *p_userdata) {
+	active_bodies[p_body_index]->integrate_velocities(delta);
+}
+
 void GodotStep2D::_setup_constraint(uint32_t p_constraint_index, void *p_userdata) {
 	GodotConstraint2D *constraint = all_constraints[p_constraint_index];
 	constraint->setup(delta);
@@ -90,6 +182,13 @@ void GodotStep2D::_pre_solve_island(LocalVector<GodotConstraint2D *> &p_constrai
 	p_constraint_island.resize(valid_constraint_count);
 }
 
+void GodotStep2D::_pre_solve_islands(uint32_t p_island_count) {
+	pre_solve_begtime = OS::get_singleton()->get_ticks_usec();
+	for (uint32_t island_index = 0; island_index < p_island_count; ++island_index) {
+		_pre_solve_island(constraint_islands[island_index]);
+	}
+}
+
 void GodotStep2D::_solve_island(uint32_t p_island_index, void *p_userdata) const {
 	const LocalVector<GodotConstraint2D *> &constraint_island = constraint_islands[p_island_index];
 
@@ -101,28 +200,21 @@ void GodotStep2D::_solve_island(uint32_t p_island_index, void *p_userdata) const
 	}
 }
 
-void GodotStep2D::_check_suspend(LocalVector<GodotBody2D *> &p_body_island) const {
+void GodotStep2D::_sleep_test_island(uint32_t p_island_index, void *p_userdata) {
+	const LocalVector<GodotBody2D *> &body_island = body_islands[p_island_index];
+
 	bool can_sleep = true;
 
-	uint32_t body_count = p_body_island.size();
+	uint32_t body_count = body_island.size();
 	for (uint32_t body_index = 0; body_index < body_count; ++body_index) {
-		GodotBody2D *body = p_body_island[body_index];
+		GodotBody2D *body = body_island[body_index];
 
 		if (!body->sleep_test(delta)) {
 			can_sleep = false;
 		}
 	}
 
-	// Put all to sleep or wake up everyone.
-	for (uint32_t body_index = 0; body_index < body_count; ++body_index) {
-		GodotBody2D *body = p_body_island[body_index];
-
-		bool active = body->is_active();
-
-		if (active == can_sleep) {
-			body->set_active(!can_sleep);
-		}
-	}
+	body_island_can_sleep[p_island_index] = can_sleep;
 }
 
 void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
@@ -142,13 +234,17 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 	uint64_t profile_begtime = OS::get_singleton()->get_ticks_usec();
 	uint64_t profile_endtime = 0;
 
-	int active_count = 0;
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
 
-	const SelfList<GodotBody2D> *b = body_list->first();
-	while (b) {
-		b->self()->integrate_forces(p_delta);
-		b = b->next();
-		active_count++;
+	_fill_active_bodies(*body_list);
+	int active_count = active_bodies.size();
+
+	WorkerThreadPool::GroupID integrate_forces_task = pool->add_template_group_task(this, &GodotStep2D::_integrate_forces, nullptr, active_bodies.size(), -1, true, SNAME("Physics2DIntegrateForces"));
+	pool->wait_for_group_task_completion(integrate_forces_task);
+
+	// Moving the shapes in the broadphase isn't thread safe, and is done in the order of the active list.
+	for (GodotBody2D *body : active_bodies) {
+		body->apply_integrated_forces();
 	}
 
 	p_space->set_active_objects(active_count);
@@ -192,42 +288,9 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 
 	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE RIGID BODIES */
 
-	b = body_list->first();
-
 	uint32_t body_island_count = 0;
-
-	while (b) {
-		GodotBody2D *body = b->self();
-
-		if (body->get_island_step() != _step) {
-			++body_island_count;
-			if (body_islands.size() < body_island_count) {
-				body_islands.resize(body_island_count);
-			}
-			LocalVector<GodotBody2D *> &body_island = body_islands[body_island_count - 1];
-			body_island.clear();
-			body_island.reserve(BODY_ISLAND_SIZE_RESERVE);
-
-			++island_count;
-			if (constraint_islands.size() < island_count) {
-				constraint_islands.resize(island_count);
-			}
-			LocalVector<GodotConstraint2D *> &constraint_island = constraint_islands[island_count - 1];
-			constraint_island.clear();
-			constraint_island.reserve(ISLAND_SIZE_RESERVE);
-
-			_populate_island(body, body_island, constraint_island);
-
-			if (body_island.is_empty()) {
-				--body_island_count;
-			}
-
-			if (constraint_island.is_empty()) {
-				--island_count;
-			}
-		}
-		b = b->next();
-	}
+	_fill_active_bodies(*body_list);
+	_generate_islands(body_island_count, island_count);
 
 	p_space->set_island_count((int)island_count);
 
@@ -239,49 +302,57 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 
 	/* SETUP CONSTRAINTS / PROCESS COLLISIONS */
 
+	// Setup, pre-solve and solve are submitted at once as a chain of dependent
+	// tasks, so that each stage starts as soon as the previous one is done.
 	uint32_t total_constraint_count = all_constraints.size();
-	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics2DConstraintSetup"));
-	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
-
-	{ //profile
-		profile_endtime = OS::get_singleton()->get_ticks_usec();
-		p_space->set_elapsed_time(GodotSpace2D::ELAPSED_TIME_SETUP_CONSTRAINTS, profile_endtime - profile_begtime);
-		profile_begtime = profile_endtime;
-	}
+	WorkerThreadPool::GroupID setup_task = pool->add_template_group_task(this, &GodotStep2D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics2DConstraintSetup"));
 
 	/* PRE-SOLVE CONSTRAINT ISLANDS */
 
-	// Warning: This doesn't run on threads, because it involves thread-unsafe processing.
-	for (uint32_t island_index = 0; island_index < island_count; ++island_index) {
-		_pre_solve_island(constraint_islands[island_index]);
-	}
+	// Warning: This doesn't run in parallel, because it involves thread-unsafe processing.
+	WorkerThreadPool::TaskID pre_solve_task = pool->add_template_task_after({ setup_task }, this, &GodotStep2D::_pre_solve_islands, island_count, true, SNAME("Physics2DConstraintPreSolveIslands"));
 
 	/* SOLVE CONSTRAINT ISLANDS */
 
 	// Warning: _solve_island modifies the constraint islands for optimization purpose,
 	// their content is not reliable after these calls and shouldn't be used anymore.
-	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_solve_island, nullptr, island_count, -1, true, SNAME("Physics2DConstraintSolveIslands"));
-	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	WorkerThreadPool::GroupID solve_task = pool->add_template_group_task_after({ pre_solve_task }, this, &GodotStep2D::_solve_island, nullptr, island_count, -1, true, SNAME("Physics2DConstraintSolveIslands"));
+	pool->wait_for_group_task_completion(solve_task);
+	pool->wait_for_task_completion(pre_solve_task);
+	pool->wait_for_group_task_completion(setup_task);
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
-		p_space->set_elapsed_time(GodotSpace2D::ELAPSED_TIME_SOLVE_CONSTRAINTS, profile_endtime - profile_begtime);
+		p_space->set_elapsed_time(GodotSpace2D::ELAPSED_TIME_SETUP_CONSTRAINTS, pre_solve_begtime - profile_begtime);
+		p_space->set_elapsed_time(GodotSpace2D::ELAPSED_TIME_SOLVE_CONSTRAINTS, profile_endtime - pre_solve_begtime);
 		profile_begtime = profile_endtime;
 	}
 
 	/* INTEGRATE VELOCITIES */
 
-	b = body_list->first();
-	while (b) {
-		const SelfList<GodotBody2D> *n = b->next();
-		b->self()->integrate_velocities(p_delta);
-		b = n; // in case it shuts itself down
+	// Solving can wake up bodies, so the active list is copied again.
+	_fill_active_bodies(*body_list);
+	WorkerThreadPool::GroupID integrate_velocities_task = pool->add_template_group_task(this, &GodotStep2D::_integrate_velocities, nullptr, active_bodies.size(), -1, true, SNAME("Physics2DIntegrateVelocities"));
+	pool->wait_for_group_task_completion(integrate_velocities_task);
+
+	for (GodotBody2D *body : active_bodies) {
+		body->apply_integrated_velocities();
 	}
 
 	/* SLEEP / WAKE UP ISLANDS */
 
+	body_island_can_sleep.resize(body_island_count);
+	WorkerThreadPool::GroupID sleep_test_task = pool->add_template_group_task(this, &GodotStep2D::_sleep_test_island, nullptr, body_island_count, -1, true, SNAME("Physics2DSleepTestIslands"));
+	pool->wait_for_group_task_completion(sleep_test_task);
+
+	// Put all to sleep or wake up everyone.
 	for (uint32_t island_index = 0; island_index < body_island_count; ++island_index) {
-		_check_suspend(body_islands[island_index]);
+		const bool can_sleep = body_island_can_sleep[island_index];
+		for (GodotBody2D *body : body_islands[island_index]) {
+			if (body->is_active() == can_sleep) {
+				body->set_active(!can_sleep);
+			}
+		}
 	}
 
 	{ //profile
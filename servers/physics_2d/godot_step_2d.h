@@ -45,11 +45,31 @@ class GodotStep2D {
 	LocalVector<LocalVector<GodotConstraint2D *>> constraint_islands;
 	LocalVector<GodotConstraint2D *> all_constraints;
 
-	void _populate_island(GodotBody2D *p_body, LocalVector<GodotBody2D *> &p_body_island, LocalVector<GodotConstraint2D *> &p_constraint_island);
+	// Copy of the active body list, so the bodies can be integrated in parallel.
+	LocalVector<GodotBody2D *> active_bodies;
+	LocalVector<uint8_t> body_island_can_sleep;
+
+	// The bodies connected by constraints, joined into islands with a union-find.
+	LocalVector<GodotBody2D *> island_bodies;
+	LocalVector<uint32_t> island_parents;
+	LocalVector<uint32_t> island_constraint_bodies; // For each constraint added by _add_island_constraint(), one of its bodies.
+	LocalVector<uint32_t> island_slots;
+
+	uint64_t pre_solve_begtime = 0; // For profiling, as pre-solving runs on a pool thread.
+
+	uint32_t _add_island_body(GodotBody2D *p_body);
+	void _add_island_constraint(GodotConstraint2D *p_constraint, uint32_t p_body_index, int p_body_pos);
+	uint32_t _find_island_root(uint32_t p_body_index);
+	void _join_islands(uint32_t p_body_index_a, uint32_t p_body_index_b);
+	void _generate_islands(uint32_t &r_body_island_count, uint32_t &r_island_count);
+	void _fill_active_bodies(const SelfList<GodotBody2D>::List &p_body_list);
+	void _integrate_forces(uint32_t p_body_index, void *p_userdata = nullptr);
+	void _integrate_velocities(uint32_t p_body_index, void *p_userdata = nullptr);
 	void _setup_constraint(uint32_t p_constraint_index, void *p_userdata = nullptr);
 	void _pre_solve_island(LocalVector<GodotConstraint2D *> &p_constraint_island) const;
+	void _pre_solve_islands(uint32_t p_island_count);
 	void _solve_island(uint32_t p_island_index, void *p_userdata = nullptr) const;
-	void _check_suspend(LocalVector<GodotBody2D *> &p_body_island) const;
+	void _sleep_test_island(uint32_t p_island_index, void *p_userdata = nullptr);
 
 public:
 	void step(GodotSpace2D *p_space, real_t p_delta);
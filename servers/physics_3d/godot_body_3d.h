@@ -145,6 +145,11 @@ class GodotBody3D : public GodotCollisionObject3D {
 	GodotPhysicsDirectBodyState3D *direct_state = nullptr;
 
 	uint64_t island_step = 0;
+	uint32_t island_index = 0;
+
+	// Motion from integrate_forces(), applied to the shapes by apply_integrated_forces().
+	Vector3 pending_motion;
+	bool has_pending_motion = false;
 
 	void _update_transform_dependent();
 
@@ -194,6 +199,9 @@ public:
 
 	_FORCE_INLINE_ uint64_t get_island_step() const { return island_step; }
 	_FORCE_INLINE_ void set_island_step(uint64_t p_step) { island_step = p_step; }
+	// Only valid during the step set with set_island_step().
+	_FORCE_INLINE_ uint32_t get_island_index() const { return island_index; }
+	_FORCE_INLINE_ void set_island_index(uint32_t p_index) { island_index = p_index; }
 
 	_FORCE_INLINE_ void add_constraint(GodotConstraint3D *p_constraint, int p_pos) { constraint_map[p_constraint] = p_pos; }
 	_FORCE_INLINE_ void remove_constraint(GodotConstraint3D *p_constraint) { constraint_map.erase(p_constraint); }
@@ -316,8 +324,12 @@ public:
 	void set_axis_lock(PhysicsServer3D::BodyAxis p_axis, bool lock);
 	bool is_axis_locked(PhysicsServer3D::BodyAxis p_axis) const;
 
+	// The integration only changes the body itself, so it can run for several bodies at once.
+	// The matching apply_*() call then updates the broadphase and the lists of the space.
 	void integrate_forces(real_t p_step);
+	void apply_integrated_forces();
 	void integrate_velocities(real_t p_step);
+	void apply_integrated_velocities();
 
 	_FORCE_INLINE_ Vector3 get_velocity_in_local_point(const Vector3 &rel_pos) const {
 		return linear_velocity + angular_velocity.cross(rel_pos - center_of_mass);
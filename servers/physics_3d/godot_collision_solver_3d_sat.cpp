@@ -37,6 +37,7 @@
 #define fallback_collision_solver gjk_epa_calculate_penetration
 
 #define _BACKFACE_NORMAL_THRESHOLD -0.0002
+#define _CAPSULE_PARALLEL_THRESHOLD 0.9998
 
 // Cylinder SAT analytic methods and face-circle contact points for cylinder-trimesh and cylinder-box collision are based on ODE colliders.
 
@@ -687,6 +688,49 @@ public:
 		return true;
 	}
 
+	// Same as calling test_axis() on each axis in order, for axes already
+	// projected in bulk: p_distance is the distance from the center of A to the
+	// center of B along the axis, and p_radius the sum of both projected half
+	// lengths, without margins.
+	_FORCE_INLINE_ bool test_projected_axes(const Vector3 *p_axes, const real_t *p_distance, const real_t *p_radius, int p_count) {
+		const real_t margin = withMargin ? margin_A + margin_B : 0.0;
+
+		// Check the whole batch for a separating axis first, without branches.
+		bool separated = false;
+		for (int i = 0; i < p_count; i++) {
+			separated |= Math::abs(p_distance[i]) > p_radius[i] + margin;
+		}
+
+		if (separated) {
+			for (int i = 0; i < p_count; i++) {
+				if (Math::abs(p_distance[i]) > p_radius[i] + margin) {
+					separator_axis = p_axes[i];
+					break;
+				}
+			}
+			return false;
+		}
+
+		for (int i = 0; i < p_count; i++) {
+			const real_t min_B = p_radius[i] + margin - p_distance[i];
+			const real_t max_B = p_radius[i] + margin + p_distance[i];
+
+			if (max_B < min_B) {
+				if (max_B < best_depth) {
+					best_depth = max_B;
+					best_axis = p_axes[i];
+				}
+			} else {
+				if (min_B < best_depth) {
+					best_depth = min_B;
+					best_axis = -p_axes[i]; // keep it as A axis
+				}
+			}
+		}
+
+		return true;
+	}
+
 	static _FORCE_INLINE_ void test_contact_points(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal, void *p_userdata) {
 		SeparatorAxisTest<ShapeA, ShapeB, withMargin> *separator = (SeparatorAxisTest<ShapeA, ShapeB, withMargin> *)p_userdata;
 		Vector3 axis = (p_point_B - p_point_A);
@@ -1068,6 +1112,52 @@ static void _collision_sphere_face(const GodotShape3D *p_a, const Transform3D &p
 	separator.generate_contacts();
 }
 
+// Separating axes of a pair of boxes, projected in bulk. The axes are stored as
+// structure of arrays padded to 16 lanes, so the projection loop has a fixed
+// trip count and no branches, and compilers turn it into SIMD code testing 4 or
+// 8 axes per instruction.
+struct _BoxBoxAxes {
+	static constexpr int MAX_AXES = 16;
+
+	real_t x[MAX_AXES] = {};
+	real_t y[MAX_AXES] = {};
+	real_t z[MAX_AXES] = {};
+	real_t distance[MAX_AXES];
+	real_t radius[MAX_AXES];
+	Vector3 axes[MAX_AXES];
+	int count = 0;
+
+	_FORCE_INLINE_ void add(const Vector3 &p_axis) {
+		x[count] = p_axis.x;
+		y[count] = p_axis.y;
+		z[count] = p_axis.z;
+		axes[count] = p_axis;
+		count++;
+	}
+
+	_FORCE_INLINE_ void project(const Transform3D &p_transform_a, const Vector3 &p_half_extents_a, const Transform3D &p_transform_b, const Vector3 &p_half_extents_b) {
+		// Box edges scaled by the half extents, the projected half length of a
+		// box is the sum of their absolute dot products with the axis.
+		const Vector3 a0 = p_transform_a.basis.get_column(0) * p_half_extents_a.x;
+		const Vector3 a1 = p_transform_a.basis.get_column(1) * p_half_extents_a.y;
+		const Vector3 a2 = p_transform_a.basis.get_column(2) * p_half_extents_a.z;
+		const Vector3 b0 = p_transform_b.basis.get_column(0) * p_half_extents_b.x;
+		const Vector3 b1 = p_transform_b.basis.get_column(1) * p_half_extents_b.y;
+		const Vector3 b2 = p_transform_b.basis.get_column(2) * p_half_extents_b.z;
+		const Vector3 offset = p_transform_b.origin - p_transform_a.origin;
+
+		for (int i = 0; i < MAX_AXES; i++) {
+			distance[i] = x[i] * offset.x + y[i] * offset.y + z[i] * offset.z;
+			radius[i] = Math::abs(x[i] * a0.x + y[i] * a0.y + z[i] * a0.z) +
+					Math::abs(x[i] * a1.x + y[i] * a1.y + z[i] * a1.z) +
+					Math::abs(x[i] * a2.x + y[i] * a2.y + z[i] * a2.z) +
+					Math::abs(x[i] * b0.x + y[i] * b0.y + z[i] * b0.z) +
+					Math::abs(x[i] * b1.x + y[i] * b1.y + z[i] * b1.z) +
+					Math::abs(x[i] * b2.x + y[i] * b2.y + z[i] * b2.z);
+		}
+	}
+};
+
 template <bool withMargin>
 static void _collision_box_box(const GodotShape3D *p_a, const Transform3D &p_transform_a, const GodotShape3D *p_b, const Transform3D &p_transform_b, _CollectorCallback *p_collector, real_t p_margin_a, real_t p_margin_b) {
 	const GodotBoxShape3D *box_A = static_cast<const GodotBoxShape3D *>(p_a);
@@ -1079,27 +1169,19 @@ static void _collision_box_box(const GodotShape3D *p_a, const Transform3D &p_tra
 		return;
 	}
 
-	// test faces of A
+	_BoxBoxAxes axes;
 
-	for (int i = 0; i < 3; i++) {
-		Vector3 axis = p_transform_a.basis.get_column(i).normalized();
+	// faces of A and B
 
-		if (!separator.test_axis(axis)) {
-			return;
-		}
+	for (int i = 0; i < 3; i++) {
+		axes.add(p_transform_a.basis.get_column(i).normalized());
 	}
 
-	// test faces of B
-
 	for (int i = 0; i < 3; i++) {
-		Vector3 axis = p_transform_b.basis.get_column(i).normalized();
-
-		if (!separator.test_axis(axis)) {
-			return;
-		}
+		axes.add(p_transform_b.basis.get_column(i).normalized());
 	}
 
-	// test combined edges
+	// combined edges
 	for (int i = 0; i < 3; i++) {
 		for (int j = 0; j < 3; j++) {
 			Vector3 axis = p_transform_a.basis.get_column(i).cross(p_transform_b.basis.get_column(j));
@@ -1107,14 +1189,16 @@ static void _collision_box_box(const GodotShape3D *p_a, const Transform3D &p_tra
 			if (Math::is_zero_approx(axis.length_squared())) {
 				continue;
 			}
-			axis.normalize();
-
-			if (!separator.test_axis(axis)) {
-				return;
-			}
+			axes.add(axis.normalized());
 		}
 	}
 
+	axes.project(p_transform_a, box_A->get_half_extents(), p_transform_b, box_B->get_half_extents());
+
+	if (!separator.test_projected_axes(axes.axes, axes.distance, axes.radius, axes.count)) {
+		return;
+	}
+
 	if (withMargin) {
 		//add endpoint test between closest vertices and edges
 
@@ -1642,6 +1726,45 @@ static void _collision_capsule_capsule(const GodotShape3D *p_a, const Transform3
 	Vector3 capsule_B_closest;
 	Vector3 capsule_A_axis = p_transform_a.basis.get_column(1) * (capsule_A->get_height() * 0.5 - capsule_A->get_radius());
 	Vector3 capsule_B_axis = p_transform_b.basis.get_column(1) * (capsule_B->get_height() * 0.5 - capsule_B->get_radius());
+
+	// Capsules lying side by side touch along a line. Report both ends of the
+	// overlap of their segments, so they can rest on each other without rolling.
+	real_t length_A = capsule_A_axis.length();
+	real_t length_B = capsule_B_axis.length();
+	if (p_collector->callback && length_A > CMP_EPSILON && length_B > CMP_EPSILON && Math::abs(capsule_A_axis.dot(capsule_B_axis)) > _CAPSULE_PARALLEL_THRESHOLD * length_A * length_B) {
+		Vector3 direction_A = capsule_A_axis / length_A;
+		Vector3 capsule_B_segment[2] = {
+			p_transform_b.origin + capsule_B_axis,
+			p_transform_b.origin - capsule_B_axis,
+		};
+
+		// Overlap of segment B along segment A, relative to the center of A.
+		real_t offset_B = direction_A.dot(p_transform_b.origin - p_transform_a.origin);
+		real_t overlap_min = MAX(offset_B - length_B, -length_A);
+		real_t overlap_max = MIN(offset_B + length_B, length_A);
+
+		if (overlap_max - overlap_min > CMP_EPSILON) {
+			for (real_t offset : { overlap_min, overlap_max }) {
+				Vector3 point_A = p_transform_a.origin + direction_A * offset;
+				Vector3 point_B = Geometry3D::get_closest_point_to_segment(point_A, capsule_B_segment);
+
+				analytic_sphere_collision<withMargin>(
+						point_A,
+						capsule_A->get_radius() * scale_A,
+						point_B,
+						capsule_B->get_radius() * scale_B,
+						p_collector,
+						p_margin_a,
+						p_margin_b);
+			}
+
+			// Slightly crossing capsules can touch between the ends only.
+			if (p_collector->collided) {
+				return;
+			}
+		}
+	}
+
 	Geometry3D::get_closest_points_between_segments(
 			p_transform_a.origin + capsule_A_axis,
 			p_transform_a.origin - capsule_A_axis,
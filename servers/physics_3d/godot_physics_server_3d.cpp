@@ -39,6 +39,7 @@
 #include "joints/godot_slider_joint_3d.h"
 
 #include "core/debugger/engine_debugger.h"
+#include "core/debugger/trace_profiler.h"
 #include "core/os/os.h"
 
 #define FLUSH_QUERY_CHECK(m_object) \
@@ -1635,6 +1636,8 @@ void GodotPhysicsServer3D::step(real_t p_step) {
 		return;
 	}
 
+	TRACE_ZONE("PhysicsServer3D::step");
+
 	_update_shapes();
 
 	island_count = 0;
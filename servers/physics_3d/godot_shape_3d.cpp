@@ -33,6 +33,7 @@
 #include "core/io/image.h"
 #include "core/math/convex_hull.h"
 #include "core/math/geometry_3d.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/templates/sort_array.h"
 
 // GodotHeightMapShape3D is based on Bullet btHeightfieldTerrainShape.
@@ -1345,15 +1346,50 @@ Vector3 GodotConcavePolygonShape3D::get_support(const Vector3 &p_normal) const {
 	return vptr[vert_support_idx];
 }
 
-void GodotConcavePolygonShape3D::_cull_segment(int p_idx, _SegmentCullParams *p_params) const {
-	const BVH *params_bvh = &p_params->bvh[p_idx];
+void GodotConcavePolygonShape3D::_quantize(const AABB &p_aabb, uint16_t *r_min, uint16_t *r_max) const {
+	// Rounded outwards by an extra step, so precision errors can't make bounds
+	// smaller than what they contain.
+	for (int i = 0; i < 3; i++) {
+		real_t min = Math::floor((p_aabb.position[i] - bvh_origin[i]) * bvh_scale[i]) - 1;
+		real_t max = Math::ceil((p_aabb.position[i] + p_aabb.size[i] - bvh_origin[i]) * bvh_scale[i]) + 1;
+		r_min[i] = CLAMP(min, 0, 65535);
+		r_max[i] = CLAMP(max, 0, 65535);
+	}
+}
 
-	if (!params_bvh->aabb.intersects_segment(p_params->from, p_params->to)) {
-		return;
+static _FORCE_INLINE_ bool _bvh_node_intersects_segment(const GodotConcavePolygonShape3D::BVH &p_node, const Vector3 &p_from, const Vector3 &p_dir, const Vector3 &p_inv_dir, real_t p_max_t) {
+	real_t t_min = 0.0;
+	real_t t_max = p_max_t;
+
+	for (int i = 0; i < 3; i++) {
+		if (p_dir[i] == 0) {
+			if (p_from[i] < p_node.min[i] || p_from[i] > p_node.max[i]) {
+				return false;
+			}
+			continue;
+		}
+
+		real_t t_0 = (p_node.min[i] - p_from[i]) * p_inv_dir[i];
+		real_t t_1 = (p_node.max[i] - p_from[i]) * p_inv_dir[i];
+		if (t_0 > t_1) {
+			SWAP(t_0, t_1);
+		}
+		t_min = MAX(t_min, t_0);
+		t_max = MIN(t_max, t_1);
+		if (t_min > t_max) {
+			return false;
+		}
 	}
 
-	if (params_bvh->face_index >= 0) {
-		const Face *f = &p_params->faces[params_bvh->face_index];
+	return true;
+}
+
+void GodotConcavePolygonShape3D::_cull_segment_faces(const BVH &p_leaf, _SegmentCullParams *p_params) const {
+	const uint32_t *face_indices = &bvh_faces[p_leaf.get_index()];
+	const uint32_t face_count = p_leaf.get_face_count();
+
+	for (uint32_t i = 0; i < face_count; i++) {
+		const Face *f = &p_params->faces[face_indices[i]];
 		GodotFaceShape3D *face = p_params->face;
 		face->normal = f->normal;
 		face->vertex[0] = p_params->vertices[f->indices[0]];
@@ -1362,7 +1398,7 @@ void GodotConcavePolygonShape3D::_cull_segment(int p_idx, _SegmentCullParams *p_
 
 		Vector3 res;
 		Vector3 normal;
-		int face_index = params_bvh->face_index;
+		int face_index = face_indices[i];
 		if (face->intersect_segment(p_params->from, p_params->to, res, normal, face_index, true)) {
 			real_t d = p_params->dir.dot(res) - p_params->dir.dot(p_params->from);
 			if ((d > 0) && (d < p_params->min_d)) {
@@ -1373,18 +1409,11 @@ void GodotConcavePolygonShape3D::_cull_segment(int p_idx, _SegmentCullParams *p_
 				p_params->collisions++;
 			}
 		}
-	} else {
-		if (params_bvh->left >= 0) {
-			_cull_segment(params_bvh->left, p_params);
-		}
-		if (params_bvh->right >= 0) {
-			_cull_segment(params_bvh->right, p_params);
-		}
 	}
 }
 
 bool GodotConcavePolygonShape3D::intersect_segment(const Vector3 &p_begin, const Vector3 &p_end, Vector3 &r_result, Vector3 &r_normal, int &r_face_index, bool p_hit_back_faces) const {
-	if (faces.size() == 0) {
+	if (bvh.is_empty()) {
 		return false;
 	}
 
@@ -1400,15 +1429,47 @@ bool GodotConcavePolygonShape3D::intersect_segment(const Vector3 &p_begin, const
 	params.from = p_begin;
 	params.to = p_end;
 	params.dir = (p_end - p_begin).normalized();
+	params.length = (p_end - p_begin).length();
 
 	params.faces = fr;
 	params.vertices = vr;
-	params.bvh = br;
 
 	params.face = &face;
 
+	// The segment parameter is the same in BVH space, where the slab tests use
+	// the quantized bounds directly.
+	params.bvh_from = (p_begin - bvh_origin) * bvh_scale;
+	params.bvh_dir = (p_end - p_begin) * bvh_scale;
+	for (int i = 0; i < 3; i++) {
+		params.bvh_inv_dir[i] = params.bvh_dir[i] != 0 ? 1.0 / params.bvh_dir[i] : 0.0;
+	}
+
 	// cull
-	_cull_segment(0, &params);
+	uint32_t stack[BVH_MAX_DEPTH];
+	uint32_t stack_size = 0;
+	uint32_t index = 0;
+
+	while (true) {
+		const BVH &node = br[index];
+
+		// Nodes past the closest hit so far can be skipped.
+		real_t max_t = params.collisions > 0 && params.length > 0 ? MIN(params.min_d / params.length, (real_t)1.0) : 1.0;
+
+		if (_bvh_node_intersects_segment(node, params.bvh_from, params.bvh_dir, params.bvh_inv_dir, max_t)) {
+			if (node.is_leaf()) {
+				_cull_segment_faces(node, &params);
+			} else {
+				stack[stack_size++] = node.get_index();
+				index++;
+				continue;
+			}
+		}
+
+		if (stack_size == 0) {
+			break;
+		}
+		index = stack[--stack_size];
+	}
 
 	if (params.collisions > 0) {
 		r_result = params.result;
@@ -1428,35 +1489,32 @@ Vector3 GodotConcavePolygonShape3D::get_closest_point_to(const Vector3 &p_point)
 	return Vector3();
 }
 
-bool GodotConcavePolygonShape3D::_cull(int p_idx, _CullParams *p_params) const {
-	const BVH *params_bvh = &p_params->bvh[p_idx];
+bool GodotConcavePolygonShape3D::_cull_faces(const BVH &p_leaf, _CullParams *p_params) const {
+	const uint32_t *face_indices = &bvh_faces[p_leaf.get_index()];
+	const uint32_t face_count = p_leaf.get_face_count();
 
-	if (!p_params->aabb.intersects(params_bvh->aabb)) {
-		return false;
-	}
+	for (uint32_t i = 0; i < face_count; i++) {
+		const Face *f = &p_params->faces[face_indices[i]];
+		const Vector3 &vertex_0 = p_params->vertices[f->indices[0]];
+		const Vector3 &vertex_1 = p_params->vertices[f->indices[1]];
+		const Vector3 &vertex_2 = p_params->vertices[f->indices[2]];
+
+		// Leaves hold several faces, skip the ones away from the query.
+		AABB face_aabb(vertex_0, Vector3());
+		face_aabb.expand_to(vertex_1);
+		face_aabb.expand_to(vertex_2);
+		if (!p_params->aabb.intersects(face_aabb)) {
+			continue;
+		}
 
-	if (params_bvh->face_index >= 0) {
-		const Face *f = &p_params->faces[params_bvh->face_index];
 		GodotFaceShape3D *face = p_params->face;
 		face->normal = f->normal;
-		face->vertex[0] = p_params->vertices[f->indices[0]];
-		face->vertex[1] = p_params->vertices[f->indices[1]];
-		face->vertex[2] = p_params->vertices[f->indices[2]];
+		face->vertex[0] = vertex_0;
+		face->vertex[1] = vertex_1;
+		face->vertex[2] = vertex_2;
 		if (p_params->callback(p_params->userdata, face)) {
 			return true;
 		}
-	} else {
-		if (params_bvh->left >= 0) {
-			if (_cull(params_bvh->left, p_params)) {
-				return true;
-			}
-		}
-
-		if (params_bvh->right >= 0) {
-			if (_cull(params_bvh->right, p_params)) {
-				return true;
-			}
-		}
 	}
 
 	return false;
@@ -1464,11 +1522,14 @@ bool GodotConcavePolygonShape3D::_cull(int p_idx, _CullParams *p_params) const {
 
 void GodotConcavePolygonShape3D::cull(const AABB &p_local_aabb, QueryCallback p_callback, void *p_userdata, bool p_invert_backface_collision) const {
 	// make matrix local to concave
-	if (faces.size() == 0) {
+	if (bvh.is_empty()) {
 		return;
 	}
 
-	AABB local_aabb = p_local_aabb;
+	// Quantized bounds are clamped to the shape, so check the shape first.
+	if (!p_local_aabb.intersects(get_aabb())) {
+		return;
+	}
 
 	// unlock data
 	const Face *fr = faces.ptr();
@@ -1480,16 +1541,41 @@ void GodotConcavePolygonShape3D::cull(const AABB &p_local_aabb, QueryCallback p_
 	face.invert_backface_collision = p_invert_backface_collision;
 
 	_CullParams params;
-	params.aabb = local_aabb;
+	params.aabb = p_local_aabb;
+	_quantize(p_local_aabb, params.min, params.max);
 	params.face = &face;
 	params.faces = fr;
 	params.vertices = vr;
-	params.bvh = br;
 	params.callback = p_callback;
 	params.userdata = p_userdata;
 
 	// cull
-	_cull(0, &params);
+	uint32_t stack[BVH_MAX_DEPTH];
+	uint32_t stack_size = 0;
+	uint32_t index = 0;
+
+	while (true) {
+		const BVH &node = br[index];
+
+		if (node.min[0] <= params.max[0] && node.max[0] >= params.min[0] &&
+				node.min[1] <= params.max[1] && node.max[1] >= params.min[1] &&
+				node.min[2] <= params.max[2] && node.max[2] >= params.min[2]) {
+			if (node.is_leaf()) {
+				if (_cull_faces(node, &params)) {
+					return;
+				}
+			} else {
+				stack[stack_size++] = node.get_index();
+				index++;
+				continue;
+			}
+		}
+
+		if (stack_size == 0) {
+			break;
+		}
+		index = stack[--stack_size];
+	}
 }
 
 Vector3 GodotConcavePolygonShape3D::get_moment_of_inertia(real_t p_mass) const {
@@ -1526,90 +1612,393 @@ struct _Volume_BVH_CompareZ {
 	}
 };
 
-struct _Volume_BVH {
+struct _Volume_BVH_Node {
 	AABB aabb;
-	_Volume_BVH *left = nullptr;
-	_Volume_BVH *right = nullptr;
-
-	int face_index = 0;
+	// Internal nodes, children with SUBTREE_BIT set are roots of subtrees.
+	uint32_t children[2] = {};
+	// Leaves, range of elements.
+	uint32_t begin = 0;
+	uint32_t count = 0;
 };
 
-_Volume_BVH *_volume_build_bvh(_Volume_BVH_Element *p_elements, int p_size, int &count) {
-	_Volume_BVH *bvh = memnew(_Volume_BVH);
-
-	if (p_size == 1) {
-		//leaf
-		bvh->aabb = p_elements[0].aabb;
-		bvh->left = nullptr;
-		bvh->right = nullptr;
-		bvh->face_index = p_elements->face_index;
-		count++;
-		return bvh;
-	} else {
-		bvh->face_index = -1;
+// Builds the BVH with binned SAH splits. Large meshes are split serially until
+// the remaining ranges are small enough, which are then built as subtrees in
+// parallel, each into its own node list.
+struct _Volume_BVH_Builder {
+	static constexpr uint32_t BIN_COUNT = 16;
+	// Past this depth, nodes are split at the median so the tree depth stays
+	// below GodotConcavePolygonShape3D::BVH_MAX_DEPTH.
+	static constexpr uint32_t SAH_MAX_DEPTH = 32;
+	static constexpr uint32_t PARALLEL_MIN_FACES = 16384;
+	static constexpr uint32_t SUBTREE_BIT = 1u << 31;
+
+	struct Subtree {
+		uint32_t begin = 0;
+		uint32_t end = 0;
+		uint32_t depth = 0;
+		LocalVector<_Volume_BVH_Node> nodes;
+	};
+
+	_Volume_BVH_Element *elements = nullptr;
+	LocalVector<_Volume_BVH_Node> nodes;
+	LocalVector<Subtree> subtrees;
+	// Ranges of at most this many elements become subtrees, 0 to build serially.
+	uint32_t subtree_size = 0;
+
+	static _FORCE_INLINE_ real_t _get_cost_area(const AABB &p_aabb) {
+		return p_aabb.size.x * p_aabb.size.y + p_aabb.size.y * p_aabb.size.z + p_aabb.size.z * p_aabb.size.x;
+	}
+
+	uint32_t _split_median(uint32_t p_begin, uint32_t p_end, int p_axis) {
+		uint32_t middle = p_begin + (p_end - p_begin) / 2;
+		switch (p_axis) {
+			case 0: {
+				SortArray<_Volume_BVH_Element, _Volume_BVH_CompareX> sort_x;
+				sort_x.nth_element(p_begin, p_end, middle, elements);
+			} break;
+			case 1: {
+				SortArray<_Volume_BVH_Element, _Volume_BVH_CompareY> sort_y;
+				sort_y.nth_element(p_begin, p_end, middle, elements);
+			} break;
+			case 2: {
+				SortArray<_Volume_BVH_Element, _Volume_BVH_CompareZ> sort_z;
+				sort_z.nth_element(p_begin, p_end, middle, elements);
+			} break;
+		}
+		return middle;
 	}
 
-	AABB aabb;
-	for (int i = 0; i < p_size; i++) {
-		if (i == 0) {
-			aabb = p_elements[i].aabb;
-		} else {
-			aabb.merge_with(p_elements[i].aabb);
+	uint32_t _split(uint32_t p_begin, uint32_t p_end, uint32_t p_depth) {
+		AABB center_bounds(elements[p_begin].center, Vector3());
+		for (uint32_t i = p_begin + 1; i < p_end; i++) {
+			center_bounds.expand_to(elements[i].center);
+		}
+
+		int axis = center_bounds.get_longest_axis_index();
+		real_t extent = center_bounds.size[axis];
+		if (extent <= 0) {
+			// All the centers are at the same place, any split is as good.
+			return p_begin + (p_end - p_begin) / 2;
+		}
+		if (p_depth >= SAH_MAX_DEPTH) {
+			return _split_median(p_begin, p_end, axis);
+		}
+
+		struct Bin {
+			AABB aabb;
+			uint32_t count = 0;
+		};
+		Bin bins[BIN_COUNT];
+
+		const real_t origin = center_bounds.position[axis];
+		const real_t bin_scale = BIN_COUNT * (1.0 - CMP_EPSILON) / extent;
+		for (uint32_t i = p_begin; i < p_end; i++) {
+			uint32_t bin = MIN(uint32_t((elements[i].center[axis] - origin) * bin_scale), BIN_COUNT - 1);
+			if (bins[bin].count == 0) {
+				bins[bin].aabb = elements[i].aabb;
+			} else {
+				bins[bin].aabb.merge_with(elements[i].aabb);
+			}
+			bins[bin].count++;
+		}
+
+		// Cost of the right side of each split, sweeping from the right.
+		real_t right_cost[BIN_COUNT];
+		AABB right_aabb;
+		uint32_t right_count = 0;
+		for (uint32_t i = BIN_COUNT - 1; i > 0; i--) {
+			if (bins[i].count > 0) {
+				right_aabb = right_count == 0 ? bins[i].aabb : right_aabb.merge(bins[i].aabb);
+				right_count += bins[i].count;
+			}
+			right_cost[i - 1] = right_count > 0 ? _get_cost_area(right_aabb) * right_count : -1.0;
+		}
+
+		uint32_t best_split = UINT32_MAX;
+		real_t best_cost = 0.0;
+		AABB left_aabb;
+		uint32_t left_count = 0;
+		for (uint32_t i = 0; i < BIN_COUNT - 1; i++) {
+			if (bins[i].count > 0) {
+				left_aabb = left_count == 0 ? bins[i].aabb : left_aabb.merge(bins[i].aabb);
+				left_count += bins[i].count;
+			}
+			if (left_count == 0 || right_cost[i] < 0) {
+				continue;
+			}
+			real_t cost = _get_cost_area(left_aabb) * left_count + right_cost[i];
+			if (best_split == UINT32_MAX || cost < best_cost) {
+				best_cost = cost;
+				best_split = i;
+			}
+		}
+
+		// Elements of the bins up to the best split go to the left.
+		uint32_t left = p_begin;
+		uint32_t right = p_end;
+		while (left < right) {
+			uint32_t bin = MIN(uint32_t((elements[left].center[axis] - origin) * bin_scale), BIN_COUNT - 1);
+			if (bin <= best_split) {
+				left++;
+			} else {
+				right--;
+				SWAP(elements[left], elements[right]);
+			}
+		}
+
+		if (left == p_begin || left == p_end) {
+			return _split_median(p_begin, p_end, axis);
+		}
+		return left;
+	}
+
+	uint32_t _build(LocalVector<_Volume_BVH_Node> &r_nodes, uint32_t p_begin, uint32_t p_end, uint32_t p_depth, bool p_top) {
+		uint32_t index = r_nodes.size();
+		r_nodes.push_back(_Volume_BVH_Node());
+
+		AABB aabb = elements[p_begin].aabb;
+		for (uint32_t i = p_begin + 1; i < p_end; i++) {
+			aabb.merge_with(elements[i].aabb);
+		}
+		r_nodes[index].aabb = aabb;
+
+		if (p_end - p_begin <= GodotConcavePolygonShape3D::LEAF_MAX_FACES) {
+			r_nodes[index].begin = p_begin;
+			r_nodes[index].count = p_end - p_begin;
+			return index;
+		}
+
+		uint32_t middle = _split(p_begin, p_end, p_depth);
+		const uint32_t ranges[2][2] = { { p_begin, middle }, { middle, p_end } };
+
+		for (int i = 0; i < 2; i++) {
+			uint32_t child;
+			if (p_top && ranges[i][1] - ranges[i][0] <= subtree_size) {
+				child = SUBTREE_BIT | subtrees.size();
+				Subtree subtree;
+				subtree.begin = ranges[i][0];
+				subtree.end = ranges[i][1];
+				subtree.depth = p_depth + 1;
+				subtrees.push_back(subtree);
+			} else {
+				child = _build(r_nodes, ranges[i][0], ranges[i][1], p_depth + 1, p_top);
+			}
+			r_nodes[index].children[i] = child;
+		}
+
+		return index;
+	}
+
+	void _build_subtree(uint32_t p_index, void *p_userdata) {
+		Subtree &subtree = subtrees[p_index];
+		_build(subtree.nodes, subtree.begin, subtree.end, subtree.depth, false);
+	}
+
+	void build(_Volume_BVH_Element *p_elements, uint32_t p_count) {
+		elements = p_elements;
+		subtree_size = p_count >= PARALLEL_MIN_FACES ? p_count / 64 : 0;
+		_build(nodes, 0, p_count, 0, true);
+
+		if (!subtrees.is_empty()) {
+			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &_Volume_BVH_Builder::_build_subtree, nullptr, subtrees.size(), -1, true, SNAME("Physics3DConcaveBuildBVH"));
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 		}
 	}
-	bvh->aabb = aabb;
-	switch (aabb.get_longest_axis_index()) {
-		case 0: {
-			SortArray<_Volume_BVH_Element, _Volume_BVH_CompareX> sort_x;
-			sort_x.sort(p_elements, p_size);
 
-		} break;
-		case 1: {
-			SortArray<_Volume_BVH_Element, _Volume_BVH_CompareY> sort_y;
-			sort_y.sort(p_elements, p_size);
-		} break;
-		case 2: {
-			SortArray<_Volume_BVH_Element, _Volume_BVH_CompareZ> sort_z;
-			sort_z.sort(p_elements, p_size);
-		} break;
+	uint32_t get_node_count() const {
+		uint32_t count = nodes.size();
+		for (const Subtree &subtree : subtrees) {
+			count += subtree.nodes.size();
+		}
+		return count;
 	}
+};
+
+void GodotConcavePolygonShape3D::_build_bvh() {
+	const uint32_t face_count = faces.size();
+	const Vector3 *vr = vertices.ptr();
+
+	LocalVector<_Volume_BVH_Element> elements;
+	elements.resize(face_count);
+	for (uint32_t i = 0; i < face_count; i++) {
+		AABB aabb(vr[i * 3 + 0], Vector3());
+		aabb.expand_to(vr[i * 3 + 1]);
+		aabb.expand_to(vr[i * 3 + 2]);
+		elements[i].aabb = aabb;
+		elements[i].center = aabb.get_center();
+		elements[i].face_index = i;
+	}
+
+	_Volume_BVH_Builder builder;
+	builder.build(elements.ptr(), face_count);
+
+	// Flatten the subtrees into a single list of quantized nodes, in depth-first order.
+	bvh.resize(builder.get_node_count());
+	bvh_faces.resize(face_count);
+	uint32_t node_index = 0;
+	uint32_t face_index = 0;
+
+	struct Entry {
+		const LocalVector<_Volume_BVH_Node> *nodes = nullptr;
+		uint32_t index = 0;
+		// Node waiting for the index of its right child.
+		uint32_t parent = UINT32_MAX;
+	};
+	Entry stack[BVH_MAX_DEPTH];
+	uint32_t stack_size = 0;
+	stack[stack_size++] = { &builder.nodes, 0 };
+
+	while (stack_size > 0) {
+		Entry entry = stack[--stack_size];
+		if (entry.parent != UINT32_MAX) {
+			bvh[entry.parent].data = node_index << 3;
+		}
+
+		const _Volume_BVH_Node &node = (*entry.nodes)[entry.index];
+		BVH &bvh_node = bvh[node_index];
+		_quantize(node.aabb, bvh_node.min, bvh_node.max);
+
+		if (node.count > 0) {
+			bvh_node.data = (face_index << 3) | node.count;
+			for (uint32_t i = 0; i < node.count; i++) {
+				bvh_faces[face_index++] = elements[node.begin + i].face_index;
+			}
+			node_index++;
+			continue;
+		}
+
+		Entry children[2];
+		for (int i = 0; i < 2; i++) {
+			if (node.children[i] & _Volume_BVH_Builder::SUBTREE_BIT) {
+				children[i] = { &builder.subtrees[node.children[i] & ~_Volume_BVH_Builder::SUBTREE_BIT].nodes, 0 };
+			} else {
+				children[i] = { entry.nodes, node.children[i] };
+			}
+		}
+		children[1].parent = node_index;
 
-	int split = p_size / 2;
-	bvh->left = _volume_build_bvh(p_elements, split, count);
-	bvh->right = _volume_build_bvh(&p_elements[split], p_size - split, count);
+		// The left child is visited next, so it's pushed last.
+		if (unlikely(stack_size + 2 > BVH_MAX_DEPTH)) {
+			bvh.clear();
+			bvh_faces.clear();
+			ERR_FAIL_MSG("The BVH of the concave polygon shape is too deep.");
+		}
+		stack[stack_size++] = children[1];
+		stack[stack_size++] = children[0];
+		node_index++;
+	}
+}
 
-	//printf("branch at %p - %i: %i\n",bvh,count,bvh->face_index);
-	count++;
-	return bvh;
+uint32_t GodotConcavePolygonShape3D::_hash_vertices() const {
+	// Hashed in chunks, the length of a buffer to hash is an int.
+	const uint8_t *data = reinterpret_cast<const uint8_t *>(vertices.ptr());
+	uint64_t size = vertices.size() * sizeof(Vector3);
+	const uint64_t chunk_size = 1 << 24;
+	uint32_t h = HASH_MURMUR3_SEED;
+	for (uint64_t offset = 0; offset < size; offset += chunk_size) {
+		h = hash_murmur3_buffer(data + offset, MIN(chunk_size, size - offset), h);
+	}
+	return h;
 }
 
-void GodotConcavePolygonShape3D::_fill_bvh(_Volume_BVH *p_bvh_tree, BVH *p_bvh_array, int &p_idx) {
-	int idx = p_idx;
+// Header of the baked BVH data, followed by the nodes and then the indices of
+// the faces of the leaves.
+struct _ConcaveBVHDataHeader {
+	uint32_t version = 0;
+	uint32_t real_size = 0;
+	uint32_t face_count = 0;
+	uint32_t vertices_hash = 0;
+	uint32_t node_count = 0;
+};
 
-	p_bvh_array[idx].aabb = p_bvh_tree->aabb;
-	p_bvh_array[idx].face_index = p_bvh_tree->face_index;
-	//printf("%p - %i: %i(%p)  -- %p:%p\n",%p_bvh_array[idx],p_idx,p_bvh_array[i]->face_index,&p_bvh_tree->face_index,p_bvh_tree->left,p_bvh_tree->right);
+PackedByteArray GodotConcavePolygonShape3D::_get_bvh_data() const {
+	_ConcaveBVHDataHeader header;
+	header.version = BVH_DATA_VERSION;
+	header.real_size = sizeof(real_t);
+	header.face_count = faces.size();
+	header.vertices_hash = _hash_vertices();
+	header.node_count = bvh.size();
+
+	PackedByteArray data;
+	data.resize(sizeof(header) + bvh.size() * sizeof(BVH) + bvh_faces.size() * sizeof(uint32_t));
+	uint8_t *w = data.ptrw();
+	memcpy(w, &header, sizeof(header));
+	w += sizeof(header);
+	memcpy(w, bvh.ptr(), bvh.size() * sizeof(BVH));
+	w += bvh.size() * sizeof(BVH);
+	memcpy(w, bvh_faces.ptr(), bvh_faces.size() * sizeof(uint32_t));
+
+	return data;
+}
+
+bool GodotConcavePolygonShape3D::_set_bvh_data(const PackedByteArray &p_data) {
+	_ConcaveBVHDataHeader header;
+	if (p_data.size() < (int64_t)sizeof(header)) {
+		return false;
+	}
 
-	if (p_bvh_tree->left) {
-		p_bvh_array[idx].left = ++p_idx;
-		_fill_bvh(p_bvh_tree->left, p_bvh_array, p_idx);
+	const uint8_t *r = p_data.ptr();
+	memcpy(&header, r, sizeof(header));
+	r += sizeof(header);
 
-	} else {
-		p_bvh_array[p_idx].left = -1;
+	// Data baked for other faces, or by another version, is ignored.
+	if (header.version != BVH_DATA_VERSION || header.real_size != sizeof(real_t) || header.face_count != (uint32_t)faces.size() || header.node_count == 0) {
+		return false;
+	}
+	if ((uint64_t)p_data.size() != sizeof(header) + (uint64_t)header.node_count * sizeof(BVH) + (uint64_t)header.face_count * sizeof(uint32_t)) {
+		return false;
+	}
+	if (header.vertices_hash != _hash_vertices()) {
+		return false;
 	}
 
-	if (p_bvh_tree->right) {
-		p_bvh_array[idx].right = ++p_idx;
-		_fill_bvh(p_bvh_tree->right, p_bvh_array, p_idx);
+	bvh.resize(header.node_count);
+	memcpy(bvh.ptr(), r, header.node_count * sizeof(BVH));
+	r += header.node_count * sizeof(BVH);
+	bvh_faces.resize(header.face_count);
+	memcpy(bvh_faces.ptr(), r, header.face_count * sizeof(uint32_t));
 
-	} else {
-		p_bvh_array[p_idx].right = -1;
+	// The queries trust the tree, so check it's a valid depth-first tree with
+	// faces in range, and not deeper than their stacks.
+	for (uint32_t face_index : bvh_faces) {
+		ERR_FAIL_COND_V(face_index >= header.face_count, false);
+	}
+
+	struct Entry {
+		uint32_t index = 0;
+		uint32_t depth = 0;
+	};
+	Entry stack[BVH_MAX_DEPTH];
+	uint32_t stack_size = 0;
+	stack[stack_size++] = { 0, 0 };
+	uint32_t visited = 0;
+
+	while (stack_size > 0) {
+		Entry entry = stack[--stack_size];
+		ERR_FAIL_COND_V(entry.index != visited || entry.index >= header.node_count || entry.depth >= BVH_MAX_DEPTH, false);
+		visited++;
+
+		const BVH &node = bvh[entry.index];
+		if (node.is_leaf()) {
+			ERR_FAIL_COND_V((uint64_t)node.get_index() + node.get_face_count() > header.face_count, false);
+			continue;
+		}
+
+		ERR_FAIL_COND_V(stack_size + 2 > BVH_MAX_DEPTH, false);
+		stack[stack_size++] = { node.get_index(), entry.depth + 1 };
+		stack[stack_size++] = { entry.index + 1, entry.depth + 1 };
 	}
+	ERR_FAIL_COND_V(visited != header.node_count, false);
 
-	memdelete(p_bvh_tree);
+	return true;
 }
 
-void GodotConcavePolygonShape3D::_setup(const Vector<Vector3> &p_faces, bool p_backface_collision) {
+void GodotConcavePolygonShape3D::_setup(const Vector<Vector3> &p_faces, bool p_backface_collision, const PackedByteArray &p_bvh_data) {
+	faces.clear();
+	vertices.clear();
+	bvh.clear();
+	bvh_faces.clear();
+
 	int src_face_count = p_faces.size();
 	if (src_face_count == 0) {
 		configure(AABB());
@@ -1617,14 +2006,10 @@ void GodotConcavePolygonShape3D::_setup(const Vector<Vector3> &p_faces, bool p_b
 	}
 	ERR_FAIL_COND(src_face_count % 3);
 	src_face_count /= 3;
+	ERR_FAIL_COND_MSG(src_face_count >= (1 << 28), "Too many faces in the concave polygon shape.");
 
 	const Vector3 *facesr = p_faces.ptr();
 
-	Vector<_Volume_BVH_Element> bvh_array;
-	bvh_array.resize(src_face_count);
-
-	_Volume_BVH_Element *bvh_arrayw = bvh_array.ptrw();
-
 	faces.resize(src_face_count);
 	Face *facesw = faces.ptrw();
 
@@ -1637,9 +2022,6 @@ void GodotConcavePolygonShape3D::_setup(const Vector<Vector3> &p_faces, bool p_b
 	for (int i = 0; i < src_face_count; i++) {
 		Face3 face(facesr[i * 3 + 0], facesr[i * 3 + 1], facesr[i * 3 + 2]);
 
-		bvh_arrayw[i].aabb = face.get_aabb();
-		bvh_arrayw[i].center = bvh_arrayw[i].aabb.get_center();
-		bvh_arrayw[i].face_index = i;
 		facesw[i].indices[0] = i * 3 + 0;
 		facesw[i].indices[1] = i * 3 + 1;
 		facesw[i].indices[2] = i * 3 + 2;
@@ -1648,21 +2030,20 @@ void GodotConcavePolygonShape3D::_setup(const Vector<Vector3> &p_faces, bool p_b
 		verticesw[i * 3 + 1] = face.vertex[1];
 		verticesw[i * 3 + 2] = face.vertex[2];
 		if (i == 0) {
-			_aabb = bvh_arrayw[i].aabb;
+			_aabb = face.get_aabb();
 		} else {
-			_aabb.merge_with(bvh_arrayw[i].aabb);
+			_aabb.merge_with(face.get_aabb());
 		}
 	}
 
-	int count = 0;
-	_Volume_BVH *bvh_tree = _volume_build_bvh(bvh_arrayw, src_face_count, count);
-
-	bvh.resize(count + 1);
-
-	BVH *bvh_arrayw2 = bvh.ptrw();
+	bvh_origin = _aabb.position;
+	for (int i = 0; i < 3; i++) {
+		bvh_scale[i] = _aabb.size[i] > 0 ? 65535.0 / _aabb.size[i] : 0.0;
+	}
 
-	int idx = 0;
-	_fill_bvh(bvh_tree, bvh_arrayw2, idx);
+	if (p_bvh_data.is_empty() || !_set_bvh_data(p_bvh_data)) {
+		_build_bvh();
+	}
 
 	backface_collision = p_backface_collision;
 
@@ -1673,13 +2054,16 @@ void GodotConcavePolygonShape3D::set_data(const Variant &p_data) {
 	Dictionary d = p_data;
 	ERR_FAIL_COND(!d.has("faces"));
 
-	_setup(d["faces"], d["backface_collision"]);
+	_setup(d["faces"], d["backface_collision"], d.get("bvh", PackedByteArray()));
 }
 
 Variant GodotConcavePolygonShape3D::get_data() const {
 	Dictionary d;
 	d["faces"] = get_faces();
 	d["backface_collision"] = backface_collision;
+	if (!bvh.is_empty()) {
+		d["bvh"] = _get_bvh_data();
+	}
 
 	return d;
 }
@@ -302,7 +302,6 @@ public:
 	GodotConvexPolygonShape3D();
 };
 
-struct _Volume_BVH;
 struct GodotFaceShape3D;
 
 struct GodotConcavePolygonShape3D : public GodotConcaveShape3D {
@@ -316,23 +315,41 @@ struct GodotConcavePolygonShape3D : public GodotConcaveShape3D {
 	Vector<Face> faces;
 	Vector<Vector3> vertices;
 
-	struct BVH {
-		AABB aabb;
-		int left = 0;
-		int right = 0;
+	static constexpr uint32_t LEAF_SIZE_MASK = 7;
+	static constexpr uint32_t LEAF_MAX_FACES = 4;
+	static constexpr uint32_t BVH_MAX_DEPTH = 64;
+	static constexpr uint32_t BVH_DATA_VERSION = 1;
 
-		int face_index = 0;
+	// Node of the quantized BVH. Bounds are stored in 1/65535 steps of the
+	// shape's AABB, rounded outwards, so a node is 16 bytes and never straddles
+	// a cache line. Nodes are in depth-first order, the left child of an
+	// internal node is the next node.
+	struct BVH {
+		uint16_t min[3] = {};
+		uint16_t max[3] = {};
+		// Leaves: index of their first face in bvh_faces << 3 | face count.
+		// Internal nodes: index of the right child << 3.
+		uint32_t data = 0;
+
+		_FORCE_INLINE_ bool is_leaf() const { return data & LEAF_SIZE_MASK; }
+		_FORCE_INLINE_ uint32_t get_index() const { return data >> 3; }
+		_FORCE_INLINE_ uint32_t get_face_count() const { return data & LEAF_SIZE_MASK; }
 	};
 
-	Vector<BVH> bvh;
+	LocalVector<BVH> bvh;
+	// Faces in the order of the leaves.
+	LocalVector<uint32_t> bvh_faces;
+	Vector3 bvh_origin;
+	Vector3 bvh_scale; // Quantization steps per unit.
 
 	struct _CullParams {
 		AABB aabb;
+		uint16_t min[3] = {};
+		uint16_t max[3] = {};
 		QueryCallback callback = nullptr;
 		void *userdata = nullptr;
 		const Face *faces = nullptr;
 		const Vector3 *vertices = nullptr;
-		const BVH *bvh = nullptr;
 		GodotFaceShape3D *face = nullptr;
 	};
 
@@ -342,9 +359,14 @@ struct GodotConcavePolygonShape3D : public GodotConcaveShape3D {
 		Vector3 dir;
 		const Face *faces = nullptr;
 		const Vector3 *vertices = nullptr;
-		const BVH *bvh = nullptr;
 		GodotFaceShape3D *face = nullptr;
 
+		// The segment in quantized BVH space.
+		Vector3 bvh_from;
+		Vector3 bvh_dir;
+		Vector3 bvh_inv_dir;
+		real_t length = 0.0;
+
 		Vector3 result;
 		Vector3 normal;
 		int face_index = -1;
@@ -354,12 +376,16 @@ struct GodotConcavePolygonShape3D : public GodotConcaveShape3D {
 
 	bool backface_collision = false;
 
-	void _cull_segment(int p_idx, _SegmentCullParams *p_params) const;
-	bool _cull(int p_idx, _CullParams *p_params) const;
+	void _quantize(const AABB &p_aabb, uint16_t *r_min, uint16_t *r_max) const;
+	void _cull_segment_faces(const BVH &p_leaf, _SegmentCullParams *p_params) const;
+	bool _cull_faces(const BVH &p_leaf, _CullParams *p_params) const;
 
-	void _fill_bvh(_Volume_BVH *p_bvh_tree, BVH *p_bvh_array, int &p_idx);
+	void _build_bvh();
+	uint32_t _hash_vertices() const;
+	PackedByteArray _get_bvh_data() const;
+	bool _set_bvh_data(const PackedByteArray &p_data);
 
-	void _setup(const Vector<Vector3> &p_faces, bool p_backface_collision);
+	void _setup(const Vector<Vector3> &p_faces, bool p_backface_collision, const PackedByteArray &p_bvh_data);
 
 public:
 	Vector<Vector3> get_faces() const;
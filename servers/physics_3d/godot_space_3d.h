@@ -41,11 +41,47 @@
 
 #include "core/config/project_settings.h"
 #include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/paged_allocator.h"
 #include "core/typedefs.h"
 
 class GodotPhysicsDirectSpaceState3D : public PhysicsDirectSpaceState3D {
 	GDCLASS(GodotPhysicsDirectSpaceState3D, PhysicsDirectSpaceState3D);
 
+	enum {
+		BATCH_PARALLEL_MIN = 32 // Smaller batches aren't worth dispatching to the WorkerThreadPool.
+	};
+
+	struct RayBatch {
+		const RayParameters *parameters = nullptr;
+		const Vector3 *from = nullptr;
+		const Vector3 *to = nullptr;
+		RayResult *results = nullptr;
+	};
+
+	struct MotionBatch {
+		const ShapeParameters *parameters = nullptr;
+		GodotShape3D *shape = nullptr;
+		const Transform3D *transforms = nullptr;
+		const Vector3 *motions = nullptr;
+		real_t *closest_safe = nullptr;
+		real_t *closest_unsafe = nullptr;
+	};
+
+	// Broadphase results of each query of a batch, from batch_offsets[i] to batch_offsets[i + 1].
+	// The broadphase isn't reentrant, so queries are culled on the calling thread and only their
+	// narrowphase runs in parallel. Kept between batches to reuse the memory.
+	LocalVector<GodotCollisionObject3D *> batch_objects;
+	LocalVector<int> batch_subindices;
+	LocalVector<uint32_t> batch_offsets;
+
+	static AABB _get_motion_aabb(const GodotShape3D *p_shape, const Transform3D &p_transform, const Vector3 &p_motion, real_t p_margin);
+	bool _intersect_ray(const RayParameters &p_parameters, const Vector3 &p_from, const Vector3 &p_to, GodotCollisionObject3D *const *p_objects, const int *p_subindices, int p_amount, RayResult &r_result) const;
+	void _cast_motion(const ShapeParameters &p_parameters, GodotShape3D *p_shape, const Transform3D &p_transform, const Vector3 &p_motion, GodotCollisionObject3D *const *p_objects, const int *p_subindices, int p_amount, real_t &r_closest_safe, real_t &r_closest_unsafe, ShapeRestInfo *r_info) const;
+	void _run_batch(uint32_t p_count, void (GodotPhysicsDirectSpaceState3D::*p_method)(uint32_t, void *), void *p_batch, const StringName &p_description);
+	void _intersect_ray_batch(uint32_t p_index, void *p_batch);
+	void _cast_motion_batch(uint32_t p_index, void *p_batch);
+
 public:
 	GodotSpace3D *space = nullptr;
 
@@ -57,6 +93,9 @@ public:
 	virtual bool rest_info(const ShapeParameters &p_parameters, ShapeRestInfo *r_info) override;
 	virtual Vector3 get_closest_point_to_object_volume(RID p_object, const Vector3 p_point) const override;
 
+	virtual int intersect_rays(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results) override;
+	virtual bool cast_motions(const ShapeParameters &p_parameters, const Transform3D *p_transforms, const Vector3 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe) override;
+
 	GodotPhysicsDirectSpaceState3D();
 };
 
@@ -89,6 +128,11 @@ private:
 	static void *_broadphase_pair(GodotCollisionObject3D *A, int p_subindex_A, GodotCollisionObject3D *B, int p_subindex_B, void *p_self);
 	static void _broadphase_unpair(GodotCollisionObject3D *A, int p_subindex_A, GodotCollisionObject3D *B, int p_subindex_B, void *p_data, void *p_self);
 
+	// Pairs are created and freed every time objects start or stop overlapping, so the common ones are recycled.
+	PagedAllocator<GodotBodyPair3D> body_pair_allocator{ 256 };
+	PagedAllocator<GodotAreaPair3D> area_pair_allocator{ 64 };
+	PagedAllocator<GodotArea2Pair3D> area2_pair_allocator{ 64 };
+
 	HashSet<GodotCollisionObject3D *> objects;
 
 	GodotArea3D *area = nullptr;
@@ -36,80 +36,171 @@
 #include "core/os/os.h"
 
 #define BODY_ISLAND_COUNT_RESERVE 128
-#define BODY_ISLAND_SIZE_RESERVE 512
 #define ISLAND_COUNT_RESERVE 128
-#define ISLAND_SIZE_RESERVE 512
 #define CONSTRAINT_COUNT_RESERVE 1024
 
-void GodotStep3D::_populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island) {
+uint32_t GodotStep3D::_add_island_body(GodotBody3D *p_body) {
+	uint32_t index = island_objects.size();
 	p_body->set_island_step(_step);
+	p_body->set_island_index(index);
 
-	if (p_body->get_mode() > PhysicsServer3D::BODY_MODE_KINEMATIC) {
-		// Only rigid bodies are tested for activation.
-		p_body_island.push_back(p_body);
+	IslandObject object;
+	object.body = p_body;
+	island_objects.push_back(object);
+	island_parents.push_back(index);
+	return index;
+}
+
+uint32_t GodotStep3D::_add_island_soft_body(GodotSoftBody3D *p_soft_body) {
+	uint32_t index = island_objects.size();
+	p_soft_body->set_island_step(_step);
+	p_soft_body->set_island_index(index);
+
+	IslandObject object;
+	object.soft_body = p_soft_body;
+	island_objects.push_back(object);
+	island_parents.push_back(index);
+	return index;
+}
+
+void GodotStep3D::_add_island_constraint(GodotConstraint3D *p_constraint, uint32_t p_object_index, int p_object_pos) {
+	if (p_constraint->get_island_step() == _step) {
+		return; // Already processed.
+	}
+	p_constraint->set_island_step(_step);
+	all_constraints.push_back(p_constraint);
+	island_constraint_objects.push_back(p_object_index);
+
+	// Join the connected rigid bodies.
+	for (int i = 0; i < p_constraint->get_body_count(); i++) {
+		if (i == p_object_pos) {
+			continue;
+		}
+		GodotBody3D *other_body = p_constraint->get_body_ptr()[i];
+		if (other_body->get_mode() == PhysicsServer3D::BODY_MODE_STATIC) {
+			continue; // Static bodies don't connect islands.
+		}
+		uint32_t other_index = (other_body->get_island_step() == _step) ? other_body->get_island_index() : _add_island_body(other_body);
+		_join_islands(p_object_index, other_index);
+	}
+
+	// Join the connected soft bodies.
+	for (int i = 0; i < p_constraint->get_soft_body_count(); i++) {
+		GodotSoftBody3D *soft_body = p_constraint->get_soft_body_ptr(i);
+		uint32_t other_index = (soft_body->get_island_step() == _step) ? soft_body->get_island_index() : _add_island_soft_body(soft_body);
+		_join_islands(p_object_index, other_index);
+	}
+}
+
+uint32_t GodotStep3D::_find_island_root(uint32_t p_object_index) {
+	while (island_parents[p_object_index] != p_object_index) {
+		// Path halving.
+		island_parents[p_object_index] = island_parents[island_parents[p_object_index]];
+		p_object_index = island_parents[p_object_index];
+	}
+	return p_object_index;
+}
+
+void GodotStep3D::_join_islands(uint32_t p_object_index_a, uint32_t p_object_index_b) {
+	uint32_t root_a = _find_island_root(p_object_index_a);
+	uint32_t root_b = _find_island_root(p_object_index_b);
+	// The first object added stays the root, so islands keep the same order from one step to the next.
+	if (root_a < root_b) {
+		island_parents[root_b] = root_a;
+	} else if (root_b < root_a) {
+		island_parents[root_a] = root_b;
 	}
+}
+
+void GodotStep3D::_generate_islands(const SelfList<GodotSoftBody3D>::List &p_soft_body_list, uint32_t &r_body_island_count, uint32_t &r_island_count) {
+	island_objects.clear();
+	island_parents.clear();
+	island_constraint_objects.clear();
 
-	for (const KeyValue<GodotConstraint3D *, int> &E : p_body->get_constraint_map()) {
-		GodotConstraint3D *constraint = const_cast<GodotConstraint3D *>(E.key);
-		if (constraint->get_island_step() == _step) {
-			continue; // Already processed.
+	// Start from the active objects, then walk their constraints, which adds the inactive objects they
+	// touch, so the whole island can be woken up or put to sleep.
+	for (GodotBody3D *body : active_bodies) {
+		if (body->get_island_step() != _step) {
+			_add_island_body(body);
+		}
+	}
+	const SelfList<GodotSoftBody3D> *sb = p_soft_body_list.first();
+	while (sb) {
+		if (sb->self()->get_island_step() != _step) {
+			_add_island_soft_body(sb->self());
 		}
-		constraint->set_island_step(_step);
-		p_constraint_island.push_back(constraint);
+		sb = sb->next();
+	}
 
-		all_constraints.push_back(constraint);
+	const uint32_t first_constraint = all_constraints.size();
 
-		// Find connected rigid bodies.
-		for (int i = 0; i < constraint->get_body_count(); i++) {
-			if (i == E.value) {
-				continue;
+	for (uint32_t object_index = 0; object_index < island_objects.size(); object_index++) {
+		const IslandObject &object = island_objects[object_index];
+		if (object.body) {
+			for (const KeyValue<GodotConstraint3D *, int> &E : object.body->get_constraint_map()) {
+				_add_island_constraint(E.key, object_index, E.value);
 			}
-			GodotBody3D *other_body = constraint->get_body_ptr()[i];
-			if (other_body->get_island_step() == _step) {
-				continue; // Already processed.
+		} else {
+			for (GodotConstraint3D *constraint : object.soft_body->get_constraints()) {
+				_add_island_constraint(constraint, object_index, -1);
 			}
-			if (other_body->get_mode() == PhysicsServer3D::BODY_MODE_STATIC) {
-				continue; // Static bodies don't connect islands.
+		}
+	}
+
+	// Number the islands in the order of their first object, skipping those without rigid bodies or constraints.
+	const uint32_t object_count = island_objects.size();
+	island_slots.resize(object_count);
+
+	for (uint32_t object_index = 0; object_index < object_count; object_index++) {
+		island_slots[object_index] = UINT32_MAX;
+	}
+	for (uint32_t object_index = 0; object_index < object_count; object_index++) {
+		GodotBody3D *body = island_objects[object_index].body;
+		if (!body || body->get_mode() <= PhysicsServer3D::BODY_MODE_KINEMATIC) {
+			continue; // Only rigid bodies are tested for activation.
+		}
+		uint32_t &slot = island_slots[_find_island_root(object_index)];
+		if (slot == UINT32_MAX) {
+			slot = r_body_island_count++;
+			if (body_islands.size() < r_body_island_count) {
+				body_islands.resize(r_body_island_count);
 			}
-			_populate_island(other_body, p_body_island, p_constraint_island);
+			body_islands[slot].clear();
 		}
+		body_islands[slot].push_back(body);
+	}
 
-		// Find connected soft bodies.
-		for (int i = 0; i < constraint->get_soft_body_count(); i++) {
-			GodotSoftBody3D *soft_body = constraint->get_soft_body_ptr(i);
-			if (soft_body->get_island_step() == _step) {
-				continue; // Already processed.
+	for (uint32_t object_index = 0; object_index < object_count; object_index++) {
+		island_slots[object_index] = UINT32_MAX;
+	}
+	for (uint32_t constraint_index = 0; constraint_index < island_constraint_objects.size(); constraint_index++) {
+		uint32_t &slot = island_slots[_find_island_root(island_constraint_objects[constraint_index])];
+		if (slot == UINT32_MAX) {
+			slot = r_island_count++;
+			if (constraint_islands.size() < r_island_count) {
+				constraint_islands.resize(r_island_count);
 			}
-			_populate_island_soft_body(soft_body, p_body_island, p_constraint_island);
+			constraint_islands[slot].clear();
 		}
+		constraint_islands[slot].push_back(all_constraints[first_constraint + constraint_index]);
 	}
 }
 
-void GodotStep3D::_populate_island_soft_body(GodotSoftBody3D *p_soft_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island) {
-	p_soft_body->set_island_step(_step);
-
-	for (const GodotConstraint3D *E : p_soft_body->get_constraints()) {
-		GodotConstraint3D *constraint = const_cast<GodotConstraint3D *>(E);
-		if (constraint->get_island_step() == _step) {
-			continue; // Already processed.
-		}
-		constraint->set_island_step(_step);
-		p_constraint_island.push_back(constraint);
+void GodotStep3D::_fill_active_bodies(const SelfList<GodotBody3D>::List &p_body_list) {
+	active_bodies.clear();
+	const SelfList<GodotBody3D> *b = p_body_list.first();
+	while (b) {
+		active_bodies.push_back(b->self());
+		b = b->next();
+	}
+}
 
-		all_constraints.push_back(constraint);
+void GodotStep3D::_integrate_forces(uint32_t p_body_index, void *p_userdata) {
+	active_bodies[p_body_index]->integrate_forces(delta);
+}
 
-		// Find connected rigid bodies.
-		for (int i = 0; i < constraint->get_body_count(); i++) {
-			GodotBody3D *body = constraint->get_body_ptr()[i];
-			if (body->get_island_step() == _step) {
-				continue; // Already processed.
-			}
-			if (body->get_mode() == PhysicsServer3D::BODY_MODE_STATIC) {
-				continue; // Static bodies don't connect islands.
-			}
-			_populate_island(body, p_body_island, p_constraint_island);
-		}
-	}
+void GodotStep3D::_integrate_velocities(uint32_t p_body_index, void *p_userdata) {
+	active_bodies[p_body_index]->integrate_velocities(delta);
 }
 
 void GodotStep3D::_setup_constraint(uint32_t p_constraint_index, void *p_userdata) {
@@ -130,6 +221,13 @@ void GodotStep3D::_pre_solve_island(LocalVector<GodotConstraint3D *> &p_constrai
 	p_constraint_island.resize(valid_constraint_count);
 }
 
+void GodotStep3D::_pre_solve_islands(uint32_t p_island_count) {
+	pre_solve_begtime = OS::get_singleton()->get_ticks_usec();
+	for (uint32_t island_index = 0; island_index < p_island_count; ++island_index) {
+		_pre_solve_island(constraint_islands[island_index]);
+	}
+}
+
 void GodotStep3D::_solve_island(uint32_t p_island_index, void *p_userdata) {
 	LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[p_island_index];
 
@@ -158,28 +256,21 @@ void GodotStep3D::_solve_island(uint32_t p_island_index, void *p_userdata) {
 	}
 }
 
-void GodotStep3D::_check_suspend(const LocalVector<GodotBody3D *> &p_body_island) const {
+void GodotStep3D::_sleep_test_island(uint32_t p_island_index, void *p_userdata) {
+	const LocalVector<GodotBody3D *> &body_island = body_islands[p_island_index];
+
 	bool can_sleep = true;
 
-	uint32_t body_count = p_body_island.size();
+	uint32_t body_count = body_island.size();
 	for (uint32_t body_index = 0; body_index < body_count; ++body_index) {
-		GodotBody3D *body = p_body_island[body_index];
+		GodotBody3D *body = body_island[body_index];
 
 		if (!body->sleep_test(delta)) {
 			can_sleep = false;
 		}
 	}
 
-	// Put all to sleep or wake up everyone.
-	for (uint32_t body_index = 0; body_index < body_count; ++body_index) {
-		GodotBody3D *body = p_body_island[body_index];
-
-		bool active = body->is_active();
-
-		if (active == can_sleep) {
-			body->set_active(!can_sleep);
-		}
-	}
+	body_island_can_sleep[p_island_index] = can_sleep;
 }
 
 void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
@@ -201,13 +292,18 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	uint64_t profile_begtime = OS::get_singleton()->get_ticks_usec();
 	uint64_t profile_endtime = 0;
 
-	int active_count = 0;
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
 
-	const SelfList<GodotBody3D> *b = body_list->first();
-	while (b) {
-		b->self()->integrate_forces(p_delta);
-		b = b->next();
-		active_count++;
+	_fill_active_bodies(*body_list);
+	uint32_t active_body_count = active_bodies.size();
+	int active_count = active_body_count;
+
+	WorkerThreadPool::GroupID integrate_forces_task = pool->add_template_group_task(this, &GodotStep3D::_integrate_forces, nullptr, active_body_count, -1, true, SNAME("Physics3DIntegrateForces"));
+	pool->wait_for_group_task_completion(integrate_forces_task);
+
+	// Moving the shapes in the broadphase isn't thread safe, and is done in the order of the active list.
+	for (GodotBody3D *body : active_bodies) {
+		body->apply_integrated_forces();
 	}
 
 	/* UPDATE SOFT BODY MOTION */
@@ -258,80 +354,11 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 		p_space->area_remove_from_moved_list((SelfList<GodotArea3D> *)aml.first()); //faster to remove here
 	}
 
-	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE RIGID BODIES */
-
-	b = body_list->first();
+	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE RIGID AND SOFT BODIES */
 
 	uint32_t body_island_count = 0;
-
-	while (b) {
-		GodotBody3D *body = b->self();
-
-		if (body->get_island_step() != _step) {
-			++body_island_count;
-			if (body_islands.size() < body_island_count) {
-				body_islands.resize(body_island_count);
-			}
-			LocalVector<GodotBody3D *> &body_island = body_islands[body_island_count - 1];
-			body_island.clear();
-			body_island.reserve(BODY_ISLAND_SIZE_RESERVE);
-
-			++island_count;
-			if (constraint_islands.size() < island_count) {
-				constraint_islands.resize(island_count);
-			}
-			LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[island_count - 1];
-			constraint_island.clear();
-			constraint_island.reserve(ISLAND_SIZE_RESERVE);
-
-			_populate_island(body, body_island, constraint_island);
-
-			if (body_island.is_empty()) {
-				--body_island_count;
-			}
-
-			if (constraint_island.is_empty()) {
-				--island_count;
-			}
-		}
-		b = b->next();
-	}
-
-	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE SOFT BODIES */
-
-	sb = soft_body_list->first();
-	while (sb) {
-		GodotSoftBody3D *soft_body = sb->self();
-
-		if (soft_body->get_island_step() != _step) {
-			++body_island_count;
-			if (body_islands.size() < body_island_count) {
-				body_islands.resize(body_island_count);
-			}
-			LocalVector<GodotBody3D *> &body_island = body_islands[body_island_count - 1];
-			body_island.clear();
-			body_island.reserve(BODY_ISLAND_SIZE_RESERVE);
-
-			++island_count;
-			if (constraint_islands.size() < island_count) {
-				constraint_islands.resize(island_count);
-			}
-			LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[island_count - 1];
-			constraint_island.clear();
-			constraint_island.reserve(ISLAND_SIZE_RESERVE);
-
-			_populate_island_soft_body(soft_body, body_island, constraint_island);
-
-			if (body_island.is_empty()) {
-				--body_island_count;
-			}
-
-			if (constraint_island.is_empty()) {
-				--island_count;
-			}
-		}
-		sb = sb->next();
-	}
+	_fill_active_bodies(*body_list);
+	_generate_islands(*soft_body_list, body_island_count, island_count);
 
 	p_space->set_island_count((int)island_count);
 
@@ -343,49 +370,57 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	/* SETUP CONSTRAINTS / PROCESS COLLISIONS */
 
+	// Setup, pre-solve and solve are submitted at once as a chain of dependent
+	// tasks, so that each stage starts as soon as the previous one is done.
 	uint32_t total_constraint_count = all_constraints.size();
-	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics3DConstraintSetup"));
-	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
-
-	{ //profile
-		profile_endtime = OS::get_singleton()->get_ticks_usec();
-		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_SETUP_CONSTRAINTS, profile_endtime - profile_begtime);
-		profile_begtime = profile_endtime;
-	}
+	WorkerThreadPool::GroupID setup_task = pool->add_template_group_task(this, &GodotStep3D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics3DConstraintSetup"));
 
 	/* PRE-SOLVE CONSTRAINT ISLANDS */
 
-	// Warning: This doesn't run on threads, because it involves thread-unsafe processing.
-	for (uint32_t island_index = 0; island_index < island_count; ++island_index) {
-		_pre_solve_island(constraint_islands[island_index]);
-	}
+	// Warning: This doesn't run in parallel, because it involves thread-unsafe processing.
+	WorkerThreadPool::TaskID pre_solve_task = pool->add_template_task_after({ setup_task }, this, &GodotStep3D::_pre_solve_islands, island_count, true, SNAME("Physics3DConstraintPreSolveIslands"));
 
 	/* SOLVE CONSTRAINT ISLANDS */
 
 	// Warning: _solve_island modifies the constraint islands for optimization purpose,
 	// their content is not reliable after these calls and shouldn't be used anymore.
-	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_island, nullptr, island_count, -1, true, SNAME("Physics3DConstraintSolveIslands"));
-	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	WorkerThreadPool::GroupID solve_task = pool->add_template_group_task_after({ pre_solve_task }, this, &GodotStep3D::_solve_island, nullptr, island_count, -1, true, SNAME("Physics3DConstraintSolveIslands"));
+	pool->wait_for_group_task_completion(solve_task);
+	pool->wait_for_task_completion(pre_solve_task);
+	pool->wait_for_group_task_completion(setup_task);
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
-		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_SOLVE_CONSTRAINTS, profile_endtime - profile_begtime);
+		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_SETUP_CONSTRAINTS, pre_solve_begtime - profile_begtime);
+		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_SOLVE_CONSTRAINTS, profile_endtime - pre_solve_begtime);
 		profile_begtime = profile_endtime;
 	}
 
 	/* INTEGRATE VELOCITIES */
 
-	b = body_list->first();
-	while (b) {
-		const SelfList<GodotBody3D> *n = b->next();
-		b->self()->integrate_velocities(p_delta);
-		b = n;
+	// Solving can wake up bodies, so the active list is copied again.
+	_fill_active_bodies(*body_list);
+	WorkerThreadPool::GroupID integrate_velocities_task = pool->add_template_group_task(this, &GodotStep3D::_integrate_velocities, nullptr, active_bodies.size(), -1, true, SNAME("Physics3DIntegrateVelocities"));
+	pool->wait_for_group_task_completion(integrate_velocities_task);
+
+	for (GodotBody3D *body : active_bodies) {
+		body->apply_integrated_velocities();
 	}
 
 	/* SLEEP / WAKE UP ISLANDS */
 
+	body_island_can_sleep.resize(body_island_count);
+	WorkerThreadPool::GroupID sleep_test_task = pool->add_template_group_task(this, &GodotStep3D::_sleep_test_island, nullptr, body_island_count, -1, true, SNAME("Physics3DSleepTestIslands"));
+	pool->wait_for_group_task_completion(sleep_test_task);
+
+	// Put all to sleep or wake up everyone.
 	for (uint32_t island_index = 0; island_index < body_island_count; ++island_index) {
-		_check_suspend(body_islands[island_index]);
+		const bool can_sleep = body_island_can_sleep[island_index];
+		for (GodotBody3D *body : body_islands[island_index]) {
+			if (body->is_active() == can_sleep) {
+				body->set_active(!can_sleep);
+			}
+		}
 	}
 
 	/* UPDATE SOFT BODY CONSTRAINTS */
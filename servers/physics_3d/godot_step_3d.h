@@ -45,12 +45,36 @@ class GodotStep3D {
 	LocalVector<LocalVector<GodotConstraint3D *>> constraint_islands;
 	LocalVector<GodotConstraint3D *> all_constraints;
 
-	void _populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
-	void _populate_island_soft_body(GodotSoftBody3D *p_soft_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
+	// Copy of the active body list, so the bodies can be integrated in parallel.
+	LocalVector<GodotBody3D *> active_bodies;
+	LocalVector<uint8_t> body_island_can_sleep;
+
+	// The bodies and soft bodies connected by constraints, joined into islands with a union-find.
+	struct IslandObject {
+		GodotBody3D *body = nullptr;
+		GodotSoftBody3D *soft_body = nullptr;
+	};
+	LocalVector<IslandObject> island_objects;
+	LocalVector<uint32_t> island_parents;
+	LocalVector<uint32_t> island_constraint_objects; // For each constraint added by _add_island_constraint(), one of its objects.
+	LocalVector<uint32_t> island_slots;
+
+	uint64_t pre_solve_begtime = 0; // For profiling, as pre-solving runs on a pool thread.
+
+	uint32_t _add_island_body(GodotBody3D *p_body);
+	uint32_t _add_island_soft_body(GodotSoftBody3D *p_soft_body);
+	void _add_island_constraint(GodotConstraint3D *p_constraint, uint32_t p_object_index, int p_object_pos);
+	uint32_t _find_island_root(uint32_t p_object_index);
+	void _join_islands(uint32_t p_object_index_a, uint32_t p_object_index_b);
+	void _generate_islands(const SelfList<GodotSoftBody3D>::List &p_soft_body_list, uint32_t &r_body_island_count, uint32_t &r_island_count);
+	void _fill_active_bodies(const SelfList<GodotBody3D>::List &p_body_list);
+	void _integrate_forces(uint32_t p_body_index, void *p_userdata = nullptr);
+	void _integrate_velocities(uint32_t p_body_index, void *p_userdata = nullptr);
 	void _setup_constraint(uint32_t p_constraint_index, void *p_userdata = nullptr);
 	void _pre_solve_island(LocalVector<GodotConstraint3D *> &p_constraint_island) const;
+	void _pre_solve_islands(uint32_t p_island_count);
 	void _solve_island(uint32_t p_island_index, void *p_userdata = nullptr);
-	void _check_suspend(const LocalVector<GodotBody3D *> &p_body_island) const;
+	void _sleep_test_island(uint32_t p_island_index, void *p_userdata = nullptr);
 
 public:
 	void step(GodotSpace3D *p_space, real_t p_delta);
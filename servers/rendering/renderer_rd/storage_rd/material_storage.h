@@ -34,6 +34,7 @@
 #include "texture_storage.h"
 
 #include "core/math/projection.h"
+#include "core/templates/flat_hash_map.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/rid_owner.h"
 #include "core/templates/self_list.h"
@@ -189,7 +190,7 @@ private:
 		bool must_update_texture_materials = false;
 		bool must_update_buffer_materials = false;
 
-		HashMap<RID, int32_t> instance_buffer_pos;
+		FlatHashMap<RID, int32_t> instance_buffer_pos;
 	} global_shader_uniforms;
 
 	int32_t _global_shader_uniform_allocate(uint32_t p_elements);
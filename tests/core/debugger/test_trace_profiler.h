@@ -0,0 +1,152 @@
+/**************************************************************************/
+/*  test_trace_profiler.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_TRACE_PROFILER_H
+#define TEST_TRACE_PROFILER_H
+
+#include "core/debugger/trace_profiler.h"
+#include "core/io/file_access.h"
+#include "core/io/json.h"
+#include "core/object/worker_thread_pool.h"
+
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestTraceProfiler {
+
+static void zone_task(void *p_userdata, uint32_t p_index) {
+	TRACE_ZONE("TestTraceProfiler::task");
+	OS::get_singleton()->delay_usec(10);
+}
+
+static uint32_t count_events(const HashMap<Thread::ID, LocalVector<TraceProfiler::Event>> &p_events, const char *p_name) {
+	uint32_t count = 0;
+	for (const KeyValue<Thread::ID, LocalVector<TraceProfiler::Event>> &E : p_events) {
+		for (const TraceProfiler::Event &event : E.value) {
+			count += String(event.name) == p_name;
+		}
+	}
+	return count;
+}
+
+TEST_CASE("[TraceProfiler] Zones are only recorded while recording") {
+	{
+		TRACE_ZONE("TestTraceProfiler::before");
+	}
+
+	TraceProfiler::start();
+	{
+		TRACE_ZONE("TestTraceProfiler::outer");
+		TRACE_ZONE("TestTraceProfiler::inner");
+		OS::get_singleton()->delay_usec(10);
+	}
+	TraceProfiler::stop();
+
+	{
+		TRACE_ZONE("TestTraceProfiler::after");
+	}
+
+	HashMap<Thread::ID, LocalVector<TraceProfiler::Event>> events;
+	TraceProfiler::get_events(events);
+	CHECK(count_events(events, "TestTraceProfiler::before") == 0);
+	CHECK(count_events(events, "TestTraceProfiler::after") == 0);
+	REQUIRE(events.has(Thread::get_caller_id()));
+
+	const LocalVector<TraceProfiler::Event> &main_events = events[Thread::get_caller_id()];
+	REQUIRE(main_events.size() == 2);
+	// Inner zones end, and so are recorded, first.
+	CHECK(String(main_events[0].name) == "TestTraceProfiler::inner");
+	CHECK(String(main_events[1].name) == "TestTraceProfiler::outer");
+	CHECK(main_events[1].begin_usec <= main_events[0].begin_usec);
+	CHECK(main_events[1].end_usec >= main_events[0].end_usec);
+	CHECK(main_events[0].end_usec - main_events[0].begin_usec >= 10);
+
+	TraceProfiler::finish();
+}
+
+TEST_CASE("[TraceProfiler] Ring buffers keep the latest events") {
+	TraceProfiler::start(4);
+	for (uint64_t i = 0; i < 10; i++) {
+		TraceProfiler::record("TestTraceProfiler::manual", i, i + 1);
+	}
+	TraceProfiler::stop();
+
+	HashMap<Thread::ID, LocalVector<TraceProfiler::Event>> events;
+	TraceProfiler::get_events(events);
+	const LocalVector<TraceProfiler::Event> &main_events = events[Thread::get_caller_id()];
+	REQUIRE(main_events.size() == 4);
+	CHECK(main_events[0].begin_usec == 6);
+	CHECK(main_events[3].begin_usec == 9);
+
+	TraceProfiler::clear();
+	events.clear();
+	TraceProfiler::get_events(events);
+	CHECK(events[Thread::get_caller_id()].is_empty());
+
+	TraceProfiler::finish();
+}
+
+TEST_CASE("[TraceProfiler] Worker threads and Chrome trace export") {
+	TraceProfiler::start();
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(&zone_task, nullptr, 64, -1, true);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+	TraceProfiler::stop();
+
+	HashMap<Thread::ID, LocalVector<TraceProfiler::Event>> events;
+	TraceProfiler::get_events(events);
+	CHECK(count_events(events, "TestTraceProfiler::task") == 64);
+
+	const String path = TestUtils::get_temp_path("trace_profiler.json");
+	REQUIRE(TraceProfiler::save_chrome_trace(path) == OK);
+	const Variant trace = JSON::parse_string(FileAccess::get_file_as_string(path));
+	REQUIRE(trace.get_type() == Variant::DICTIONARY);
+
+	const Array trace_events = Dictionary(trace)["traceEvents"];
+	uint32_t task_events = 0;
+	uint32_t thread_names = 0;
+	for (int i = 0; i < trace_events.size(); i++) {
+		const Dictionary event = trace_events[i];
+		if (event["ph"] == "M") {
+			thread_names++;
+		} else if (event["name"] == "TestTraceProfiler::task") {
+			CHECK(event["ph"] == "X");
+			CHECK(double(event["dur"]) >= 10);
+			task_events++;
+		}
+	}
+	CHECK(task_events == 64);
+	CHECK(thread_names == events.size());
+
+	TraceProfiler::finish();
+}
+
+} // namespace TestTraceProfiler
+
+#endif // TEST_TRACE_PROFILER_H
@@ -38,6 +38,7 @@
 
 #include "thirdparty/doctest/doctest.h"
 
+#include "tests/test_benchmark.h"
 #include "tests/test_macros.h"
 
 namespace TestResource {
@@ -166,6 +167,31 @@ TEST_CASE("[Resource] Breaking circular references on save") {
 	// Break circular reference to avoid memory leak
 	resource_c->remove_meta("next");
 }
+
+TEST_CASE("[Resource][Benchmark] Saving and loading" * doctest::skip()) {
+	Ref<Resource> resource = memnew(Resource);
+	PackedVector3Array points;
+	for (int i = 0; i < 10000; i++) {
+		points.push_back(Vector3(i, i * 2, i * 3));
+	}
+	resource->set_meta("points", points);
+	Dictionary dictionary;
+	for (int i = 0; i < 1000; i++) {
+		dictionary[itos(i)] = i;
+	}
+	resource->set_meta("dictionary", dictionary);
+
+	for (const String extension : { "res", "tres" }) {
+		const String path = TestUtils::get_temp_path("benchmark_resource." + extension);
+		TestBenchmark::measure("Resource/save_" + extension, 1, [&]() {
+			CHECK(ResourceSaver::save(resource, path) == OK);
+		});
+		TestBenchmark::measure("Resource/load_" + extension, 1, [&]() {
+			const Ref<Resource> loaded = ResourceLoader::load(path, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+			CHECK(loaded.is_valid());
+		});
+	}
+}
 } // namespace TestResource
 
 #endif // TEST_RESOURCE_H
@@ -0,0 +1,352 @@
+/**************************************************************************/
+/*  test_batch_math.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_BATCH_MATH_H
+#define TEST_BATCH_MATH_H
+
+#include "core/math/batch_math.h"
+#include "core/math/random_pcg.h"
+#include "core/templates/local_vector.h"
+#include "core/variant/variant.h"
+
+#include "tests/test_benchmark.h"
+#include "tests/test_macros.h"
+
+namespace TestBatchMath {
+
+static real_t random_real(RandomPCG &p_rng) {
+	return p_rng.randf() * 4.0 - 2.0;
+}
+
+static Vector3 random_vector3(RandomPCG &p_rng) {
+	return Vector3(random_real(p_rng), random_real(p_rng), random_real(p_rng));
+}
+
+static Transform3D random_transform(RandomPCG &p_rng) {
+	return Transform3D(Basis(random_vector3(p_rng), random_vector3(p_rng), random_vector3(p_rng)), random_vector3(p_rng));
+}
+
+// Every SIMD level the CPU supports, the scalar one included.
+static LocalVector<BatchMath::SIMDLevel> get_simd_levels() {
+	LocalVector<BatchMath::SIMDLevel> levels;
+	for (int level = BatchMath::SIMD_NONE; level <= BatchMath::SIMD_NEON; level++) {
+		if (BatchMath::is_simd_level_supported((BatchMath::SIMDLevel)level)) {
+			levels.push_back((BatchMath::SIMDLevel)level);
+		}
+	}
+	return levels;
+}
+
+// Odd count, so the SIMD kernels also have leftover elements to handle.
+static const uint32_t ELEMENT_COUNT = 37;
+
+TEST_CASE("[BatchMath] Transform points") {
+	RandomPCG rng(1234);
+	const Transform3D xform = random_transform(rng);
+	LocalVector<Vector3> points;
+	for (uint32_t i = 0; i < ELEMENT_COUNT; i++) {
+		points.push_back(random_vector3(rng));
+	}
+
+	for (BatchMath::SIMDLevel level : get_simd_levels()) {
+		BatchMath::set_simd_level(level);
+		LocalVector<Vector3> result;
+		result.resize(ELEMENT_COUNT);
+		BatchMath::xform_points(xform, points.ptr(), result.ptr(), ELEMENT_COUNT);
+
+		// Not compared exactly, the compiler may contract the scalar code into fused multiply-adds.
+		bool matches = true;
+		for (uint32_t i = 0; i < ELEMENT_COUNT; i++) {
+			matches &= result[i].is_equal_approx(xform.xform(points[i]));
+		}
+		CHECK_MESSAGE(matches, "Points should match Transform3D::xform() at SIMD level ", (int)level, ".");
+
+		// In place.
+		result = points;
+		BatchMath::xform_points(xform, result.ptr(), result.ptr(), ELEMENT_COUNT);
+		CHECK(result[ELEMENT_COUNT - 1].is_equal_approx(xform.xform(points[ELEMENT_COUNT - 1])));
+	}
+	BatchMath::set_simd_level(BatchMath::get_supported_simd_level());
+
+	Vector<Vector3> packed;
+	packed.push_back(Vector3(1, 2, 3));
+	CHECK(xform.xform(packed)[0].is_equal_approx(xform.xform(Vector3(1, 2, 3))));
+}
+
+TEST_CASE("[BatchMath] Transform and compose transforms") {
+	RandomPCG rng(4321);
+	const Transform3D xform = random_transform(rng);
+	LocalVector<Transform3D> a;
+	LocalVector<Transform3D> b;
+	for (uint32_t i = 0; i < ELEMENT_COUNT; i++) {
+		a.push_back(random_transform(rng));
+		b.push_back(random_transform(rng));
+	}
+
+	for (BatchMath::SIMDLevel level : get_simd_levels()) {
+		BatchMath::set_simd_level(level);
+		LocalVector<Transform3D> result;
+		result.resize(ELEMENT_COUNT);
+
+		BatchMath::xform_transforms(xform, b.ptr(), result.ptr(), ELEMENT_COUNT);
+		bool matches = true;
+		for (uint32_t i = 0; i < ELEMENT_COUNT; i++) {
+			matches &= result[i].is_equal_approx(xform * b[i]);
+		}
+		CHECK_MESSAGE(matches, "Transforms should match Transform3D::operator*() at SIMD level ", (int)level, ".");
+
+		BatchMath::compose_transforms(a.ptr(), b.ptr(), result.ptr(), ELEMENT_COUNT);
+		matches = true;
+		for (uint32_t i = 0; i < ELEMENT_COUNT; i++) {
+			matches &= result[i].is_equal_approx(a[i] * b[i]);
+		}
+		CHECK_MESSAGE(matches, "Composed transforms should match Transform3D::operator*() at SIMD level ", (int)level, ".");
+	}
+	BatchMath::set_simd_level(BatchMath::get_supported_simd_level());
+}
+
+TEST_CASE("[BatchMath] Transform MultiMesh-style buffers") {
+	RandomPCG rng(5678);
+	const Transform3D xform = random_transform(rng);
+	const uint32_t stride = 16; // Transform and color.
+	LocalVector<float> buffer;
+	for (uint32_t i = 0; i < ELEMENT_COUNT * stride; i++) {
+		buffer.push_back(random_real(rng));
+	}
+
+	for (BatchMath::SIMDLevel level : get_simd_levels()) {
+		BatchMath::set_simd_level(level);
+		LocalVector<float> result = buffer;
+		BatchMath::xform_transforms_3x4(xform, buffer.ptr(), result.ptr(), ELEMENT_COUNT, stride);
+
+		bool matches = true;
+		for (uint32_t i = 0; i < ELEMENT_COUNT; i++) {
+			const float *s = buffer.ptr() + i * stride;
+			const float *r = result.ptr() + i * stride;
+			const Transform3D expected = xform * Transform3D(s[0], s[1], s[2], s[4], s[5], s[6], s[8], s[9], s[10], s[3], s[7], s[11]);
+			const Transform3D got = Transform3D(r[0], r[1], r[2], r[4], r[5], r[6], r[8], r[9], r[10], r[3], r[7], r[11]);
+			matches &= got.is_equal_approx(expected);
+			for (uint32_t j = 12; j < stride; j++) {
+				matches &= r[j] == s[j];
+			}
+		}
+		CHECK_MESSAGE(matches, "Buffer transforms should match Transform3D::operator*() at SIMD level ", (int)level, ".");
+	}
+	BatchMath::set_simd_level(BatchMath::get_supported_simd_level());
+}
+
+TEST_CASE("[BatchMath] Transform AABBs") {
+	RandomPCG rng(8765);
+	const Transform3D xform = random_transform(rng);
+	LocalVector<AABB> aabbs;
+	for (uint32_t i = 0; i < ELEMENT_COUNT; i++) {
+		aabbs.push_back(AABB(random_vector3(rng), random_vector3(rng).abs()));
+	}
+
+	for (BatchMath::SIMDLevel level : get_simd_levels()) {
+		BatchMath::set_simd_level(level);
+		LocalVector<AABB> result;
+		result.resize(ELEMENT_COUNT);
+		BatchMath::xform_aabbs(xform, aabbs.ptr(), result.ptr(), ELEMENT_COUNT);
+
+		bool matches = true;
+		for (uint32_t i = 0; i < ELEMENT_COUNT; i++) {
+			matches &= result[i].is_equal_approx(xform.xform(aabbs[i]));
+		}
+		CHECK_MESSAGE(matches, "AABBs should match Transform3D::xform() at SIMD level ", (int)level, ".");
+	}
+	BatchMath::set_simd_level(BatchMath::get_supported_simd_level());
+}
+
+TEST_CASE("[BatchMath] Element-wise math on float arrays") {
+	RandomPCG rng(2468);
+	LocalVector<float> a;
+	LocalVector<float> b;
+	for (uint32_t i = 0; i < ELEMENT_COUNT; i++) {
+		a.push_back(random_real(rng));
+		b.push_back(random_real(rng));
+	}
+
+	double expected_sum = 0;
+	double expected_dot = 0;
+	float expected_min = a[0];
+	float expected_max = a[0];
+	for (uint32_t i = 0; i < ELEMENT_COUNT; i++) {
+		expected_sum += a[i];
+		expected_dot += a[i] * b[i];
+		expected_min = MIN(expected_min, a[i]);
+		expected_max = MAX(expected_max, a[i]);
+	}
+
+	for (BatchMath::SIMDLevel level : get_simd_levels()) {
+		BatchMath::set_simd_level(level);
+		LocalVector<float> result;
+		result.resize(ELEMENT_COUNT);
+
+		BatchMath::add(a.ptr(), b.ptr(), result.ptr(), ELEMENT_COUNT);
+		bool matches = true;
+		for (uint32_t i = 0; i < ELEMENT_COUNT; i++) {
+			matches &= Math::is_equal_approx(result[i], a[i] + b[i]);
+		}
+		CHECK_MESSAGE(matches, "Sums should match at SIMD level ", (int)level, ".");
+
+		BatchMath::multiply(a.ptr(), b.ptr(), result.ptr(), ELEMENT_COUNT);
+		matches = true;
+		for (uint32_t i = 0; i < ELEMENT_COUNT; i++) {
+			matches &= Math::is_equal_approx(result[i], a[i] * b[i]);
+		}
+		CHECK_MESSAGE(matches, "Products should match at SIMD level ", (int)level, ".");
+
+		BatchMath::scale_offset(a.ptr(), 3.0f, -0.5f, result.ptr(), ELEMENT_COUNT);
+		matches = true;
+		for (uint32_t i = 0; i < ELEMENT_COUNT; i++) {
+			matches &= Math::is_equal_approx(result[i], a[i] * 3.0f - 0.5f);
+		}
+		CHECK_MESSAGE(matches, "Scaled values should match at SIMD level ", (int)level, ".");
+
+		BatchMath::lerp(a.ptr(), b.ptr(), 0.25f, result.ptr(), ELEMENT_COUNT);
+		matches = true;
+		for (uint32_t i = 0; i < ELEMENT_COUNT; i++) {
+			matches &= Math::is_equal_approx(result[i], Math::lerp(a[i], b[i], 0.25f));
+		}
+		CHECK_MESSAGE(matches, "Interpolated values should match Math::lerp() at SIMD level ", (int)level, ".");
+
+		BatchMath::clamp(a.ptr(), -0.5f, 1.0f, result.ptr(), ELEMENT_COUNT);
+		matches = true;
+		for (uint32_t i = 0; i < ELEMENT_COUNT; i++) {
+			matches &= result[i] == CLAMP(a[i], -0.5f, 1.0f);
+		}
+		CHECK_MESSAGE(matches, "Clamped values should match CLAMP() at SIMD level ", (int)level, ".");
+
+		BatchMath::fill_range(2.0f, 0.5f, result.ptr(), ELEMENT_COUNT);
+		matches = true;
+		for (uint32_t i = 0; i < ELEMENT_COUNT; i++) {
+			matches &= Math::is_equal_approx(result[i], 2.0f + i * 0.5f);
+		}
+		CHECK_MESSAGE(matches, "Ranges should match at SIMD level ", (int)level, ".");
+
+		// In place.
+		result = a;
+		BatchMath::add(result.ptr(), b.ptr(), result.ptr(), ELEMENT_COUNT);
+		CHECK(Math::is_equal_approx(result[ELEMENT_COUNT - 1], a[ELEMENT_COUNT - 1] + b[ELEMENT_COUNT - 1]));
+
+		CHECK(BatchMath::sum(a.ptr(), ELEMENT_COUNT) == doctest::Approx(expected_sum).epsilon(0.0001));
+		CHECK(BatchMath::dot(a.ptr(), b.ptr(), ELEMENT_COUNT) == doctest::Approx(expected_dot).epsilon(0.0001));
+		CHECK(BatchMath::min(a.ptr(), ELEMENT_COUNT) == expected_min);
+		CHECK(BatchMath::max(a.ptr(), ELEMENT_COUNT) == expected_max);
+		CHECK(BatchMath::min(a.ptr(), 0) == 0.0f);
+		CHECK(BatchMath::sum(a.ptr(), 3) == doctest::Approx(a[0] + a[1] + a[2]));
+
+		// Summed in float, the ones would be lost next to 2^24.
+		LocalVector<float> large_and_ones;
+		large_and_ones.resize(1001);
+		large_and_ones[0] = 16777216.0f;
+		for (uint32_t i = 1; i < large_and_ones.size(); i++) {
+			large_and_ones[i] = 1.0f;
+		}
+		CHECK(BatchMath::sum(large_and_ones.ptr(), large_and_ones.size()) == 16777216.0 + 1000.0);
+		CHECK(BatchMath::dot(large_and_ones.ptr(), large_and_ones.ptr(), large_and_ones.size()) == 16777216.0 * 16777216.0 + 1000.0);
+	}
+	BatchMath::set_simd_level(BatchMath::get_supported_simd_level());
+
+	double d[3] = { 1.0, -2.0, 4.0 };
+	BatchMath::scale_offset(d, 2.0, 1.0, d, 3);
+	CHECK(d[1] == -3.0);
+	CHECK(BatchMath::sum(d, 3) == 9.0);
+	CHECK(BatchMath::max(d, 3) == 9.0);
+}
+
+TEST_CASE("[BatchMath] PackedVector3Array.transform() matches transforming each point") {
+	RandomPCG rng(1357);
+	const Transform3D xform = random_transform(rng);
+	PackedVector3Array points;
+	for (uint32_t i = 0; i < ELEMENT_COUNT; i++) {
+		points.push_back(random_vector3(rng));
+	}
+
+	for (BatchMath::SIMDLevel level : get_simd_levels()) {
+		BatchMath::set_simd_level(level);
+		Variant array = points.duplicate();
+		const Variant arg = xform;
+		const Variant *args[1] = { &arg };
+		Variant ret;
+		Callable::CallError ce;
+		array.callp("transform", args, 1, ret, ce);
+		REQUIRE(ce.error == Callable::CallError::CALL_OK);
+
+		const PackedVector3Array result = array;
+		bool matches = true;
+		for (uint32_t i = 0; i < ELEMENT_COUNT; i++) {
+			matches &= result[i].is_equal_approx(xform.xform(points[i]));
+		}
+		CHECK_MESSAGE(matches, "Points should match Transform3D::xform() at SIMD level ", (int)level, ".");
+	}
+	BatchMath::set_simd_level(BatchMath::get_supported_simd_level());
+}
+
+TEST_CASE("[BatchMath][Benchmark] Batch kernels compared to scalar loops" * doctest::skip()) {
+	const uint32_t count = 1 << 20;
+	const int passes = 20;
+
+	RandomPCG rng(1234);
+	const Transform3D xform = random_transform(rng);
+	LocalVector<Vector3> points;
+	LocalVector<Transform3D> transforms;
+	LocalVector<AABB> aabbs;
+	for (uint32_t i = 0; i < count; i++) {
+		points.push_back(random_vector3(rng));
+		transforms.push_back(random_transform(rng));
+		aabbs.push_back(AABB(random_vector3(rng), random_vector3(rng).abs()));
+	}
+	LocalVector<Vector3> points_out;
+	points_out.resize(count);
+	LocalVector<Transform3D> transforms_out;
+	transforms_out.resize(count);
+	LocalVector<AABB> aabbs_out;
+	aabbs_out.resize(count);
+
+	for (BatchMath::SIMDLevel level : get_simd_levels()) {
+		BatchMath::set_simd_level(level);
+		TestBenchmark::measure(vformat("BatchMath/xform_points_1m/simd_%d", (int)level), passes, [&]() {
+			BatchMath::xform_points(xform, points.ptr(), points_out.ptr(), count);
+		});
+		TestBenchmark::measure(vformat("BatchMath/xform_transforms_1m/simd_%d", (int)level), passes, [&]() {
+			BatchMath::xform_transforms(xform, transforms.ptr(), transforms_out.ptr(), count);
+		});
+		TestBenchmark::measure(vformat("BatchMath/xform_aabbs_1m/simd_%d", (int)level), passes, [&]() {
+			BatchMath::xform_aabbs(xform, aabbs.ptr(), aabbs_out.ptr(), count);
+		});
+	}
+	BatchMath::set_simd_level(BatchMath::get_supported_simd_level());
+}
+
+} // namespace TestBatchMath
+
+#endif // TEST_BATCH_MATH_H
@@ -0,0 +1,153 @@
+/**************************************************************************/
+/*  test_bvh.h                                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_BVH_H
+#define TEST_BVH_H
+
+#include "core/math/bvh.h"
+#include "core/math/random_pcg.h"
+
+#include "tests/test_macros.h"
+
+namespace TestBVH {
+
+struct Item {
+	uint32_t index = 0;
+};
+
+template <typename T>
+class PairTestFunction {
+public:
+	static bool user_pair_check(const T *p_a, const T *p_b) {
+		return true;
+	}
+};
+
+template <typename T>
+class CullTestFunction {
+public:
+	static bool user_cull_check(const T *p_a, const T *p_b) {
+		return true;
+	}
+};
+
+typedef BVH_Manager<Item, 1, true, 32, PairTestFunction<Item>, CullTestFunction<Item>> PairingBVH;
+
+struct PairEvent {
+	bool paired = false;
+	uint32_t a = 0;
+	uint32_t b = 0;
+
+	bool operator==(const PairEvent &p_other) const {
+		return paired == p_other.paired && a == p_other.a && b == p_other.b;
+	}
+};
+
+static void *pair_callback(void *p_self, uint32_t p_id_a, Item *p_a, int p_subindex_a, uint32_t p_id_b, Item *p_b, int p_subindex_b) {
+	LocalVector<PairEvent> *events = (LocalVector<PairEvent> *)p_self;
+	events->push_back({ true, p_a->index, p_b->index });
+	return nullptr;
+}
+
+static void unpair_callback(void *p_self, uint32_t p_id_a, Item *p_a, int p_subindex_a, uint32_t p_id_b, Item *p_b, int p_subindex_b, void *p_pair_data) {
+	LocalVector<PairEvent> *events = (LocalVector<PairEvent> *)p_self;
+	events->push_back({ false, p_a->index, p_b->index });
+}
+
+static AABB random_aabb(RandomPCG &p_rng) {
+	const Vector3 position = Vector3(p_rng.randf(), p_rng.randf(), p_rng.randf()) * 40.0;
+	return AABB(position, Vector3(1, 1, 1) + Vector3(p_rng.randf(), p_rng.randf(), p_rng.randf()) * 2.0);
+}
+
+TEST_CASE("[BVH] Parallel pairing sends the same callbacks as serial pairing") {
+	const uint32_t item_count = 500;
+	LocalVector<Item> items;
+	items.resize(item_count);
+
+	LocalVector<PairEvent> serial_events;
+	LocalVector<PairEvent> parallel_events;
+	PairingBVH serial;
+	PairingBVH parallel;
+	serial.set_pair_callback(pair_callback, &serial_events);
+	serial.set_unpair_callback(unpair_callback, &serial_events);
+	parallel.set_pair_callback(pair_callback, &parallel_events);
+	parallel.set_unpair_callback(unpair_callback, &parallel_events);
+	parallel.params_set_parallel_pairing(true);
+
+	RandomPCG rng(1234);
+	LocalVector<AABB> aabbs;
+	LocalVector<BVHHandle> serial_handles;
+	LocalVector<BVHHandle> parallel_handles;
+	for (uint32_t i = 0; i < item_count; i++) {
+		items[i].index = i;
+		aabbs.push_back(random_aabb(rng));
+		serial_handles.push_back(serial.create(&items[i], true, 0, 1, aabbs[i]));
+		parallel_handles.push_back(parallel.create(&items[i], true, 0, 1, aabbs[i]));
+	}
+
+	bool pairs_changed = true;
+	for (int frame = 0; frame < 30; frame++) {
+		// Some items jump anywhere, the others drift, so the stale expanded aabbs of
+		// items moved earlier in the update can pair and unpair items moved later.
+		for (uint32_t i = 0; i < item_count; i++) {
+			const float choice = rng.randf();
+			if (choice < 0.1) {
+				aabbs[i] = random_aabb(rng);
+			} else if (choice < 0.6) {
+				aabbs[i].position += Vector3(rng.randf() - 0.5, rng.randf() - 0.5, rng.randf() - 0.5) * 2.0;
+			} else {
+				continue;
+			}
+			serial.move(serial_handles[i], aabbs[i]);
+			parallel.move(parallel_handles[i], aabbs[i]);
+		}
+
+		serial_events.clear();
+		parallel_events.clear();
+		serial.update();
+		parallel.update();
+
+		pairs_changed = pairs_changed && !serial_events.is_empty();
+		REQUIRE_MESSAGE(parallel_events.size() == serial_events.size(), "Frame ", frame);
+		for (uint32_t i = 0; i < serial_events.size(); i++) {
+			REQUIRE_MESSAGE(parallel_events[i] == serial_events[i], "Frame ", frame, ", event ", i);
+		}
+	}
+	CHECK_MESSAGE(pairs_changed, "Every frame should change some pairs.");
+
+	for (uint32_t i = 0; i < item_count; i++) {
+		serial.erase(serial_handles[i]);
+		parallel.erase(parallel_handles[i]);
+	}
+}
+
+} // namespace TestBVH
+
+#endif // TEST_BVH_H
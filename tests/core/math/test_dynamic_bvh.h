@@ -0,0 +1,117 @@
+/**************************************************************************/
+/*  test_dynamic_bvh.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_DYNAMIC_BVH_H
+#define TEST_DYNAMIC_BVH_H
+
+#include "core/math/dynamic_bvh.h"
+#include "core/math/projection.h"
+#include "core/math/random_pcg.h"
+
+#include "tests/test_benchmark.h"
+#include "tests/test_macros.h"
+
+namespace TestDynamicBVH {
+
+struct CountQueryResult {
+	uint32_t count = 0;
+
+	bool operator()(void *p_data) {
+		count++;
+		return false;
+	}
+};
+
+static LocalVector<AABB> random_aabbs(uint32_t p_count, float p_extent) {
+	RandomPCG rng(1234);
+	LocalVector<AABB> aabbs;
+	for (uint32_t i = 0; i < p_count; i++) {
+		const Vector3 position = Vector3(rng.randf(), rng.randf(), rng.randf()) * p_extent * 2.0 - Vector3(p_extent, p_extent, p_extent);
+		aabbs.push_back(AABB(position, Vector3(1, 1, 1) + Vector3(rng.randf(), rng.randf(), rng.randf()) * 3.0));
+	}
+	return aabbs;
+}
+
+// The convex hull of a camera frustum, as the renderer culls with.
+static void get_frustum(const Transform3D &p_camera, Vector<Plane> &r_planes, Vector3 *r_points) {
+	Projection projection;
+	projection.set_perspective(75.0, 16.0 / 9.0, 0.05, 100.0);
+	r_planes = projection.get_projection_planes(p_camera);
+	projection.get_endpoints(p_camera, r_points);
+}
+
+TEST_CASE("[DynamicBVH] Frustum queries match a brute force search") {
+	const LocalVector<AABB> aabbs = random_aabbs(2000, 100.0);
+	DynamicBVH bvh;
+	for (uint32_t i = 0; i < aabbs.size(); i++) {
+		bvh.insert(aabbs[i], (void *)(uintptr_t)(i + 1));
+	}
+	CHECK(bvh.get_leaf_count() == 2000);
+
+	Vector<Plane> planes;
+	Vector3 points[8];
+	get_frustum(Transform3D(Basis(Vector3(0, 1, 0), 0.5), Vector3(0, 0, 10)), planes, points);
+	AABB bounds(points[0], Vector3());
+	for (int i = 1; i < 8; i++) {
+		bounds.expand_to(points[i]);
+	}
+
+	uint32_t expected = 0;
+	for (const AABB &aabb : aabbs) {
+		expected += aabb.intersects(bounds) && aabb.intersects_convex_shape(planes.ptr(), planes.size(), points, 8);
+	}
+
+	CountQueryResult result;
+	bvh.convex_query(planes.ptr(), planes.size(), points, 8, result);
+	CHECK(expected > 0);
+	CHECK(result.count == expected);
+}
+
+TEST_CASE("[DynamicBVH][Benchmark] Frustum culling" * doctest::skip()) {
+	const LocalVector<AABB> aabbs = random_aabbs(100000, 500.0);
+	DynamicBVH bvh;
+	for (uint32_t i = 0; i < aabbs.size(); i++) {
+		bvh.insert(aabbs[i], (void *)(uintptr_t)(i + 1));
+	}
+
+	Vector<Plane> planes;
+	Vector3 points[8];
+	uint32_t frame = 0;
+	TestBenchmark::measure("DynamicBVH/frustum_cull_100k", 100, [&]() {
+		// A camera turning around, so each query sees a different part of the tree.
+		get_frustum(Transform3D(Basis(Vector3(0, 1, 0), frame++ * 0.05), Vector3()), planes, points);
+		CountQueryResult result;
+		bvh.convex_query(planes.ptr(), planes.size(), points, 8, result);
+	});
+}
+
+} // namespace TestDynamicBVH
+
+#endif // TEST_DYNAMIC_BVH_H
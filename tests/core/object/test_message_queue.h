@@ -0,0 +1,268 @@
+/**************************************************************************/
+/*  test_message_queue.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_MESSAGE_QUEUE_H
+#define TEST_MESSAGE_QUEUE_H
+
+#include "core/object/message_queue.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/os/thread.h"
+
+#include "tests/test_macros.h"
+
+namespace TestMessageQueue {
+
+class MessageRecorder : public Object {
+public:
+	LocalVector<Vector2i> received;
+
+	void record(int p_sender, int p_sequence) {
+		received.push_back(Vector2i(p_sender, p_sequence));
+	}
+};
+
+struct MessageSender {
+	static const int MESSAGES_PER_SENDER = 200;
+
+	MessageRecorder *recorder = nullptr;
+
+	void send(uint32_t p_sender, void *p_userdata) {
+		for (int i = 0; i < MESSAGES_PER_SENDER; i++) {
+			MessageQueue::get_singleton()->push_callable(callable_mp(recorder, &MessageRecorder::record), p_sender, i);
+		}
+	}
+};
+
+TEST_CASE("[MessageQueue] Messages pushed from threads are all flushed, in order") {
+	CallQueue *message_queue = memnew(MessageQueue);
+	MessageRecorder *recorder = memnew(MessageRecorder);
+	uint64_t messages = 0;
+	uint64_t bytes = 0;
+	uint64_t flush_usec = 0;
+	MessageQueue::take_statistics(messages, bytes, flush_usec);
+
+	const uint32_t sender_count = 64;
+	MessageSender sender;
+	sender.recorder = recorder;
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_template_group_task(&sender, &MessageSender::send, nullptr, sender_count);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+
+	message_queue->push_callable(callable_mp(recorder, &MessageRecorder::record), -1, 0);
+	CHECK(message_queue->flush() == OK);
+
+	const uint32_t total = sender_count * MessageSender::MESSAGES_PER_SENDER + 1;
+	CHECK(recorder->received.size() == total);
+
+	LocalVector<int> next_sequence;
+	next_sequence.resize(sender_count);
+	for (uint32_t i = 0; i < sender_count; i++) {
+		next_sequence[i] = 0;
+	}
+	bool in_order = true;
+	for (const Vector2i &message : recorder->received) {
+		if (message.x < 0) {
+			continue;
+		}
+		in_order &= message.y == next_sequence[message.x];
+		next_sequence[message.x]++;
+	}
+	CHECK_MESSAGE(in_order, "Each sender's messages should run in the order they were pushed.");
+
+	MessageQueue::take_statistics(messages, bytes, flush_usec);
+	CHECK(messages == total);
+	CHECK(bytes > messages * sizeof(Variant) * 2);
+	MessageQueue::take_statistics(messages, bytes, flush_usec);
+	CHECK(messages == 0);
+	CHECK(bytes == 0);
+
+	memdelete(recorder);
+	memdelete(message_queue);
+}
+
+TEST_CASE("[MessageQueue] Flushing while threads push") {
+	CallQueue *message_queue = memnew(MessageQueue);
+	MessageRecorder *recorder = memnew(MessageRecorder);
+	MessageSender sender;
+	sender.recorder = recorder;
+
+	const uint32_t sender_count = 256;
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_template_group_task(&sender, &MessageSender::send, nullptr, sender_count);
+	while (!WorkerThreadPool::get_singleton()->is_group_task_completed(group)) {
+		message_queue->flush();
+	}
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+	message_queue->flush();
+
+	CHECK(recorder->received.size() == sender_count * MessageSender::MESSAGES_PER_SENDER);
+
+	memdelete(recorder);
+	memdelete(message_queue);
+}
+
+static void _send_from_task(void *p_userdata) {
+	MessageSender *sender = (MessageSender *)p_userdata;
+	sender->send(0, nullptr);
+}
+
+class FlushingSender : public Object {
+public:
+	MessageSender *sender = nullptr;
+
+	void send_and_wait() {
+		WorkerThreadPool::TaskID task = WorkerThreadPool::get_singleton()->add_native_task(_send_from_task, sender);
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(task);
+	}
+};
+
+TEST_CASE("[MessageQueue] Messages pushed from threads while flushing run in the same flush") {
+	CallQueue *message_queue = memnew(MessageQueue);
+	MessageRecorder *recorder = memnew(MessageRecorder);
+	MessageSender sender;
+	sender.recorder = recorder;
+
+	WorkerThreadPool::TaskID task = WorkerThreadPool::get_singleton()->add_native_task(_send_from_task, &sender);
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(task);
+	CHECK_MESSAGE(message_queue->has_messages(), "Messages waiting to be merged should count.");
+	CHECK(message_queue->flush() == OK);
+	CHECK_FALSE(message_queue->has_messages());
+	CHECK(recorder->received.size() == uint32_t(MessageSender::MESSAGES_PER_SENDER));
+
+	FlushingSender flushing_sender;
+	flushing_sender.sender = &sender;
+	message_queue->push_callable(callable_mp(&flushing_sender, &FlushingSender::send_and_wait));
+	CHECK(message_queue->flush() == OK);
+	CHECK(recorder->received.size() == uint32_t(2 * MessageSender::MESSAGES_PER_SENDER));
+
+	memdelete(recorder);
+	memdelete(message_queue);
+}
+
+static void _send_and_exit(void *p_userdata) {
+	MessageSender *sender = (MessageSender *)p_userdata;
+	sender->send(0, nullptr);
+}
+
+TEST_CASE("[MessageQueue] Messages from threads that exited are flushed") {
+	CallQueue *message_queue = memnew(MessageQueue);
+	MessageRecorder *recorder = memnew(MessageRecorder);
+	MessageSender sender;
+	sender.recorder = recorder;
+
+	for (int i = 0; i < 3; i++) {
+		Thread thread;
+		thread.start(_send_and_exit, &sender);
+		thread.wait_to_finish();
+		CHECK(message_queue->flush() == OK);
+		CHECK(recorder->received.size() == uint32_t((i + 1) * MessageSender::MESSAGES_PER_SENDER));
+	}
+
+	// Pending messages are freed along with the queue.
+	Thread thread;
+	thread.start(_send_and_exit, &sender);
+	thread.wait_to_finish();
+
+	memdelete(message_queue);
+	memdelete(recorder);
+}
+
+// Pushes from its destructor, which runs during thread exit, after the
+// thread's own submission queues are gone.
+struct ExitPusher {
+	MessageSender *sender = nullptr;
+
+	~ExitPusher() {
+		if (sender) {
+			sender->send(1, nullptr);
+		}
+	}
+};
+
+static void _send_on_exit(void *p_userdata) {
+	// Constructed before the first push sets up the submission queues, so
+	// destroyed after them.
+	static thread_local ExitPusher exit_pusher;
+	exit_pusher.sender = (MessageSender *)p_userdata;
+	exit_pusher.sender->send(0, nullptr);
+}
+
+TEST_CASE("[MessageQueue] Messages pushed while threads exit are flushed") {
+	CallQueue *message_queue = memnew(MessageQueue);
+	MessageRecorder *recorder = memnew(MessageRecorder);
+	MessageSender sender;
+	sender.recorder = recorder;
+
+	Thread thread;
+	thread.start(_send_on_exit, &sender);
+	thread.wait_to_finish();
+	CHECK(message_queue->flush() == OK);
+	CHECK(message_queue->flush() == OK);
+	CHECK(recorder->received.size() == uint32_t(2 * MessageSender::MESSAGES_PER_SENDER));
+
+	memdelete(message_queue);
+	memdelete(recorder);
+}
+
+TEST_CASE("[MessageQueue] Transferring messages to another queue") {
+	MessageRecorder *recorder = memnew(MessageRecorder);
+	CallQueue *source = memnew(CallQueue);
+	CallQueue *target = memnew(CallQueue);
+	CallQueue *small_target = memnew(CallQueue(nullptr, 2));
+
+	const int count = 200; // Several pages worth.
+	for (int i = 0; i < count; i++) {
+		source->push_callable(callable_mp(recorder, &MessageRecorder::record), 0, i);
+	}
+
+	// Nothing is moved, or lost, when the target can't take all the messages.
+	CHECK(source->transfer_to(small_target) == ERR_OUT_OF_MEMORY);
+	CHECK_FALSE(small_target->has_messages());
+	CHECK(source->has_messages());
+
+	target->push_callable(callable_mp(recorder, &MessageRecorder::record), 1, 0);
+	CHECK(source->transfer_to(target) == OK);
+	CHECK_FALSE(source->has_messages());
+	CHECK(target->flush() == OK);
+
+	REQUIRE(recorder->received.size() == uint32_t(count + 1));
+	bool in_order = recorder->received[0] == Vector2i(1, 0);
+	for (int i = 0; i < count; i++) {
+		in_order &= recorder->received[i + 1] == Vector2i(0, i);
+	}
+	CHECK_MESSAGE(in_order, "Transferred messages should run after the target's own, in order.");
+
+	memdelete(small_target);
+	memdelete(target);
+	memdelete(source);
+	memdelete(recorder);
+}
+
+} // namespace TestMessageQueue
+
+#endif // TEST_MESSAGE_QUEUE_H
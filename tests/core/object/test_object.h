@@ -35,6 +35,7 @@
 #include "core/object/object.h"
 #include "core/object/script_language.h"
 
+#include "tests/test_benchmark.h"
 #include "tests/test_macros.h"
 
 // Declared in global namespace because of GDCLASS macro warning (Windows):
@@ -57,6 +58,48 @@ public:
 	int get_property() const { return property_value; }
 };
 
+// Handles some calls itself, like a script calling its static functions.
+class _TestCallpObject : public _TestDerivedObject {
+	GDCLASS(_TestCallpObject, _TestDerivedObject);
+
+public:
+	virtual Variant callp(const StringName &p_method, const Variant **p_args, int p_argcount, Callable::CallError &r_error) override {
+		if (p_method == SNAME("set_property") && p_argcount == 1) {
+			r_error.error = Callable::CallError::CALL_OK;
+			set_property(int(*p_args[0]) * 10);
+			return Variant();
+		}
+		return _TestDerivedObject::callp(p_method, p_args, p_argcount, r_error);
+	}
+};
+
+// Binds its methods in no particular order, to check they are listed in the same order.
+class _TestMethodOrderObject : public Object {
+	GDCLASS(_TestMethodOrderObject, Object);
+
+protected:
+	static void _bind_methods() {
+		ClassDB::bind_method(D_METHOD("update"), &_TestMethodOrderObject::update);
+		ClassDB::bind_method(D_METHOD("clear"), &_TestMethodOrderObject::clear);
+		ClassDB::bind_method(D_METHOD("start"), &_TestMethodOrderObject::start);
+		ClassDB::bind_method(D_METHOD("add"), &_TestMethodOrderObject::add);
+		ClassDB::bind_method(D_METHOD("stop"), &_TestMethodOrderObject::stop);
+		ClassDB::bind_method(D_METHOD("reset"), &_TestMethodOrderObject::reset);
+		ClassDB::bind_method(D_METHOD("pause"), &_TestMethodOrderObject::pause);
+		ClassDB::bind_method(D_METHOD("finish"), &_TestMethodOrderObject::finish);
+	}
+
+public:
+	void update() {}
+	void clear() {}
+	void start() {}
+	void add() {}
+	void stop() {}
+	void reset() {}
+	void pause() {}
+	void finish() {}
+};
+
 namespace TestObject {
 
 class _MockScriptInstance : public ScriptInstance {
@@ -145,6 +188,18 @@ TEST_CASE("[Object] Core getters") {
 			"The inheritance list should consist of Object only");
 }
 
+TEST_CASE("[Object] Methods are listed in the order they were bound") {
+	GDREGISTER_CLASS(_TestMethodOrderObject);
+
+	List<MethodInfo> methods;
+	ClassDB::get_method_list(_TestMethodOrderObject::get_class_static(), &methods, true);
+	Vector<String> names;
+	for (const MethodInfo &method : methods) {
+		names.push_back(method.name);
+	}
+	CHECK(String(",").join(names) == "update,clear,start,add,stop,reset,pause,finish");
+}
+
 TEST_CASE("[Object] Metadata") {
 	const String meta_path = "complex_metadata_path";
 	Object object;
@@ -431,6 +486,147 @@ TEST_CASE("[Object] Signals") {
 	}
 }
 
+TEST_CASE("[Object] Signal IDs") {
+	GDREGISTER_CLASS(_TestDerivedObject);
+	Object object;
+	object.add_user_signal(MethodInfo("value_changed", PropertyInfo(Variant::INT, "value")));
+
+	ERR_PRINT_OFF;
+	CHECK_FALSE(object.get_signal_id("nonexistent_signal").is_valid());
+	ERR_PRINT_ON;
+
+	const Object::SignalID id = object.get_signal_id("value_changed");
+	REQUIRE(id.is_valid());
+	CHECK(id.get_name() == "value_changed");
+
+	SUBCASE("Emitting by ID should call native methods and callables") {
+		_TestDerivedObject target;
+		target.set_property(0);
+		object.connect("value_changed", Callable(&target, "set_property"));
+		_TestDerivedObject method_target;
+		method_target.set_property(0);
+		object.connect("value_changed", callable_mp(&method_target, &_TestDerivedObject::set_property));
+
+		CHECK(object.emit_signal(id, 5) == OK);
+		CHECK(target.get_property() == 5);
+		CHECK(method_target.get_property() == 5);
+
+		// Arguments of other types are converted by the regular call path.
+		CHECK(object.emit_signal(id, 7.0) == OK);
+		CHECK(target.get_property() == 7);
+
+		CHECK(object.emit_signal("value_changed", 9) == OK);
+		CHECK(target.get_property() == 9);
+		CHECK(method_target.get_property() == 9);
+	}
+
+	SUBCASE("Connections changed while emitting should only apply to later emissions") {
+		_TestDerivedObject first;
+		_TestDerivedObject second;
+		first.set_property(0);
+		second.set_property(0);
+		object.connect("value_changed", Callable(&first, "set_property"), Object::CONNECT_ONE_SHOT);
+		object.connect("value_changed", Callable(&second, "set_property"));
+
+		CHECK(object.emit_signal(id, 1) == OK);
+		CHECK(first.get_property() == 1);
+		CHECK(second.get_property() == 1);
+
+		CHECK(object.emit_signal(id, 2) == OK);
+		CHECK_MESSAGE(first.get_property() == 1, "One-shot connections should be disconnected.");
+		CHECK(second.get_property() == 2);
+
+		object.disconnect("value_changed", Callable(&second, "set_property"));
+		CHECK(object.emit_signal(id, 3) == OK);
+		CHECK(second.get_property() == 2);
+	}
+
+	SUBCASE("Targets overriding callp() should be called through it") {
+		GDREGISTER_CLASS(_TestCallpObject);
+		_TestCallpObject target;
+		target.set_property(0);
+		object.connect("value_changed", Callable(&target, "set_property"));
+
+		CHECK(object.emit_signal(id, 5) == OK);
+		CHECK(target.get_property() == 50);
+		CHECK(object.emit_signal("value_changed", 6) == OK);
+		CHECK(target.get_property() == 60);
+	}
+
+	SUBCASE("Freed targets should be skipped") {
+		_TestDerivedObject *target = memnew(_TestDerivedObject);
+		object.connect("value_changed", Callable(target, "set_property"));
+		memdelete(target);
+		CHECK(object.emit_signal(id, 1) == OK);
+	}
+
+	SUBCASE("IDs should stay valid when a user signal is removed") {
+		Object scripted;
+		scripted.call("add_user_signal", "removable_signal");
+		const Object::SignalID removable_id = scripted.get_signal_id("removable_signal");
+		scripted.call("remove_user_signal", "removable_signal");
+		CHECK_FALSE(scripted.has_signal("removable_signal"));
+		CHECK(scripted.emit_signal(removable_id) == OK);
+
+		ERR_PRINT_OFF;
+		CHECK(scripted.connect("removable_signal", callable_mp(&scripted, &Object::notify_property_list_changed)) == ERR_INVALID_PARAMETER);
+		ERR_PRINT_ON;
+
+		scripted.call("add_user_signal", "removable_signal");
+		CHECK(scripted.has_signal("removable_signal"));
+		SIGNAL_WATCH(&scripted, "removable_signal");
+		CHECK(scripted.emit_signal(removable_id) == OK);
+		Array empty_signal_args;
+		empty_signal_args.push_back(Array());
+		SIGNAL_CHECK("removable_signal", empty_signal_args);
+		SIGNAL_UNWATCH(&scripted, "removable_signal");
+	}
+
+	SUBCASE("IDs of other objects should be rejected") {
+		Object other;
+		ERR_PRINT_OFF;
+		CHECK(other.emit_signal(id, 1) == ERR_INVALID_PARAMETER);
+		ERR_PRINT_ON;
+	}
+}
+
+TEST_CASE("[Object][Benchmark] Signal emission" * doctest::skip()) {
+	GDREGISTER_CLASS(_TestDerivedObject);
+	const uint32_t count = 100000;
+
+	Object object;
+	object.add_user_signal(MethodInfo("value_changed", PropertyInfo(Variant::INT, "value")));
+	_TestDerivedObject targets[4];
+	for (_TestDerivedObject &target : targets) {
+		object.connect("value_changed", Callable(&target, "set_property"));
+	}
+
+	int value = 0;
+	TestBenchmark::measure("Object/emit_signal_by_name_native_4", count, [&]() {
+		object.emit_signal("value_changed", value++);
+	});
+
+	const Object::SignalID id = object.get_signal_id("value_changed");
+	TestBenchmark::measure("Object/emit_signal_by_id_native_4", count, [&]() {
+		object.emit_signal(id, value++);
+	});
+	CHECK(targets[3].get_property() == value - 1);
+
+	Object other;
+	other.add_user_signal(MethodInfo("notified"));
+	for (Object &target : targets) {
+		other.connect("notified", callable_mp(&target, &Object::notify_property_list_changed));
+	}
+	TestBenchmark::measure("Object/emit_signal_by_name_callable_mp_4", count, [&]() {
+		other.emit_signal("notified");
+	});
+
+	const Object::SignalID notified = other.get_signal_id("notified");
+	TestBenchmark::measure("Object/emit_signal_by_id_callable_mp_4", count, [&]() {
+		other.emit_signal(notified);
+	});
+}
+
 class NotificationObject1 : public Object {
 	GDCLASS(NotificationObject1, Object);
 
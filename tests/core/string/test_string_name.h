@@ -0,0 +1,119 @@
+/**************************************************************************/
+/*  test_string_name.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_STRING_NAME_H
+#define TEST_STRING_NAME_H
+
+#include "core/object/worker_thread_pool.h"
+#include "core/os/os.h"
+#include "core/string/string_name.h"
+
+#include "tests/test_benchmark.h"
+#include "tests/test_macros.h"
+
+namespace TestStringName {
+
+TEST_CASE("[StringName] Interning") {
+	const StringName a = "test_string_name_interning";
+	const StringName b = String("test_string_name_interning");
+	const StringName c = StringName::search("test_string_name_interning");
+
+	CHECK(a == b);
+	CHECK(a == c);
+	CHECK(a.data_unique_pointer() == b.data_unique_pointer());
+	CHECK(String(a) == "test_string_name_interning");
+
+	CHECK_MESSAGE(StringName::search("test_string_name_never_created") == StringName(), "Searching should not create names.");
+}
+
+TEST_CASE("[StringName] Recreating a released name") {
+	const void *previous = nullptr;
+	{
+		StringName name = "test_string_name_released";
+		previous = name.data_unique_pointer();
+		CHECK(previous != nullptr);
+	}
+	CHECK(StringName::search("test_string_name_released") == StringName());
+
+	StringName name = "test_string_name_released";
+	CHECK(String(name) == "test_string_name_released");
+}
+
+struct StringNameStress {
+	static constexpr uint32_t NAMES = 1024;
+	LocalVector<StringName> expected;
+	SafeNumeric<uint32_t> mismatches;
+
+	void build(uint32_t p_index, void *p_userdata) {
+		// Mix lookups of existing names with short-lived ones that get inserted and removed.
+		const StringName existing = vformat("stress_name_%d", p_index % NAMES);
+		if (existing != expected[p_index % NAMES]) {
+			mismatches.increment();
+		}
+		const StringName temporary = vformat("stress_temporary_%d", p_index);
+		if (String(temporary) != vformat("stress_temporary_%d", p_index)) {
+			mismatches.increment();
+		}
+	}
+};
+
+TEST_CASE("[StringName] Concurrent construction from worker threads") {
+	StringNameStress stress;
+	for (uint32_t i = 0; i < StringNameStress::NAMES; i++) {
+		stress.expected.push_back(vformat("stress_name_%d", i));
+	}
+
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_template_group_task(&stress, &StringNameStress::build, nullptr, 50000);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+
+	CHECK(stress.mismatches.get() == 0);
+}
+
+TEST_CASE("[StringName][Benchmark] Lookup scaling with thread count" * doctest::skip()) {
+	StringNameStress stress;
+	for (uint32_t i = 0; i < StringNameStress::NAMES; i++) {
+		stress.expected.push_back(vformat("stress_name_%d", i));
+	}
+
+	const int elements = 1000000;
+	const int max_threads = WorkerThreadPool::get_singleton()->get_thread_count();
+	for (int threads = 1; threads <= max_threads; threads *= 2) {
+		TestBenchmark::measure(vformat("StringName/lookup_1m_%d_threads", threads), 1, [&]() {
+			WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_template_group_task(&stress, &StringNameStress::build, nullptr, elements, threads, true);
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+		});
+	}
+
+	CHECK(stress.mismatches.get() == 0);
+}
+
+} // namespace TestStringName
+
+#endif // TEST_STRING_NAME_H
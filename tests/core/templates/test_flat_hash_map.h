@@ -0,0 +1,243 @@
+/**************************************************************************/
+/*  test_flat_hash_map.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_FLAT_HASH_MAP_H
+#define TEST_FLAT_HASH_MAP_H
+
+#include "core/math/random_pcg.h"
+#include "core/templates/flat_hash_map.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/oa_hash_map.h"
+#include "core/templates/paged_allocator.h"
+
+#include "tests/test_benchmark.h"
+#include "tests/test_macros.h"
+
+namespace TestFlatHashMap {
+
+TEST_CASE("[FlatHashMap] Insert element") {
+	FlatHashMap<int, int> map;
+	FlatHashMap<int, int>::Iterator e = map.insert(42, 84);
+
+	CHECK(e);
+	CHECK(e->key == 42);
+	CHECK(e->value == 84);
+	CHECK(map[42] == 84);
+	CHECK(map.has(42));
+	CHECK(map.find(42));
+}
+
+TEST_CASE("[FlatHashMap] Overwrite element") {
+	FlatHashMap<int, int> map;
+	map.insert(42, 84);
+	map.insert(42, 1234);
+
+	CHECK(map[42] == 1234);
+	CHECK(map.size() == 1);
+}
+
+TEST_CASE("[FlatHashMap] Erase via element") {
+	FlatHashMap<int, int> map;
+	FlatHashMap<int, int>::Iterator e = map.insert(42, 84);
+	map.remove(e);
+	CHECK(!map.has(42));
+	CHECK(!map.find(42));
+}
+
+TEST_CASE("[FlatHashMap] Erase via key") {
+	FlatHashMap<int, int> map;
+	map.insert(42, 84);
+	CHECK(map.erase(42));
+	CHECK(!map.erase(42));
+	CHECK(!map.has(42));
+	CHECK(map.is_empty());
+}
+
+TEST_CASE("[FlatHashMap] Iteration visits every element once") {
+	FlatHashMap<int, int> map;
+	for (int i = 0; i < 1000; i++) {
+		map.insert(i, i * 2);
+	}
+	for (int i = 0; i < 1000; i += 3) {
+		map.erase(i);
+	}
+
+	int count = 0;
+	int64_t sum = 0;
+	for (const KeyValue<int, int> &E : map) {
+		CHECK(E.value == E.key * 2);
+		CHECK(E.key % 3 != 0);
+		count++;
+		sum += E.key;
+	}
+	CHECK(count == (int)map.size());
+	CHECK(count == 666);
+	CHECK(sum == 332667);
+}
+
+TEST_CASE("[FlatHashMap] Matches HashMap under random operations") {
+	FlatHashMap<uint32_t, uint32_t> flat;
+	HashMap<uint32_t, uint32_t> reference;
+	RandomPCG rng(4321);
+
+	bool all_match = true;
+	for (uint32_t i = 0; i < 100000; i++) {
+		const uint32_t key = rng.rand() % 2048;
+		switch (rng.rand() % 3) {
+			case 0: {
+				flat.insert(key, i);
+				reference.insert(key, i);
+			} break;
+			case 1: {
+				all_match &= flat.erase(key) == reference.erase(key);
+			} break;
+			default: {
+				const uint32_t *a = flat.getptr(key);
+				const uint32_t *b = reference.getptr(key);
+				all_match &= (a == nullptr) == (b == nullptr) && (!a || *a == *b);
+			} break;
+		}
+		all_match &= flat.size() == reference.size();
+	}
+	CHECK(all_match);
+
+	FlatHashMap<uint32_t, uint32_t> copy = flat;
+	CHECK(copy.size() == reference.size());
+	for (const KeyValue<uint32_t, uint32_t> &E : reference) {
+		CHECK(copy.has(E.key));
+		CHECK(copy[E.key] == E.value);
+	}
+
+	copy.clear();
+	CHECK(copy.is_empty());
+	CHECK(copy.begin() == copy.end());
+}
+
+TEST_CASE("[FlatHashMap] Non-trivial keys and values") {
+	FlatHashMap<String, Vector<int>> map;
+	for (int i = 0; i < 100; i++) {
+		Vector<int> v;
+		v.push_back(i);
+		map.insert(itos(i), v);
+	}
+	map.reserve(1000);
+	CHECK(map.size() == 100);
+	CHECK(map["57"][0] == 57);
+	map.erase("57");
+	CHECK(!map.has("57"));
+	map.reset();
+	CHECK(map.get_capacity() == 0);
+}
+
+// Benchmarks.
+
+template <typename M>
+static void _bench_insert_lookup(const String &p_name, const LocalVector<uint32_t> &p_keys, uint32_t p_iterations, M &r_map) {
+	TestBenchmark::measure(p_name + "/insert", p_iterations, [&]() {
+		r_map.clear();
+		for (uint32_t i = 0; i < p_keys.size(); i++) {
+			r_map.insert(p_keys[i], i);
+		}
+	});
+
+	uint64_t found = 0;
+	TestBenchmark::measure(p_name + "/lookup", p_iterations, [&]() {
+		for (uint32_t i = 0; i < p_keys.size(); i++) {
+			found += r_map.has(p_keys[i]);
+			found += r_map.has(p_keys[i] + 1); // Mostly misses.
+		}
+	});
+
+	uint64_t sum = 0;
+	TestBenchmark::measure(p_name + "/iterate", p_iterations, [&]() {
+		for (const KeyValue<uint32_t, uint32_t> &E : r_map) {
+			sum += E.value;
+		}
+	});
+
+	// Erased keys are inserted back, so every iteration erases the same amount.
+	TestBenchmark::measure(p_name + "/erase_insert_half", p_iterations, [&]() {
+		for (uint32_t i = 0; i < p_keys.size(); i += 2) {
+			r_map.erase(p_keys[i]);
+		}
+		for (uint32_t i = 0; i < p_keys.size(); i += 2) {
+			r_map.insert(p_keys[i], i);
+		}
+	});
+	CHECK(found > 0);
+	CHECK(sum > 0);
+}
+
+TEST_CASE("[FlatHashMap][Benchmark] Compared to other maps" * doctest::skip()) {
+	RandomPCG rng(1234);
+	for (uint32_t count : { 64u, 4096u, 1000000u }) {
+		LocalVector<uint32_t> keys;
+		for (uint32_t i = 0; i < count; i++) {
+			keys.push_back(rng.rand() & ~1u); // Even keys, so key + 1 misses.
+		}
+		// Around a million operations per sample, whatever the size.
+		const uint32_t iterations = MAX(1u, 1000000u / count);
+
+		{
+			HashMap<uint32_t, uint32_t> map;
+			_bench_insert_lookup(vformat("HashMap/%d_keys", count), keys, iterations, map);
+		}
+		{
+			// Allocation-free nodes, closest to an array backed map with insertion order.
+			HashMap<uint32_t, uint32_t, HashMapHasherDefault, HashMapComparatorDefault<uint32_t>, PagedAllocator<HashMapElement<uint32_t, uint32_t>>> map;
+			_bench_insert_lookup(vformat("HashMap_paged/%d_keys", count), keys, iterations, map);
+		}
+		{
+			FlatHashMap<uint32_t, uint32_t> map;
+			_bench_insert_lookup(vformat("FlatHashMap/%d_keys", count), keys, iterations, map);
+		}
+		{
+			OAHashMap<uint32_t, uint32_t> map;
+			TestBenchmark::measure(vformat("OAHashMap/%d_keys/insert", count), iterations, [&]() {
+				map.clear();
+				for (uint32_t i = 0; i < keys.size(); i++) {
+					map.set(keys[i], i);
+				}
+			});
+			uint64_t found = 0;
+			TestBenchmark::measure(vformat("OAHashMap/%d_keys/lookup", count), iterations, [&]() {
+				for (uint32_t i = 0; i < keys.size(); i++) {
+					found += map.has(keys[i]);
+					found += map.has(keys[i] + 1);
+				}
+			});
+			CHECK(found > 0);
+		}
+	}
+}
+
+} // namespace TestFlatHashMap
+
+#endif // TEST_FLAT_HASH_MAP_H
@@ -0,0 +1,197 @@
+/**************************************************************************/
+/*  test_frame_arena.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_FRAME_ARENA_H
+#define TEST_FRAME_ARENA_H
+
+#include "core/math/aabb.h"
+#include "core/math/plane.h"
+#include "core/math/random_pcg.h"
+#include "core/os/frame_arena.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/list.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/paged_allocator.h"
+
+#include "tests/test_benchmark.h"
+#include "tests/test_macros.h"
+
+namespace TestFrameArena {
+
+TEST_CASE("[FrameArena] Allocations are aligned and distinct") {
+	FrameArena::advance_frame();
+
+	uint8_t *a = (uint8_t *)FrameArena::alloc(3);
+	uint8_t *b = (uint8_t *)FrameArena::alloc(17);
+	uint8_t *c = (uint8_t *)FrameArena::alloc(FrameArena::MIN_CHUNK_SIZE * 2);
+
+	CHECK(a != nullptr);
+	CHECK(b != nullptr);
+	CHECK(c != nullptr);
+	CHECK(((uintptr_t)a % FrameArena::ALIGNMENT) == 0);
+	CHECK(((uintptr_t)b % FrameArena::ALIGNMENT) == 0);
+	CHECK(((uintptr_t)c % FrameArena::ALIGNMENT) == 0);
+	CHECK_MESSAGE(b >= a + 3, "Allocations should not overlap.");
+	CHECK(FrameArena::get_thread_used_bytes() >= FrameArena::MIN_CHUNK_SIZE * 2 + 20);
+}
+
+TEST_CASE("[FrameArena] Realloc keeps contents") {
+	FrameArena::advance_frame();
+
+	uint32_t *first = (uint32_t *)FrameArena::alloc(sizeof(uint32_t) * 4);
+	for (uint32_t i = 0; i < 4; i++) {
+		first[i] = i;
+	}
+
+	// Last allocation grows in place.
+	uint32_t *grown = (uint32_t *)FrameArena::realloc(first, sizeof(uint32_t) * 8);
+	CHECK(grown == first);
+
+	// Once something else was allocated, it has to move.
+	FrameArena::alloc(16);
+	uint32_t *moved = (uint32_t *)FrameArena::realloc(grown, sizeof(uint32_t) * 1024);
+	CHECK(moved != grown);
+	for (uint32_t i = 0; i < 4; i++) {
+		CHECK(moved[i] == i);
+	}
+}
+
+TEST_CASE("[FrameArena] Advancing the frame reuses memory") {
+	FrameArena::advance_frame();
+	for (int i = 0; i < 8; i++) {
+		FrameArena::alloc(FrameArena::MIN_CHUNK_SIZE / 2);
+	}
+	const size_t capacity = FrameArena::get_thread_capacity_bytes();
+	CHECK(capacity >= FrameArena::MIN_CHUNK_SIZE * 4);
+
+	FrameArena::advance_frame();
+	CHECK_MESSAGE(FrameArena::get_thread_used_bytes() == 0, "A new frame should start with an empty arena.");
+
+	// Chunks were coalesced, so the same workload now fits in a single chunk.
+	void *first = FrameArena::alloc(FrameArena::MIN_CHUNK_SIZE / 2);
+	for (int i = 1; i < 8; i++) {
+		FrameArena::alloc(FrameArena::MIN_CHUNK_SIZE / 2);
+	}
+	CHECK(FrameArena::get_thread_capacity_bytes() >= capacity);
+
+	FrameArena::advance_frame();
+	CHECK_MESSAGE(FrameArena::alloc(16) == first, "Steady state frames should reuse the same chunk.");
+}
+
+TEST_CASE("[FrameArena] Containers backed by the arena") {
+	FrameArena::advance_frame();
+
+	LocalVector<int, uint32_t, false, false, FrameArena> vector;
+	for (int i = 0; i < 1000; i++) {
+		vector.push_back(i);
+	}
+	CHECK(vector.size() == 1000);
+	CHECK(vector[999] == 999);
+
+	HashMap<int, int, HashMapHasherDefault, HashMapComparatorDefault<int>, FrameTypedAllocator<HashMapElement<int, int>>> map;
+	for (int i = 0; i < 100; i++) {
+		map.insert(i, i * 2);
+	}
+	CHECK(map.size() == 100);
+	CHECK(map[42] == 84);
+	map.erase(42);
+	CHECK(!map.has(42));
+
+	List<int, FrameArena> list;
+	list.push_back(1);
+	list.push_back(2);
+	CHECK(list.size() == 2);
+
+	PagedAllocator<Vector3, false, 64, FrameArena> paged;
+	Vector3 *v = paged.alloc(1, 2, 3);
+	CHECK(v->y == 2);
+	paged.free(v);
+	paged.reset();
+}
+
+// Mimics the scratch data a culling pass builds every frame: a list of
+// visible instances, a lookup from instance to its slot and a sorted copy.
+template <typename A, typename TA>
+static uint64_t _cull_frames(const LocalVector<AABB> &p_instances, const Plane *p_planes, int p_frames) {
+	uint64_t checksum = 0;
+	for (int frame = 0; frame < p_frames; frame++) {
+		FrameArena::advance_frame();
+
+		LocalVector<uint32_t, uint32_t, false, false, A> visible;
+		HashMap<uint32_t, uint32_t, HashMapHasherDefault, HashMapComparatorDefault<uint32_t>, TA> slots;
+
+		for (uint32_t i = 0; i < p_instances.size(); i++) {
+			if (p_instances[i].inside_convex_shape(p_planes, 6)) {
+				slots.insert(i, visible.size());
+				visible.push_back(i);
+			}
+		}
+
+		visible.sort();
+		checksum += visible.size() + slots.size();
+	}
+	return checksum;
+}
+
+TEST_CASE("[FrameArena][Benchmark] Culling-style scratch allocations" * doctest::skip()) {
+	const uint32_t instance_count = 100000;
+	const int frames = 50;
+
+	RandomPCG rng(1234);
+	LocalVector<AABB> instances;
+	for (uint32_t i = 0; i < instance_count; i++) {
+		Vector3 pos(rng.randf() * 200.0 - 100.0, rng.randf() * 200.0 - 100.0, rng.randf() * 200.0 - 100.0);
+		instances.push_back(AABB(pos, Vector3(1, 1, 1)));
+	}
+
+	const Plane planes[6] = {
+		Plane(Vector3(1, 0, 0), 50),
+		Plane(Vector3(-1, 0, 0), 50),
+		Plane(Vector3(0, 1, 0), 50),
+		Plane(Vector3(0, -1, 0), 50),
+		Plane(Vector3(0, 0, 1), 50),
+		Plane(Vector3(0, 0, -1), 50),
+	};
+
+	const uint64_t heap_checksum = _cull_frames<DefaultAllocator, DefaultTypedAllocator<HashMapElement<uint32_t, uint32_t>>>(instances, planes, 1);
+	const uint64_t arena_checksum = _cull_frames<FrameArena, FrameTypedAllocator<HashMapElement<uint32_t, uint32_t>>>(instances, planes, 1);
+	CHECK(heap_checksum == arena_checksum);
+
+	TestBenchmark::measure("FrameArena/cull_frame_heap_100k", frames, [&]() {
+		_cull_frames<DefaultAllocator, DefaultTypedAllocator<HashMapElement<uint32_t, uint32_t>>>(instances, planes, 1);
+	});
+	TestBenchmark::measure("FrameArena/cull_frame_arena_100k", frames, [&]() {
+		_cull_frames<FrameArena, FrameTypedAllocator<HashMapElement<uint32_t, uint32_t>>>(instances, planes, 1);
+	});
+}
+
+} // namespace TestFrameArena
+
+#endif // TEST_FRAME_ARENA_H
@@ -0,0 +1,128 @@
+/**************************************************************************/
+/*  test_vector_slice.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_VECTOR_SLICE_H
+#define TEST_VECTOR_SLICE_H
+
+#include "core/io/marshalls.h"
+#include "core/io/stream_peer.h"
+#include "core/templates/vector_slice.h"
+
+#include "tests/test_macros.h"
+
+namespace TestVectorSlice {
+
+TEST_CASE("[VectorSlice] Slices share the source buffer") {
+	Vector<int> vector{ 0, 1, 2, 3, 4, 5, 6, 7 };
+
+	VectorSlice<int> view = vector;
+	CHECK(view.size() == 8);
+	CHECK(view.ptr() == vector.ptr());
+
+	VectorSlice<int> sub = view.slice(2, 5);
+	CHECK(sub.size() == 3);
+	CHECK(sub.ptr() == vector.ptr() + 2);
+	CHECK(sub[0] == 2);
+	CHECK(sub[2] == 4);
+
+	int sum = 0;
+	for (int value : sub) {
+		sum += value;
+	}
+	CHECK(sum == 9);
+
+	// Full slices give the source back without copying.
+	CHECK(view.to_vector().ptr() == vector.ptr());
+	Vector<int> copy = sub.to_vector();
+	CHECK(copy.size() == 3);
+	CHECK(copy.ptr() != vector.ptr());
+	CHECK(copy[1] == 3);
+}
+
+TEST_CASE("[VectorSlice] Slicing follows Vector::slice()") {
+	Vector<int> vector{ 0, 1, 2, 3, 4, 5, 6, 7 };
+	VectorSlice<int> view = VectorSlice<int>(vector, 1, 6); // 1 to 6.
+
+	for (int begin = -8; begin <= 8; begin++) {
+		for (int end = -8; end <= 8; end++) {
+			const Vector<int> expected = vector.slice(1, 7).slice(begin, end);
+			if (expected.is_empty()) {
+				continue; // Also covers begin > end, which errors.
+			}
+			const VectorSlice<int> got = view.slice(begin, end);
+			CHECK(got.size() == expected.size());
+			CHECK(got.to_vector() == expected);
+		}
+	}
+	CHECK(view.slice(-2).size() == 2);
+	CHECK(view.slice(-2)[0] == 5);
+	CHECK(view.slice(6).is_empty());
+}
+
+TEST_CASE("[VectorSlice] Slices outlive changes to the source") {
+	Vector<int> vector{ 0, 1, 2, 3 };
+	VectorSlice<int> view = VectorSlice<int>(vector).slice(1, 3);
+
+	vector.write[1] = 100;
+	vector.push_back(4);
+	CHECK(view.size() == 2);
+	CHECK(view[0] == 1);
+	CHECK(view[1] == 2);
+
+	vector.clear();
+	CHECK(view[1] == 2);
+}
+
+TEST_CASE("[VectorSlice] Passing byte slices to I/O") {
+	Vector<uint8_t> encoded;
+	encoded.resize(4); // Header, skipped through the slice.
+	int len = 0;
+	REQUIRE(encode_variant("hello", nullptr, len) == OK);
+	encoded.resize(4 + len);
+	REQUIRE(encode_variant("hello", encoded.ptrw() + 4, len) == OK);
+
+	Variant decoded;
+	int decoded_len = 0;
+	CHECK(decode_variant(decoded, VectorSlice<uint8_t>(encoded).slice(4), &decoded_len) == OK);
+	CHECK(decoded == Variant("hello"));
+	CHECK(decoded_len == len);
+
+	Ref<StreamPeerBuffer> buffer;
+	buffer.instantiate();
+	Ref<StreamPeer> peer = buffer;
+	CHECK(peer->put_data(VectorSlice<uint8_t>(encoded).slice(4)) == OK);
+	CHECK(buffer->get_data_array() == encoded.slice(4));
+	CHECK(peer->put_data(VectorSlice<uint8_t>()) == OK);
+	CHECK(buffer->get_size() == len);
+}
+
+} // namespace TestVectorSlice
+
+#endif // TEST_VECTOR_SLICE_H
@@ -32,7 +32,9 @@
 #define TEST_WORKER_THREAD_POOL_H
 
 #include "core/object/worker_thread_pool.h"
+#include "core/os/os.h"
 
+#include "tests/test_benchmark.h"
 #include "tests/test_macros.h"
 
 namespace TestWorkerThreadPool {
@@ -173,6 +175,202 @@ TEST_CASE("[WorkerThreadPool] Run a yielding daemon as the only hope for other t
 	CHECK_MESSAGE(all_needed_yield, "All legit tasks should have needed the daemon yielding to run.");
 }
 
+static SafeNumeric<uint32_t> sequence;
+static LocalVector<uint32_t> finished_at;
+
+static void static_sequenced_test(void *p_arg) {
+	finished_at[(uintptr_t)p_arg] = sequence.increment();
+}
+
+static void static_sequenced_group_test(void *p_arg, uint32_t p_index) {
+	counter[p_index].set(finished_at[(uintptr_t)p_arg]); // Should always see the dependency done.
+}
+
+TEST_CASE("[WorkerThreadPool] Run tasks and groups after their dependencies") {
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	for (int iterations = 0; iterations < 100; iterations++) {
+		const int count = Math::pow(2.0f, Math::random(0.0f, 5.0f));
+		sequence.set(0);
+		finished_at.clear();
+		finished_at.resize(3);
+		counter.clear();
+		counter.resize(count);
+
+		WorkerThreadPool::TaskID first = pool->add_native_task(static_sequenced_test, (void *)0);
+		WorkerThreadPool::GroupID group = pool->add_native_group_task_after({ first }, static_sequenced_group_test, (void *)0, count);
+		WorkerThreadPool::TaskID last = pool->add_native_task_after({ first, group }, static_sequenced_test, (void *)1);
+
+		pool->wait_for_task_completion(last);
+		CHECK(pool->is_group_task_completed(group));
+		pool->wait_for_group_task_completion(group);
+		pool->wait_for_task_completion(first);
+
+		bool all_after = true;
+		for (int i = 0; i < count; i++) {
+			all_after &= counter[i].get() == 1;
+		}
+		CHECK_MESSAGE(all_after, "Group elements should only run after the task they depend on.");
+		CHECK(finished_at[1] == 2);
+
+		// Dependencies already completed and waited on are satisfied.
+		WorkerThreadPool::TaskID late = pool->add_native_task_after({ first, last }, static_sequenced_test, (void *)2);
+		pool->wait_for_task_completion(late);
+		CHECK(finished_at[2] == 3);
+	}
+}
+
+static void static_slow_sequenced_test(void *p_arg) {
+	OS::get_singleton()->delay_usec(1000);
+	static_sequenced_test(p_arg);
+}
+
+TEST_CASE("[WorkerThreadPool] Run tasks after empty groups with dependencies") {
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	// Enough threads for the last task to run alongside the first one, if it
+	// didn't wait for it. The original thread count is restored at the end.
+	const int thread_count = pool->get_thread_count();
+	pool->finish();
+	pool->init(4);
+
+	for (int iterations = 0; iterations < 20; iterations++) {
+		sequence.set(0);
+		finished_at.clear();
+		finished_at.resize(2);
+
+		// High priority, so the tasks aren't serialized by the low priority thread limit.
+		WorkerThreadPool::TaskID first = pool->add_native_task(static_slow_sequenced_test, (void *)0, true);
+		WorkerThreadPool::GroupID empty = pool->add_native_group_task_after({ first }, static_sequenced_group_test, (void *)0, 0, -1, true);
+		WorkerThreadPool::TaskID last = pool->add_native_task_after({ empty }, static_sequenced_test, (void *)1, true);
+
+		pool->wait_for_task_completion(last);
+		CHECK_MESSAGE(finished_at[0] == 1, "The task after the empty group should only run after the group's dependency.");
+		CHECK(finished_at[1] == 2);
+		CHECK(pool->is_group_task_completed(empty));
+		pool->wait_for_group_task_completion(empty);
+		pool->wait_for_task_completion(first);
+	}
+
+	// Without dependencies, empty groups still complete right away.
+	WorkerThreadPool::GroupID empty = pool->add_native_group_task(static_sequenced_group_test, (void *)0, 0);
+	CHECK(pool->is_group_task_completed(empty));
+	pool->wait_for_group_task_completion(empty);
+
+	pool->finish();
+	pool->init(thread_count);
+}
+
+TEST_CASE("[WorkerThreadPool] Run random task graphs in dependency order") {
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	for (int iterations = 0; iterations < 100; iterations++) {
+		const int count = 64;
+		sequence.set(0);
+		finished_at.clear();
+		finished_at.resize(count);
+
+		LocalVector<WorkerThreadPool::TaskID> ids;
+		LocalVector<Vector<int>> dependencies;
+		for (int i = 0; i < count; i++) {
+			Vector<int> deps;
+			Vector<WorkerThreadPool::TaskID> dep_ids;
+			for (int j = 0; i > 0 && j < 3; j++) {
+				const int dep = Math::rand() % i;
+				deps.push_back(dep);
+				dep_ids.push_back(ids[dep]);
+			}
+			dependencies.push_back(deps);
+			ids.push_back(pool->add_native_task_after(dep_ids, static_sequenced_test, (void *)(uintptr_t)i, Math::rand() % 2));
+		}
+		// Waiting in reverse order means most tasks have completed when waited on.
+		for (int i = count - 1; i >= 0; i--) {
+			pool->wait_for_task_completion(ids[i]);
+		}
+
+		bool order_respected = true;
+		for (int i = 0; i < count; i++) {
+			for (int dep : dependencies[i]) {
+				order_respected &= finished_at[i] > finished_at[dep];
+			}
+		}
+		CHECK(order_respected);
+		CHECK(sequence.get() == (uint32_t)count);
+	}
+}
+
+static void static_fork_join_test(void *p_arg) {
+	const uintptr_t depth = (uintptr_t)p_arg;
+	counter[0].increment();
+	if (depth == 0) {
+		return;
+	}
+	// Posted from a pool thread, so these go through its own queue and may get stolen.
+	WorkerThreadPool::TaskID a = WorkerThreadPool::get_singleton()->add_native_task(static_fork_join_test, (void *)(depth - 1), true);
+	WorkerThreadPool::TaskID b = WorkerThreadPool::get_singleton()->add_native_task(static_fork_join_test, (void *)(depth - 1), true);
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(a);
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(b);
+}
+
+TEST_CASE("[WorkerThreadPool] Run tasks posted from pool threads") {
+	counter.clear();
+	counter.resize(1);
+	const uintptr_t depth = 10;
+	WorkerThreadPool::TaskID root = WorkerThreadPool::get_singleton()->add_native_task(static_fork_join_test, (void *)depth, true);
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(root);
+	CHECK(counter[0].get() == (1 << (depth + 1)) - 1);
+}
+
+// Benchmarks.
+
+static void static_spin_test(void *p_arg, uint32_t p_index) {
+	// Roughly a microsecond of work, so that scheduling costs show.
+	uint32_t value = p_index;
+	for (int i = 0; i < 500; i++) {
+		value = value * 1664525u + 1013904223u;
+	}
+	counter[0].add(value & 1);
+}
+
+TEST_CASE("[WorkerThreadPool][Benchmark] Scaling with thread count and task graphs" * doctest::skip()) {
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	counter.clear();
+	counter.resize(1);
+	const int elements = 1 << 18;
+
+	// Limiting the tasks of a group limits the threads working on it.
+	for (int tasks = 1; tasks <= pool->get_thread_count(); tasks *= 2) {
+		TestBenchmark::measure(vformat("WorkerThreadPool/group_256k_%d_threads", tasks), 1, [&]() {
+			pool->wait_for_group_task_completion(pool->add_native_group_task(static_spin_test, nullptr, elements, tasks, true));
+		});
+	}
+
+	TestBenchmark::measure("WorkerThreadPool/fork_join_32k_tasks", 1, [&]() {
+		WorkerThreadPool::TaskID root = pool->add_native_task(static_fork_join_test, (void *)14, true);
+		pool->wait_for_task_completion(root);
+	});
+
+	// A chain of small groups, either waited on one by one or submitted upfront.
+	const int stages = 64;
+	const int stage_elements = 1024;
+	TestBenchmark::measure("WorkerThreadPool/group_chain_64_waits", 1, [&]() {
+		for (int i = 0; i < stages; i++) {
+			pool->wait_for_group_task_completion(pool->add_native_group_task(static_spin_test, nullptr, stage_elements, -1, true));
+		}
+	});
+
+	TestBenchmark::measure("WorkerThreadPool/group_chain_64_graph", 1, [&]() {
+		LocalVector<WorkerThreadPool::GroupID> chain;
+		for (int i = 0; i < stages; i++) {
+			Vector<WorkerThreadPool::TaskID> dependencies;
+			if (i > 0) {
+				dependencies.push_back(chain[i - 1]);
+			}
+			chain.push_back(pool->add_native_group_task_after(dependencies, static_spin_test, nullptr, stage_elements, -1, true));
+		}
+		for (WorkerThreadPool::GroupID group : chain) {
+			pool->wait_for_group_task_completion(group);
+		}
+	});
+}
+
 } // namespace TestWorkerThreadPool
 
 #endif // TEST_WORKER_THREAD_POOL_H
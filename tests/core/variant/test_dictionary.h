@@ -31,7 +31,9 @@
 #ifndef TEST_DICTIONARY_H
 #define TEST_DICTIONARY_H
 
+#include "core/io/json.h"
 #include "core/variant/dictionary.h"
+#include "tests/test_benchmark.h"
 #include "tests/test_macros.h"
 
 namespace TestDictionary {
@@ -537,6 +539,120 @@ TEST_CASE("[Dictionary] Order and find") {
 	CHECK_EQ(d.find_key("does not exist"), Variant());
 }
 
+TEST_CASE("[Dictionary] Many keys, erasing and inserting again") {
+	// Goes past the small inline table, so some keys end up in the hash map.
+	Dictionary d;
+	Array keys;
+	for (int i = 0; i < 20; i++) {
+		d[vformat("key_%d", i)] = i;
+		keys.append(vformat("key_%d", i));
+	}
+	CHECK(d.size() == 20);
+	CHECK_EQ(d.keys(), keys);
+	for (int i = 0; i < 20; i++) {
+		CHECK(int(d[StringName(vformat("key_%d", i))]) == i);
+	}
+
+	// A reference to a value stays valid while other keys are added and erased.
+	Variant &first = d["key_0"];
+	d["key_20"] = 20;
+	CHECK(d.erase("key_1"));
+	CHECK(d.erase(StringName("key_15")));
+	CHECK_FALSE(d.erase("key_15"));
+	first = "changed";
+	CHECK(d["key_0"] == Variant("changed"));
+
+	// Keys inserted again go to the end, like new keys.
+	d["key_1"] = 1;
+	keys.erase("key_1");
+	keys.erase("key_15");
+	keys.append("key_20");
+	keys.append("key_1");
+	CHECK_EQ(d.keys(), keys);
+	CHECK(d.size() == 20);
+
+	// Iterating with next() visits the same keys in the same order.
+	Array iterated;
+	for (const Variant *key = d.next(); key; key = d.next(key)) {
+		iterated.append(*key);
+	}
+	CHECK_EQ(iterated, keys);
+
+	Dictionary same;
+	for (int i = keys.size() - 1; i >= 0; i--) {
+		same[keys[i]] = d[keys[i]];
+	}
+	CHECK_EQ(d, same);
+
+	d.clear();
+	CHECK(d.is_empty());
+	CHECK(d.next() == nullptr);
+	d[StringName("name")] = "value";
+	CHECK(d.has("name"));
+	CHECK(d.keys() == build_array("name"));
+}
+
+TEST_CASE("[Dictionary] Erasing the last keys") {
+	Dictionary d;
+	d[1] = 1;
+	d[2] = 2;
+	d[3] = 3;
+	d.erase(3);
+	d.erase(2);
+	d[4] = 4;
+	d[2] = 2;
+	CHECK_EQ(d.keys(), build_array(1, 4, 2));
+	d.erase(1);
+	d.erase(4);
+	d.erase(2);
+	CHECK(d.is_empty());
+	d[5] = 5;
+	CHECK_EQ(d.keys(), build_array(5));
+}
+
+TEST_CASE("[Dictionary][Benchmark] Record-style dictionaries" * doctest::skip()) {
+	const uint32_t count = 10000;
+
+	const StringName name = "name";
+	const StringName health = "health";
+	const StringName position = "position";
+	Dictionary record;
+	TestBenchmark::measure("Dictionary/create_record_3_keys", count, [&]() {
+		record = Dictionary();
+		record[name] = "Player";
+		record[health] = 100;
+		record[position] = Vector2(1, 2);
+	});
+	CHECK(record.size() == 3);
+
+	int total = 0;
+	const Variant health_key = health;
+	TestBenchmark::measure("Dictionary/get_stringname_key", count * 10, [&]() {
+		total += int(*record.getptr(health_key));
+	});
+	CHECK(total > 0);
+
+	const Variant position_string = "position";
+	TestBenchmark::measure("Dictionary/get_string_key", count * 10, [&]() {
+		total += record.has(position_string);
+	});
+
+	Dictionary large;
+	for (int i = 0; i < 64; i++) {
+		large[i] = i;
+	}
+	TestBenchmark::measure("Dictionary/get_int_key_64_keys", count * 10, [&]() {
+		total += int(large[total & 63]);
+	});
+
+	const String json = "{\"name\": \"Player\", \"health\": 100, \"position\": [1, 2], \"tags\": {\"team\": 1}}";
+	Variant parsed;
+	TestBenchmark::measure("Dictionary/parse_json_record", count / 10, [&]() {
+		parsed = JSON::parse_string(json);
+	});
+	CHECK(Dictionary(parsed).size() == 4);
+}
+
 } // namespace TestDictionary
 
 #endif // TEST_DICTIONARY_H
@@ -34,6 +34,7 @@
 #include "core/variant/variant.h"
 #include "core/variant/variant_parser.h"
 
+#include "tests/test_benchmark.h"
 #include "tests/test_macros.h"
 
 namespace TestVariant {
@@ -2208,6 +2209,41 @@ TEST_CASE("[Variant] Operator NOT") {
 	}
 }
 
+TEST_CASE("[Variant][Benchmark] Operators, calls and conversions" * doctest::skip()) {
+	const uint32_t count = 10000;
+
+	Variant sum = 0;
+	const Variant one = 1;
+	TestBenchmark::measure("Variant/evaluate_int_add", count, [&]() {
+		sum = Variant::evaluate(Variant::OP_ADD, sum, one);
+	});
+	CHECK(int(sum) == int(count) * (TestBenchmark::get_sample_count() + 1));
+
+	const Variant::ValidatedOperatorEvaluator evaluator = Variant::get_validated_operator_evaluator(Variant::OP_MULTIPLY, Variant::VECTOR3, Variant::FLOAT);
+	Variant product = Vector3(1, 2, 3);
+	const Variant factor = 1.0;
+	TestBenchmark::measure("Variant/validated_vector3_multiply", count, [&]() {
+		evaluator(&product, &factor, &product);
+	});
+	CHECK(product == Variant(Vector3(1, 2, 3)));
+
+	Variant vector = Vector3(3, 4, 0);
+	const StringName length = "length";
+	Variant ret;
+	TestBenchmark::measure("Variant/call_builtin_method", count, [&]() {
+		Callable::CallError ce;
+		vector.callp(length, nullptr, 0, ret, ce);
+	});
+	CHECK(double(ret) == doctest::Approx(5.0));
+
+	const Variant value = Vector3(1.5, 2.5, 3.5);
+	String string;
+	TestBenchmark::measure("Variant/stringify_vector3", count / 10, [&]() {
+		string = value.stringify();
+	});
+	CHECK(string == "(1.5, 2.5, 3.5)");
+}
+
 } // namespace TestVariant
 
 #endif // TEST_VARIANT_H
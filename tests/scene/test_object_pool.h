@@ -0,0 +1,161 @@
+/**************************************************************************/
+/*  test_object_pool.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_OBJECT_POOL_H
+#define TEST_OBJECT_POOL_H
+
+#include "scene/main/object_pool.h"
+#include "scene/main/scene_tree.h"
+#include "scene/main/window.h"
+
+#include "tests/test_benchmark.h"
+#include "tests/test_macros.h"
+
+namespace TestObjectPool {
+
+TEST_CASE("[ObjectPool] Recycle RefCounted objects") {
+	Ref<ObjectPool> pool;
+	pool.instantiate();
+	pool->set_object_class("RefCounted");
+
+	Ref<RefCounted> object = pool->acquire();
+	REQUIRE(object.is_valid());
+	const ObjectID id = object->get_instance_id();
+	pool->release(object.ptr());
+	object.unref();
+	CHECK_MESSAGE(ObjectDB::get_instance(id) != nullptr, "The pool should keep released objects alive.");
+	CHECK(pool->get_available_count() == 1);
+
+	object = pool->acquire();
+	CHECK(object->get_instance_id() == id);
+	CHECK(pool->get_available_count() == 0);
+
+	Ref<ObjectPool> other;
+	other.instantiate();
+	other->set_object_class("Resource");
+	ERR_PRINT_OFF;
+	other->release(object.ptr());
+	ERR_PRINT_ON;
+	CHECK_MESSAGE(other->get_available_count() == 0, "Objects of another class should be rejected.");
+
+	pool->set_max_size(2);
+	pool->prewarm(5);
+	CHECK(pool->get_available_count() == 2);
+	pool->release(object.ptr());
+	CHECK(pool->get_available_count() == 2);
+	pool->clear();
+	CHECK(pool->get_available_count() == 0);
+}
+
+TEST_CASE("[ObjectPool] Reject objects released twice") {
+	Ref<ObjectPool> pool;
+	pool.instantiate();
+	pool->set_object_class("RefCounted");
+
+	Ref<RefCounted> object = pool->acquire();
+	REQUIRE(object.is_valid());
+	pool->release(object.ptr());
+	ERR_PRINT_OFF;
+	pool->release(object.ptr());
+	ERR_PRINT_ON;
+	CHECK_MESSAGE(pool->get_available_count() == 1, "The second release should be rejected.");
+
+	Ref<RefCounted> first = pool->acquire();
+	Ref<RefCounted> second = pool->acquire();
+	CHECK(first == object);
+	CHECK_MESSAGE(second != object, "The object should only be handed out once.");
+
+	pool->release(first.ptr());
+	CHECK_MESSAGE(pool->get_available_count() == 1, "Acquired objects can be released again.");
+}
+
+TEST_CASE("[SceneTree][ObjectPool] Recycle nodes") {
+	Node *parent = memnew(Node);
+	SceneTree::get_singleton()->get_root()->add_child(parent);
+
+	Ref<ObjectPool> pool;
+	pool.instantiate();
+	pool->set_object_class("Node");
+
+	Node *node = Object::cast_to<Node>(pool->acquire().get_validated_object());
+	REQUIRE(node != nullptr);
+	parent->add_child(node);
+	const StringName name = node->get_name();
+	CHECK(node->is_inside_tree());
+
+	pool->release(node);
+	CHECK_FALSE(node->is_inside_tree());
+	CHECK(parent->get_child_count() == 0);
+
+	CHECK(Object::cast_to<Node>(pool->acquire().get_validated_object()) == node);
+	parent->add_child(node);
+	CHECK(node->get_name() == name);
+	CHECK(node->is_inside_tree());
+
+	pool->release(node);
+	const ObjectID id = node->get_instance_id();
+	pool->set_object_class("Node2D");
+	SceneTree::get_singleton()->process(0);
+	CHECK_MESSAGE(ObjectDB::get_instance(id) == nullptr, "Clearing the pool should free its nodes.");
+
+	memdelete(parent);
+}
+
+TEST_CASE("[SceneTree][ObjectPool][Benchmark] Spawn and despawn nodes" * doctest::skip()) {
+	const uint32_t count = 1000;
+	Node *parent = memnew(Node);
+	SceneTree::get_singleton()->get_root()->add_child(parent);
+
+	TestBenchmark::measure("ObjectPool/spawn_despawn_node_new", count, [&]() {
+		Node *node = memnew(Node);
+		parent->add_child(node);
+		parent->remove_child(node);
+		memdelete(node);
+	});
+
+	Ref<ObjectPool> pool;
+	pool.instantiate();
+	pool->set_object_class("Node");
+	TestBenchmark::measure("ObjectPool/spawn_despawn_node_pooled", count, [&]() {
+		Node *node = Object::cast_to<Node>(pool->acquire().get_validated_object());
+		parent->add_child(node);
+		pool->release(node);
+	});
+	CHECK(pool->get_available_count() == 1);
+	CHECK(parent->get_child_count() == 0);
+
+	pool->clear();
+	SceneTree::get_singleton()->process(0);
+	memdelete(parent);
+}
+
+} // namespace TestObjectPool
+
+#endif // TEST_OBJECT_POOL_H
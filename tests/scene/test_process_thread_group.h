@@ -0,0 +1,199 @@
+/**************************************************************************/
+/*  test_process_thread_group.h                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_PROCESS_THREAD_GROUP_H
+#define TEST_PROCESS_THREAD_GROUP_H
+
+#include "core/object/worker_thread_pool.h"
+#include "scene/main/node.h"
+#include "scene/main/scene_tree.h"
+#include "scene/main/window.h"
+
+#include "tests/test_benchmark.h"
+#include "tests/test_macros.h"
+
+namespace TestProcessThreadGroup {
+
+class IndependentNode : public Node {
+	GDCLASS(IndependentNode, Node);
+
+	void _deferred_record() {
+		if (deferred_order) {
+			deferred_order->push_back(index);
+		}
+	}
+
+protected:
+	void _notification(int p_what) {
+		switch (p_what) {
+			case NOTIFICATION_PROCESS: {
+				process_counter++;
+				process_thread = Thread::get_caller_id();
+				// Some busy work, standing in for a script.
+				for (uint32_t i = 0; i < work_iterations; i++) {
+					state = state * 1664525u + 1013904223u;
+				}
+				callable_mp(this, &IndependentNode::_deferred_record).call_deferred();
+			} break;
+			case NOTIFICATION_PHYSICS_PROCESS: {
+				physics_process_counter++;
+			} break;
+		}
+	}
+
+public:
+	int index = 0;
+	int process_counter = 0;
+	int physics_process_counter = 0;
+	uint32_t work_iterations = 0;
+	uint32_t state = 0;
+	Thread::ID process_thread = Thread::UNASSIGNED_ID;
+	LocalVector<int> *deferred_order = nullptr;
+};
+
+static Node *create_independent_nodes(int p_count, uint32_t p_work_iterations, LocalVector<int> *r_deferred_order) {
+	Node *parent = memnew(Node);
+	for (int i = 0; i < p_count; i++) {
+		IndependentNode *node = memnew(IndependentNode);
+		node->index = i;
+		node->work_iterations = p_work_iterations;
+		node->deferred_order = r_deferred_order;
+		node->set_process(true);
+		node->set_physics_process(true);
+		parent->add_child(node);
+	}
+	return parent;
+}
+
+TEST_CASE("[SceneTree][ProcessThreadGroup] Process independent nodes in parallel") {
+	LocalVector<int> deferred_order;
+	const int count = 1000;
+	Node *parent = create_independent_nodes(count, 0, &deferred_order);
+	parent->set_process_thread_group(Node::PROCESS_THREAD_GROUP_SUB_THREAD);
+	parent->set_process_thread_parallel_nodes(true);
+	CHECK(parent->is_process_thread_parallel_nodes());
+	SceneTree::get_singleton()->get_root()->add_child(parent);
+
+	SceneTree::get_singleton()->process(0);
+	SceneTree::get_singleton()->physics_process(0);
+	SceneTree::get_singleton()->process(0);
+
+	bool all_processed = true;
+	for (int i = 0; i < count; i++) {
+		const IndependentNode *node = Object::cast_to<IndependentNode>(parent->get_child(i));
+		all_processed &= node->process_counter == 2 && node->physics_process_counter == 1;
+	}
+	CHECK_MESSAGE(all_processed, "Every node should have been processed exactly once per frame.");
+
+	bool in_order = deferred_order.size() == (uint32_t)count * 2;
+	for (uint32_t i = 0; in_order && i < deferred_order.size(); i++) {
+		in_order &= deferred_order[i] == int(i % count);
+	}
+	CHECK_MESSAGE(in_order, "Deferred calls should run in node order, as if processed on a single thread.");
+
+	memdelete(parent);
+}
+
+TEST_CASE("[SceneTree][ProcessThreadGroup] Small groups are processed as a whole") {
+	LocalVector<int> deferred_order;
+	Node *parent = create_independent_nodes(10, 0, &deferred_order);
+	parent->set_process_thread_group(Node::PROCESS_THREAD_GROUP_SUB_THREAD);
+	parent->set_process_thread_parallel_nodes(true);
+	SceneTree::get_singleton()->get_root()->add_child(parent);
+
+	SceneTree::get_singleton()->process(0);
+
+	CHECK(deferred_order.size() == 10);
+	for (int i = 0; i < 10; i++) {
+		CHECK(Object::cast_to<IndependentNode>(parent->get_child(i))->process_counter == 1);
+	}
+
+	memdelete(parent);
+}
+
+TEST_CASE("[SceneTree][ProcessThreadGroup] Groups processed on the main thread aren't split") {
+	LocalVector<int> deferred_order;
+	const int count = 1000;
+	Node *parent = create_independent_nodes(count, 0, &deferred_order);
+	parent->set_process_thread_group(Node::PROCESS_THREAD_GROUP_MAIN_THREAD);
+	parent->set_process_thread_parallel_nodes(true);
+	SceneTree::get_singleton()->get_root()->add_child(parent);
+
+	SceneTree::get_singleton()->process(0);
+
+	bool on_main_thread = true;
+	for (int i = 0; i < count; i++) {
+		const IndependentNode *node = Object::cast_to<IndependentNode>(parent->get_child(i));
+		on_main_thread &= node->process_counter == 1 && node->process_thread == Thread::get_main_id();
+	}
+	CHECK_MESSAGE(on_main_thread, "Nodes of a main thread group should all be processed on the main thread.");
+	CHECK(deferred_order.size() == (uint32_t)count);
+
+	memdelete(parent);
+}
+
+TEST_CASE("[SceneTree][ProcessThreadGroup][Benchmark] Process time compared to thread count" * doctest::skip()) {
+	const int count = 20000;
+	const uint32_t work_iterations = 200;
+	const int frames = 20;
+	// The shared pool is restarted with fewer threads, then restored to its
+	// original thread count so later tests aren't affected.
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	const int max_threads = pool->get_thread_count();
+
+	Node *parent = create_independent_nodes(count, work_iterations, nullptr);
+	SceneTree::get_singleton()->get_root()->add_child(parent);
+
+	TestBenchmark::measure("ProcessThreadGroup/main_thread_20k_nodes", frames, [&]() {
+		SceneTree::get_singleton()->process(0);
+	});
+
+	parent->set_process_thread_group(Node::PROCESS_THREAD_GROUP_SUB_THREAD);
+	TestBenchmark::measure("ProcessThreadGroup/sub_thread_20k_nodes", frames, [&]() {
+		SceneTree::get_singleton()->process(0);
+	});
+
+	parent->set_process_thread_parallel_nodes(true);
+	for (int threads = 1; threads <= max_threads; threads *= 2) {
+		pool->finish();
+		pool->init(threads);
+		TestBenchmark::measure(vformat("ProcessThreadGroup/parallel_nodes_20k_nodes_%d_threads", threads), frames, [&]() {
+			SceneTree::get_singleton()->process(0);
+		});
+	}
+	pool->finish();
+	pool->init(max_threads);
+
+	memdelete(parent);
+}
+
+} // namespace TestProcessThreadGroup
+
+#endif // TEST_PROCESS_THREAD_GROUP_H
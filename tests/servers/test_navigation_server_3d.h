@@ -35,6 +35,8 @@
 #include "scene/resources/3d/primitive_meshes.h"
 #include "servers/navigation_server_3d.h"
 
+#include "tests/test_benchmark.h"
+
 namespace TestNavigationServer3D {
 
 // TODO: Find a more generic way to create `Callable` mocks.
@@ -788,6 +790,44 @@ TEST_SUITE("[Navigation]") {
 		CHECK_EQ(navigation_mesh->get_vertices().size(), 0);
 	}
 	*/
+
+	TEST_CASE("[NavigationServer3D][Benchmark] Path and closest point queries" * doctest::skip()) {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+		Ref<NavigationMeshSourceGeometryData3D> source_geometry = memnew(NavigationMeshSourceGeometryData3D);
+
+		// A floor with a grid of pillars, so paths have to go around something.
+		Array arr;
+		arr.resize(RS::ARRAY_MAX);
+		BoxMesh::create_mesh_array(arr, Vector3(100.0, 0.001, 100.0));
+		source_geometry->add_mesh_array(arr, Transform3D());
+		BoxMesh::create_mesh_array(arr, Vector3(2.0, 4.0, 2.0));
+		for (int x = -4; x <= 4; x++) {
+			for (int z = -4; z <= 4; z++) {
+				source_geometry->add_mesh_array(arr, Transform3D(Basis(), Vector3(x * 10.0 + 5.0, 2.0, z * 10.0 + 5.0)));
+			}
+		}
+		navigation_server->bake_from_source_geometry_data(navigation_mesh, source_geometry, Callable());
+		REQUIRE_NE(navigation_mesh->get_polygon_count(), 0);
+
+		RID map = navigation_server->map_create();
+		RID region = navigation_server->region_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->region_set_map(region, map);
+		navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		TestBenchmark::measure("NavigationServer3D/map_get_path", 100, [&]() {
+			CHECK_NE(navigation_server->map_get_path(map, Vector3(-45, 0, -45), Vector3(45, 0, 45), true).size(), 0);
+		});
+		TestBenchmark::measure("NavigationServer3D/map_get_closest_point", 1000, [&]() {
+			navigation_server->map_get_closest_point(map, Vector3(12.5, 1.0, -33.0));
+		});
+
+		navigation_server->free(region);
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
 }
 } //namespace TestNavigationServer3D
 
@@ -0,0 +1,141 @@
+/**************************************************************************/
+/*  test_physics_server_2d.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_PHYSICS_SERVER_2D_H
+#define TEST_PHYSICS_SERVER_2D_H
+
+#include "servers/physics_server_2d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPhysicsServer2D {
+
+TEST_CASE("[PhysicsServer2D][SceneTree] Batched queries match single queries") {
+	PhysicsServer2D *physics_server = PhysicsServer2D::get_singleton();
+	LocalVector<RID> rids;
+	RID space = physics_server->space_create();
+	physics_server->space_set_active(space, true);
+	rids.push_back(space);
+
+	// A floor at y = 0, with the solid side below it as y points down.
+	RID floor_shape = physics_server->world_boundary_shape_create();
+	Array floor_data;
+	floor_data.push_back(Vector2(0, -1));
+	floor_data.push_back(0.0);
+	physics_server->shape_set_data(floor_shape, floor_data);
+	RID box_shape = physics_server->rectangle_shape_create();
+	physics_server->shape_set_data(box_shape, Vector2(0.5, 0.5));
+	rids.insert(0, floor_shape);
+	rids.insert(0, box_shape);
+
+	RID floor = physics_server->body_create();
+	physics_server->body_set_mode(floor, PhysicsServer2D::BODY_MODE_STATIC);
+	physics_server->body_add_shape(floor, floor_shape);
+	physics_server->body_set_space(floor, space);
+	rids.insert(0, floor);
+	for (int x = 0; x < 4; x++) {
+		RID box = physics_server->body_create();
+		physics_server->body_set_mode(box, PhysicsServer2D::BODY_MODE_STATIC);
+		physics_server->body_add_shape(box, box_shape);
+		physics_server->body_set_state(box, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0, Vector2(x * 4.0, -2.0)));
+		physics_server->body_set_space(box, space);
+		rids.insert(0, box);
+	}
+
+	PhysicsDirectSpaceState2D *space_state = physics_server->space_get_direct_state(space);
+	REQUIRE(space_state != nullptr);
+
+	// Enough queries to be split across threads, hitting the boxes, the floor, or nothing.
+	const int count = 100;
+	LocalVector<Vector2> from;
+	LocalVector<Vector2> to;
+	LocalVector<Transform2D> transforms;
+	LocalVector<Vector2> motions;
+	for (int i = 0; i < count; i++) {
+		const Vector2 origin = Vector2(i * 0.17, -5.0);
+		from.push_back(origin);
+		to.push_back(origin + Vector2(0, (i % 4 == 0) ? 2.0 : 10.0));
+		transforms.push_back(Transform2D(0, origin));
+		motions.push_back(Vector2(0, (i % 4 == 0) ? 1.0 : 10.0));
+	}
+
+	PhysicsDirectSpaceState2D::RayParameters ray_parameters;
+	LocalVector<PhysicsDirectSpaceState2D::RayResult> ray_results;
+	ray_results.resize(count);
+	const int hits = space_state->intersect_rays(ray_parameters, from.ptr(), to.ptr(), count, ray_results.ptr());
+
+	int expected_hits = 0;
+	for (int i = 0; i < count; i++) {
+		ray_parameters.from = from[i];
+		ray_parameters.to = to[i];
+		PhysicsDirectSpaceState2D::RayResult result;
+		const bool hit = space_state->intersect_ray(ray_parameters, result);
+		expected_hits += hit ? 1 : 0;
+		CHECK(ray_results[i].rid == (hit ? result.rid : RID()));
+		if (hit) {
+			CHECK(ray_results[i].position.is_equal_approx(result.position));
+			CHECK(ray_results[i].normal.is_equal_approx(result.normal));
+		}
+	}
+	CHECK(hits == expected_hits);
+	CHECK(hits > 0);
+	CHECK(hits < count);
+
+	RID circle_shape = physics_server->circle_shape_create();
+	physics_server->shape_set_data(circle_shape, 0.25);
+	rids.insert(0, circle_shape);
+
+	PhysicsDirectSpaceState2D::ShapeParameters shape_parameters;
+	shape_parameters.shape_rid = circle_shape;
+	LocalVector<real_t> closest_safe;
+	LocalVector<real_t> closest_unsafe;
+	closest_safe.resize(count);
+	closest_unsafe.resize(count);
+	CHECK(space_state->cast_motions(shape_parameters, transforms.ptr(), motions.ptr(), count, closest_safe.ptr(), closest_unsafe.ptr()));
+
+	for (int i = 0; i < count; i++) {
+		shape_parameters.transform = transforms[i];
+		shape_parameters.motion = motions[i];
+		real_t safe = 0.0;
+		real_t unsafe = 0.0;
+		space_state->cast_motion(shape_parameters, safe, unsafe);
+		CHECK(closest_safe[i] == doctest::Approx(safe));
+		CHECK(closest_unsafe[i] == doctest::Approx(unsafe));
+	}
+
+	// Bodies before their shapes, the space last.
+	for (const RID &rid : rids) {
+		physics_server->free(rid);
+	}
+}
+
+} // namespace TestPhysicsServer2D
+
+#endif // TEST_PHYSICS_SERVER_2D_H
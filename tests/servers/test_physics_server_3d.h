@@ -0,0 +1,679 @@
+/**************************************************************************/
+/*  test_physics_server_3d.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_PHYSICS_SERVER_3D_H
+#define TEST_PHYSICS_SERVER_3D_H
+
+#include "core/io/marshalls.h"
+#include "servers/physics_server_3d.h"
+
+#include "tests/test_benchmark.h"
+#include "tests/test_macros.h"
+
+namespace TestPhysicsServer3D {
+
+// A static floor at y = 0 in a new active space, with the usual gravity.
+static RID create_space_with_floor(LocalVector<RID> &r_rids) {
+	PhysicsServer3D *physics_server = PhysicsServer3D::get_singleton();
+	RID space = physics_server->space_create();
+	physics_server->space_set_active(space, true);
+	physics_server->area_set_param(space, PhysicsServer3D::AREA_PARAM_GRAVITY, 9.8);
+	physics_server->area_set_param(space, PhysicsServer3D::AREA_PARAM_GRAVITY_VECTOR, Vector3(0, -1, 0));
+
+	RID floor_shape = physics_server->world_boundary_shape_create();
+	physics_server->shape_set_data(floor_shape, Plane(Vector3(0, 1, 0), 0));
+	RID floor = physics_server->body_create();
+	physics_server->body_set_mode(floor, PhysicsServer3D::BODY_MODE_STATIC);
+	physics_server->body_add_shape(floor, floor_shape);
+	physics_server->body_set_space(floor, space);
+
+	r_rids.push_back(floor);
+	r_rids.push_back(floor_shape);
+	r_rids.push_back(space);
+	return space;
+}
+
+static RID create_box(RID p_space, RID p_shape, const Vector3 &p_position) {
+	PhysicsServer3D *physics_server = PhysicsServer3D::get_singleton();
+	RID body = physics_server->body_create();
+	physics_server->body_set_mode(body, PhysicsServer3D::BODY_MODE_RIGID);
+	physics_server->body_add_shape(body, p_shape);
+	physics_server->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), p_position));
+	physics_server->body_set_space(body, p_space);
+	return body;
+}
+
+static void free_rids(LocalVector<RID> &p_rids) {
+	// Bodies first, spaces last.
+	for (const RID &rid : p_rids) {
+		PhysicsServer3D::get_singleton()->free(rid);
+	}
+	p_rids.clear();
+}
+
+TEST_CASE("[PhysicsServer3D][SceneTree] Rigid bodies fall and rest on the floor") {
+	PhysicsServer3D *physics_server = PhysicsServer3D::get_singleton();
+	LocalVector<RID> rids;
+	RID space = create_space_with_floor(rids);
+
+	RID box_shape = physics_server->box_shape_create();
+	physics_server->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+	RID box = create_box(space, box_shape, Vector3(0, 5, 0));
+	rids.insert(0, box);
+	rids.insert(1, box_shape);
+
+	for (int i = 0; i < 240; i++) {
+		physics_server->step(1.0 / 60.0);
+	}
+
+	const Transform3D transform = physics_server->body_get_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM);
+	CHECK(transform.origin.y == doctest::Approx(0.5).epsilon(0.05));
+	CHECK(transform.origin.x == doctest::Approx(0.0));
+
+	free_rids(rids);
+}
+
+TEST_CASE("[PhysicsServer3D][SceneTree] Broadphase pairs follow moving bodies") {
+	PhysicsServer3D *physics_server = PhysicsServer3D::get_singleton();
+	LocalVector<RID> rids;
+	RID space = create_space_with_floor(rids);
+
+	RID box_shape = physics_server->box_shape_create();
+	physics_server->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+	// Enough moving bodies for the pairs to be found on several threads.
+	LocalVector<RID> top_boxes;
+	LocalVector<RID> boxes;
+	for (int x = 0; x < 10; x++) {
+		for (int z = 0; z < 10; z++) {
+			boxes.push_back(create_box(space, box_shape, Vector3(x * 4.0, 0.5, z * 4.0)));
+			RID top_box = create_box(space, box_shape, Vector3(x * 4.0, 1.5, z * 4.0));
+			boxes.push_back(top_box);
+			top_boxes.push_back(top_box);
+		}
+	}
+
+	for (int i = 0; i < 10; i++) {
+		physics_server->step(1.0 / 60.0);
+	}
+	// Every box with the floor, and each stack with itself.
+	CHECK(physics_server->get_process_info(PhysicsServer3D::INFO_COLLISION_PAIRS) == 300);
+
+	for (const RID &top_box : top_boxes) {
+		const Transform3D transform = physics_server->body_get_state(top_box, PhysicsServer3D::BODY_STATE_TRANSFORM);
+		physics_server->body_set_state(top_box, PhysicsServer3D::BODY_STATE_TRANSFORM, transform.translated(Vector3(0, 10, 0)));
+	}
+	physics_server->step(1.0 / 60.0);
+	CHECK_MESSAGE(physics_server->get_process_info(PhysicsServer3D::INFO_COLLISION_PAIRS) == 200, "The stacks should no longer be paired.");
+
+	for (const RID &box : boxes) {
+		physics_server->free(box);
+	}
+	physics_server->free(box_shape);
+	physics_server->step(1.0 / 60.0);
+	CHECK(physics_server->get_process_info(PhysicsServer3D::INFO_COLLISION_PAIRS) == 0);
+	free_rids(rids);
+}
+
+TEST_CASE("[PhysicsServer3D][SceneTree][Benchmark] Steps with falling and resting boxes" * doctest::skip()) {
+	PhysicsServer3D *physics_server = PhysicsServer3D::get_singleton();
+	LocalVector<RID> rids;
+	RID space = create_space_with_floor(rids);
+
+	RID box_shape = physics_server->box_shape_create();
+	physics_server->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+	LocalVector<RID> boxes;
+	// Stacks of boxes, far enough apart to make separate islands.
+	for (int x = 0; x < 10; x++) {
+		for (int z = 0; z < 10; z++) {
+			for (int y = 0; y < 5; y++) {
+				RID box = create_box(space, box_shape, Vector3(x * 3.0, 0.5 + y * 1.01, z * 3.0));
+				// Keep the stacks simulated, rather than measuring sleeping bodies.
+				physics_server->body_set_state(box, PhysicsServer3D::BODY_STATE_CAN_SLEEP, false);
+				boxes.push_back(box);
+			}
+		}
+	}
+
+	TestBenchmark::measure("PhysicsServer3D/step_500_boxes", 60, [&]() {
+		physics_server->step(1.0 / 60.0);
+	});
+
+	for (const RID &box : boxes) {
+		physics_server->free(box);
+	}
+	physics_server->free(box_shape);
+	free_rids(rids);
+}
+
+TEST_CASE("[PhysicsServer3D][SceneTree] Islands fall asleep and wake up together") {
+	PhysicsServer3D *physics_server = PhysicsServer3D::get_singleton();
+	LocalVector<RID> rids;
+	RID space = create_space_with_floor(rids);
+
+	RID box_shape = physics_server->box_shape_create();
+	physics_server->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+	// Two stacks, far enough apart to be separate islands.
+	LocalVector<RID> stack_a;
+	LocalVector<RID> stack_b;
+	for (int y = 0; y < 3; y++) {
+		stack_a.push_back(create_box(space, box_shape, Vector3(0, 0.5 + y * 1.01, 0)));
+		stack_b.push_back(create_box(space, box_shape, Vector3(10, 0.5 + y * 1.01, 0)));
+	}
+
+	for (int i = 0; i < 300; i++) {
+		physics_server->step(1.0 / 60.0);
+	}
+	for (uint32_t i = 0; i < stack_a.size(); i++) {
+		CHECK(bool(physics_server->body_get_state(stack_a[i], PhysicsServer3D::BODY_STATE_SLEEPING)));
+		CHECK(bool(physics_server->body_get_state(stack_b[i], PhysicsServer3D::BODY_STATE_SLEEPING)));
+	}
+
+	// Waking the top box wakes the boxes it rests on, but not the other stack.
+	physics_server->body_apply_central_impulse(stack_a[2], Vector3(2, 0, 0));
+	physics_server->step(1.0 / 60.0);
+	for (uint32_t i = 0; i < stack_a.size(); i++) {
+		CHECK_FALSE(bool(physics_server->body_get_state(stack_a[i], PhysicsServer3D::BODY_STATE_SLEEPING)));
+		CHECK(bool(physics_server->body_get_state(stack_b[i], PhysicsServer3D::BODY_STATE_SLEEPING)));
+	}
+
+	for (uint32_t i = 0; i < stack_a.size(); i++) {
+		physics_server->free(stack_a[i]);
+		physics_server->free(stack_b[i]);
+	}
+	physics_server->free(box_shape);
+	free_rids(rids);
+}
+
+TEST_CASE("[PhysicsServer3D][SceneTree] Batched queries match single queries") {
+	PhysicsServer3D *physics_server = PhysicsServer3D::get_singleton();
+	LocalVector<RID> rids;
+	RID space = create_space_with_floor(rids);
+
+	RID box_shape = physics_server->box_shape_create();
+	physics_server->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+	for (int x = 0; x < 4; x++) {
+		RID box = physics_server->body_create();
+		physics_server->body_set_mode(box, PhysicsServer3D::BODY_MODE_STATIC);
+		physics_server->body_add_shape(box, box_shape);
+		physics_server->body_set_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(x * 4.0, 2.0, 0)));
+		physics_server->body_set_space(box, space);
+		rids.insert(0, box);
+	}
+	rids.insert(0, box_shape);
+
+	PhysicsDirectSpaceState3D *space_state = physics_server->space_get_direct_state(space);
+	REQUIRE(space_state != nullptr);
+
+	// Enough queries to be split across threads, hitting the boxes, the floor, or nothing.
+	const int count = 100;
+	LocalVector<Vector3> from;
+	LocalVector<Vector3> to;
+	LocalVector<Transform3D> transforms;
+	LocalVector<Vector3> motions;
+	for (int i = 0; i < count; i++) {
+		const Vector3 origin = Vector3(i * 0.17, 5.0, (i % 3) * 0.4);
+		from.push_back(origin);
+		to.push_back(origin + Vector3(0, (i % 4 == 0) ? -2.0 : -10.0, 0));
+		transforms.push_back(Transform3D(Basis(), origin));
+		motions.push_back(Vector3(0, (i % 4 == 0) ? -1.0 : -10.0, 0));
+	}
+
+	PhysicsDirectSpaceState3D::RayParameters ray_parameters;
+	LocalVector<PhysicsDirectSpaceState3D::RayResult> ray_results;
+	ray_results.resize(count);
+	const int hits = space_state->intersect_rays(ray_parameters, from.ptr(), to.ptr(), count, ray_results.ptr());
+
+	int expected_hits = 0;
+	for (int i = 0; i < count; i++) {
+		ray_parameters.from = from[i];
+		ray_parameters.to = to[i];
+		PhysicsDirectSpaceState3D::RayResult result;
+		const bool hit = space_state->intersect_ray(ray_parameters, result);
+		expected_hits += hit ? 1 : 0;
+		CHECK(ray_results[i].rid == (hit ? result.rid : RID()));
+		if (hit) {
+			CHECK(ray_results[i].position.is_equal_approx(result.position));
+			CHECK(ray_results[i].normal.is_equal_approx(result.normal));
+		}
+	}
+	CHECK(hits == expected_hits);
+	CHECK(hits > 0);
+	CHECK(hits < count);
+
+	RID sphere_shape = physics_server->sphere_shape_create();
+	physics_server->shape_set_data(sphere_shape, 0.25);
+	rids.insert(0, sphere_shape);
+
+	PhysicsDirectSpaceState3D::ShapeParameters shape_parameters;
+	shape_parameters.shape_rid = sphere_shape;
+	LocalVector<real_t> closest_safe;
+	LocalVector<real_t> closest_unsafe;
+	closest_safe.resize(count);
+	closest_unsafe.resize(count);
+	CHECK(space_state->cast_motions(shape_parameters, transforms.ptr(), motions.ptr(), count, closest_safe.ptr(), closest_unsafe.ptr()));
+
+	for (int i = 0; i < count; i++) {
+		shape_parameters.transform = transforms[i];
+		shape_parameters.motion = motions[i];
+		real_t safe = 0.0;
+		real_t unsafe = 0.0;
+		space_state->cast_motion(shape_parameters, safe, unsafe);
+		CHECK(closest_safe[i] == doctest::Approx(safe));
+		CHECK(closest_unsafe[i] == doctest::Approx(unsafe));
+	}
+
+	free_rids(rids);
+}
+
+TEST_CASE("[PhysicsServer3D][SceneTree][Benchmark] Single and batched raycasts" * doctest::skip()) {
+	PhysicsServer3D *physics_server = PhysicsServer3D::get_singleton();
+	LocalVector<RID> rids;
+	RID space = create_space_with_floor(rids);
+
+	RID box_shape = physics_server->box_shape_create();
+	physics_server->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+	for (int x = 0; x < 20; x++) {
+		for (int z = 0; z < 20; z++) {
+			RID box = physics_server->body_create();
+			physics_server->body_set_mode(box, PhysicsServer3D::BODY_MODE_STATIC);
+			physics_server->body_add_shape(box, box_shape);
+			physics_server->body_set_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(x * 2.0, 0.5, z * 2.0)));
+			physics_server->body_set_space(box, space);
+			rids.insert(0, box);
+		}
+	}
+	rids.insert(0, box_shape);
+
+	PhysicsDirectSpaceState3D *space_state = physics_server->space_get_direct_state(space);
+	const int count = 10000;
+	LocalVector<Vector3> from;
+	LocalVector<Vector3> to;
+	for (int i = 0; i < count; i++) {
+		const Vector3 origin = Vector3((i % 100) * 0.4, 10.0, (i / 100) * 0.4);
+		from.push_back(origin);
+		to.push_back(origin + Vector3(1.0, -20.0, 0.5));
+	}
+
+	PhysicsDirectSpaceState3D::RayParameters ray_parameters;
+	LocalVector<PhysicsDirectSpaceState3D::RayResult> ray_results;
+	ray_results.resize(count);
+
+	TestBenchmark::measure("PhysicsServer3D/intersect_ray_10k", 10, [&]() {
+		for (int i = 0; i < count; i++) {
+			ray_parameters.from = from[i];
+			ray_parameters.to = to[i];
+			space_state->intersect_ray(ray_parameters, ray_results[i]);
+		}
+	});
+
+	TestBenchmark::measure("PhysicsServer3D/intersect_rays_10k", 10, [&]() {
+		space_state->intersect_rays(ray_parameters, from.ptr(), to.ptr(), count, ray_results.ptr());
+	});
+
+	free_rids(rids);
+}
+
+// Static bodies of each primitive shape type, 10 units apart along x.
+static void create_shape_bodies(RID p_space, LocalVector<RID> &r_shapes, LocalVector<RID> &r_rids) {
+	PhysicsServer3D *physics_server = PhysicsServer3D::get_singleton();
+
+	RID sphere = physics_server->sphere_shape_create();
+	physics_server->shape_set_data(sphere, 0.5);
+	RID box = physics_server->box_shape_create();
+	physics_server->shape_set_data(box, Vector3(0.5, 0.5, 0.5));
+	RID capsule = physics_server->capsule_shape_create();
+	Dictionary capsule_data;
+	capsule_data["radius"] = 0.5;
+	capsule_data["height"] = 3.0;
+	physics_server->shape_set_data(capsule, capsule_data);
+	RID cylinder = physics_server->cylinder_shape_create();
+	Dictionary cylinder_data;
+	cylinder_data["radius"] = 0.5;
+	cylinder_data["height"] = 2.0;
+	physics_server->shape_set_data(cylinder, cylinder_data);
+	RID convex = physics_server->convex_polygon_shape_create();
+	PackedVector3Array convex_points;
+	for (int i = 0; i < 8; i++) {
+		convex_points.push_back(Vector3(i & 1 ? 0.5 : -0.5, i & 2 ? 0.5 : -0.5, i & 4 ? 0.5 : -0.5));
+	}
+	convex_points.push_back(Vector3(0.0, 0.8, 0.0));
+	physics_server->shape_set_data(convex, convex_points);
+
+	r_shapes = LocalVector<RID>({ sphere, box, capsule, cylinder, convex });
+	for (const RID &shape : r_shapes) {
+		r_rids.insert(0, shape);
+	}
+	for (uint32_t i = 0; i < r_shapes.size(); i++) {
+		RID body = physics_server->body_create();
+		physics_server->body_set_mode(body, PhysicsServer3D::BODY_MODE_STATIC);
+		physics_server->body_add_shape(body, r_shapes[i]);
+		physics_server->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(i * 10.0, 0.0, 0.0)));
+		physics_server->body_set_space(body, p_space);
+		r_rids.insert(0, body);
+	}
+}
+
+TEST_CASE("[PhysicsServer3D][SceneTree] Contacts between primitive shapes") {
+	PhysicsServer3D *physics_server = PhysicsServer3D::get_singleton();
+	LocalVector<RID> rids;
+	RID space = physics_server->space_create();
+	physics_server->space_set_active(space, true);
+	rids.push_back(space);
+	LocalVector<RID> shapes;
+	create_shape_bodies(space, shapes, rids);
+	PhysicsDirectSpaceState3D *space_state = physics_server->space_get_direct_state(space);
+
+	PhysicsDirectSpaceState3D::ShapeParameters parameters;
+	Vector3 results[16];
+	int result_count = 0;
+
+	SUBCASE("Sphere resting on a box") {
+		parameters.shape_rid = shapes[0];
+		parameters.transform = Transform3D(Basis(), Vector3(10.3, 0.9, 0.2));
+		CHECK(space_state->collide_shape(parameters, results, 8, result_count));
+		REQUIRE(result_count == 1);
+		CHECK(results[0].is_equal_approx(Vector3(10.3, 0.4, 0.2)));
+		CHECK(results[1].is_equal_approx(Vector3(10.3, 0.5, 0.2)));
+	}
+
+	SUBCASE("Box resting on a box") {
+		parameters.shape_rid = shapes[1];
+		parameters.transform = Transform3D(Basis(), Vector3(10.2, 0.9, 0.0));
+		CHECK(space_state->collide_shape(parameters, results, 8, result_count));
+		CHECK(result_count == 4);
+		for (int i = 0; i < result_count; i++) {
+			CHECK(Math::is_equal_approx(results[i * 2 + 1].y - results[i * 2].y, (real_t)0.1));
+		}
+
+		// Separated along a pair of edges only, with overlapping bounds.
+		parameters.transform = Transform3D(Basis(Vector3(0, 0, 1), Math_PI / 4.0).rotated(Vector3(1, 0, 0), Math_PI / 4.0), Vector3(10.0, 1.2, 1.2));
+		CHECK_FALSE(space_state->collide_shape(parameters, results, 8, result_count));
+		CHECK(result_count == 0);
+	}
+
+	SUBCASE("Capsule next to a parallel capsule") {
+		parameters.shape_rid = shapes[2];
+		parameters.transform = Transform3D(Basis(), Vector3(20.9, 0.5, 0.0));
+		CHECK(space_state->collide_shape(parameters, results, 8, result_count));
+		REQUIRE_MESSAGE(result_count == 2, "Parallel capsules should touch at both ends of their overlap.");
+		CHECK(results[0].is_equal_approx(Vector3(20.4, -0.5, 0.0)));
+		CHECK(results[1].is_equal_approx(Vector3(20.5, -0.5, 0.0)));
+		CHECK(results[2].is_equal_approx(Vector3(20.4, 1.0, 0.0)));
+		CHECK(results[3].is_equal_approx(Vector3(20.5, 1.0, 0.0)));
+	}
+
+	free_rids(rids);
+}
+
+TEST_CASE("[PhysicsServer3D][SceneTree][Benchmark] Narrowphase between primitive shapes" * doctest::skip()) {
+	PhysicsServer3D *physics_server = PhysicsServer3D::get_singleton();
+	LocalVector<RID> rids;
+	RID space = physics_server->space_create();
+	physics_server->space_set_active(space, true);
+	rids.push_back(space);
+	LocalVector<RID> shapes;
+	create_shape_bodies(space, shapes, rids);
+	PhysicsDirectSpaceState3D *space_state = physics_server->space_get_direct_state(space);
+
+	const char *shape_names[] = { "sphere", "box", "capsule", "cylinder", "convex" };
+	PhysicsDirectSpaceState3D::ShapeParameters parameters;
+	Vector3 results[16];
+	int result_count = 0;
+
+	// Each iteration tests one pair of overlapping shapes, slightly rotated.
+	for (uint32_t i = 0; i < shapes.size(); i++) {
+		for (uint32_t j = 0; j < shapes.size(); j++) {
+			parameters.shape_rid = shapes[i];
+			parameters.transform = Transform3D(Basis::from_euler(Vector3(0.1, 0.2, 0.3)), Vector3(j * 10.0 + 0.1, 0.8, 0.1));
+			REQUIRE(space_state->collide_shape(parameters, results, 8, result_count));
+
+			TestBenchmark::measure(vformat("PhysicsServer3D/narrowphase_%s_%s", shape_names[i], shape_names[j]), 10000, [&]() {
+				space_state->collide_shape(parameters, results, 8, result_count);
+			});
+		}
+	}
+
+	free_rids(rids);
+}
+
+// Faces of a bumpy grid of p_size by p_size quads, one unit wide, facing up.
+static PackedVector3Array create_terrain_faces(int p_size) {
+	PackedVector3Array faces;
+	faces.resize(p_size * p_size * 6);
+	Vector3 *w = faces.ptrw();
+	int index = 0;
+	for (int z = 0; z < p_size; z++) {
+		for (int x = 0; x < p_size; x++) {
+			Vector3 corners[4];
+			for (int i = 0; i < 4; i++) {
+				const int corner_x = x + (i & 1);
+				const int corner_z = z + (i >> 1);
+				corners[i] = Vector3(corner_x, Math::sin(corner_x * 0.37) * Math::cos(corner_z * 0.21) * 2.0, corner_z);
+			}
+			w[index++] = corners[0];
+			w[index++] = corners[1];
+			w[index++] = corners[3];
+			w[index++] = corners[0];
+			w[index++] = corners[3];
+			w[index++] = corners[2];
+		}
+	}
+	return faces;
+}
+
+static RID create_concave_shape(const PackedVector3Array &p_faces, const PackedByteArray &p_bvh_data = PackedByteArray()) {
+	RID shape = PhysicsServer3D::get_singleton()->concave_polygon_shape_create();
+	Dictionary data;
+	data["faces"] = p_faces;
+	data["backface_collision"] = false;
+	if (!p_bvh_data.is_empty()) {
+		data["bvh"] = p_bvh_data;
+	}
+	PhysicsServer3D::get_singleton()->shape_set_data(shape, data);
+	return shape;
+}
+
+TEST_CASE("[PhysicsServer3D][SceneTree] Concave polygon shape queries and baked BVH") {
+	PhysicsServer3D *physics_server = PhysicsServer3D::get_singleton();
+	LocalVector<RID> rids;
+	RID space = physics_server->space_create();
+	physics_server->space_set_active(space, true);
+	rids.push_back(space);
+
+	// Large enough for the BVH to be built in parallel.
+	const int size = 100;
+	const PackedVector3Array faces = create_terrain_faces(size);
+	const int face_count = faces.size() / 3;
+
+	RID shape = create_concave_shape(faces);
+	const PackedByteArray bvh_data = Dictionary(physics_server->shape_get_data(shape)).get("bvh", PackedByteArray());
+	REQUIRE_FALSE(bvh_data.is_empty());
+	CHECK_MESSAGE(bvh_data.size() < face_count * 16, "The BVH should take less than 16 bytes per face.");
+
+	// Data baked for other faces is ignored, and the BVH is built again.
+	PackedVector3Array other_faces = faces;
+	other_faces.set(0, other_faces[0] + Vector3(0, 0.5, 0));
+	RID other_shape = create_concave_shape(other_faces, bvh_data);
+	RID other_built_shape = create_concave_shape(other_faces);
+	CHECK(Dictionary(physics_server->shape_get_data(other_shape))["bvh"] == Dictionary(physics_server->shape_get_data(other_built_shape))["bvh"]);
+	CHECK(Dictionary(physics_server->shape_get_data(other_shape))["bvh"] != Variant(bvh_data));
+	rids.insert(0, other_shape);
+	rids.insert(0, other_built_shape);
+
+	// Bodies with a built shape, with the baked BVH, and with broken data, which must be rebuilt.
+	LocalVector<RID> shapes;
+	shapes.push_back(shape);
+	shapes.push_back(create_concave_shape(faces, bvh_data));
+	PackedByteArray wrong_version = bvh_data;
+	wrong_version.set(0, wrong_version[0] + 1);
+	shapes.push_back(create_concave_shape(faces, wrong_version));
+	PackedByteArray wrong_size = bvh_data;
+	wrong_size.resize(wrong_size.size() - 4);
+	shapes.push_back(create_concave_shape(faces, wrong_size));
+	// Right child of the root node past the end of the tree.
+	PackedByteArray wrong_tree = bvh_data;
+	encode_uint32(0xFFFFFFF8, wrong_tree.ptrw() + 32);
+	ERR_PRINT_OFF;
+	shapes.push_back(create_concave_shape(faces, wrong_tree));
+	ERR_PRINT_ON;
+
+	for (uint32_t i = 0; i < shapes.size(); i++) {
+		RID body = physics_server->body_create();
+		physics_server->body_set_mode(body, PhysicsServer3D::BODY_MODE_STATIC);
+		physics_server->body_add_shape(body, shapes[i]);
+		physics_server->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(0, i * 10.0, 0)));
+		physics_server->body_set_space(body, space);
+		rids.insert(0, shapes[i]);
+		rids.insert(0, body);
+	}
+
+	PhysicsDirectSpaceState3D *space_state = physics_server->space_get_direct_state(space);
+	const Vector3 *face_vertices = faces.ptr();
+
+	for (int i = 0; i < 200; i++) {
+		// Inside of the faces, away from their edges.
+		const Vector3 origin = Vector3((i * 37) % size + 0.3, 0.0, (i * 53) % size + 0.6);
+
+		// Closest hit of a segment going down and sideways, tested against every face.
+		const Vector3 motion = Vector3(0.2, -10.0, 0.1);
+		int expected_face = -1;
+		Vector3 expected_position;
+		for (int j = 0; j < face_count; j++) {
+			Vector3 position;
+			if (Geometry3D::segment_intersects_triangle(origin + Vector3(0, 5, 0), origin + Vector3(0, 5, 0) + motion, face_vertices[j * 3], face_vertices[j * 3 + 1], face_vertices[j * 3 + 2], &position)) {
+				if (expected_face == -1 || position.y > expected_position.y) {
+					expected_face = j;
+					expected_position = position;
+				}
+			}
+		}
+		REQUIRE(expected_face != -1);
+
+		for (uint32_t j = 0; j < shapes.size(); j++) {
+			const Vector3 offset = Vector3(0, j * 10.0, 0);
+			PhysicsDirectSpaceState3D::RayParameters parameters;
+			parameters.from = origin + offset + Vector3(0, 5, 0);
+			parameters.to = parameters.from + motion;
+			PhysicsDirectSpaceState3D::RayResult result;
+			REQUIRE(space_state->intersect_ray(parameters, result));
+			CHECK(result.face_index == expected_face);
+			CHECK(result.position.is_equal_approx(expected_position + offset));
+		}
+	}
+
+	// Boxes resting on the terrain touch it, boxes above it don't.
+	RID box_shape = physics_server->box_shape_create();
+	physics_server->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+	rids.insert(0, box_shape);
+	PhysicsDirectSpaceState3D::ShapeParameters shape_parameters;
+	shape_parameters.shape_rid = box_shape;
+	Vector3 results[32];
+	int result_count = 0;
+	for (uint32_t j = 0; j < shapes.size(); j++) {
+		shape_parameters.transform = Transform3D(Basis(), Vector3(50.5, j * 10.0 + 2.6, 50.5));
+		CHECK_FALSE(space_state->collide_shape(shape_parameters, results, 16, result_count));
+		shape_parameters.transform = Transform3D(Basis(), Vector3(50.5, j * 10.0 + 0.5, 50.5));
+		CHECK(space_state->collide_shape(shape_parameters, results, 16, result_count));
+		CHECK(result_count > 0);
+	}
+
+	free_rids(rids);
+}
+
+TEST_CASE("[PhysicsServer3D][SceneTree][Benchmark] Concave polygon shape BVH" * doctest::skip()) {
+	PhysicsServer3D *physics_server = PhysicsServer3D::get_singleton();
+	LocalVector<RID> rids;
+	RID space = physics_server->space_create();
+	physics_server->space_set_active(space, true);
+	rids.push_back(space);
+
+	const int size = 500;
+	const PackedVector3Array faces = create_terrain_faces(size);
+	const int face_count = faces.size() / 3;
+
+	RID shape = physics_server->concave_polygon_shape_create();
+	Dictionary data;
+	data["faces"] = faces;
+	data["backface_collision"] = false;
+	TestBenchmark::measure("PhysicsServer3D/concave_build_500k", 1, [&]() {
+		physics_server->shape_set_data(shape, data);
+	});
+
+	const uint64_t memory_before = Memory::get_mem_usage();
+	RID memory_shape = create_concave_shape(faces);
+	const uint64_t memory_after = Memory::get_mem_usage();
+	physics_server->free(memory_shape);
+	const PackedByteArray bvh_data = Dictionary(physics_server->shape_get_data(shape))["bvh"];
+	MESSAGE(vformat("Concave polygon shape: %.1f bytes per face, %.1f for the BVH.", double(memory_after - memory_before) / face_count, double(bvh_data.size()) / face_count));
+
+	data["bvh"] = bvh_data;
+	TestBenchmark::measure("PhysicsServer3D/concave_load_baked_500k", 1, [&]() {
+		physics_server->shape_set_data(shape, data);
+	});
+
+	RID body = physics_server->body_create();
+	physics_server->body_set_mode(body, PhysicsServer3D::BODY_MODE_STATIC);
+	physics_server->body_add_shape(body, shape);
+	physics_server->body_set_space(body, space);
+	rids.insert(0, shape);
+	rids.insert(0, body);
+
+	RID box_shape = physics_server->box_shape_create();
+	physics_server->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+	rids.insert(0, box_shape);
+
+	PhysicsDirectSpaceState3D *space_state = physics_server->space_get_direct_state(space);
+	PhysicsDirectSpaceState3D::RayParameters ray_parameters;
+	PhysicsDirectSpaceState3D::RayResult ray_result;
+	TestBenchmark::measure("PhysicsServer3D/concave_intersect_ray_10k", 1, [&]() {
+		for (int i = 0; i < 10000; i++) {
+			ray_parameters.from = Vector3((i * 37) % size + 0.3, 5.0, (i * 53) % size + 0.6);
+			ray_parameters.to = ray_parameters.from + Vector3(3.0, -10.0, 2.0);
+			space_state->intersect_ray(ray_parameters, ray_result);
+		}
+	});
+
+	PhysicsDirectSpaceState3D::ShapeParameters shape_parameters;
+	shape_parameters.shape_rid = box_shape;
+	Vector3 results[32];
+	int result_count = 0;
+	TestBenchmark::measure("PhysicsServer3D/concave_collide_box_1k", 1, [&]() {
+		for (int i = 0; i < 1000; i++) {
+			shape_parameters.transform = Transform3D(Basis(), Vector3((i * 37) % size + 0.5, 1.0, (i * 53) % size + 0.5));
+			space_state->collide_shape(shape_parameters, results, 16, result_count);
+		}
+	});
+
+	free_rids(rids);
+}
+
+} // namespace TestPhysicsServer3D
+
+#endif // TEST_PHYSICS_SERVER_3D_H
@@ -0,0 +1,187 @@
+/**************************************************************************/
+/*  test_benchmark.cpp                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/test_benchmark.h"
+
+#include "core/io/file_access.h"
+#include "core/io/json.h"
+#include "core/templates/sort_array.h"
+#include "core/version.h"
+
+namespace TestBenchmark {
+
+static bool enabled = false;
+static uint32_t sample_count = 10;
+static String output_path;
+static String baseline_path;
+static double threshold = 10.0;
+static LocalVector<Result> results;
+
+bool is_enabled() {
+	return enabled;
+}
+
+uint32_t get_sample_count() {
+	return sample_count;
+}
+
+void add_result(const String &p_name, uint32_t p_iterations, const LocalVector<uint64_t> &p_sample_usec) {
+	ERR_FAIL_COND(p_iterations == 0 || p_sample_usec.is_empty());
+
+	LocalVector<double> samples;
+	samples.resize(p_sample_usec.size());
+	for (uint32_t i = 0; i < p_sample_usec.size(); i++) {
+		samples[i] = double(p_sample_usec[i]) / p_iterations;
+	}
+	SortArray<double> sorter;
+	sorter.sort(samples.ptr(), samples.size());
+
+	Result result;
+	result.name = p_name;
+	result.iterations = p_iterations;
+	result.min = samples[0];
+	result.max = samples[samples.size() - 1];
+	const uint32_t half = samples.size() / 2;
+	result.median = (samples.size() % 2) ? samples[half] : (samples[half - 1] + samples[half]) * 0.5;
+
+	double sum = 0.0;
+	for (double sample : samples) {
+		sum += sample;
+	}
+	result.mean = sum / samples.size();
+	double variance = 0.0;
+	for (double sample : samples) {
+		variance += (sample - result.mean) * (sample - result.mean);
+	}
+	result.stddev = samples.size() > 1 ? Math::sqrt(variance / (samples.size() - 1)) : 0.0;
+
+	for (const Result &E : results) {
+		if (E.name == p_name) {
+			WARN_PRINT(vformat("Benchmark \"%s\" was measured more than once, only the first result is compared to the baseline.", p_name));
+			break;
+		}
+	}
+	results.push_back(result);
+
+	print_line(vformat("%s: median %.3f usec, mean %.3f usec (stddev %.3f), min %.3f usec, max %.3f usec.", p_name, result.median, result.mean, result.stddev, result.min, result.max));
+}
+
+static Dictionary _result_to_dictionary(const Result &p_result) {
+	Dictionary dict;
+	dict["iterations"] = p_result.iterations;
+	dict["min_usec"] = p_result.min;
+	dict["median_usec"] = p_result.median;
+	dict["mean_usec"] = p_result.mean;
+	dict["stddev_usec"] = p_result.stddev;
+	dict["max_usec"] = p_result.max;
+	return dict;
+}
+
+void setup(const List<String> &p_args) {
+	enabled = true;
+	for (const List<String>::Element *E = p_args.front(); E; E = E->next()) {
+		const List<String>::Element *N = E->next();
+		if (!N) {
+			break;
+		}
+		if (E->get() == "--benchmark-samples") {
+			sample_count = MAX(N->get().to_int(), 1);
+		} else if (E->get() == "--benchmark-output") {
+			output_path = N->get();
+		} else if (E->get() == "--benchmark-baseline") {
+			baseline_path = N->get();
+		} else if (E->get() == "--benchmark-threshold") {
+			threshold = MAX(N->get().to_float(), 0.0);
+		}
+	}
+}
+
+int finish() {
+	ERR_FAIL_COND_V(!enabled, EXIT_FAILURE);
+
+	Dictionary benchmarks;
+	for (const Result &result : results) {
+		if (!benchmarks.has(result.name)) {
+			benchmarks[result.name] = _result_to_dictionary(result);
+		}
+	}
+
+	if (!output_path.is_empty()) {
+		Dictionary report;
+		report["version"] = VERSION_FULL_BUILD;
+		report["samples"] = sample_count;
+		report["benchmarks"] = benchmarks;
+
+		Error err = OK;
+		Ref<FileAccess> f = FileAccess::open(output_path, FileAccess::WRITE, &err);
+		ERR_FAIL_COND_V_MSG(err != OK, EXIT_FAILURE, "Can't open benchmark output file: " + output_path);
+		f->store_string(JSON::stringify(report, "\t", true, true));
+		print_line(vformat("Benchmark results saved to: %s", output_path));
+	}
+
+	if (baseline_path.is_empty()) {
+		return EXIT_SUCCESS;
+	}
+
+	const Variant baseline = JSON::parse_string(FileAccess::get_file_as_string(baseline_path));
+	ERR_FAIL_COND_V_MSG(baseline.get_type() != Variant::DICTIONARY, EXIT_FAILURE, "Invalid benchmark baseline file: " + baseline_path);
+	const Dictionary baseline_benchmarks = Dictionary(baseline).get("benchmarks", Dictionary());
+
+	int regressions = 0;
+	print_line(vformat("Comparing to %s (threshold: %.1f%%):", baseline_path, threshold));
+	for (const Variant *key = benchmarks.next(nullptr); key; key = benchmarks.next(key)) {
+		const Dictionary current = benchmarks[*key];
+		if (!baseline_benchmarks.has(*key)) {
+			print_line(vformat("  %s: new, not in the baseline.", *key));
+			continue;
+		}
+
+		const Dictionary previous = baseline_benchmarks[*key];
+		const double current_median = current["median_usec"];
+		const double previous_median = previous["median_usec"];
+		const double change = previous_median > 0.0 ? (current_median / previous_median - 1.0) * 100.0 : 0.0;
+		// Slowdowns within the noise of either run don't count, however large
+		// they are relative to very short measurements.
+		const double noise = MAX(double(current["stddev_usec"]), double(previous.get("stddev_usec", 0.0)));
+		const bool regressed = change > threshold && current_median - previous_median > noise;
+		if (regressed) {
+			regressions++;
+		}
+		print_line(vformat("  %s: %.3f usec, was %.3f usec (%+.1f%%)%s", *key, current_median, previous_median, change, regressed ? " REGRESSED" : ""));
+	}
+
+	if (regressions > 0) {
+		print_line(vformat("%d benchmark(s) regressed.", regressions));
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
+
+} // namespace TestBenchmark
@@ -0,0 +1,94 @@
+/**************************************************************************/
+/*  test_benchmark.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_BENCHMARK_H
+#define TEST_BENCHMARK_H
+
+#include "core/os/os.h"
+#include "core/string/ustring.h"
+#include "core/templates/local_vector.h"
+
+// Benchmarks are doctest cases tagged with [Benchmark] and skipped by default.
+// Running `godot --test --benchmarks` runs only them, printing one line per
+// measure(), and collects every measurement into a JSON report:
+//
+//   --benchmark-samples <n>       Samples taken per measurement (default: 10).
+//   --benchmark-output <file>     Saves the report to a file.
+//   --benchmark-baseline <file>   Compares against a previously saved report, the
+//                                 exit code is non-zero if anything regressed.
+//   --benchmark-threshold <pct>   Slowdown of the median tolerated before a
+//                                 measurement counts as regressed (default: 10).
+//
+// Names of measurements are the keys compared against the baseline, so keep
+// them stable, and make them unique across the whole run.
+namespace TestBenchmark {
+
+struct Result {
+	String name;
+	uint32_t iterations = 0;
+	// Per iteration, in microseconds.
+	double min = 0.0;
+	double median = 0.0;
+	double mean = 0.0;
+	double stddev = 0.0;
+	double max = 0.0;
+};
+
+bool is_enabled();
+uint32_t get_sample_count();
+void add_result(const String &p_name, uint32_t p_iterations, const LocalVector<uint64_t> &p_sample_usec);
+
+// Times p_iterations calls of p_function, once to warm up then for each sample.
+template <typename F>
+void measure(const String &p_name, uint32_t p_iterations, F p_function) {
+	for (uint32_t i = 0; i < p_iterations; i++) {
+		p_function();
+	}
+
+	const uint32_t sample_count = get_sample_count();
+	LocalVector<uint64_t> sample_usec;
+	sample_usec.resize(sample_count);
+	for (uint32_t sample = 0; sample < sample_count; sample++) {
+		const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (uint32_t i = 0; i < p_iterations; i++) {
+			p_function();
+		}
+		sample_usec[sample] = OS::get_singleton()->get_ticks_usec() - begin;
+	}
+	add_result(p_name, p_iterations, sample_usec);
+}
+
+// Called by the test runner.
+void setup(const List<String> &p_args);
+int finish();
+
+} // namespace TestBenchmark
+
+#endif // TEST_BENCHMARK_H